@@ -1,4 +1,11 @@
 
+# Build with USE_LUAJIT=true to use LuaJIT from external-deps/luajit instead of Lua 5.2.
+ifeq ($(USE_LUAJIT),true)
+LUA_DIR := luajit
+else
+LUA_DIR := lua
+endif
+
 LOCAL_PATH := $(call my-dir)/../../src
 
 include $(CLEAR_VARS)
@@ -40,6 +47,7 @@ LOCAL_SRC_FILES := \
     Frustum.cpp \
     Game.cpp \
     Gamepad.cpp \
+    GlyphAtlas.cpp \
     HeightField.cpp \
     Image.cpp \
     ImageControl.cpp \
@@ -96,10 +104,14 @@ LOCAL_SRC_FILES := \
     Technique.cpp \
     Terrain.cpp \
     TerrainPatch.cpp \
+    TerrainPager.cpp \
     TextBox.cpp \
     Texture.cpp \
+    TextureAtlas.cpp \
     Theme.cpp \
     ThemeStyle.cpp \
+    Thread.cpp \
+    ThreadPool.cpp \
     Transform.cpp \
     Vector2.cpp \
     Vector3.cpp \
@@ -107,6 +119,7 @@ LOCAL_SRC_FILES := \
     VertexAttributeBinding.cpp \
     VertexFormat.cpp \
     VerticalLayout.cpp \
+    VirtualList.cpp \
     lua/lua_AbsoluteLayout.cpp \
     lua/lua_AIAgent.cpp \
     lua/lua_AIAgentListener.cpp \
@@ -285,7 +298,7 @@ LOCAL_SRC_FILES := \
     lua/lua_VerticalLayout.cpp
 
     
-LOCAL_CFLAGS := -D__ANDROID__ -DGP_USE_SOCIAL -I"../../external-deps/lua/include" -I"../../external-deps/bullet/include" -I"../../external-deps/png/include" -I"../../external-deps/oggvorbis/include" -I"../../external-deps/openal/include"
+LOCAL_CFLAGS := -D__ANDROID__ -DGP_USE_SOCIAL -I"../../external-deps/$(LUA_DIR)/include" -I"../../external-deps/bullet/include" -I"../../external-deps/png/include" -I"../../external-deps/oggvorbis/include" -I"../../external-deps/openal/include"
 LOCAL_STATIC_LIBRARIES := android_native_app_glue
 
 include $(BUILD_STATIC_LIBRARY)
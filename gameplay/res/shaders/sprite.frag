@@ -8,15 +8,44 @@ precision mediump float;
 
 ///////////////////////////////////////////////////////////
 // Uniforms
+#if defined(MULTI_TEXTURE)
+uniform sampler2D u_texture0;
+uniform sampler2D u_texture1;
+uniform sampler2D u_texture2;
+uniform sampler2D u_texture3;
+#else
 uniform sampler2D u_texture;
+#endif
 
 ///////////////////////////////////////////////////////////
 // Varyings
 varying vec2 v_texCoord;
 varying vec4 v_color;
+#if defined(MULTI_TEXTURE)
+varying vec2 v_texture;
+#endif
 
 
 void main()
 {
+    #if defined(MULTI_TEXTURE)
+
+    // v_texture.x selects the texture and v_texture.y is 1 for textures that only provide alpha.
+    vec4 color;
+    if (v_texture.x < 0.5)
+        color = texture2D(u_texture0, v_texCoord);
+    else if (v_texture.x < 1.5)
+        color = texture2D(u_texture1, v_texCoord);
+    else if (v_texture.x < 2.5)
+        color = texture2D(u_texture2, v_texCoord);
+    else
+        color = texture2D(u_texture3, v_texCoord);
+    color.rgb = mix(color.rgb, vec3(1.0), v_texture.y);
+    gl_FragColor = v_color * color;
+
+    #else
+
     gl_FragColor = v_color * texture2D(u_texture, v_texCoord);
+
+    #endif
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 attribute vec3 a_position;
 attribute vec2 a_texCoord;
 attribute vec4 a_color;
+#if defined(MULTI_TEXTURE)
+attribute vec2 a_texCoord1;
+#endif
 
 ///////////////////////////////////////////////////////////
 // Uniforms
@@ -12,6 +15,9 @@ uniform mat4 u_projectionMatrix;
 // Varyings
 varying vec2 v_texCoord;
 varying vec4 v_color;
+#if defined(MULTI_TEXTURE)
+varying vec2 v_texture;
+#endif
 
 
 void main()
@@ -19,4 +25,7 @@ void main()
     gl_Position = u_projectionMatrix * vec4(a_position, 1);
     v_texCoord = a_texCoord;
     v_color = a_color;
+    #if defined(MULTI_TEXTURE)
+    v_texture = a_texCoord1;
+    #endif
 }
@@ -13,11 +13,20 @@
 
 ///////////////////////////////////////////////////////////
 // Attributes
+#if defined(COMPACT_VERTICES)
+// x: packed grid coordinate relative to the patch origin, y: height
+attribute vec2 a_position;
+#if !defined(NORMAL_MAP) && defined(LIGHTING)
+// Normal x and z components packed into a single value
+attribute float a_normal;
+#endif
+#else
 attribute vec4 a_position;
 #if !defined(NORMAL_MAP) && defined(LIGHTING)
 attribute vec3 a_normal;
 #endif
 attribute vec2 a_texCoord0;
+#endif
 
 ///////////////////////////////////////////////////////////
 // Uniforms
@@ -26,6 +35,13 @@ uniform mat4 u_worldViewProjectionMatrix;
 uniform mat4 u_normalMatrix;
 #endif
 
+#if defined(COMPACT_VERTICES)
+uniform vec2 u_gridOrigin;
+uniform vec2 u_gridSize;
+uniform vec4 u_gridToPosition;
+uniform vec4 u_gridToTexCoord;
+#endif
+
 #if defined(LIGHTING)
 
 uniform mat4 u_inverseTransposeWorldViewMatrix;
@@ -85,30 +101,63 @@ varying vec2 v_texCoordLayer2;
 
 void main()
 {
+    #if defined(COMPACT_VERTICES)
+
+    // Derive the position and texture coord from the grid coordinate, which is offset by one
+    // so that skirt vertices lie one step outside the patch on either side
+    float gridZ = floor(a_position.x / 4096.0);
+    vec2 local = vec2(a_position.x - gridZ * 4096.0, gridZ);
+    vec2 grid = u_gridOrigin + clamp(local - 1.0, vec2(0.0), u_gridSize);
+    vec4 position = vec4(grid.x * u_gridToPosition.x + u_gridToPosition.z, a_position.y, grid.y * u_gridToPosition.y + u_gridToPosition.w, 1.0);
+    vec2 texCoord = vec2(grid.x * u_gridToTexCoord.x, 1.0 - grid.y * u_gridToTexCoord.y);
+
+    // Offset the texture coord of skirts away from the patch, preferring the x offset at corners
+    vec2 skirt = step(u_gridSize + 1.5, local) - (1.0 - step(0.5, local));
+    texCoord.x += skirt.x * u_gridToTexCoord.z;
+    texCoord.y += (1.0 - abs(skirt.x)) * skirt.y * u_gridToTexCoord.w;
+
+    #if defined(LIGHTING) && !defined(NORMAL_MAP)
+    // Unpack the normal, whose y component is always positive for terrain
+    float normalX = floor(a_normal / 4096.0);
+    vec2 normalXZ = vec2(normalX, a_normal - normalX * 4096.0) * (2.0 / 4095.0) - 1.0;
+    vec3 normal = vec3(normalXZ.x, sqrt(max(0.0, 1.0 - dot(normalXZ, normalXZ))), normalXZ.y);
+    #endif
+
+    #else
+
+    vec4 position = a_position;
+    vec2 texCoord = a_texCoord0;
+
+    #if defined(LIGHTING) && !defined(NORMAL_MAP)
+    vec3 normal = a_normal;
+    #endif
+
+    #endif
+
     // Transform position to clip space.
-    gl_Position = u_worldViewProjectionMatrix * a_position;
+    gl_Position = u_worldViewProjectionMatrix * position;
 
     #if defined(LIGHTING)
 
     #if !defined(NORMAL_MAP) 
-    v_normalVector = normalize((u_normalMatrix * vec4(a_normal.x, a_normal.y, a_normal.z, 0)).xyz);
+    v_normalVector = normalize((u_normalMatrix * vec4(normal.x, normal.y, normal.z, 0)).xyz);
     #endif
 
-    applyLight(a_position);
+    applyLight(position);
 
     #endif
 
     // Pass base texture coord
-    v_texCoord0 = a_texCoord0;
+    v_texCoord0 = texCoord;
 
     // Pass repeated texture coordinates for each layer
     #if LAYER_COUNT > 0
-    v_texCoordLayer0 = a_texCoord0 * TEXTURE_REPEAT_0;
+    v_texCoordLayer0 = texCoord * TEXTURE_REPEAT_0;
     #endif
     #if LAYER_COUNT > 1
-    v_texCoordLayer1 = a_texCoord0 * TEXTURE_REPEAT_1;
+    v_texCoordLayer1 = texCoord * TEXTURE_REPEAT_1;
     #endif
     #if LAYER_COUNT > 2
-    v_texCoordLayer2 = a_texCoord0 * TEXTURE_REPEAT_2;
+    v_texCoordLayer2 = texCoord * TEXTURE_REPEAT_2;
     #endif
 }
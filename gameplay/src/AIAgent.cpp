@@ -6,7 +6,8 @@ namespace gameplay
 {
 
 AIAgent::AIAgent()
-    : _stateMachine(NULL), _node(NULL), _enabled(true), _listener(NULL), _next(NULL)
+    : _stateMachine(NULL), _node(NULL), _enabled(true), _listener(NULL), _next(NULL),
+      _updateInterval(0), _elapsedTime(0), _overdueTime(0)
 {
     _stateMachine = new AIStateMachine(this);
 
@@ -56,6 +57,16 @@ void AIAgent::setListener(Listener* listener)
     _listener = listener;
 }
 
+float AIAgent::getUpdateInterval() const
+{
+    return _updateInterval;
+}
+
+void AIAgent::setUpdateInterval(float interval)
+{
+    _updateInterval = std::max(interval, 0.0f);
+}
+
 void AIAgent::update(float elapsedTime)
 {
     _stateMachine->update(elapsedTime);
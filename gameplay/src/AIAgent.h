@@ -118,6 +118,25 @@ public:
      */
     void setListener(Listener* listener);
 
+    /**
+     * Returns the minimum interval between updates of this AIAgent.
+     *
+     * @return The update interval, in milliseconds, or zero if the agent is updated every frame.
+     */
+    float getUpdateInterval() const;
+
+    /**
+     * Sets the minimum interval between updates of this AIAgent.
+     *
+     * Agents with a non-zero interval have their state machine updated at most once
+     * per interval, and the active state receives the total time elapsed since its
+     * previous update. Such agents share the AIController's per-frame update budget,
+     * so an update may occur later than the interval when many agents are due.
+     *
+     * @param interval The update interval, in milliseconds, or zero to update every frame.
+     */
+    void setUpdateInterval(float interval);
+
 private:
 
     /**
@@ -161,6 +180,9 @@ private:
     bool _enabled;
     Listener* _listener;
     AIAgent* _next;
+    float _updateInterval;
+    float _elapsedTime;
+    float _overdueTime;
 
 };
 
@@ -1,12 +1,15 @@
 #include "Base.h"
 #include "AIController.h"
 #include "Game.h"
+#include "Node.h"
+#include "ThreadPool.h"
 
 namespace gameplay
 {
 
 AIController::AIController()
-    : _paused(false), _firstMessage(NULL), _firstAgent(NULL)
+    : _paused(false), _firstAgent(NULL), _focusNode(NULL),
+      _farDistance(0), _farInterval(0), _budget(0), _threadPool(NULL)
 {
 }
 
@@ -16,10 +19,26 @@ AIController::~AIController()
 
 void AIController::initialize()
 {
+    Properties* config = Game::getInstance()->getConfig()->getNamespace("ai", true);
+    unsigned int threadCount = 1;
+    if (config)
+    {
+        if (config->exists("threads"))
+            threadCount = (unsigned int)std::max(config->getInt("threads"), 0);
+        _budget = std::max(config->getFloat("budget"), 0.0f);
+        setFarUpdateDistance(config->getFloat("farDistance"), config->getFloat("farInterval"));
+    }
+    if (threadCount == 0)
+        threadCount = Thread::getHardwareConcurrency();
+    if (threadCount > 1)
+        _threadPool = ThreadPool::create(threadCount);
 }
 
 void AIController::finalize()
 {
+    SAFE_RELEASE(_focusNode);
+    SAFE_DELETE(_threadPool);
+
     // Remove all agents
     AIAgent* agent = _firstAgent;
     while (agent)
@@ -29,16 +48,15 @@ void AIController::finalize()
         SAFE_RELEASE(temp);
     }
     _firstAgent = NULL;
+    _agentIndex.clear();
 
     // Remove all messages
-    AIMessage* message = _firstMessage;
-    while (message)
+    for (size_t i = 0, count = _delayedMessages.size(); i < count; ++i)
     {
-        AIMessage* temp = message;
-        message = message->_next;
-        AIMessage::destroy(temp);
+        AIMessage::destroy(_delayedMessages[i]);
     }
-    _firstMessage = NULL;
+    _delayedMessages.clear();
+    AIMessage::clearPool();
 }
 
 void AIController::pause()
@@ -87,9 +105,9 @@ void AIController::sendMessage(AIMessage* message, float delay)
     else
     {
         // Queue for later delivery
-        if (_firstMessage)
-            message->_next = _firstMessage;
-        _firstMessage = message;
+        message->_deliveryTime = Game::getGameTime() + delay;
+        _delayedMessages.push_back(message);
+        std::push_heap(_delayedMessages.begin(), _delayedMessages.end(), &compareDeliveryTime);
     }
 }
 
@@ -98,41 +116,110 @@ void AIController::update(float elapsedTime)
     if (_paused)
         return;
 
-    static Game* game = Game::getInstance();
-
-    // Send all pending messages that have expired
-    AIMessage* prevMsg = NULL;
-    AIMessage* msg = _firstMessage;
-    while (msg)
+    // Send all pending messages whose delivery time has been reached (this also deletes them)
+    double gameTime = Game::getGameTime();
+    while (!_delayedMessages.empty() && _delayedMessages.front()->getDeliveryTime() <= gameTime)
     {
-        // If the message delivery time has expired, send it (this also deletes it)
-        if (msg->getDeliveryTime() >= game->getGameTime())
-        {
-            // Link the message out of our list
-            if (prevMsg)
-                prevMsg->_next = msg->_next;
-
-            AIMessage* temp = msg;
-            msg = msg->_next;
-            temp->_next = NULL;
-            sendMessage(temp);
-        }
-        else
-        {
-            prevMsg = msg;
-            msg = msg->_next;
-        }
+        std::pop_heap(_delayedMessages.begin(), _delayedMessages.end(), &compareDeliveryTime);
+        AIMessage* message = _delayedMessages.back();
+        _delayedMessages.pop_back();
+        sendMessage(message);
     }
 
-    // Update all enabled agents
+    // Gather the agents that are due for an update. Agents updated on this thread are
+    // referenced until they have been updated, in case an earlier update removes them.
+    Vector3 focus;
+    float farDistanceSq = 0;
+    if (_focusNode && _farDistance > 0)
+    {
+        focus = _focusNode->getTranslationWorld();
+        farDistanceSq = _farDistance * _farDistance;
+    }
     AIAgent* agent = _firstAgent;
     while (agent)
     {
         if (agent->isEnabled())
-            agent->update(elapsedTime);
+        {
+            agent->_elapsedTime += elapsedTime;
+
+            float interval = agent->_updateInterval;
+            if (farDistanceSq > 0 && agent->_node->getTranslationWorld().distanceSquared(focus) > farDistanceSq)
+                interval = std::max(interval, _farInterval);
+
+            if (agent->_elapsedTime >= interval)
+            {
+                if (_threadPool && agent->_stateMachine->getActiveState()->isConcurrent())
+                {
+                    _concurrentAgents.push_back(agent);
+                }
+                else if (interval <= 0)
+                {
+                    agent->addRef();
+                    _frameAgents.push_back(agent);
+                }
+                else
+                {
+                    agent->addRef();
+                    agent->_overdueTime = agent->_elapsedTime - interval;
+                    _pendingAgents.push_back(agent);
+                }
+            }
+        }
 
         agent = agent->_next;
     }
+
+    double startTime = Game::getAbsoluteTime();
+
+    // Update agents with thread-safe states in parallel. These updates cannot change
+    // the agent list, so this is done before any other agent is updated.
+    if (!_concurrentAgents.empty())
+    {
+        _threadPool->execute(&updateAgents, &_concurrentAgents[0], (unsigned int)_concurrentAgents.size(), 32);
+        _concurrentAgents.clear();
+    }
+
+    // Update agents that run every frame.
+    for (size_t i = 0, count = _frameAgents.size(); i < count; ++i)
+    {
+        agent = _frameAgents[i];
+        if (agent->isEnabled())
+            updateAgent(agent);
+        agent->release();
+    }
+    _frameAgents.clear();
+
+    // Update the remaining due agents, longest waiting first, until the budget is spent.
+    if (!_pendingAgents.empty())
+    {
+        if (_budget > 0)
+            std::sort(_pendingAgents.begin(), _pendingAgents.end(), &compareOverdueTime);
+
+        for (size_t i = 0, count = _pendingAgents.size(); i < count; ++i)
+        {
+            agent = _pendingAgents[i];
+            if (agent->isEnabled() && (i == 0 || _budget <= 0 || Game::getAbsoluteTime() - startTime < _budget))
+                updateAgent(agent);
+            agent->release();
+        }
+        _pendingAgents.clear();
+    }
+}
+
+void AIController::updateAgent(AIAgent* agent)
+{
+    float elapsedTime = agent->_elapsedTime;
+    agent->_elapsedTime = 0;
+    agent->update(elapsedTime);
+}
+
+void AIController::updateAgents(void* arg, unsigned int begin, unsigned int end)
+{
+    AIAgent** agents = static_cast<AIAgent**>(arg);
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        updateAgent(agents[i]);
+    }
 }
 
 void AIController::addAgent(AIAgent* agent)
@@ -143,6 +230,8 @@ void AIController::addAgent(AIAgent* agent)
         agent->_next = _firstAgent;
 
     _firstAgent = agent;
+
+    indexAgent(agent);
 }
 
 void AIController::removeAgent(AIAgent* agent)
@@ -154,6 +243,8 @@ void AIController::removeAgent(AIAgent* agent)
     {
         if (itr == agent)
         {
+            unindexAgent(agent);
+
             if (prevAgent)
                 prevAgent->_next = agent->_next;
             else
@@ -173,16 +264,107 @@ AIAgent* AIController::findAgent(const char* id) const
 {
     GP_ASSERT(id);
 
-    AIAgent* agent = _firstAgent;
-    while (agent)
+    AIAgent* const* agent = _agentIndex.find(AgentKey(id));
+    return agent ? *agent : NULL;
+}
+
+void AIController::indexAgent(AIAgent* agent)
+{
+    // Replace the key as well as the value, since the key references the agent's ID string.
+    AgentKey key(agent->getId());
+    _agentIndex.remove(key);
+    _agentIndex.insert(key, agent);
+}
+
+void AIController::unindexAgent(AIAgent* agent)
+{
+    AgentKey key(agent->getId());
+    AIAgent** indexed = _agentIndex.find(key);
+    if (!indexed || *indexed != agent)
+        return;
+
+    _agentIndex.remove(key);
+
+    // Index the next registered agent with the same ID, if any.
+    for (AIAgent* itr = _firstAgent; itr; itr = itr->_next)
     {
-        if (strcmp(id, agent->getId()) == 0)
-            return agent;
+        if (itr != agent && strcmp(key.id, itr->getId()) == 0)
+        {
+            _agentIndex.insert(AgentKey(itr->getId()), itr);
+            break;
+        }
+    }
+}
 
-        agent = agent->_next;
+Node* AIController::getFocusNode() const
+{
+    return _focusNode;
+}
+
+void AIController::setFocusNode(Node* node)
+{
+    if (node != _focusNode)
+    {
+        SAFE_RELEASE(_focusNode);
+        _focusNode = node;
+        if (_focusNode)
+            _focusNode->addRef();
     }
+}
+
+float AIController::getFarUpdateDistance() const
+{
+    return _farDistance;
+}
+
+float AIController::getFarUpdateInterval() const
+{
+    return _farInterval;
+}
+
+void AIController::setFarUpdateDistance(float distance, float interval)
+{
+    _farDistance = std::max(distance, 0.0f);
+    _farInterval = std::max(interval, 0.0f);
+}
+
+float AIController::getUpdateBudget() const
+{
+    return _budget;
+}
+
+void AIController::setUpdateBudget(float budget)
+{
+    _budget = std::max(budget, 0.0f);
+}
 
-    return NULL;
+bool AIController::compareDeliveryTime(const AIMessage* a, const AIMessage* b)
+{
+    return a->_deliveryTime > b->_deliveryTime;
+}
+
+AIController::AgentKey::AgentKey(const char* id)
+    : id(id)
+{
+    // FNV-1a hash of the ID.
+    hash = 2166136261u;
+    for (const unsigned char* c = (const unsigned char*)id; *c; ++c)
+        hash = (hash ^ *c) * 16777619u;
+}
+
+unsigned int AIController::AgentKey::getHash() const
+{
+    return hash;
+}
+
+bool AIController::AgentKey::equals(const AgentKey& other) const
+{
+    return hash == other.hash && strcmp(id, other.id) == 0;
+}
+
+bool AIController::compareOverdueTime(const AIAgent* a, const AIAgent* b)
+{
+    return a->_overdueTime > b->_overdueTime;
 }
 
 }
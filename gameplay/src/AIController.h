@@ -7,6 +7,8 @@
 namespace gameplay
 {
 
+class ThreadPool;
+
 /**
  * Defines and facilitates the state machine execution and message passing
  * between AI objects in the game. This class is generally not interfaced
@@ -30,7 +32,7 @@ public:
      * they are sent through the AIController.
      *
      * @param message The message to send.
-     * @param delay The delay (in milliseconds) to wait before sending the message.
+     * @param delay The delay (in milliseconds) of game time to wait before sending the message.
      */
     void sendMessage(AIMessage* message, float delay = 0);
 
@@ -43,6 +45,66 @@ public:
      */
     AIAgent* findAgent(const char* id) const;
 
+    /**
+     * Returns the node that agent update rates are measured from.
+     *
+     * @return The focus node, or NULL if no focus node is set.
+     */
+    Node* getFocusNode() const;
+
+    /**
+     * Sets the node that agent update rates are measured from, typically the camera or player node.
+     *
+     * Agents farther than the far update distance from the focus node are updated
+     * no more often than the far update interval.
+     *
+     * @param node The focus node, or NULL to update all agents at their own interval.
+     */
+    void setFocusNode(Node* node);
+
+    /**
+     * Returns the distance from the focus node beyond which agents are updated at the far update interval.
+     *
+     * @return The far update distance.
+     */
+    float getFarUpdateDistance() const;
+
+    /**
+     * Returns the minimum interval between updates of agents beyond the far update distance.
+     *
+     * @return The far update interval, in milliseconds.
+     */
+    float getFarUpdateInterval() const;
+
+    /**
+     * Sets the distance from the focus node beyond which agents are updated less often.
+     *
+     * The far update interval only raises an agent's own update interval (see AIAgent::setUpdateInterval).
+     *
+     * @param distance The far update distance, or zero to disable distance based update rates.
+     * @param interval The minimum interval between updates of far agents, in milliseconds.
+     */
+    void setFarUpdateDistance(float distance, float interval);
+
+    /**
+     * Returns the time each frame that may be spent updating agents with an update interval.
+     *
+     * @return The update budget, in milliseconds, or zero if the budget is unlimited.
+     */
+    float getUpdateBudget() const;
+
+    /**
+     * Sets the time each frame that may be spent updating agents with an update interval.
+     *
+     * Agents without an update interval are always updated every frame. Agents that are due
+     * for an update are then updated in order of how long they have been waiting, until
+     * the time spent updating agents this frame exceeds the budget. At least one waiting
+     * agent is updated every frame.
+     *
+     * @param budget The update budget, in milliseconds, or zero for an unlimited budget.
+     */
+    void setUpdateBudget(float budget);
+
 private:
 
     /**
@@ -96,9 +158,62 @@ private:
 
     void removeAgent(AIAgent* agent);
 
+    /**
+     * Adds an agent to the ID index used by findAgent.
+     */
+    void indexAgent(AIAgent* agent);
+
+    /**
+     * Removes an agent from the ID index, replacing it with another agent that has the same ID.
+     */
+    void unindexAgent(AIAgent* agent);
+
+    /**
+     * Orders delayed messages so that the message with the earliest delivery time is at the top of the heap.
+     */
+    static bool compareDeliveryTime(const AIMessage* a, const AIMessage* b);
+
+    /**
+     * Updates an agent with the time accumulated since its previous update.
+     */
+    static void updateAgent(AIAgent* agent);
+
+    /**
+     * Thread pool function that updates a range of agents with thread-safe states.
+     */
+    static void updateAgents(void* arg, unsigned int begin, unsigned int end);
+
+    /**
+     * Orders agents that are due for an update by how long they have been waiting.
+     */
+    static bool compareOverdueTime(const AIAgent* a, const AIAgent* b);
+
+    // Identifies the agents registered with an ID. The ID string is owned by the agent's node,
+    // which removes its agent from the index before changing its ID.
+    struct AgentKey
+    {
+        AgentKey(const char* id);
+
+        unsigned int getHash() const;
+
+        bool equals(const AgentKey& other) const;
+
+        const char* id;
+        unsigned int hash;
+    };
+
     bool _paused;
-    AIMessage* _firstMessage;
+    std::vector<AIMessage*> _delayedMessages;
     AIAgent* _firstAgent;
+    btHashMap<AgentKey, AIAgent*> _agentIndex;
+    Node* _focusNode;
+    float _farDistance;
+    float _farInterval;
+    float _budget;
+    ThreadPool* _threadPool;
+    std::vector<AIAgent*> _concurrentAgents;
+    std::vector<AIAgent*> _frameAgents;
+    std::vector<AIAgent*> _pendingAgents;
 
 };
 
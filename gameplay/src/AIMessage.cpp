@@ -1,11 +1,17 @@
 #include "Base.h"
 #include "AIMessage.h"
 
+// The maximum number of destroyed messages kept for reuse.
+#define MAX_POOLED_MESSAGES 1024
+
 namespace gameplay
 {
 
+AIMessage* AIMessage::_pool = NULL;
+unsigned int AIMessage::_poolSize = 0;
+
 AIMessage::AIMessage()
-    : _id(0), _deliveryTime(0), _parameters(NULL), _parameterCount(0), _messageType(MESSAGE_TYPE_CUSTOM), _next(NULL)
+    : _id(0), _deliveryTime(0), _parameters(NULL), _parameterCount(0), _parameterCapacity(0), _messageType(MESSAGE_TYPE_CUSTOM), _next(NULL)
 {
 }
 
@@ -16,19 +22,62 @@ AIMessage::~AIMessage()
 
 AIMessage* AIMessage::create(unsigned int id, const char* sender, const char* receiver, unsigned int parameterCount)
 {
-    AIMessage* message = new AIMessage();
+    AIMessage* message = _pool;
+    if (message)
+    {
+        _pool = message->_next;
+        message->_next = NULL;
+        --_poolSize;
+    }
+    else
+    {
+        message = new AIMessage();
+    }
+
     message->_id = id;
-    message->_sender = sender;
-    message->_receiver = receiver;
-    message->_parameterCount = parameterCount;
-    if (parameterCount > 0)
+    message->_sender = sender ? sender : "";
+    message->_receiver = receiver ? receiver : "";
+    message->_deliveryTime = 0;
+    message->_messageType = MESSAGE_TYPE_CUSTOM;
+    if (parameterCount > message->_parameterCapacity)
+    {
+        SAFE_DELETE_ARRAY(message->_parameters);
         message->_parameters = new AIMessage::Parameter[parameterCount];
+        message->_parameterCapacity = parameterCount;
+    }
+    message->_parameterCount = parameterCount;
     return message;
 }
 
 void AIMessage::destroy(AIMessage* message)
 {
-    SAFE_DELETE(message);
+    if (!message)
+        return;
+
+    if (_poolSize >= MAX_POOLED_MESSAGES)
+    {
+        SAFE_DELETE(message);
+        return;
+    }
+
+    for (unsigned int i = 0; i < message->_parameterCount; ++i)
+        message->_parameters[i].clear();
+    message->_parameterCount = 0;
+
+    message->_next = _pool;
+    _pool = message;
+    ++_poolSize;
+}
+
+void AIMessage::clearPool()
+{
+    while (_pool)
+    {
+        AIMessage* message = _pool;
+        _pool = message->_next;
+        SAFE_DELETE(message);
+    }
+    _poolSize = 0;
 }
 
 unsigned int AIMessage::getId() const
@@ -156,12 +205,17 @@ void AIMessage::setString(unsigned int index, const char* value)
 
     clearParameter(index);
 
-    // Copy the string into our parameter
+    // Copy the string into our parameter, reusing its buffer when it is large enough
+    Parameter& parameter = _parameters[index];
     size_t len = strlen(value);
-    char* buffer = new char[len + 1];
-    strcpy(buffer, value);
-    _parameters[index].stringValue = buffer;
-    _parameters[index].type = AIMessage::STRING;
+    if (len >= parameter.stringCapacity)
+    {
+        SAFE_DELETE_ARRAY(parameter.stringValue);
+        parameter.stringValue = new char[len + 1];
+        parameter.stringCapacity = (unsigned int)len + 1;
+    }
+    memcpy(parameter.stringValue, value, len + 1);
+    parameter.type = AIMessage::STRING;
 }
 
 unsigned int AIMessage::getParameterCount() const
@@ -184,24 +238,17 @@ void AIMessage::clearParameter(unsigned int index)
 }
 
 AIMessage::Parameter::Parameter()
-    : type(UNDEFINED)
+    : stringValue(NULL), stringCapacity(0), type(UNDEFINED)
 {
 }
 
 AIMessage::Parameter::~Parameter()
 {
-    clear();
+    SAFE_DELETE_ARRAY(stringValue);
 }
 
 void AIMessage::Parameter::clear()
 {
-    switch (type)
-    {
-    case AIMessage::STRING:
-        SAFE_DELETE_ARRAY(stringValue);
-        break;
-    }
-
     type = AIMessage::UNDEFINED;
 }
 
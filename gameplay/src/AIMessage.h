@@ -49,6 +49,8 @@ public:
      * @param receiver AIAgent receiver ID (can be empty or null for a broadcast message).
      * @param parameterCount Number of parameters for this message.
      *
+     * Messages are recycled through a pool, so creating a message usually does not allocate memory.
+     *
      * @return A new AIMessage.
      */
     static AIMessage* create(unsigned int id, const char* sender, const char* receiver, unsigned int parameterCount);
@@ -61,6 +63,8 @@ public:
      * sent. However, in the rare case where an AIMessage is constructed and not
      * passed to AIController::sendMessage, this method should be called to destroy
      * the message.
+     *
+     * Destroyed messages are returned to a pool to be reused by AIMessage::create.
      */
     static void destroy(AIMessage* message);
 
@@ -232,9 +236,11 @@ private:
             float floatValue;
             double doubleValue;
             bool boolValue;
-            char* stringValue;
         };
 
+        // String values have their own buffer so that it can be reused when the message is recycled.
+        char* stringValue;
+        unsigned int stringCapacity;
         AIMessage::ParameterType type;
     };
 
@@ -267,15 +273,25 @@ private:
 
     void clearParameter(unsigned int index);
 
+    /**
+     * Deletes the messages held in the pool.
+     */
+    static void clearPool();
+
     unsigned int _id;
     std::string _sender;
     std::string _receiver;
     double _deliveryTime;
     Parameter* _parameters;
     unsigned int _parameterCount;
+    unsigned int _parameterCapacity;
     MessageType _messageType;
     AIMessage* _next;
 
+    // Destroyed messages available for reuse, linked through _next.
+    static AIMessage* _pool;
+    static unsigned int _poolSize;
+
 };
 
 }
@@ -8,7 +8,7 @@ namespace gameplay
 AIState* AIState::_empty = NULL;
 
 AIState::AIState(const char* id)
-    : _id(id), _listener(NULL)
+    : _id(id), _listener(NULL), _threadSafe(false)
 {
     addScriptEvent("enter", "<AIAgent><AIState>");
     addScriptEvent("exit", "<AIAgent><AIState>");
@@ -34,6 +34,25 @@ void AIState::setListener(Listener* listener)
     _listener = listener;
 }
 
+void AIState::setThreadSafe(bool threadSafe)
+{
+    _threadSafe = threadSafe;
+}
+
+bool AIState::isThreadSafe() const
+{
+    return _threadSafe;
+}
+
+bool AIState::isConcurrent() const
+{
+    if (!_threadSafe)
+        return false;
+
+    // Script callbacks must run on the main thread.
+    return !hasScriptCallbacks("update");
+}
+
 void AIState::enter(AIStateMachine* stateMachine)
 {
     if (_listener)
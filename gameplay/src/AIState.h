@@ -20,6 +20,7 @@ class AIStateMachine;
 class AIState : public Ref, public ScriptTarget
 {
     friend class AIStateMachine;
+    friend class AIController;
 
 public:
 
@@ -87,6 +88,27 @@ public:
      */
     void setListener(Listener* listener);
 
+    /**
+     * Sets whether this state may be updated concurrently with other agents.
+     *
+     * When the AIController is configured with worker threads, agents whose active
+     * state is thread-safe are updated in parallel batches. The stateUpdate method of
+     * the state's listener must then only modify data owned by the agent being updated.
+     * It must not change states, send messages or otherwise call into shared engine
+     * objects. States that have a script "update" callback are always updated on the
+     * main thread.
+     *
+     * @param threadSafe true if the state can be updated concurrently, false otherwise.
+     */
+    void setThreadSafe(bool threadSafe);
+
+    /**
+     * Determines whether this state may be updated concurrently with other agents.
+     *
+     * @return true if the state is thread-safe, false otherwise.
+     */
+    bool isThreadSafe() const;
+
 private:
 
     /**
@@ -124,8 +146,14 @@ private:
      */
     void update(AIStateMachine* stateMachine, float elapsedTime);
 
+    /**
+     * Determines whether this state can currently be updated from a worker thread.
+     */
+    bool isConcurrent() const;
+
     std::string _id;
     Listener* _listener;
+    bool _threadSafe;
 
     // The default/empty state.
     static AIState* _empty;
@@ -122,6 +122,7 @@ extern int strcmpnocase(const char* s1, const char* s2);
 // Bullet Physics
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#include <LinearMath/btHashMap.h>
 #define BV(v) (btVector3((v).x, (v).y, (v).z))
 #define BQ(q) (btQuaternion((q).x, (q).y, (q).z, (q).w))
 
@@ -201,6 +202,17 @@ extern int strcmpnocase(const char* s1, const char* s2);
 using std::va_list;
 #include <lua.hpp>
 
+// Lua 5.1 and LuaJIT compatibility for the Lua 5.2 API used by the engine and the generated bindings.
+#if LUA_VERSION_NUM < 502
+    #define lua_pushunsigned(L, n) lua_pushnumber(L, (lua_Number)(n))
+    #define luaL_checkunsigned(L, n) ((unsigned int)luaL_checknumber(L, n))
+    #define lua_len(L, i) lua_pushinteger(L, (lua_Integer)lua_objlen(L, i))
+    #if !defined(LUAJIT_VERSION_NUM) || LUAJIT_VERSION_NUM < 20100
+        // Upvalues are not supported; the engine only registers functions without them.
+        #define luaL_setfuncs(L, l, nup) luaL_register(L, NULL, l)
+    #endif
+#endif
+
 #define WINDOW_VSYNC        1
 
 // Graphics (OpenGL)
@@ -269,6 +281,12 @@ using std::va_list;
     #endif
 #endif
 
+// SIMD math on x86 and x64 (SSE is part of the x64 baseline)
+#if !defined(USE_NEON) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+    #include <xmmintrin.h>
+    #define USE_SSE
+#endif
+
 // Graphics (GLSL)
 #define VERTEX_ATTRIBUTE_POSITION_NAME              "a_position"
 #define VERTEX_ATTRIBUTE_NORMAL_NAME                "a_normal"
@@ -49,14 +49,15 @@ Container::Container()
     : _layout(NULL), _activeControl(NULL), _scrollBarTopCap(NULL), _scrollBarVertical(NULL), _scrollBarBottomCap(NULL),
       _scrollBarLeftCap(NULL), _scrollBarHorizontal(NULL), _scrollBarRightCap(NULL),
       _scroll(SCROLL_NONE), _scrollBarBounds(Rectangle::empty()), _scrollPosition(Vector2::zero()),
+      _totalWidth(0), _totalHeight(0),
       _scrollBarsAutoHide(false), _scrollBarOpacity(1.0f), _scrolling(false),
       _scrollingVeryFirstX(0), _scrollingVeryFirstY(0), _scrollingFirstX(0), _scrollingFirstY(0), _scrollingLastX(0), _scrollingLastY(0),
       _scrollingStartTimeX(0), _scrollingStartTimeY(0), _scrollingLastTime(0),
       _scrollingVelocity(Vector2::zero()), _scrollingFriction(1.0f), _scrollWheelSpeed(400.0f),
       _scrollingRight(false), _scrollingDown(false),
       _scrollingMouseVertically(false), _scrollingMouseHorizontally(false),
-      _scrollBarOpacityClip(NULL), _zIndexDefault(0),
-      _selectButtonDown(false), _lastFrameTime(0), _totalWidth(0), _totalHeight(0),
+      _scrollBarOpacityClip(NULL), _zIndexDefault(0), _focusIndexMax(0),
+      _selectButtonDown(false), _lastFrameTime(0),
       _initializedWithScroll(false), _scrollWheelRequiresFocus(false)
 {
 	clearContacts();
@@ -172,9 +173,6 @@ void Container::addControls(Properties* properties)
         // Get the next control.
         controlSpace = properties->getNextNamespace();
     }
-
-    // Sort controls by Z-Order.
-    sortControls();
 }
 
 Layout* Container::getLayout()
@@ -189,6 +187,7 @@ void Container::setLayout(Layout::Type type)
 		SAFE_RELEASE(_layout);
 
 		_layout = createLayout(type);
+        sortControls();
         setDirty(Control::DIRTY_BOUNDS);
 	}
 }
@@ -219,16 +218,17 @@ unsigned int Container::addControl(Control* control)
 	}
 
 	if( control->getFocusIndex() == -1 ) {
-		// Find the current largest focus index
-		int maxFocusIndex = 0;
-		for( size_t i = 0, count = _controls.size(); i < count; ++i ) {
-			if( _controls[ i ]->_focusIndex > maxFocusIndex )
-				maxFocusIndex = _controls[ i ]->_focusIndex;
-		}
-		control->setFocusIndex( maxFocusIndex + 1 );
+		// Follow the largest focus index of our controls
+		control->setFocusIndex( _focusIndexMax + 1 );
 	}
 
-	_controls.push_back( control );
+	// Controls in absolute layouts are kept sorted by z-order, so insert the control
+	// after all controls with the same or lower z-index.
+	std::vector<Control*>::iterator it = _controls.end();
+	if( _layout && _layout->getType() == Layout::LAYOUT_ABSOLUTE )
+		it = std::upper_bound( _controls.begin(), _controls.end(), control, &sortControlsByZOrder );
+	const unsigned int index = (unsigned int)( it - _controls.begin() );
+	_controls.insert( it, control );
 	control->addRef();
 
 	// Remove the control from its current parent
@@ -238,10 +238,16 @@ unsigned int Container::addControl(Control* control)
 	}
 
 	control->_parent = this;
+	controlsChanged();
 
-	sortControls();
+	if( control->_focusIndex > _focusIndexMax )
+		_focusIndexMax = control->_focusIndex;
 
-	return (unsigned int)( _controls.size() - 1 );
+	// Lay out the new control, and ourself around it
+	control->setDirty( DIRTY_BOUNDS );
+	setDirty( DIRTY_BOUNDS );
+
+	return index;
 }
 
 void Container::insertControl(Control* control, unsigned int index)
@@ -259,6 +265,13 @@ void Container::insertControl(Control* control, unsigned int index)
         _controls.insert(it, control);
         control->addRef();
         control->_parent = this;
+        controlsChanged();
+
+        if (control->_focusIndex > _focusIndexMax)
+            _focusIndexMax = control->_focusIndex;
+
+        control->setDirty(DIRTY_BOUNDS);
+        setDirty(DIRTY_BOUNDS);
     }
 }
 
@@ -270,6 +283,7 @@ void Container::removeControl(unsigned int index)
     Control* control = *it;
     _controls.erase(it);
     control->_parent = NULL;
+    controlsChanged();
 
     if (_activeControl == control)
         _activeControl = NULL;
@@ -277,6 +291,9 @@ void Container::removeControl(unsigned int index)
     Form::verifyRemovedControlState(control);
 
     SAFE_RELEASE(control);
+
+    // Close the gap left in our layout
+    setDirty(DIRTY_BOUNDS);
 }
 
 void Container::removeControl(const char* id)
@@ -621,6 +638,8 @@ bool Container::updateChildBounds()
 
         if (ctrl->isVisible())
         {
+            const float oldWidth = ctrl->_bounds.width;
+            const float oldHeight = ctrl->_bounds.height;
             bool changed = ctrl->updateBoundsInternal(_scrollPosition);
 
             // If the child bounds have changed, dirty our bounds and all of our
@@ -633,6 +652,13 @@ bool Container::updateChildBounds()
                     parent->setDirty(DIRTY_BOUNDS);
                     parent = parent->_parent;
                 }
+
+                // Flow and vertical layouts position the following controls based on the size of this one
+                if ((ctrl->_bounds.width != oldWidth || ctrl->_bounds.height != oldHeight) &&
+                    _layout->getType() != Layout::LAYOUT_ABSOLUTE)
+                {
+                    setDirty(DIRTY_BOUNDS);
+                }
             }
 
             result = result || changed;
@@ -654,7 +680,8 @@ unsigned int Container::draw(Form* form, const Rectangle& clip)
     for (size_t i = 0, count = _controls.size(); i < count; ++i)
     {
         Control* control = _controls[i];
-        if (control && control->_absoluteClipBounds.intersects(_absoluteClipBounds))
+        if (control && control->_absoluteClipBounds.intersects(_absoluteClipBounds) &&
+            (form == NULL || control->_absoluteClipBounds.intersects(form->_drawRegion)))
         {
             drawCalls += control->draw(form, _viewportClipBounds);
         }
@@ -1072,27 +1099,7 @@ void Container::updateScroll()
     const Theme::Padding& containerPadding = getPadding();
 
     // Calculate total width and height.
-    _totalWidth = _totalHeight = 0.0f;
-    std::vector<Control*> controls = getControls();
-    for (size_t i = 0, count = controls.size(); i < count; ++i)
-    {
-        Control* control = _controls[i];
-
-        const Rectangle& bounds = control->getBounds();
-        const Theme::Margin& margin = control->getMargin();
-
-        float newWidth = bounds.x + bounds.width + margin.right;
-        if (newWidth > _totalWidth)
-        {
-            _totalWidth = newWidth;
-        }
-
-        float newHeight = bounds.y + bounds.height + margin.bottom;
-        if (newHeight > _totalHeight)
-        {
-            _totalHeight = newHeight;
-        }
-    }
+    updateTotalSize();
 
     float vWidth = getImageRegion("verticalScrollBar", state).width;
     float hHeight = getImageRegion("horizontalScrollBar", state).height;
@@ -1180,11 +1187,36 @@ void Container::updateScroll()
     }
 
     // When scroll position is updated, we need to recompute bounds since children
-    // absolute bounds offset will need to be updated.
+    // absolute bounds offset will need to be updated. Only their positions change, and
+    // each child passes the change on to its own children as it is updated.
     if (dirty)
     {
         setDirty(DIRTY_BOUNDS);
-        setChildrenDirty(DIRTY_BOUNDS, true);
+        setChildrenDirty(DIRTY_POSITION, false);
+    }
+}
+
+void Container::updateTotalSize()
+{
+    _totalWidth = _totalHeight = 0.0f;
+    for (size_t i = 0, count = _controls.size(); i < count; ++i)
+    {
+        Control* control = _controls[i];
+
+        const Rectangle& bounds = control->getBounds();
+        const Theme::Margin& margin = control->getMargin();
+
+        float newWidth = bounds.x + bounds.width + margin.right;
+        if (newWidth > _totalWidth)
+        {
+            _totalWidth = newWidth;
+        }
+
+        float newHeight = bounds.y + bounds.height + margin.bottom;
+        if (newHeight > _totalHeight)
+        {
+            _totalHeight = newHeight;
+        }
     }
 }
 
@@ -1192,10 +1224,26 @@ void Container::sortControls()
 {
     if (_layout->getType() == Layout::LAYOUT_ABSOLUTE)
     {
-        std::sort(_controls.begin(), _controls.end(), &sortControlsByZOrder);
+        std::stable_sort(_controls.begin(), _controls.end(), &sortControlsByZOrder);
+        controlsChanged();
     }
 }
 
+void Container::sortControl(Control* control)
+{
+    GP_ASSERT(control);
+
+    if (_layout->getType() != Layout::LAYOUT_ABSOLUTE)
+        return;
+
+    // The other controls are still sorted, so only this one needs to move.
+    std::vector<Control*>::iterator it = std::find(_controls.begin(), _controls.end(), control);
+    GP_ASSERT(it != _controls.end());
+    _controls.erase(it);
+    _controls.insert(std::upper_bound(_controls.begin(), _controls.end(), control, &sortControlsByZOrder), control);
+    controlsChanged();
+}
+
 bool Container::touchEventScroll(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
 {
     switch (evt)
@@ -1462,6 +1510,13 @@ bool Container::inContact()
 	return false;
 }
 
+void Container::controlsChanged()
+{
+    Form* form = getTopLevelForm();
+    if (form)
+        form->invalidateHitGrid();
+}
+
 Container::Scroll Container::getScroll(const char* scroll)
 {
     if (!scroll)
@@ -1553,6 +1608,7 @@ void Container::setAnimationPropertyValue(int propertyId, AnimationValue* value,
     {
     case ANIMATE_SCROLLBAR_OPACITY:
         _scrollBarOpacity = Curve::lerp(blendWeight, _opacity, value->getFloat(0));
+        setDirty(DIRTY_STATE);
         break;
     default:
         Control::setAnimationPropertyValue(propertyId, value, blendWeight);
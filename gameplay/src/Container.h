@@ -370,12 +370,27 @@ protected:
      */
     void updateScroll();
 
+    /**
+     * Computes the total width and height of the content of this container, which bound
+     * the range it can be scrolled over.
+     *
+     * By default the content size is the extent of the bounds of the child controls.
+     */
+    virtual void updateTotalSize();
+
     /**
      * Sorts controls by Z-Order (for absolute layouts only).
+     */
+    void sortControls();
+
+    /**
+     * Moves a control to its position in Z-Order (for absolute layouts only).
      * This method is used by controls to notify their parent container when
      * their Z-Index changes.
+     *
+     * @param control The control whose Z-Index changed.
      */
-    void sortControls();
+    void sortControl(Control* control);
 
     /**
      * Applies touch events to scroll state.
@@ -462,6 +477,14 @@ protected:
      * How far this layout has been scrolled in each direction.
      */
     Vector2 _scrollPosition;
+    /**
+     * The total width of the content of this container, see updateTotalSize.
+     */
+    float _totalWidth;
+    /**
+     * The total height of the content of this container, see updateTotalSize.
+     */
+    float _totalHeight;
     /** 
      * Whether the scrollbars should auto-hide. Default is false.
      */
@@ -571,13 +594,15 @@ private:
     void clearContacts();
     bool inContact();
 
+    // Notifies our form that the order of the controls it hit-tests against has changed.
+    void controlsChanged();
+
     AnimationClip* _scrollBarOpacityClip;
     int _zIndexDefault;
+    int _focusIndexMax;
     bool _selectButtonDown;
     double _lastFrameTime;
 
-    float _totalWidth;
-    float _totalHeight;
     bool _contactIndices[MAX_CONTACT_INDICES];
     bool _initializedWithScroll;
     bool _scrollWheelRequiresFocus;
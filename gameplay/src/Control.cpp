@@ -48,8 +48,11 @@ static bool parseCoordPair(const char* s, float* v1, float* v2, bool* v1Percenta
 Control::Control()
     : _id(""), _boundsBits(0), _dirtyBits(DIRTY_BOUNDS | DIRTY_STATE), _consumeInputEvents(true), _alignment(ALIGN_TOP_LEFT),
     _autoSize(AUTO_SIZE_BOTH), _style(NULL), _listeners(NULL), _visible(true), _zIndex(-1),
-    _contactIndex(INVALID_CONTACT_INDEX), _focusIndex(-1), _canFocus(false), _state(NORMAL), _parent(NULL), _styleOverridden(false), _skin(NULL)
+    _contactIndex(INVALID_CONTACT_INDEX), _focusIndex(-1), _canFocus(false), _state(NORMAL), _parent(NULL), _styleOverridden(false), _skin(NULL), _hitOrder(0)
 {
+    _hitCells[0] = _hitCells[1] = 0;
+    _hitCells[2] = _hitCells[3] = -1;
+
     addScriptEvent("controlEvent", "<Control>[Control::Listener::EventType]");
 }
 
@@ -504,6 +507,10 @@ void Control::setVisible(bool visible)
             Form::controlDisabled(this);
 
         setDirty(DIRTY_BOUNDS);
+
+        // Our parent's layout must make room for us or close the gap we leave.
+        if (_parent)
+            _parent->setDirty(DIRTY_BOUNDS);
     }
 }
 
@@ -560,6 +567,8 @@ void Control::setOpacity(float opacity, unsigned char states)
         if (overlays[i])
             overlays[i]->setOpacity(opacity);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 float Control::getOpacity(State state) const
@@ -631,6 +640,8 @@ void Control::setSkinRegion(const Rectangle& region, unsigned char states)
         if( overlays[i] )
             overlays[i]->setSkinRegion(region, _style->_tw, _style->_th);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 const Rectangle& Control::getSkinRegion(State state) const
@@ -651,6 +662,8 @@ void Control::setSkinColor(const Vector4& color, unsigned char states)
         if( overlays[i] )
             overlays[i]->setSkinColor(color);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 const Vector4& Control::getSkinColor(State state) const
@@ -699,6 +712,8 @@ void Control::setImageRegion(const char* id, const Rectangle& region, unsigned c
         if( overlays[i] )
             overlays[i]->setImageRegion(id, region, _style->_tw, _style->_th);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 const Rectangle& Control::getImageRegion(const char* id, State state) const
@@ -719,6 +734,8 @@ void Control::setImageColor(const char* id, const Vector4& color, unsigned char
         if( overlays[i] )
             overlays[i]->setImageColor(id, color);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 const Vector4& Control::getImageColor(const char* id, State state) const
@@ -746,6 +763,8 @@ void Control::setCursorRegion(const Rectangle& region, unsigned char states)
         if( overlays[i] )
             overlays[i]->setCursorRegion(region, _style->_tw, _style->_th);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 const Rectangle& Control::getCursorRegion(State state) const
@@ -766,6 +785,8 @@ void Control::setCursorColor(const Vector4& color, unsigned char states)
         if( overlays[i] )
             overlays[i]->setCursorColor(color);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 const Vector4& Control::getCursorColor(State state)
@@ -794,6 +815,8 @@ void Control::setFont(Font* font, unsigned char states)
             overlays[i]->setFont(font);
     }
 
+    setDirty(DIRTY_STATE);
+
     if (_autoSize != AUTO_SIZE_NONE)
         setDirty(DIRTY_BOUNDS);
 }
@@ -817,6 +840,8 @@ void Control::setFontSize(unsigned int fontSize, unsigned char states)
             overlays[i]->setFontSize(fontSize);
     }
 
+    setDirty(DIRTY_STATE);
+
     if (_autoSize != AUTO_SIZE_NONE)
         setDirty(DIRTY_BOUNDS);
 }
@@ -839,6 +864,8 @@ void Control::setTextColor(const Vector4& color, unsigned char states)
         if( overlays[i] )
             overlays[i]->setTextColor(color);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 const Vector4& Control::getTextColor(State state) const
@@ -859,6 +886,8 @@ void Control::setTextAlignment(Font::Justify alignment, unsigned char states)
         if( overlays[i] )
             overlays[i]->setTextAlignment(alignment);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 Font::Justify Control::getTextAlignment(State state) const
@@ -879,6 +908,8 @@ void Control::setTextRightToLeft(bool rightToLeft, unsigned char states)
         if( overlays[i] )
             overlays[i]->setTextRightToLeft(rightToLeft);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 bool Control::getTextRightToLeft(State state) const
@@ -960,7 +991,7 @@ void Control::setZIndex(int zIndex)
 
         if (_parent)
         {
-			_parent->sortControls();
+			_parent->sortControl(this);
         }
     }
 }
@@ -973,6 +1004,9 @@ int Control::getFocusIndex() const
 void Control::setFocusIndex(int focusIndex)
 {
     _focusIndex = focusIndex;
+
+    if (_parent && focusIndex > _parent->_focusIndexMax)
+        _parent->_focusIndexMax = focusIndex;
 }
 
 void Control::addListener(Control::Listener* listener, int eventFlags)
@@ -1105,6 +1139,19 @@ void Control::controlEvent(Control::Listener::EventType evt)
 void Control::setDirty(int bits)
 {
     _dirtyBits |= bits;
+
+    // Flag our ancestors so that bounds updates can skip subtrees without dirty controls.
+    Container* parent = _parent;
+    while (parent && (parent->_dirtyBits & DIRTY_CHILDREN) == 0)
+    {
+        parent->_dirtyBits |= DIRTY_CHILDREN;
+        parent = parent->_parent;
+    }
+
+    // Let a form that caches its rendering know that this control must be redrawn.
+    Form* form = getTopLevelForm();
+    if (form)
+        form->invalidate(this, bits);
 }
 
 bool Control::isDirty(int bit) const
@@ -1147,16 +1194,20 @@ bool Control::updateBoundsInternal(const Vector2& offset)
         _dirtyBits &= ~DIRTY_STATE;
     }
 
-    // Clear our dirty bounds bit
-    bool dirtyBounds = (_dirtyBits & DIRTY_BOUNDS) != 0;
-    _dirtyBits &= ~DIRTY_BOUNDS;
-
-    // If we are a container, always update child bounds first
+    // If we are a container, update child bounds first, skipping them when none are dirty
     bool changed = false;
-    if (isContainer())
+    if (isContainer() && (_dirtyBits & DIRTY_CHILDREN))
+    {
+        _dirtyBits &= ~DIRTY_CHILDREN;
         changed = static_cast<Container*>(this)->updateChildBounds();
+    }
+
+    // Clear our dirty bounds bits, which may have been set by child size changes above
+    bool dirtyBounds = (_dirtyBits & DIRTY_BOUNDS) != 0;
+    bool dirtyPosition = (_dirtyBits & DIRTY_POSITION) != 0;
+    _dirtyBits &= ~(DIRTY_BOUNDS | DIRTY_POSITION);
 
-    if (dirtyBounds)
+    if (dirtyBounds || dirtyPosition)
     {
         // Store old bounds so we can determine if they change
         Rectangle oldAbsoluteBounds(_absoluteBounds);
@@ -1164,20 +1215,42 @@ bool Control::updateBoundsInternal(const Vector2& offset)
         Rectangle oldViewportBounds(_viewportBounds);
         Rectangle oldViewportClipBounds(_viewportClipBounds);
 
-        updateBounds();
+        // When only our position is dirty, our local bounds are still valid and don't need to be measured again
+        if (dirtyBounds)
+            updateBounds();
         updateAbsoluteBounds(offset);
 
+        // Keep the hit-test grid of our form in sync with the region we accept input in
+        if (_absoluteClipBounds != oldAbsoluteClipBounds)
+        {
+            Form* form = getTopLevelForm();
+            if (form)
+                form->updateHitGrid(this);
+        }
+
         if (_absoluteBounds != oldAbsoluteBounds ||
             _absoluteClipBounds != oldAbsoluteClipBounds ||
             _viewportBounds != oldViewportBounds ||
             _viewportClipBounds != oldViewportClipBounds)
         {
             if (isContainer())
-                static_cast<Container*>(this)->setChildrenDirty(DIRTY_BOUNDS, true);
+            {
+                // Children may be sized relative to our viewport; if its size is unchanged they only move
+                bool resized = _viewportBounds.width != oldViewportBounds.width || _viewportBounds.height != oldViewportBounds.height;
+                static_cast<Container*>(this)->setChildrenDirty(resized ? DIRTY_BOUNDS : DIRTY_POSITION, false);
+            }
             changed = true;
         }
     }
 
+    // Update children dirtied by our layout or bounds changes within the same pass
+    if (isContainer() && (_dirtyBits & DIRTY_CHILDREN))
+    {
+        _dirtyBits &= ~DIRTY_CHILDREN;
+        if (static_cast<Container*>(this)->updateChildBounds())
+            changed = true;
+    }
+
     return changed;
 }
 
@@ -1761,6 +1834,8 @@ void Control::setImageList(Theme::ImageList* imageList, unsigned char states)
             overlays[i]->setImageList(imageList);
     }
 
+    setDirty(DIRTY_STATE);
+
     if (_autoSize != AUTO_SIZE_NONE)
         setDirty(DIRTY_BOUNDS);
 }
@@ -1776,6 +1851,8 @@ void Control::setCursor(Theme::ThemeImage* cursor, unsigned char states)
         if( overlays[i] )
             overlays[i]->setCursor(cursor);
     }
+
+    setDirty(DIRTY_STATE);
 }
 
 void Control::setSkin(Theme::Skin* skin, unsigned char states)
@@ -1790,6 +1867,8 @@ void Control::setSkin(Theme::Skin* skin, unsigned char states)
             overlays[i]->setSkin(skin);
     }
 
+    setDirty(DIRTY_STATE);
+
     if (_autoSize != AUTO_SIZE_NONE)
         setDirty(DIRTY_BOUNDS);
 }
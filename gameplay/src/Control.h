@@ -985,6 +985,16 @@ protected:
      */
     static const int DIRTY_STATE = 2;
 
+    /**
+     * Indicates that the absolute position of the control is dirty, while its local bounds are not.
+     */
+    static const int DIRTY_POSITION = 4;
+
+    /**
+     * Indicates that the bounds or state of a descendant of the control are dirty.
+     */
+    static const int DIRTY_CHILDREN = 8;
+
     /**
      * Constructor.
      */
@@ -1433,6 +1443,10 @@ private:
     bool _styleOverridden;
     Theme::Skin* _skin;
 
+    // Position of the control in its form's hit-test grid
+    unsigned int _hitOrder;
+    int _hitCells[4];
+
 };
 
 }
@@ -9,6 +9,7 @@
 #include "TextBox.h"
 #include "JoystickControl.h"
 #include "ImageControl.h"
+#include "VirtualList.h"
 
 namespace gameplay
 {
@@ -87,6 +88,7 @@ void ControlFactory::registerStandardControls()
     registerCustomControl("TEXTBOX", &TextBox::create);
     registerCustomControl("JOYSTICK", &JoystickControl::create);
     registerCustomControl("IMAGE", &ImageControl::create);
+    registerCustomControl("VIRTUALLIST", &VirtualList::create);
 }
 
 }
@@ -3,6 +3,12 @@
 #include "Game.h"
 #include "FileSystem.h"
 #include "Bundle.h"
+#include "GlyphAtlas.h"
+
+#ifdef GP_USE_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
 
 // Default font shaders
 #define FONT_VSH "res/shaders/font.vert"
@@ -15,8 +21,99 @@ static std::vector<Font*> __fontCache;
 
 static Effect* __fontEffect = NULL;
 
+// Default pixel size of dynamic fonts loaded through Font::create.
+#define FONT_DYNAMIC_SIZE 32
+
+// Maximum number of measured strings cached by each font.
+#define GLYPH_RUN_CACHE_SIZE 256
+
+// Width of the smoothing band on each side of the edges of distance field glyphs, in multiples
+// of the change in distance across one pixel (see font.frag).
+#define DISTANCE_FIELD_CUTOFF 1.0f
+
+#ifdef GP_USE_FREETYPE
+
+/**
+ * Rasterizes the glyphs of a dynamic font with FreeType.
+ */
+class Font::Rasterizer
+{
+public:
+
+    Rasterizer() : library(NULL), face(NULL), data(NULL), baseline(0)
+    {
+    }
+
+    ~Rasterizer()
+    {
+        if (face)
+            FT_Done_Face(face);
+        if (library)
+            FT_Done_FreeType(library);
+        SAFE_DELETE_ARRAY(data);
+    }
+
+    FT_Library library;
+    FT_Face face;
+    char* data;
+    int baseline;
+    std::vector<unsigned char> cell;
+};
+
+#else
+
+class Font::Rasterizer
+{
+};
+
+#endif
+
+/**
+ * Decodes the UTF-8 character starting at the given position.
+ *
+ * @return The code point of the character, or 0 if the position is within a
+ *      multi-byte character or the sequence is invalid.
+ */
+static unsigned int decodeUTF8(const char* c)
+{
+    const unsigned char* s = (const unsigned char*)c;
+    unsigned int code;
+    int length;
+    if (s[0] < 0x80)
+        return s[0];
+    else if ((s[0] & 0xE0) == 0xC0)
+    {
+        code = s[0] & 0x1F;
+        length = 1;
+    }
+    else if ((s[0] & 0xF0) == 0xE0)
+    {
+        code = s[0] & 0x0F;
+        length = 2;
+    }
+    else if ((s[0] & 0xF8) == 0xF0)
+    {
+        code = s[0] & 0x07;
+        length = 3;
+    }
+    else
+    {
+        // Continuation byte or invalid lead byte.
+        return 0;
+    }
+
+    for (int i = 1; i <= length; ++i)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+            return 0;
+        code = (code << 6) | (s[i] & 0x3F);
+    }
+    return code;
+}
+
 Font::Font() :
-    _format(BITMAP), _style(PLAIN), _size(0), _spacing(0.125f), _glyphs(NULL), _glyphCount(0), _texture(NULL), _batch(NULL), _cutoffParam(NULL)
+    _format(BITMAP), _style(PLAIN), _size(0), _spacing(0.125f), _glyphs(NULL), _glyphCount(0), _texture(NULL), _batch(NULL), _cutoffParam(NULL),
+    _rasterizer(NULL), _atlas(NULL), _glyphRunHits(0), _glyphRunMisses(0)
 {
 }
 
@@ -32,6 +129,8 @@ Font::~Font()
     SAFE_DELETE(_batch);
     SAFE_DELETE_ARRAY(_glyphs);
     SAFE_RELEASE(_texture);
+    SAFE_DELETE(_atlas);
+    SAFE_DELETE(_rasterizer);
 
     // Free child fonts
     for (size_t i = 0, count = _sizes.size(); i < count; ++i)
@@ -57,6 +156,13 @@ Font* Font::create(const char* path, const char* id)
         }
     }
 
+    // TrueType fonts are rasterized on demand.
+    std::string ext = FileSystem::getExtension(path);
+    if (ext == ".TTF" || ext == ".OTF")
+    {
+        return createDynamic(path, FONT_DYNAMIC_SIZE);
+    }
+
     // Load the bundle.
     Bundle* bundle = Bundle::create(path);
     if (bundle == NULL)
@@ -99,7 +205,7 @@ Font* Font::create(const char* path, const char* id)
 Font* Font::create(const char* family, Style style, unsigned int size, Glyph* glyphs, int glyphCount, Texture* texture, Font::Format format)
 {
     GP_ASSERT(family);
-    GP_ASSERT(glyphs);
+    GP_ASSERT(glyphs || glyphCount == 0);
     GP_ASSERT(texture);
 
     // Create the effect for the font's sprite batch.
@@ -133,6 +239,9 @@ Font* Font::create(const char* family, Style style, unsigned int size, Glyph* gl
         return NULL;
     }
 
+    // Bitmap fonts only take alpha from their texture, which lets form batches draw them along with other sprites.
+    batch->_alphaTexture = (format == BITMAP);
+
     // Add linear filtering for better font quality.
     Texture::Sampler* sampler = batch->getSampler();
     sampler->setFilterMode(Texture::LINEAR_MIPMAP_LINEAR, Texture::LINEAR);
@@ -150,13 +259,102 @@ Font* Font::create(const char* family, Style style, unsigned int size, Glyph* gl
     font->_batch = batch;
 
     // Copy the glyphs array.
-    font->_glyphs = new Glyph[glyphCount];
-    memcpy(font->_glyphs, glyphs, sizeof(Glyph) * glyphCount);
+    if (glyphCount > 0)
+    {
+        font->_glyphs = new Glyph[glyphCount];
+        memcpy(font->_glyphs, glyphs, sizeof(Glyph) * glyphCount);
+    }
     font->_glyphCount = glyphCount;
 
     return font;
 }
 
+Font* Font::createDynamic(const char* path, unsigned int size, unsigned int atlasWidth, unsigned int atlasHeight)
+{
+    GP_ASSERT(path);
+    GP_ASSERT(size);
+
+#ifdef GP_USE_FREETYPE
+    // Search the font cache for a dynamic font with the given path.
+    for (size_t i = 0, count = __fontCache.size(); i < count; ++i)
+    {
+        Font* f = __fontCache[i];
+        GP_ASSERT(f);
+        if (f->_atlas && f->_path == path)
+        {
+            f->addRef();
+            return f;
+        }
+    }
+
+    Rasterizer* rasterizer = new Rasterizer();
+    int fileSize = 0;
+    rasterizer->data = FileSystem::readAll(path, &fileSize);
+    if (rasterizer->data == NULL)
+    {
+        GP_WARN("Failed to read font file '%s'.", path);
+        SAFE_DELETE(rasterizer);
+        return NULL;
+    }
+
+    if (FT_Init_FreeType(&rasterizer->library) ||
+        FT_New_Memory_Face(rasterizer->library, (const FT_Byte*)rasterizer->data, fileSize, 0, &rasterizer->face) ||
+        FT_Set_Pixel_Sizes(rasterizer->face, 0, size))
+    {
+        GP_WARN("Failed to load font file '%s'.", path);
+        SAFE_DELETE(rasterizer);
+        return NULL;
+    }
+    rasterizer->baseline = rasterizer->face->size->metrics.ascender >> 6;
+
+    Font::Style style = PLAIN;
+    if ((rasterizer->face->style_flags & FT_STYLE_FLAG_BOLD) && (rasterizer->face->style_flags & FT_STYLE_FLAG_ITALIC))
+        style = BOLD_ITALIC;
+    else if (rasterizer->face->style_flags & FT_STYLE_FLAG_BOLD)
+        style = BOLD;
+    else if (rasterizer->face->style_flags & FT_STYLE_FLAG_ITALIC)
+        style = ITALIC;
+
+    // Start from a cleared texture, since the padding around glyphs is sampled when filtering.
+    std::vector<unsigned char> pixels(atlasWidth * atlasHeight, 0);
+    Texture* texture = Texture::create(Texture::ALPHA, atlasWidth, atlasHeight, &pixels[0], false);
+    if (texture == NULL)
+    {
+        GP_WARN("Failed to create glyph atlas texture for font '%s'.", path);
+        SAFE_DELETE(rasterizer);
+        return NULL;
+    }
+
+    const char* family = rasterizer->face->family_name ? rasterizer->face->family_name : "";
+    Font* font = create(family, style, size, NULL, 0, texture, BITMAP);
+
+    // Release the texture since the font keeps a reference to it.
+    SAFE_RELEASE(texture);
+
+    if (font == NULL)
+    {
+        SAFE_DELETE(rasterizer);
+        return NULL;
+    }
+
+    // The atlas texture has no mipmaps and is updated as glyphs are added.
+    Texture::Sampler* sampler = font->_batch->getSampler();
+    sampler->setFilterMode(Texture::LINEAR, Texture::LINEAR);
+    sampler->setWrapMode(Texture::CLAMP, Texture::CLAMP);
+
+    font->_path = path;
+    font->_rasterizer = rasterizer;
+    font->_atlas = new GlyphAtlas(atlasWidth, atlasHeight);
+
+    __fontCache.push_back(font);
+
+    return font;
+#else
+    GP_WARN("Failed to load font '%s'; dynamic fonts require gameplay to be built with FreeType (GP_USE_FREETYPE).", path);
+    return NULL;
+#endif
+}
+
 unsigned int Font::getSize(unsigned int index) const
 {
     GP_ASSERT(index <= _sizes.size());
@@ -177,11 +375,109 @@ Font::Format Font::getFormat()
 
 bool Font::isCharacterSupported(int character) const
 {
-    // TODO: Update this once we support unicode fonts
-    int glyphIndex = character - 32; // HACK for ASCII
+#ifdef GP_USE_FREETYPE
+    if (_rasterizer)
+        return character > 0 && FT_Get_Char_Index(_rasterizer->face, (FT_ULong)character) != 0;
+#endif
+
+    // Baked fonts contain the printable ASCII characters in order.
+    int glyphIndex = character - 32;
     return (glyphIndex >= 0 && glyphIndex < (int)_glyphCount);
 }
 
+const Font::Glyph* Font::getGlyph(const char* c)
+{
+    if (_atlas == NULL)
+    {
+        unsigned int glyphIndex = (unsigned char)c[0] - 32;
+        return glyphIndex < _glyphCount ? &_glyphs[glyphIndex] : NULL;
+    }
+
+    unsigned int code = decodeUTF8(c);
+    if (code < 32)
+        return NULL;
+
+    int index = _atlas->find(code);
+    if (index < 0)
+    {
+        index = rasterizeGlyph(code);
+        if (index < 0)
+            return NULL;
+    }
+    return &_atlasGlyphs[index];
+}
+
+int Font::rasterizeGlyph(unsigned int code)
+{
+#ifdef GP_USE_FREETYPE
+    GP_ASSERT(_rasterizer);
+    GP_ASSERT(_atlas);
+
+    FT_Face face = _rasterizer->face;
+    if (FT_Load_Char(face, code, FT_LOAD_RENDER | FT_LOAD_FORCE_AUTOHINT))
+    {
+        GP_WARN("Failed to rasterize character %u of font '%s'.", code, _path.c_str());
+        return -1;
+    }
+
+    // Glyphs are drawn as cells of the font size in height, as wide as their advance,
+    // with the bitmap positioned relative to the baseline of the cell.
+    const FT_Bitmap& bitmap = face->glyph->bitmap;
+    const int left = std::max(face->glyph->bitmap_left, 0);
+    const int top = _rasterizer->baseline - face->glyph->bitmap_top;
+    const unsigned int width = std::max((unsigned int)(face->glyph->advance.x >> 6), (unsigned int)(left + bitmap.width));
+    const unsigned int height = _size;
+
+    const unsigned int evictionCount = _atlas->getEvictionCount();
+    int index = _atlas->insert(code, width, height);
+    if (index < 0)
+    {
+        GP_WARN("Character %u of font '%s' does not fit in the glyph atlas.", code, _path.c_str());
+        return -1;
+    }
+
+    // Sprites already batched may reference evicted glyphs whose regions are about to be
+    // overwritten, so draw them first.
+    if (_atlas->getEvictionCount() != evictionCount && _batch->isStarted())
+    {
+        _batch->finish();
+        _batch->start();
+    }
+
+    // Copy the bitmap into the cell, including the padding pixel to its right and below
+    // when it lies within the texture, so stale pixels of evicted glyphs are cleared.
+    const GlyphAtlas::Region& region = _atlas->getRegion(index);
+    const unsigned int cellWidth = std::min(width + 1, _atlas->getWidth() - region.x);
+    const unsigned int cellHeight = std::min(height + 1, _atlas->getHeight() - region.y);
+    std::vector<unsigned char>& cell = _rasterizer->cell;
+    cell.assign(cellWidth * cellHeight, 0);
+    for (int row = 0; row < (int)bitmap.rows; ++row)
+    {
+        int y = top + row;
+        if (y < 0 || y >= (int)height)
+            continue;
+        const unsigned char* src = bitmap.buffer + row * bitmap.pitch;
+        memcpy(&cell[y * cellWidth + left], src, bitmap.width);
+    }
+    _texture->setData(region.x, region.y, cellWidth, cellHeight, &cell[0]);
+
+    if (index >= (int)_atlasGlyphs.size())
+        _atlasGlyphs.resize(index + 1);
+
+    Glyph& glyph = _atlasGlyphs[index];
+    glyph.code = code;
+    glyph.width = width;
+    glyph.uvs[0] = (float)region.x / _atlas->getWidth();
+    glyph.uvs[1] = (float)region.y / _atlas->getHeight();
+    glyph.uvs[2] = (float)(region.x + width) / _atlas->getWidth();
+    glyph.uvs[3] = (float)(region.y + height) / _atlas->getHeight();
+
+    return index;
+#else
+    return -1;
+#endif
+}
+
 void Font::start()
 {
     // no-op : fonts now are lazily started on the first draw call
@@ -205,6 +501,16 @@ void Font::lazyStart()
     _batch->start();
 }
 
+void Font::updateCutoff()
+{
+    if (_format != DISTANCE_FIELD)
+        return;
+
+    if (_cutoffParam == NULL)
+        _cutoffParam = _batch->getMaterial()->getParameter("u_cutoff");
+    _cutoffParam->setVector2(Vector2(DISTANCE_FIELD_CUTOFF, DISTANCE_FIELD_CUTOFF));
+}
+
 void Font::finish()
 {
     // Finish any font batches that have been started
@@ -223,7 +529,7 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
     bool wrap, bool rightToLeft, const Rectangle* clip)
 {
     GP_ASSERT(text);
-    GP_ASSERT(_glyphs);
+    GP_ASSERT(_glyphs || _atlas);
     GP_ASSERT(_batch);
     GP_ASSERT(_size);
 
@@ -253,6 +559,8 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
     Text* batch = new Text(text);
     batch->_font = this;
     batch->_font->addRef();
+    batch->_color = color;
+    batch->_glyphGeneration = _atlas ? _atlas->getEvictionCount() : 0;
 
     GP_ASSERT(batch->_vertices);
     GP_ASSERT(batch->_indices);
@@ -325,7 +633,7 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
         }
 
         bool draw = true;
-        if (yPos < static_cast<int>(area.y))
+        if (yPos < static_cast<int>(area.y - size))
         {
             // Skip drawing until line break or wrap.
             draw = false;
@@ -338,12 +646,10 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
 
         for (int i = startIndex; i < (int)tokenLength && i >= 0; i += iteration)
         {
-            char c = token[i];
-            int glyphIndex = c - 32; // HACK for ASCII
-        
-            if (glyphIndex >= 0 && glyphIndex < (int)_glyphCount)
+            const Glyph* glyph = getGlyph(&token[i]);
+            if (glyph)
             {
-                Glyph& g = _glyphs[glyphIndex];
+                const Glyph& g = *glyph;
 
                 if (xPos + (int)(g.width*scale) > area.x + area.width)
                 {
@@ -354,17 +660,23 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
                 else if (xPos >= area.x)
                 {
                     // Draw this character.
+                    bool added = false;
                     if (draw)
                     {
                         if (clip)
                         {
-                            _batch->addSprite(xPos, yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color, *clip, &batch->_vertices[batch->_vertexCount]);
+                            // Skip glyphs that are clipped away entirely, rather than storing unused vertices.
+                            added = _batch->addSprite(xPos, yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color, *clip, &batch->_vertices[batch->_vertexCount]);
                         }
                         else
                         {
                             _batch->addSprite(xPos, yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color, &batch->_vertices[batch->_vertexCount]);
+                            added = true;
                         }
+                    }
 
+                    if (added)
+                    {
                         if (batch->_vertexCount == 0)
                         {
                             // Simply copy values directly into the start of the index array
@@ -467,6 +779,18 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
 
 Font* Font::findClosestSize(int size)
 {
+    // Distance fields scale without blurring, so the largest one serves every size.
+    if (_format == DISTANCE_FIELD)
+    {
+        Font* largest = this;
+        for (size_t i = 0, count = _sizes.size(); i < count; ++i)
+        {
+            if (_sizes[i]->_size > largest->_size)
+                largest = _sizes[i];
+        }
+        return largest;
+    }
+
     if (size == _size)
         return this;
 
@@ -502,7 +826,11 @@ void Font::drawText(Text* text)
     GP_ASSERT(text->_vertices);
     GP_ASSERT(text->_indices);
 
+    if (text->_vertexCount == 0)
+        return;
+
     lazyStart();
+    updateCutoff();
     _batch->draw(text->_vertices, text->_vertexCount, text->_indices, text->_indexCount);
 }
 
@@ -527,6 +855,7 @@ void Font::drawText(const char* text, int x, int y, const Vector4& color, unsign
     }
 
     lazyStart();
+    updateCutoff();
 
     float scale = (float)size / _size;
     int spacing = (int)(size * _spacing);
@@ -591,7 +920,7 @@ void Font::drawText(const char* text, int x, int y, const Vector4& color, unsign
             iteration = 1;
         }
 
-        GP_ASSERT(_glyphs);
+        GP_ASSERT(_glyphs || _atlas);
         GP_ASSERT(_batch);
         for (size_t i = startIndex; i < length; i += (size_t)iteration)
         {
@@ -620,18 +949,11 @@ void Font::drawText(const char* text, int x, int y, const Vector4& color, unsign
                 xPos += (size >> 1)*4;
                 break;
             default:
-                int index = c - 32; // HACK for ASCII
-                if (index >= 0 && index < (int)_glyphCount)
+                const Glyph* glyph = getGlyph(rightToLeft ? &cursor[i] : &text[i]);
+                if (glyph)
                 {
-                    Glyph& g = _glyphs[index];
+                    const Glyph& g = *glyph;
 
-                    if (getFormat() == DISTANCE_FIELD )
-                    {
-                        if (_cutoffParam == NULL)
-                            _cutoffParam = _batch->getMaterial()->getParameter("u_cutoff");    
-                        // TODO: Fix me so that smaller font are much smoother
-                        _cutoffParam->setVector2(Vector2(1.0, 1.0));
-                    }
                     _batch->draw(xPos, yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color);
                     xPos += floor(g.width * scale + spacing);
                     break;
@@ -677,6 +999,7 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
     }
 
     lazyStart();
+    updateCutoff();
 
     float scale = (float)size / _size;
     int spacing = (int)(size * _spacing);
@@ -767,16 +1090,14 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
             break;
         }
 
-        GP_ASSERT(_glyphs);
+        GP_ASSERT(_glyphs || _atlas);
         GP_ASSERT(_batch);
         for (int i = startIndex; i < (int)tokenLength && i >= 0; i += iteration)
         {
-            char c = token[i];
-            int glyphIndex = c - 32; // HACK for ASCII
-        
-            if (glyphIndex >= 0 && glyphIndex < (int)_glyphCount)
+            const Glyph* glyph = getGlyph(&token[i]);
+            if (glyph)
             {
-                Glyph& g = _glyphs[glyphIndex];
+                const Glyph& g = *glyph;
 
                 if (xPos + (int)(g.width*scale) > area.x + area.width)
                 {
@@ -789,13 +1110,6 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
                     // Draw this character.
                     if (draw)
                     {
-                        if (getFormat() == DISTANCE_FIELD)
-                        {
-                            if (_cutoffParam == NULL)
-                                _cutoffParam = _batch->getMaterial()->getParameter("u_cutoff");
-                            // TODO: Fix me so that smaller font are much smoother
-                            _cutoffParam->setVector2(Vector2(1.0, 1.0));
-                        }
                         if (clip)
                         {
                             _batch->draw(xPos, yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color, *clip);
@@ -883,28 +1197,97 @@ void Font::measureText(const char* text, unsigned int size, unsigned int* width,
 
     if (size == 0)
     {
-        size = _size;
+        measureLines(text, _size, width, height);
     }
     else
     {
         // Delegate to closest sized font
-        Font* f = findClosestSize(size);
-        if (f != this)
-        {
-            f->measureText(text, size, width, height);
-            return;
-        }
+        findClosestSize(size)->measureLines(text, size, width, height);
+    }
+}
+
+void Font::measureText(const char* text, const Rectangle& clip, unsigned int size, Rectangle* out, Justify justify, bool wrap, bool ignoreClip)
+{
+    GP_ASSERT(_size);
+    GP_ASSERT(text);
+    GP_ASSERT(out);
+
+    if (size == 0)
+    {
+        measureArea(text, clip, _size, out, justify, wrap, ignoreClip);
+    }
+    else
+    {
+        // Delegate to closest sized font
+        findClosestSize(size)->measureArea(text, clip, size, out, justify, wrap, ignoreClip);
+    }
+}
+
+void Font::measureText(const char** texts, unsigned int count, unsigned int size, unsigned int* widthsOut, unsigned int* heightsOut)
+{
+    GP_ASSERT(_size);
+    GP_ASSERT(texts || count == 0);
+    GP_ASSERT(widthsOut || count == 0);
+    GP_ASSERT(heightsOut || count == 0);
+
+    Font* f = this;
+    if (size == 0)
+        size = _size;
+    else
+        f = findClosestSize(size);
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        GP_ASSERT(texts[i]);
+        f->measureLines(texts[i], size, &widthsOut[i], &heightsOut[i]);
+    }
+}
+
+void Font::measureText(const char** texts, unsigned int count, const Rectangle& clip, unsigned int size, Rectangle* out,
+                       Justify justify, bool wrap, bool ignoreClip)
+{
+    GP_ASSERT(_size);
+    GP_ASSERT(texts || count == 0);
+    GP_ASSERT(out || count == 0);
+
+    Font* f = this;
+    if (size == 0)
+        size = _size;
+    else
+        f = findClosestSize(size);
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        GP_ASSERT(texts[i]);
+        f->measureArea(texts[i], clip, size, &out[i], justify, wrap, ignoreClip);
+    }
+}
+
+void Font::getGlyphRunCacheStats(unsigned int* hits, unsigned int* misses) const
+{
+    GP_ASSERT(hits);
+    GP_ASSERT(misses);
+
+    // Text is measured by the font closest to the requested size, so include the other sizes.
+    *hits = _glyphRunHits;
+    *misses = _glyphRunMisses;
+    for (size_t i = 0, count = _sizes.size(); i < count; ++i)
+    {
+        *hits += _sizes[i]->_glyphRunHits;
+        *misses += _sizes[i]->_glyphRunMisses;
     }
+}
 
-    const size_t length = strlen(text);
-    if (length == 0)
+void Font::measureLines(const char* text, unsigned int size, unsigned int* width, unsigned int* height)
+{
+    if (text[0] == 0)
     {
         *width = 0;
         *height = 0;
         return;
     }
 
-    float scale = (float)size / _size;
+    const GlyphRun* run = getGlyphRun(text, size, false, 0.0f);
     const char* token = text;
 
     *width = 0;
@@ -920,7 +1303,7 @@ void Font::measureText(const char* text, unsigned int size, unsigned int* width,
         }
 
         unsigned int tokenLength = (unsigned int)strcspn(token, "\n");
-        unsigned int tokenWidth = getTokenWidth(token, tokenLength, size, scale);
+        unsigned int tokenWidth = getRunWidth(*run, text, token, tokenLength);
         if (tokenWidth > *width)
         {
             *width = tokenWidth;
@@ -930,34 +1313,14 @@ void Font::measureText(const char* text, unsigned int size, unsigned int* width,
     }
 }
 
-void Font::measureText(const char* text, const Rectangle& clip, unsigned int size, Rectangle* out, Justify justify, bool wrap, bool ignoreClip)
+void Font::measureArea(const char* text, const Rectangle& clip, unsigned int size, Rectangle* out, Justify justify, bool wrap, bool ignoreClip)
 {
-    GP_ASSERT(_size);
-    GP_ASSERT(text);
-    GP_ASSERT(out);
-
-    if (size == 0)
-    {
-        size = _size;
-    }
-    else
-    {
-        // Delegate to closest sized font
-        Font* f = findClosestSize(size);
-        if (f != this)
-        {
-            f->measureText(text, clip, size, out, justify, wrap, ignoreClip);
-            return;
-        }
-    }
-
-    if (strlen(text) == 0)
+    if (text[0] == 0)
     {
         out->set(0, 0, 0, 0);
         return;
     }
 
-    float scale = (float)size / _size;
     Justify vAlign = static_cast<Justify>(justify & 0xF0);
     if (vAlign == 0)
     {
@@ -970,230 +1333,51 @@ void Font::measureText(const char* text, const Rectangle& clip, unsigned int siz
         hAlign = ALIGN_LEFT;
     }
 
-    const char* token = text;
-    std::vector<bool> emptyLines;
-    std::vector<Vector2> lines;
+    // Line breaks only depend on the clip width when wrapping.
+    GlyphRun* run = getGlyphRun(text, size, wrap, wrap ? clip.width : 0.0f);
+    if (!run->hasLines)
+        layoutLines(*run);
 
-    unsigned int lineWidth = 0;
+    const std::vector<int>& lines = run->lineWidths;
+    const std::vector<bool>& emptyLines = run->emptyLines;
     int yPos = clip.y + size;
+    yPos += run->lineAdvance;
     const float viewportHeight = clip.height;
 
-    if (wrap)
+    int x = INT_MAX;
+    int y = clip.y;
+    unsigned int width = 0;
+    int height = yPos - clip.y;
+
+    // Calculate top of text without clipping.
+    int vWhitespace = viewportHeight - height;
+    if (vAlign == ALIGN_VCENTER)
     {
-        unsigned int delimWidth = 0;
-        bool reachedEOF = false;
-        while (token[0] != 0)
+        y += vWhitespace / 2;
+    }
+    else if (vAlign == ALIGN_BOTTOM)
+    {
+        y += vWhitespace;
+    }
+    
+    int clippedTop = 0;
+    int clippedBottom = 0;
+    if (!ignoreClip)
+    {
+        // Trim rect to fit text that would actually be drawn within the given clip.
+        if (y >= clip.y)
         {
-            // Handle delimiters until next token.
-            char delimiter = token[0];
-            while (delimiter == ' ' ||
-                    delimiter == '\t' ||
-                    delimiter == '\r' ||
-                    delimiter == '\n' ||
-                    delimiter == 0)
+            // Text goes off the bottom of the clip.
+            clippedBottom = (height - viewportHeight) / size + 1;
+            if (clippedBottom > 0)
             {
-                switch (delimiter)
+                // Also need to crop empty lines above non-empty lines that have been clipped.
+                size_t emptyIndex = emptyLines.size() - clippedBottom;
+                while (emptyIndex < emptyLines.size() && emptyLines[emptyIndex] == true)
                 {
-                    case ' ':
-                        delimWidth += size >> 1;
-                        break;
-                    case '\r':
-                    case '\n':
-                        // Add line-height to vertical cursor.
-                        yPos += size;
-
-                        if (lineWidth > 0)
-                        {
-                            // Determine horizontal position and width.
-                            int hWhitespace = clip.width - lineWidth;
-                            int xPos = clip.x;
-                            if (hAlign == ALIGN_HCENTER)
-                            {
-                                xPos += hWhitespace / 2;
-                            }
-                            else if (hAlign == ALIGN_RIGHT)
-                            {
-                                xPos += hWhitespace;
-                            }
-
-                            // Record this line's size.
-                            emptyLines.push_back(false);
-                            lines.push_back(Vector2(xPos, lineWidth));
-                        }
-                        else
-                        {
-                            // Record the existence of an empty line.
-                            emptyLines.push_back(true);
-                            lines.push_back(Vector2(FLT_MAX, 0));
-                        }
-
-                        lineWidth = 0;
-                        delimWidth = 0;
-                        break;
-                    case '\t':
-                        delimWidth += (size >> 1)*4;
-                        break;
-                    case 0:
-                        reachedEOF = true;
-                        break;
-                }
-
-                if (reachedEOF)
-                {
-                    break;
-                }
-
-                token++;
-                delimiter = token[0];
-            }
-
-            if (reachedEOF)
-            {
-                break;
-            }
-
-            // Measure the next token.
-            unsigned int tokenLength = (unsigned int)strcspn(token, " \r\n\t");
-            unsigned int tokenWidth = getTokenWidth(token, tokenLength, size, scale);
-
-            // Wrap if necessary.
-            if (lineWidth + tokenWidth + delimWidth > clip.width)
-            {
-                // Add line-height to vertical cursor.
-                yPos += size;
-
-                // Determine horizontal position and width.
-                int hWhitespace = clip.width - lineWidth;
-                int xPos = clip.x;
-                if (hAlign == ALIGN_HCENTER)
-                {
-                    xPos += hWhitespace / 2;
-                }
-                else if (hAlign == ALIGN_RIGHT)
-                {
-                    xPos += hWhitespace;
-                }
-
-                // Record this line's size.
-                emptyLines.push_back(false);
-                lines.push_back(Vector2(xPos, lineWidth));
-                lineWidth = 0;
-            }
-            else
-            {
-                lineWidth += delimWidth;
-            }
-
-            delimWidth = 0;
-            lineWidth += tokenWidth;
-            token += tokenLength;
-        }
-    }
-    else
-    {
-        // Measure a whole line at a time.
-        int emptyLinesCount = 0;
-        while (token[0] != 0)
-        {
-            // Handle any number of consecutive newlines.
-            bool nextLine = true;
-            while (token[0] == '\n')
-            {
-                if (nextLine)
-                {
-                    // Add line-height to vertical cursor.
-                    yPos += size * (emptyLinesCount+1);
-                    nextLine = false;
-                    emptyLinesCount = 0;
-                    emptyLines.push_back(false);
-                }
-                else
-                {
-                    // Record the existence of an empty line.
-                    ++emptyLinesCount;
-                    emptyLines.push_back(true);
-                    lines.push_back(Vector2(FLT_MAX, 0));
-                }
-                
-                token++;
-            }
-
-            // Measure the next line.
-            unsigned int tokenLength = (unsigned int)strcspn(token, "\n");
-            lineWidth = getTokenWidth(token, tokenLength, size, scale);
-            
-            // Determine horizontal position and width.
-            int xPos = clip.x;
-            int hWhitespace = clip.width - lineWidth;
-            if (hAlign == ALIGN_HCENTER)
-            {
-                xPos += hWhitespace / 2;
-            }
-            else if (hAlign == ALIGN_RIGHT)
-            {
-                xPos += hWhitespace;
-            }
-
-            // Record this line's size.
-            lines.push_back(Vector2(xPos, lineWidth));
-
-            token += tokenLength;
-        }
-
-        yPos += size;
-    }
-
-    if (wrap)
-    {
-        // Record the size of the last line.
-        int hWhitespace = clip.width - lineWidth;
-        int xPos = clip.x;
-        if (hAlign == ALIGN_HCENTER)
-        {
-            xPos += hWhitespace / 2;
-        }
-        else if (hAlign == ALIGN_RIGHT)
-        {
-            xPos += hWhitespace;
-        }
-
-        lines.push_back(Vector2(xPos, lineWidth));
-    }
-
-    int x = INT_MAX;
-    int y = clip.y;
-    unsigned int width = 0;
-    int height = yPos - clip.y;
-
-    // Calculate top of text without clipping.
-    int vWhitespace = viewportHeight - height;
-    if (vAlign == ALIGN_VCENTER)
-    {
-        y += vWhitespace / 2;
-    }
-    else if (vAlign == ALIGN_BOTTOM)
-    {
-        y += vWhitespace;
-    }
-    
-    int clippedTop = 0;
-    int clippedBottom = 0;
-    if (!ignoreClip)
-    {
-        // Trim rect to fit text that would actually be drawn within the given clip.
-        if (y >= clip.y)
-        {
-            // Text goes off the bottom of the clip.
-            clippedBottom = (height - viewportHeight) / size + 1;
-            if (clippedBottom > 0)
-            {
-                // Also need to crop empty lines above non-empty lines that have been clipped.
-                size_t emptyIndex = emptyLines.size() - clippedBottom;
-                while (emptyIndex < emptyLines.size() && emptyLines[emptyIndex] == true)
-                {
-                    height -= size;
-                    emptyIndex++;
-                }
+                    height -= size;
+                    emptyIndex++;
+                }
 
                 height -= size * clippedBottom;
             }
@@ -1249,13 +1433,29 @@ void Font::measureText(const char* text, const Rectangle& clip, unsigned int siz
     // Determine left-most x coordinate and largest width out of lines that have not been clipped.
     for (int i = clippedTop; i < (int)lines.size() - clippedBottom; ++i)
     {
-        if (lines[i].x < x)
+        const int lineWidth = lines[i];
+        if (lineWidth < 0)
+            continue;
+
+        // Determine horizontal position of the line.
+        int hWhitespace = clip.width - lineWidth;
+        int xPos = clip.x;
+        if (hAlign == ALIGN_HCENTER)
+        {
+            xPos += hWhitespace / 2;
+        }
+        else if (hAlign == ALIGN_RIGHT)
+        {
+            xPos += hWhitespace;
+        }
+
+        if (xPos < x)
         {
-            x = lines[i].x;
+            x = xPos;
         }
-        if (lines[i].y > width)
+        if ((unsigned int)lineWidth > width)
         {
-            width = lines[i].y;
+            width = lineWidth;
         }
     }
 
@@ -1277,7 +1477,7 @@ void Font::measureText(const char* text, const Rectangle& clip, unsigned int siz
 }
 
 void Font::getMeasurementInfo(const char* text, const Rectangle& area, unsigned int size, Justify justify, bool wrap, bool rightToLeft,
-        std::vector<int>* xPositions, int* yPosition, std::vector<unsigned int>* lineLengths)
+        std::vector<int>* xPositions, int* yPosition, std::vector<unsigned int>* lineLengths, const GlyphRun* run)
 {
     GP_ASSERT(_size);
     GP_ASSERT(text);
@@ -1371,7 +1571,7 @@ void Font::getMeasurementInfo(const char* text, const Rectangle& area, unsigned
                 }
 
                 unsigned int tokenLength = (unsigned int)strcspn(token, " \r\n\t");
-                tokenWidth += getTokenWidth(token, tokenLength, size, scale);
+                tokenWidth += run ? getRunWidth(*run, text, token, tokenLength) : getTokenWidth(token, tokenLength, size, scale);
 
                 // Wrap if necessary.
                 if (lineWidth + tokenWidth + delimWidth > area.width)
@@ -1438,7 +1638,7 @@ void Font::getMeasurementInfo(const char* text, const Rectangle& area, unsigned
                     tokenLength = (unsigned int)strlen(token);
                 }
 
-                int lineWidth = getTokenWidth(token, tokenLength, size, scale);
+                int lineWidth = run ? getRunWidth(*run, text, token, tokenLength) : getTokenWidth(token, tokenLength, size, scale);
                 addLineInfo(area, lineWidth, tokenLength, hAlign, xPositions, lineLengths, rightToLeft);
 
                 token += tokenLength;
@@ -1470,7 +1670,13 @@ float Font::getCharacterSpacing() const
 
 void Font::setCharacterSpacing(float spacing)
 {
-    _spacing = spacing;
+    if (spacing != _spacing)
+    {
+        _spacing = spacing;
+
+        // Cached runs were measured with the previous spacing.
+        clearGlyphRuns();
+    }
 }
 
 int Font::getIndexAtLocation(const char* text, const Rectangle& area, unsigned int size, const Vector2& inLocation, Vector2* outLocation,
@@ -1516,7 +1722,9 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
     std::vector<int> xPositions;
     std::vector<unsigned int> lineLengths;
 
-    getMeasurementInfo(text, area, size, justify, wrap, rightToLeft, &xPositions, &yPos, &lineLengths);
+    // Measure tokens from the cached advances of the text, which is usually measured with the same area.
+    const GlyphRun* run = getGlyphRun(text, size, wrap, wrap ? area.width : 0.0f);
+    getMeasurementInfo(text, area, size, justify, wrap, rightToLeft, &xPositions, &yPos, &lineLengths, run);
 
     int xPos = area.x;
     std::vector<int>::const_iterator xPositionsIt = xPositions.begin();
@@ -1583,14 +1791,14 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
             currentLineLength += tokenLength;
             charIndex += tokenLength;
             token -= (tokenLength - 1);
-            tokenWidth = getTokenWidth(token, tokenLength, size, scale);
+            tokenWidth = getRunWidth(*run, text, token, tokenLength);
             iteration = -1;
             startIndex = tokenLength - 1;
         }
         else
         {
             tokenLength = (unsigned int)strcspn(token, " \r\n\t");
-            tokenWidth = getTokenWidth(token, tokenLength, size, scale);
+            tokenWidth = getRunWidth(*run, text, token, tokenLength);
             iteration = 1;
             startIndex = 0;
         }
@@ -1617,15 +1825,13 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
             break;
         }
 
-        GP_ASSERT(_glyphs);
+        GP_ASSERT(_glyphs || _atlas);
         for (int i = startIndex; i < (int)tokenLength && i >= 0; i += iteration)
         {
-            char c = token[i];
-            int glyphIndex = c - 32; // HACK for ASCII
-        
-            if (glyphIndex >= 0 && glyphIndex < (int)_glyphCount)
+            const Glyph* glyph = getGlyph(&token[i]);
+            if (glyph)
             {
-                Glyph& g = _glyphs[glyphIndex];
+                const Glyph& g = *glyph;
 
                 if (xPos + (int)(g.width*scale) > area.x + area.width)
                 {
@@ -1730,10 +1936,243 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
     return -1;
 }
 
+Font::GlyphRun* Font::getGlyphRun(const char* text, unsigned int size, bool wrap, float wrapWidth)
+{
+    GP_ASSERT(text);
+    GP_ASSERT(_glyphs || _atlas);
+
+    // FNV-1a hash of the text.
+    unsigned int hash = 2166136261u;
+    size_t length = 0;
+    for (; text[length] != 0; ++length)
+    {
+        hash = (hash ^ (unsigned char)text[length]) * 16777619u;
+    }
+
+    typedef std::multimap<unsigned int, std::list<GlyphRun>::iterator>::iterator IndexIterator;
+    std::pair<IndexIterator, IndexIterator> range = _glyphRunIndex.equal_range(hash);
+    for (IndexIterator itr = range.first; itr != range.second; ++itr)
+    {
+        GlyphRun& run = *itr->second;
+        if (run.size == size && run.wrap == wrap && run.wrapWidth == wrapWidth && run.text.length() == length && run.text == text)
+        {
+            // Move the run to the front of the list as the most recently used one.
+            _glyphRuns.splice(_glyphRuns.begin(), _glyphRuns, itr->second);
+            ++_glyphRunHits;
+            return &run;
+        }
+    }
+    ++_glyphRunMisses;
+
+    // Evict the least recently used run when the cache is full.
+    if (_glyphRunIndex.size() >= GLYPH_RUN_CACHE_SIZE)
+    {
+        std::list<GlyphRun>::iterator last = --_glyphRuns.end();
+        range = _glyphRunIndex.equal_range(last->hash);
+        for (IndexIterator itr = range.first; itr != range.second; ++itr)
+        {
+            if (itr->second == last)
+            {
+                _glyphRunIndex.erase(itr);
+                break;
+            }
+        }
+        _glyphRuns.erase(last);
+    }
+
+    _glyphRuns.push_front(GlyphRun());
+    _glyphRunIndex.insert(std::make_pair(hash, _glyphRuns.begin()));
+
+    GlyphRun& run = _glyphRuns.front();
+    run.text.assign(text, length);
+    run.hash = hash;
+    run.size = size;
+    run.wrap = wrap;
+    run.wrapWidth = wrapWidth;
+    run.hasLines = false;
+    run.lineAdvance = 0;
+
+    // Store the offset of each character, advancing as getTokenWidth does.
+    const float scale = (float)size / _size;
+    const int spacing = (int)(size * _spacing);
+    run.offsets.resize(length + 1);
+    unsigned int offset = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        run.offsets[i] = offset;
+        switch (text[i])
+        {
+        case ' ':
+            offset += size >> 1;
+            break;
+        case '\t':
+            offset += (size >> 1)*4;
+            break;
+        default:
+            const Glyph* glyph = getGlyph(&text[i]);
+            if (glyph)
+            {
+                offset += floor(glyph->width * scale + spacing);
+            }
+            break;
+        }
+    }
+    run.offsets[length] = offset;
+
+    return &run;
+}
+
+void Font::layoutLines(GlyphRun& run)
+{
+    const char* text = run.text.c_str();
+    const char* token = text;
+    const unsigned int size = run.size;
+    unsigned int lineWidth = 0;
+    int yPos = 0;
+
+    if (run.wrap)
+    {
+        unsigned int delimWidth = 0;
+        bool reachedEOF = false;
+        while (token[0] != 0)
+        {
+            // Handle delimiters until next token.
+            char delimiter = token[0];
+            while (delimiter == ' ' ||
+                    delimiter == '\t' ||
+                    delimiter == '\r' ||
+                    delimiter == '\n' ||
+                    delimiter == 0)
+            {
+                switch (delimiter)
+                {
+                    case ' ':
+                        delimWidth += size >> 1;
+                        break;
+                    case '\r':
+                    case '\n':
+                        // Add line-height to vertical cursor.
+                        yPos += size;
+
+                        // Record this line's width, or the existence of an empty line.
+                        run.emptyLines.push_back(lineWidth == 0);
+                        run.lineWidths.push_back(lineWidth > 0 ? (int)lineWidth : -1);
+
+                        lineWidth = 0;
+                        delimWidth = 0;
+                        break;
+                    case '\t':
+                        delimWidth += (size >> 1)*4;
+                        break;
+                    case 0:
+                        reachedEOF = true;
+                        break;
+                }
+
+                if (reachedEOF)
+                {
+                    break;
+                }
+
+                token++;
+                delimiter = token[0];
+            }
+
+            if (reachedEOF)
+            {
+                break;
+            }
+
+            // Measure the next token.
+            unsigned int tokenLength = (unsigned int)strcspn(token, " \r\n\t");
+            unsigned int tokenWidth = getRunWidth(run, text, token, tokenLength);
+
+            // Wrap if necessary.
+            if (lineWidth + tokenWidth + delimWidth > run.wrapWidth)
+            {
+                // Add line-height to vertical cursor.
+                yPos += size;
+
+                // Record this line's width.
+                run.emptyLines.push_back(false);
+                run.lineWidths.push_back(lineWidth);
+                lineWidth = 0;
+            }
+            else
+            {
+                lineWidth += delimWidth;
+            }
+
+            delimWidth = 0;
+            lineWidth += tokenWidth;
+            token += tokenLength;
+        }
+
+        // Record the width of the last line.
+        run.lineWidths.push_back(lineWidth);
+    }
+    else
+    {
+        // Measure a whole line at a time.
+        int emptyLinesCount = 0;
+        while (token[0] != 0)
+        {
+            // Handle any number of consecutive newlines.
+            bool nextLine = true;
+            while (token[0] == '\n')
+            {
+                if (nextLine)
+                {
+                    // Add line-height to vertical cursor.
+                    yPos += size * (emptyLinesCount+1);
+                    nextLine = false;
+                    emptyLinesCount = 0;
+                    run.emptyLines.push_back(false);
+                }
+                else
+                {
+                    // Record the existence of an empty line.
+                    ++emptyLinesCount;
+                    run.emptyLines.push_back(true);
+                    run.lineWidths.push_back(-1);
+                }
+
+                token++;
+            }
+
+            // Measure the next line.
+            unsigned int tokenLength = (unsigned int)strcspn(token, "\n");
+            run.lineWidths.push_back(getRunWidth(run, text, token, tokenLength));
+
+            token += tokenLength;
+        }
+
+        yPos += size;
+    }
+
+    run.lineAdvance = yPos;
+    run.hasLines = true;
+}
+
+unsigned int Font::getRunWidth(const GlyphRun& run, const char* text, const char* token, unsigned int length) const
+{
+    GP_ASSERT(token >= text);
+
+    const size_t start = token - text;
+    GP_ASSERT(start + length < run.offsets.size());
+    return run.offsets[start + length] - run.offsets[start];
+}
+
+void Font::clearGlyphRuns()
+{
+    _glyphRuns.clear();
+    _glyphRunIndex.clear();
+}
+
 unsigned int Font::getTokenWidth(const char* token, unsigned int length, unsigned int size, float scale)
 {
     GP_ASSERT(token);
-    GP_ASSERT(_glyphs);
+    GP_ASSERT(_glyphs || _atlas);
 
     if (size == 0)
         size = _size;
@@ -1754,10 +2193,10 @@ unsigned int Font::getTokenWidth(const char* token, unsigned int length, unsigne
             tokenWidth += (size >> 1)*4;
             break;
         default:
-            int glyphIndex = c - 32;
-            if (glyphIndex >= 0 && glyphIndex < (int)_glyphCount)
+            const Glyph* glyph = getGlyph(&token[i]);
+            if (glyph)
             {
-                Glyph& g = _glyphs[glyphIndex];
+                const Glyph& g = *glyph;
                 tokenWidth += floor(g.width * scale + spacing);
             }
             break;
@@ -1981,9 +2420,11 @@ Font::Justify Font::getJustify(const char* justify)
     return Font::ALIGN_TOP_LEFT;
 }
 
-Font::Text::Text(const char* text) : _text(text ? text : ""), _vertexCount(0), _vertices(NULL), _indexCount(0), _indices(NULL), _font(NULL)
+Font::Text::Text(const char* text) : _text(text ? text : ""), _vertexCount(0), _vertices(NULL), _indexCount(0), _indices(NULL), _font(NULL),
+    _glyphGeneration(0)
 {
-    const size_t length = strlen(text);
+    // Always allocate room for at least one glyph, so that empty text is valid to draw.
+    const size_t length = std::max(_text.length(), (size_t)1);
     _vertices = new SpriteBatch::SpriteVertex[length * 4];
     _indices = new unsigned short[((length - 1) * 6) + 4];
 }
@@ -2000,4 +2441,30 @@ const char* Font::Text::getText()
     return _text.c_str();
 }
 
+const Vector4& Font::Text::getColor() const
+{
+    return _color;
+}
+
+bool Font::Text::isValid() const
+{
+    return _font == NULL || _font->_atlas == NULL || _glyphGeneration == _font->_atlas->getEvictionCount();
+}
+
+void Font::Text::setColor(const Vector4& color)
+{
+    if (color == _color)
+        return;
+
+    _color = color;
+    for (unsigned int i = 0; i < _vertexCount; ++i)
+    {
+        SpriteBatch::SpriteVertex& v = _vertices[i];
+        v.r = color.x;
+        v.g = color.y;
+        v.b = color.z;
+        v.a = color.w;
+    }
+}
+
 }
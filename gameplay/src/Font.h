@@ -6,6 +6,8 @@
 namespace gameplay
 {
 
+class GlyphAtlas;
+
 /**
  * Defines a font for text rendering.
  */
@@ -51,6 +53,12 @@ public:
 
     /**
      * Defines the format of the font.
+     *
+     * Bitmap fonts store glyphs at fixed sizes, and text of other sizes is scaled from the
+     * closest one. Distance field fonts store the distance of each texel to the outline of
+     * its glyph, which stays sharp when scaled, so the largest size stored in the font is
+     * used for text of every size. All text of a distance field font is therefore drawn
+     * from one texture with one sprite batch.
      */
     enum Format
     {
@@ -83,6 +91,33 @@ public:
          */
         const char* getText();
 
+        /**
+         * Gets the color of the text.
+         *
+         * @return The color of the text.
+         */
+        const Vector4& getColor() const;
+
+        /**
+         * Sets the color of the text.
+         *
+         * This only updates the color of the stored vertices, so it does not
+         * require the text to be laid out again.
+         *
+         * @param color The new color of the text.
+         */
+        void setColor(const Vector4& color);
+
+        /**
+         * Determines whether the glyphs this text was created with are still available.
+         *
+         * Text created with a dynamic font becomes invalid once the font evicts glyphs
+         * from its texture to make room for others, and must then be created again.
+         *
+         * @return True if the text can be drawn, false if it must be created again.
+         */
+        bool isValid() const;
+
     private:
 
         /**
@@ -102,6 +137,7 @@ public:
         unsigned short* _indices;
         Vector4 _color;
         Font* _font;
+        unsigned int _glyphGeneration;
     };
 
     /**
@@ -114,6 +150,9 @@ public:
      * If a font for the given path has already been loaded, the existing font will be
      * returned with its reference count increased.
      *
+     * If the path is a TrueType font file (.ttf or .otf) rather than a bundle, a dynamic
+     * font is created from it (see createDynamic) with the default size of 32 pixels.
+     *
      * @param path The path to a bundle file containing a font resource.
      * @param id An optional ID of the font resource within the bundle (NULL for the first/only resource).
      * 
@@ -122,6 +161,29 @@ public:
      */
     static Font* create(const char* path, const char* id = NULL);
 
+    /**
+     * Creates a dynamic font from a TrueType font file.
+     *
+     * Dynamic fonts rasterize glyphs into an atlas texture the first time they are drawn,
+     * so they can draw any character in the font file, given as UTF-8 in strings. When the
+     * atlas is full, the least recently used glyphs are evicted to make room.
+     *
+     * Dynamic fonts require gameplay to be built with FreeType (GP_USE_FREETYPE). Fonts
+     * loaded from bundles are not affected and keep using their pre-rendered glyphs.
+     *
+     * If a font for the given path has already been loaded, the existing font will be
+     * returned with its reference count increased.
+     *
+     * @param path The path to the TrueType font file.
+     * @param size The size to rasterize glyphs at, in pixels.
+     * @param atlasWidth The width of the glyph atlas texture.
+     * @param atlasHeight The height of the glyph atlas texture.
+     *
+     * @return The new Font or NULL if there was an error.
+     * @script{create}
+     */
+    static Font* createDynamic(const char* path, unsigned int size, unsigned int atlasWidth = 1024, unsigned int atlasHeight = 1024);
+
     /**
      * Gets the font size (max height of glyphs) in pixels, at the specified index.
      *
@@ -256,6 +318,54 @@ public:
     void measureText(const char* text, const Rectangle& clip, unsigned int size, Rectangle* out,
                      Justify justify = ALIGN_TOP_LEFT, bool wrap = true, bool ignoreClip = false);
 
+    /**
+     * Measures the width and height of several strings without alignment, wrapping or clipping.
+     *
+     * This gives the same results as measuring each string separately, but only looks up
+     * the font size to measure with once.
+     *
+     * @param texts The array of strings to measure.
+     * @param count The number of strings in the array.
+     * @param size The font height to scale to.
+     * @param widthsOut Array of count elements receiving the width of each string.
+     * @param heightsOut Array of count elements receiving the height of each string.
+     * @script{ignore}
+     */
+    void measureText(const char** texts, unsigned int count, unsigned int size, unsigned int* widthsOut, unsigned int* heightsOut);
+
+    /**
+     * Measures the bounding boxes of several strings after alignment, wrapping and clipping within a viewport.
+     *
+     * This gives the same results as measuring each string separately, but only looks up
+     * the font size to measure with once.
+     *
+     * @param texts The array of strings to measure.
+     * @param count The number of strings in the array.
+     * @param clip The clip rectangle.
+     * @param size The font height to scale to.
+     * @param out Array of count rectangles receiving the bounds of each string.
+     * @param justify Justification of text within the viewport.
+     * @param wrap Whether to measure text with wrapping applied.
+     * @param ignoreClip Whether to clip 'out' to the viewport.
+     * @script{ignore}
+     */
+    void measureText(const char** texts, unsigned int count, const Rectangle& clip, unsigned int size, Rectangle* out,
+                     Justify justify = ALIGN_TOP_LEFT, bool wrap = true, bool ignoreClip = false);
+
+    /**
+     * Gets the statistics of the glyph run cache of this font.
+     *
+     * Measuring a string stores its character advances and line breaks in a cache, so that
+     * measuring it again with the same size and wrap width, or finding character positions
+     * within it, does not need to look up each of its glyphs. The least recently used runs
+     * are evicted when the cache is full.
+     *
+     * @param hits Destination for the number of measurements answered from the cache.
+     * @param misses Destination for the number of measurements that added a run to the cache.
+     * @script{ignore}
+     */
+    void getGlyphRunCacheStats(unsigned int* hits, unsigned int* misses) const;
+
     /**
      * Returns current character spacing for this font in percentage of fonts size.
      *
@@ -295,7 +405,8 @@ public:
      * 
      * @param size The font size to be drawn.
      *
-     * @return The SpriteBatch that most closely matches the requested font size.
+     * @return The SpriteBatch that most closely matches the requested font size. Distance field
+     *      fonts return the same batch for every size.
      */
     SpriteBatch* getSpriteBatch(unsigned int size) const;
 
@@ -333,6 +444,23 @@ private:
         float uvs[4];
     };
 
+    /**
+     * Defines the cached measurements of a string at a given size and wrap width.
+     */
+    struct GlyphRun
+    {
+        std::string text;
+        unsigned int hash;
+        unsigned int size;
+        bool wrap;
+        float wrapWidth;
+        std::vector<unsigned int> offsets;  // Horizontal offset of each character from the start of the text, followed by the total width
+        bool hasLines;                      // Whether the lines below have been laid out
+        std::vector<int> lineWidths;        // Width of each line, or -1 for empty lines
+        std::vector<bool> emptyLines;
+        int lineAdvance;                    // Height of the text less the height of one line
+    };
+
     /**
      * Constructor.
      */
@@ -372,7 +500,28 @@ private:
     static Font* create(const char* family, Style style, unsigned int size, Glyph* glyphs, int glyphCount, Texture* texture, Font::Format format);
 
     void getMeasurementInfo(const char* text, const Rectangle& area, unsigned int size, Justify justify, bool wrap, bool rightToLeft,
-                            std::vector<int>* xPositions, int* yPosition, std::vector<unsigned int>* lineLengths);
+                            std::vector<int>* xPositions, int* yPosition, std::vector<unsigned int>* lineLengths, const GlyphRun* run = NULL);
+
+    void measureLines(const char* text, unsigned int size, unsigned int* width, unsigned int* height);
+
+    void measureArea(const char* text, const Rectangle& clip, unsigned int size, Rectangle* out, Justify justify, bool wrap, bool ignoreClip);
+
+    /**
+     * Gets the cached run of a string, measuring the advances of its characters first if it is not cached.
+     */
+    GlyphRun* getGlyphRun(const char* text, unsigned int size, bool wrap, float wrapWidth);
+
+    /**
+     * Breaks the text of a run into lines.
+     */
+    void layoutLines(GlyphRun& run);
+
+    /**
+     * Gets the width of a token within the text of a run from its cached character advances.
+     */
+    unsigned int getRunWidth(const GlyphRun& run, const char* text, const char* token, unsigned int length) const;
+
+    void clearGlyphRuns();
 
     int getIndexOrLocation(const char* text, const Rectangle& clip, unsigned int size, const Vector2& inLocation, Vector2* outLocation,
                            const int destIndex = -1, Justify justify = ALIGN_TOP_LEFT, bool wrap = true, bool rightToLeft = false);
@@ -392,6 +541,29 @@ private:
 
     void lazyStart();
 
+    /**
+     * Sets the edge smoothing of distance field fonts for the next glyphs drawn.
+     */
+    void updateCutoff();
+
+    /**
+     * Gets the glyph for the character starting at the given position of a UTF-8 string,
+     * rasterizing it first for dynamic fonts.
+     *
+     * @return The glyph, or NULL if the character is not supported or the position is
+     *      within a multi-byte character.
+     */
+    const Glyph* getGlyph(const char* c);
+
+    /**
+     * Rasterizes a glyph of a dynamic font into the glyph atlas.
+     *
+     * @return The index of the glyph in the atlas, or -1 if it could not be added.
+     */
+    int rasterizeGlyph(unsigned int code);
+
+    class Rasterizer;
+
     Format _format;
     std::string _path;
     std::string _id;
@@ -406,6 +578,13 @@ private:
     SpriteBatch* _batch;
     Rectangle _viewport;
     MaterialParameter* _cutoffParam;
+    Rasterizer* _rasterizer;
+    GlyphAtlas* _atlas;
+    std::vector<Glyph> _atlasGlyphs;
+    std::list<GlyphRun> _glyphRuns;     // Cached runs, most recently used first
+    std::multimap<unsigned int, std::list<GlyphRun>::iterator> _glyphRunIndex; // Cached runs by the hash of their text
+    unsigned int _glyphRunHits;
+    unsigned int _glyphRunMisses;
 };
 
 }
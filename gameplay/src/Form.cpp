@@ -17,6 +17,11 @@ static const float JOYSTICK_THRESHOLD = 0.75f;
 // If the DPad or joystick is held down, this is the initial delay in milliseconds between focus changes.
 static const float GAMEPAD_FOCUS_REPEAT_DELAY = 300.0f;
 
+// Size of the cells of the grid used to find the controls under a point, in pixels.
+static const float HIT_GRID_CELL_SIZE = 64.0f;
+// Maximum number of columns and rows of the hit-test grid.
+static const int HIT_GRID_MAX_CELLS = 64;
+
 // Shaders used for drawing offscreen quad when form is attached to a node
 #define FORM_VSH "res/shaders/sprite.vert"
 #define FORM_FSH "res/shaders/sprite.frag"
@@ -42,7 +47,8 @@ struct FormInit
 };
 static FormInit __init;
 
-Form::Form() : _node(NULL), _batched(true)
+Form::Form() : _node(NULL), _batched(true), _spriteBatch(NULL), _cachingEnabled(false), _frameBuffer(NULL), _frameBatch(NULL), _redrawAll(true),
+    _hitGridColumns(0), _hitGridRows(0), _hitGridDirty(true)
 {
 }
 
@@ -54,6 +60,10 @@ Form::~Form()
     {
         __forms.erase(it);
     }
+
+    SAFE_DELETE(_spriteBatch);
+    SAFE_DELETE(_frameBatch);
+    SAFE_RELEASE(_frameBuffer);
 }
 
 Form* Form::create(const char* url)
@@ -102,6 +112,7 @@ Form* Form::create(const char* url)
     }
 
     form->_batched = formProperties->getBool("batchingEnabled", true);
+    form->_cachingEnabled = formProperties->getBool("cachingEnabled", false);
 
     // Initialize the form and all of its child controls
     form->initialize("Form", style, formProperties);
@@ -215,8 +226,14 @@ void Form::startBatch(SpriteBatch* batch)
     // TODO (note: might want to pass a level number/depth here so that batch draw calls can be sorted correctly, such as all text on top)
     if (!batch->isStarted())
     {
-        batch->setProjectionMatrix(_projectionMatrix);
-        batch->start();
+        // Draw the batch into the form's multi-texture batch when its effect allows it,
+        // so that sprites of different textures are drawn together and in order.
+        if (!_batched || !_spriteBatch || !batch->setTarget(_spriteBatch))
+        {
+            batch->setProjectionMatrix(_projectionMatrix);
+            batch->start();
+            setCacheBlending(batch);
+        }
 
         if (_batched)
             _batches.push_back(batch);
@@ -241,8 +258,10 @@ unsigned int Form::draw()
     if (!_visible || _absoluteClipBounds.width == 0 || _absoluteClipBounds.height == 0)
         return 0;
 
-    Game* game = Game::getInstance();
-    Rectangle viewport = game->getViewport();
+    // Bring the cached rendering up to date before setting up the projection to draw it with.
+    unsigned int drawCalls = 0;
+    if (_cachingEnabled)
+        drawCalls = updateFrameBuffer();
 
     // If we're drawing in 2D (i.e. not attached to a node), we need to clear the depth buffer
     if (_node)
@@ -264,22 +283,319 @@ unsigned int Form::draw()
         Matrix::createOrthographicOffCenter(0, viewport.width, viewport.height, 0, 0, 1, &_projectionMatrix);
     }
 
+    if (_cachingEnabled)
+    {
+        // Draw the cached rendering. Its color is already multiplied by alpha.
+        _frameBatch->setProjectionMatrix(_projectionMatrix);
+        _frameBatch->start();
+        _frameBatch->draw(_absoluteClipBounds.x, _absoluteClipBounds.y, _frameBuffer->getWidth(), _frameBuffer->getHeight(), 0, 1, 1, 0, Vector4::one());
+        _frameBatch->finish();
+        return drawCalls + 1;
+    }
+
     // Draw the form
+    _drawRegion = _absoluteClipBounds;
+    return drawControls();
+}
+
+unsigned int Form::drawControls()
+{
+    if (_batched)
+    {
+        if (!_spriteBatch)
+            _spriteBatch = SpriteBatch::createMultiTexture();
+        if (_spriteBatch)
+        {
+            _spriteBatch->setProjectionMatrix(_projectionMatrix);
+            _spriteBatch->start();
+            setCacheBlending(_spriteBatch);
+        }
+    }
+
     unsigned int drawCalls = Container::draw(this, _absoluteClipBounds);
 
-    // Flush all batches that were queued during drawing and then empty the batch list
+    // Flush all batches that were queued during drawing and then empty the batch list.
+    // Batches drawn into the multi-texture batch are flushed along with it, before the
+    // others, which use custom effects.
     if (_batched)
     {
-        unsigned int batchCount = _batches.size();
-        for (unsigned int i = 0; i < batchCount; ++i)
-            _batches[i]->finish();
+        drawCalls = 0;
+        if (_spriteBatch)
+        {
+            _spriteBatch->finish();
+            ++drawCalls;
+        }
+
+        for (size_t i = 0, count = _batches.size(); i < count; ++i)
+        {
+            SpriteBatch* batch = _batches[i];
+            if (batch->getTarget())
+            {
+                batch->setTarget(NULL);
+            }
+            else
+            {
+                batch->finish();
+                ++drawCalls;
+            }
+        }
         _batches.clear();
-        drawCalls = batchCount;
     }
 
     return drawCalls;
 }
 
+unsigned int Form::updateFrameBuffer()
+{
+    const Rectangle& bounds = _absoluteClipBounds;
+    unsigned int width = (unsigned int)ceilf(bounds.width);
+    unsigned int height = (unsigned int)ceilf(bounds.height);
+
+    // (Re)create the frame buffer to match the size of the form.
+    if (_frameBuffer == NULL || _frameBuffer->getWidth() != width || _frameBuffer->getHeight() != height)
+    {
+        SAFE_DELETE(_frameBatch);
+        SAFE_RELEASE(_frameBuffer);
+
+        _frameBuffer = FrameBuffer::create(_id.c_str(), width, height);
+        GP_ASSERT(_frameBuffer);
+        _frameBatch = SpriteBatch::create(_frameBuffer->getRenderTarget()->getTexture());
+        GP_ASSERT(_frameBatch);
+        _frameBatch->getSampler()->setFilterMode(Texture::LINEAR, Texture::LINEAR);
+        _frameBatch->getSampler()->setWrapMode(Texture::CLAMP, Texture::CLAMP);
+        _frameBatch->getStateBlock()->setBlendSrc(RenderState::BLEND_ONE);
+        _redrawAll = true;
+    }
+
+    if (_redrawAll)
+    {
+        _drawRegion = bounds;
+    }
+    else if (!Rectangle::intersect(_dirtyRegion, bounds, &_drawRegion))
+    {
+        _dirtyRegion = Rectangle();
+        return 0;
+    }
+    _dirtyRegion = Rectangle();
+    _redrawAll = false;
+
+    Game* game = Game::getInstance();
+    Rectangle viewport = game->getViewport();
+    FrameBuffer* previousFrameBuffer = _frameBuffer->bind();
+    game->setViewport(Rectangle(width, height));
+
+    // Only touch the pixels of the draw region. Frame buffer rows start at the bottom.
+    int scissorX = (int)floorf(_drawRegion.x - bounds.x);
+    int scissorY = (int)floorf(bounds.bottom() - _drawRegion.bottom());
+    int scissorWidth = (int)ceilf(_drawRegion.right() - bounds.x) - scissorX;
+    int scissorHeight = (int)ceilf(bounds.bottom() - _drawRegion.y) - scissorY;
+    GL_ASSERT( glEnable(GL_SCISSOR_TEST) );
+    GL_ASSERT( glScissor(scissorX, scissorY, scissorWidth, scissorHeight) );
+    game->clear(Game::CLEAR_COLOR, Vector4::zero(), 1, 0);
+
+    // Map the form's bounds onto the whole frame buffer.
+    Matrix::createOrthographicOffCenter(bounds.x, bounds.right(), bounds.bottom(), bounds.y, 0, 1, &_projectionMatrix);
+    unsigned int drawCalls = drawControls();
+
+    for (size_t i = 0, count = _cacheBatches.size(); i < count; ++i)
+    {
+        _cacheBatches[i]->getStateBlock()->setBlendSeparate(false);
+    }
+    _cacheBatches.clear();
+
+    GL_ASSERT( glDisable(GL_SCISSOR_TEST) );
+    game->setViewport(viewport);
+    previousFrameBuffer->bind();
+
+    return drawCalls;
+}
+
+void Form::setCacheBlending(SpriteBatch* batch)
+{
+    // Controls are only drawn into the frame buffer when caching is enabled.
+    if (!_cachingEnabled || std::find(_cacheBatches.begin(), _cacheBatches.end(), batch) != _cacheBatches.end())
+        return;
+
+    // Blend colors as usual, but accumulate the coverage of each sprite into the alpha channel,
+    // so the frame buffer holds premultiplied colors with the correct alpha for drawing it.
+    RenderState::StateBlock* stateBlock = batch->getStateBlock();
+    stateBlock->setBlendSeparate(true);
+    stateBlock->setBlendSrcAlpha(RenderState::BLEND_ONE);
+    stateBlock->setBlendDstAlpha(RenderState::BLEND_ONE_MINUS_SRC_ALPHA);
+    _cacheBatches.push_back(batch);
+}
+
+void Form::invalidate(Control* control, int bits)
+{
+    GP_ASSERT(control);
+
+    if (!_cachingEnabled || _redrawAll)
+        return;
+
+    // Bounds changes may move any number of controls, so redraw everything.
+    if (bits & (DIRTY_BOUNDS | DIRTY_POSITION))
+    {
+        _redrawAll = true;
+        return;
+    }
+
+    if (control->_absoluteBounds.isEmpty())
+        return;
+
+    if (_dirtyRegion.isEmpty())
+        _dirtyRegion = control->_absoluteBounds;
+    else
+        Rectangle::combine(_dirtyRegion, control->_absoluteBounds, &_dirtyRegion);
+}
+
+void Form::invalidateHitGrid()
+{
+    _hitGridDirty = true;
+}
+
+void Form::updateHitGrid(Control* control)
+{
+    GP_ASSERT(control);
+
+    // The grid is laid out over our own bounds, so it must be rebuilt when they change.
+    if (_hitGridDirty || control == this)
+    {
+        _hitGridDirty = true;
+        return;
+    }
+
+    int cells[4];
+    getHitCells(control->_absoluteClipBounds, cells);
+    int* oldCells = control->_hitCells;
+    if (cells[0] == oldCells[0] && cells[1] == oldCells[1] && cells[2] == oldCells[2] && cells[3] == oldCells[3])
+        return;
+
+    // Move the control from the cells it overlapped to the ones it overlaps now.
+    for (int y = oldCells[1]; y <= oldCells[3]; ++y)
+    {
+        for (int x = oldCells[0]; x <= oldCells[2]; ++x)
+        {
+            std::vector<Control*>& cell = _hitGrid[y * _hitGridColumns + x];
+            std::vector<Control*>::iterator itr = std::find(cell.begin(), cell.end(), control);
+            GP_ASSERT(itr != cell.end());
+            *itr = cell.back();
+            cell.pop_back();
+        }
+    }
+    for (int y = cells[1]; y <= cells[3]; ++y)
+    {
+        for (int x = cells[0]; x <= cells[2]; ++x)
+        {
+            _hitGrid[y * _hitGridColumns + x].push_back(control);
+        }
+    }
+    memcpy(oldCells, cells, sizeof(cells));
+}
+
+void Form::rebuildHitGrid()
+{
+    _hitGridBounds = _absoluteClipBounds;
+    _hitGridColumns = std::min(std::max((int)ceilf(_hitGridBounds.width / HIT_GRID_CELL_SIZE), 1), HIT_GRID_MAX_CELLS);
+    _hitGridRows = std::min(std::max((int)ceilf(_hitGridBounds.height / HIT_GRID_CELL_SIZE), 1), HIT_GRID_MAX_CELLS);
+
+    _hitGrid.resize(_hitGridColumns * _hitGridRows);
+    for (size_t i = 0, count = _hitGrid.size(); i < count; ++i)
+    {
+        _hitGrid[i].clear();
+    }
+
+    unsigned int order = 0;
+    addToHitGrid(this, &order);
+
+    _hitGridDirty = false;
+}
+
+void Form::addToHitGrid(Control* control, unsigned int* order)
+{
+    // Number the controls in the order the recursive search used to visit them in,
+    // so that the last control found under a point is still the one drawn on top.
+    control->_hitOrder = (*order)++;
+
+    int* cells = control->_hitCells;
+    getHitCells(control->_absoluteClipBounds, cells);
+    for (int y = cells[1]; y <= cells[3]; ++y)
+    {
+        for (int x = cells[0]; x <= cells[2]; ++x)
+        {
+            _hitGrid[y * _hitGridColumns + x].push_back(control);
+        }
+    }
+
+    if (control->isContainer())
+    {
+        Container* container = static_cast<Container*>(control);
+        for (unsigned int i = 0, count = container->getControlCount(); i < count; ++i)
+        {
+            addToHitGrid(container->getControl(i), order);
+        }
+    }
+}
+
+void Form::getHitCells(const Rectangle& bounds, int* cells) const
+{
+    if (bounds.width < 0 || bounds.height < 0)
+    {
+        cells[0] = cells[1] = 0;
+        cells[2] = cells[3] = -1;
+        return;
+    }
+
+    // Bounds reaching outside of the grid are stored in its edge cells, which are also
+    // searched for points outside of the grid.
+    const float cellWidth = _hitGridBounds.width / _hitGridColumns;
+    const float cellHeight = _hitGridBounds.height / _hitGridRows;
+    const float scaleX = cellWidth > 0 ? 1.0f / cellWidth : 0.0f;
+    const float scaleY = cellHeight > 0 ? 1.0f / cellHeight : 0.0f;
+    cells[0] = std::min(std::max((int)floorf((bounds.x - _hitGridBounds.x) * scaleX), 0), _hitGridColumns - 1);
+    cells[1] = std::min(std::max((int)floorf((bounds.y - _hitGridBounds.y) * scaleY), 0), _hitGridRows - 1);
+    cells[2] = std::min(std::max((int)floorf((bounds.right() - _hitGridBounds.x) * scaleX), 0), _hitGridColumns - 1);
+    cells[3] = std::min(std::max((int)floorf((bounds.bottom() - _hitGridBounds.y) * scaleY), 0), _hitGridRows - 1);
+}
+
+Control* Form::hitTest(int x, int y, bool focus)
+{
+    if (_hitGridDirty)
+        rebuildHitGrid();
+
+    int cells[4];
+    getHitCells(Rectangle((float)x, (float)y, 0, 0), cells);
+
+    Control* result = NULL;
+    const std::vector<Control*>& cell = _hitGrid[cells[1] * _hitGridColumns + cells[0]];
+    for (size_t i = 0, count = cell.size(); i < count; ++i)
+    {
+        Control* control = cell[i];
+        if (result && control->_hitOrder < result->_hitOrder)
+            continue;
+
+        // Does the control's bounds intersect the specified coordinates - and
+        // does the control support the specified input state?
+        if (!control->_consumeInputEvents || (focus && !control->canFocus()))
+            continue;
+        if (!control->_absoluteClipBounds.contains(x, y))
+            continue;
+
+        // Controls only receive input when they and all of their ancestors are visible and enabled.
+        Control* parent = control;
+        while (parent && parent->_visible && parent->isEnabled())
+            parent = parent->_parent;
+        if (parent == NULL)
+            result = control;
+    }
+
+    return result;
+}
+
+Control* Form::getControlAt(int x, int y)
+{
+    return hitTest(x, y, false);
+}
+
 const char* Form::getType() const
 {
     return "form";
@@ -296,6 +612,25 @@ void Form::setBatchingEnabled(bool enabled)
     _batched = enabled;
 }
 
+bool Form::isCachingEnabled() const
+{
+    return _cachingEnabled;
+}
+
+void Form::setCachingEnabled(bool enabled)
+{
+    if (_cachingEnabled == enabled)
+        return;
+
+    _cachingEnabled = enabled;
+    _redrawAll = true;
+    if (!enabled)
+    {
+        SAFE_DELETE(_frameBatch);
+        SAFE_RELEASE(_frameBuffer);
+    }
+}
+
 void Form::updateInternal(float elapsedTime)
 {
     pollGamepads();
@@ -353,7 +688,7 @@ Control* Form::findInputControl(int* x, int* y, bool focus, unsigned int contact
             continue;
 
         // Search for an input control within this form
-        Control* ctrl = findInputControl(form, formX, formY, focus, contactIndex);
+        Control* ctrl = form->hitTest(formX, formY, focus);
         if (ctrl)
         {
             *x = formX;
@@ -370,37 +705,6 @@ Control* Form::findInputControl(int* x, int* y, bool focus, unsigned int contact
     return NULL;
 }
 
-Control* Form::findInputControl(Control* control, int x, int y, bool focus, unsigned int contactIndex)
-{
-    if (!(control->_visible && control->isEnabled()))
-        return NULL;
-
-    Control* result = NULL;
-
-    // Does the passed in control's bounds intersect the specified coordinates - and 
-    // does the control support the specified input state?
-    if (control->_consumeInputEvents && (!focus || control->canFocus()))
-    {
-        if (control->_absoluteClipBounds.contains(x, y))
-            result = control;
-    }
-
-    // If the control has children, search for an input control inside it that also
-    // supports the above conditions.
-    if (control->isContainer())
-    {
-        Container* container = static_cast<Container*>(control);
-        for (unsigned int i = 0, childCount = container->getControlCount(); i < childCount; ++i)
-        {
-            Control* ctrl = findInputControl(container->getControl(i), x, y, focus, contactIndex);
-            if (ctrl)
-                result = ctrl;
-        }
-    }
-
-    return result;
-}
-
 Control* Form::handlePointerPressRelease(int* x, int* y, bool pressed, unsigned int contactIndex)
 {
     if (contactIndex >= Touch::MAX_TOUCH_POINTS)
@@ -119,6 +119,19 @@ public:
      */
     unsigned int draw();
 
+    /**
+     * Gets the top-most control of this form that would receive input at the specified point.
+     *
+     * The control must consume input events, and it and all of its ancestors must be visible
+     * and enabled. This is the control that a touch or mouse event at the point is sent to.
+     *
+     * @param x The x coordinate of the point, relative to the form.
+     * @param y The y coordinate of the point, relative to the form.
+     *
+     * @return The control at the point, or NULL if there is none.
+     */
+    Control* getControlAt(int x, int y);
+
     /**
      * @see Control::getType
      */
@@ -143,6 +156,32 @@ public:
      */
     void setBatchingEnabled(bool enabled);
 
+    /**
+     * Determines whether this form caches its rendering in a frame buffer.
+     *
+     * @return True if caching is enabled for this form, false otherwise.
+     */
+    bool isCachingEnabled() const;
+
+    /**
+     * Turns caching of rendering on or off for this form.
+     *
+     * When caching is enabled, the form renders its controls into a frame buffer once and
+     * then draws that frame buffer as a single quad each frame. Controls are only rendered
+     * again when they become dirty, such as when their state, style, bounds, text or value
+     * changes, when they are animated or when they handle an input event, and only the
+     * dirty parts of the frame buffer are redrawn. This suits forms that rarely change,
+     * such as menus and HUDs, at the cost of the memory for the frame buffer.
+     *
+     * Custom controls whose appearance changes for any other reason must call setDirty
+     * for the change to be drawn.
+     *
+     * Caching can also be enabled with the "cachingEnabled" property of a form file.
+     *
+     * @param enabled True to enable caching, false (default) to draw all controls every frame.
+     */
+    void setCachingEnabled(bool enabled);
+
 private:
     
     /**
@@ -238,12 +277,60 @@ private:
 
     const Matrix& getProjectionMatrix() const;
 
+    /**
+     * Draws the controls of the form that intersect the current draw region and flushes the batches.
+     */
+    unsigned int drawControls();
+
+    /**
+     * Redraws the dirty region of the frame buffer that caches the form's rendering.
+     */
+    unsigned int updateFrameBuffer();
+
+    /**
+     * Sets the blend function of a batch that draws into the frame buffer cache, until the cache is updated.
+     */
+    void setCacheBlending(SpriteBatch* batch);
+
+    /**
+     * Called when a control of this form becomes dirty, to mark its region for redrawing.
+     */
+    void invalidate(Control* control, int bits);
+
+    /**
+     * Called when the controls of this form are added, removed or reordered, to rebuild the hit-test grid.
+     */
+    void invalidateHitGrid();
+
+    /**
+     * Called when the clip bounds of a control of this form change, to move it within the hit-test grid.
+     */
+    void updateHitGrid(Control* control);
+
+    /**
+     * Rebuilds the hit-test grid from the current bounds of all controls of the form.
+     */
+    void rebuildHitGrid();
+
+    /**
+     * Adds a control and its descendants to the hit-test grid, in drawing order.
+     */
+    void addToHitGrid(Control* control, unsigned int* order);
+
+    /**
+     * Gets the range of hit-test grid cells overlapping the specified bounds.
+     */
+    void getHitCells(const Rectangle& bounds, int* cells) const;
+
+    /**
+     * Finds the top-most control of this form accepting input at the specified point, in form coordinates.
+     */
+    Control* hitTest(int x, int y, bool focus);
+
     static bool pointerEventInternal(bool mouse, int evt, int x, int y, int param);
 
     static Control* findInputControl(int* x, int* y, bool focus, unsigned int contactIndex);
 
-    static Control* findInputControl(Control* control, int x, int y, bool focus, unsigned int contactIndex);
-
     static Control* handlePointerPressRelease(int* x, int* y, bool pressed, unsigned int contactIndex);
 
     static Control* handlePointerMove(int* x, int* y, unsigned int contactIndex);
@@ -264,6 +351,19 @@ private:
     Matrix _projectionMatrix;           // Projection matrix to be set on SpriteBatch objects when rendering the form
     std::vector<SpriteBatch*> _batches;
     bool _batched;
+    SpriteBatch* _spriteBatch;          // Multi-texture batch that the batches of the controls are drawn into
+    bool _cachingEnabled;               // Whether the form is rendered into _frameBuffer and only redrawn where dirty
+    FrameBuffer* _frameBuffer;          // Frame buffer caching the rendering of the form
+    SpriteBatch* _frameBatch;           // Batch for drawing the frame buffer
+    std::vector<SpriteBatch*> _cacheBatches; // Batches whose blend function was set for drawing into the frame buffer
+    Rectangle _drawRegion;              // Region of the form being drawn; controls outside of it are skipped
+    Rectangle _dirtyRegion;             // Region of the frame buffer to redraw
+    bool _redrawAll;                    // Whether the whole frame buffer must be redrawn
+    std::vector<std::vector<Control*> > _hitGrid; // Controls overlapping each cell of the hit-test grid, row by row
+    Rectangle _hitGridBounds;           // Region of the form covered by the hit-test grid
+    int _hitGridColumns;
+    int _hitGridRows;
+    bool _hitGridDirty;                 // Whether the hit-test grid must be rebuilt before it is used
 };
 
 }
@@ -340,6 +340,9 @@ void Game::frame()
         // Run script render.
         _scriptController->render(elapsedTime);
 
+        // Collect script garbage within the frame's budget.
+        _scriptController->collectGarbage();
+
         // Update FPS.
         ++_frameCount;
         if ((Game::getGameTime() - _frameLastFPS) >= 1000)
@@ -368,6 +371,9 @@ void Game::frame()
 
         // Script render.
         _scriptController->render(0);
+
+        // Collect script garbage within the frame's budget.
+        _scriptController->collectGarbage();
     }
 }
 
@@ -31,6 +31,7 @@ class ScriptController;
 class Game
 {
     friend class Platform;
+    friend class HeadlessGame;
     friend class ShutdownListener;
 
 public:
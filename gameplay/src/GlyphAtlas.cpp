@@ -0,0 +1,251 @@
+#include "Base.h"
+#include "GlyphAtlas.h"
+
+namespace gameplay
+{
+
+GlyphAtlas::GlyphAtlas(unsigned int width, unsigned int height, unsigned int padding) :
+    _width(width), _height(height), _padding(padding), _shelfEnd(0), _glyphCount(0), _evictionCount(0), _head(-1), _tail(-1)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+}
+
+unsigned int GlyphAtlas::getWidth() const
+{
+    return _width;
+}
+
+unsigned int GlyphAtlas::getHeight() const
+{
+    return _height;
+}
+
+unsigned int GlyphAtlas::getGlyphCount() const
+{
+    return _glyphCount;
+}
+
+unsigned int GlyphAtlas::getEvictionCount() const
+{
+    return _evictionCount;
+}
+
+int GlyphAtlas::find(unsigned int code)
+{
+    int* index = _lookup.find(btHashInt((int)code));
+    if (index == NULL)
+        return -1;
+
+    if (*index != _head)
+    {
+        unlink(*index);
+        link(*index);
+    }
+    return *index;
+}
+
+int GlyphAtlas::insert(unsigned int code, unsigned int width, unsigned int height)
+{
+    GP_ASSERT(_lookup.find(btHashInt((int)code)) == NULL);
+
+    const unsigned int paddedWidth = width + _padding;
+    const unsigned int paddedHeight = height + _padding;
+    if (paddedWidth > _width || paddedHeight > _height)
+        return -1;
+
+    int shelf;
+    unsigned int x;
+    while (!allocate(paddedWidth, paddedHeight, &shelf, &x))
+    {
+        // Make room by evicting the least recently used glyph. Once every glyph
+        // has been evicted all shelves are released, so the glyph will fit.
+        if (_tail < 0)
+            return -1;
+        evict(_tail);
+    }
+
+    int index;
+    if (_freeEntries.empty())
+    {
+        index = (int)_entries.size();
+        _entries.push_back(Entry());
+    }
+    else
+    {
+        index = _freeEntries.back();
+        _freeEntries.pop_back();
+    }
+
+    Entry& entry = _entries[index];
+    entry.code = code;
+    entry.region.x = x;
+    entry.region.y = _shelves[shelf].y;
+    entry.region.width = width;
+    entry.region.height = height;
+    entry.shelf = shelf;
+    link(index);
+
+    _lookup.insert(btHashInt((int)code), index);
+    ++_glyphCount;
+
+    return index;
+}
+
+unsigned int GlyphAtlas::getCode(int index) const
+{
+    GP_ASSERT(index >= 0 && index < (int)_entries.size());
+    return _entries[index].code;
+}
+
+const GlyphAtlas::Region& GlyphAtlas::getRegion(int index) const
+{
+    GP_ASSERT(index >= 0 && index < (int)_entries.size());
+    return _entries[index].region;
+}
+
+void GlyphAtlas::clear()
+{
+    _evictionCount += _glyphCount;
+    _glyphCount = 0;
+    _shelfEnd = 0;
+    _shelves.clear();
+    _entries.clear();
+    _freeEntries.clear();
+    _lookup.clear();
+    _head = -1;
+    _tail = -1;
+}
+
+bool GlyphAtlas::allocate(unsigned int width, unsigned int height, int* shelf, unsigned int* x)
+{
+    // Use the shortest shelf that is tall enough and has a wide enough free span.
+    int bestShelf = -1;
+    size_t bestSpan = 0;
+    for (size_t i = 0, count = _shelves.size(); i < count; ++i)
+    {
+        const Shelf& s = _shelves[i];
+        if (s.height < height || (bestShelf >= 0 && s.height >= _shelves[bestShelf].height))
+            continue;
+
+        for (size_t j = 0, spanCount = s.free.size(); j < spanCount; ++j)
+        {
+            if (s.free[j].width >= width)
+            {
+                bestShelf = (int)i;
+                bestSpan = j;
+                break;
+            }
+        }
+    }
+
+    if (bestShelf < 0)
+    {
+        // Start a new shelf after the existing ones.
+        if (_shelfEnd + height > _height)
+            return false;
+
+        Shelf s;
+        s.y = _shelfEnd;
+        s.height = height;
+        Span span = { 0, _width };
+        s.free.push_back(span);
+        _shelves.push_back(s);
+        _shelfEnd += height;
+
+        bestShelf = (int)_shelves.size() - 1;
+        bestSpan = 0;
+    }
+
+    std::vector<Span>& spans = _shelves[bestShelf].free;
+    Span& span = spans[bestSpan];
+    *shelf = bestShelf;
+    *x = span.x;
+    span.x += width;
+    span.width -= width;
+    if (span.width == 0)
+        spans.erase(spans.begin() + bestSpan);
+
+    return true;
+}
+
+void GlyphAtlas::release(int shelf, unsigned int x, unsigned int width)
+{
+    GP_ASSERT(shelf >= 0 && shelf < (int)_shelves.size());
+
+    // Insert the span in order, merging it with its neighbours.
+    std::vector<Span>& spans = _shelves[shelf].free;
+    size_t i = 0;
+    while (i < spans.size() && spans[i].x < x)
+        ++i;
+
+    if (i < spans.size() && x + width == spans[i].x)
+    {
+        spans[i].x = x;
+        spans[i].width += width;
+    }
+    else
+    {
+        Span span = { x, width };
+        spans.insert(spans.begin() + i, span);
+    }
+
+    if (i > 0 && spans[i - 1].x + spans[i - 1].width == spans[i].x)
+    {
+        spans[i - 1].width += spans[i].width;
+        spans.erase(spans.begin() + i);
+    }
+
+    // Release empty shelves at the end, so the space can be used for shelves of other heights.
+    while (!_shelves.empty())
+    {
+        const Shelf& last = _shelves.back();
+        if (last.free.size() != 1 || last.free[0].width != _width)
+            break;
+        _shelfEnd = last.y;
+        _shelves.pop_back();
+    }
+}
+
+void GlyphAtlas::evict(int index)
+{
+    Entry& entry = _entries[index];
+    unlink(index);
+    _lookup.remove(btHashInt((int)entry.code));
+    release(entry.shelf, entry.region.x, entry.region.width + _padding);
+    entry.shelf = -1;
+    _freeEntries.push_back(index);
+
+    --_glyphCount;
+    ++_evictionCount;
+}
+
+void GlyphAtlas::link(int index)
+{
+    Entry& entry = _entries[index];
+    entry.prev = -1;
+    entry.next = _head;
+    if (_head >= 0)
+        _entries[_head].prev = index;
+    _head = index;
+    if (_tail < 0)
+        _tail = index;
+}
+
+void GlyphAtlas::unlink(int index)
+{
+    Entry& entry = _entries[index];
+    if (entry.prev >= 0)
+        _entries[entry.prev].next = entry.next;
+    else
+        _head = entry.next;
+
+    if (entry.next >= 0)
+        _entries[entry.next].prev = entry.prev;
+    else
+        _tail = entry.prev;
+}
+
+}
@@ -0,0 +1,201 @@
+#ifndef GLYPHATLAS_H_
+#define GLYPHATLAS_H_
+
+#include "Base.h"
+
+namespace gameplay
+{
+
+/**
+ * Allocates regions of a fixed size texture for glyphs that are rasterized on demand.
+ *
+ * Regions are packed into horizontal shelves. When there is no room left for a new glyph,
+ * the least recently used glyphs are evicted until it fits. Glyphs are looked up by their
+ * character code through a hash map.
+ *
+ * The atlas only manages space within the texture and does not hold any pixel data, so it
+ * does not require a graphics context.
+ *
+ * @script{ignore}
+ */
+class GlyphAtlas
+{
+public:
+
+    /**
+     * Defines the region of the atlas allocated to a glyph, in pixels.
+     */
+    struct Region
+    {
+        /**
+         * The x position of the region.
+         */
+        unsigned int x;
+
+        /**
+         * The y position of the region.
+         */
+        unsigned int y;
+
+        /**
+         * The width of the region.
+         */
+        unsigned int width;
+
+        /**
+         * The height of the region.
+         */
+        unsigned int height;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param width The width of the atlas, in pixels.
+     * @param height The height of the atlas, in pixels.
+     * @param padding The number of empty pixels to keep to the right of and below each glyph.
+     */
+    GlyphAtlas(unsigned int width, unsigned int height, unsigned int padding = 1);
+
+    /**
+     * Destructor.
+     */
+    ~GlyphAtlas();
+
+    /**
+     * Gets the width of the atlas.
+     *
+     * @return The width of the atlas, in pixels.
+     */
+    unsigned int getWidth() const;
+
+    /**
+     * Gets the height of the atlas.
+     *
+     * @return The height of the atlas, in pixels.
+     */
+    unsigned int getHeight() const;
+
+    /**
+     * Gets the number of glyphs currently in the atlas.
+     *
+     * @return The number of glyphs.
+     */
+    unsigned int getGlyphCount() const;
+
+    /**
+     * Gets the total number of glyphs that have been evicted from the atlas.
+     *
+     * This can be compared between calls to determine whether any glyph regions were reused.
+     *
+     * @return The number of evicted glyphs.
+     */
+    unsigned int getEvictionCount() const;
+
+    /**
+     * Finds a glyph and marks it as the most recently used.
+     *
+     * @param code The character code of the glyph.
+     *
+     * @return The index of the glyph, or -1 if the glyph is not in the atlas.
+     */
+    int find(unsigned int code);
+
+    /**
+     * Allocates a region for a glyph, evicting the least recently used glyphs if there is no room.
+     *
+     * The new glyph becomes the most recently used. The index of an evicted glyph may be
+     * reused for a later glyph.
+     *
+     * @param code The character code of the glyph, which must not already be in the atlas.
+     * @param width The width of the glyph, in pixels.
+     * @param height The height of the glyph, in pixels.
+     *
+     * @return The index of the new glyph, or -1 if the glyph does not fit within the atlas.
+     */
+    int insert(unsigned int code, unsigned int width, unsigned int height);
+
+    /**
+     * Gets the character code of a glyph.
+     *
+     * @param index The index of the glyph.
+     *
+     * @return The character code.
+     */
+    unsigned int getCode(int index) const;
+
+    /**
+     * Gets the region allocated to a glyph.
+     *
+     * @param index The index of the glyph.
+     *
+     * @return The region of the glyph.
+     */
+    const Region& getRegion(int index) const;
+
+    /**
+     * Removes all glyphs from the atlas.
+     */
+    void clear();
+
+private:
+
+    struct Span
+    {
+        unsigned int x;
+        unsigned int width;
+    };
+
+    struct Shelf
+    {
+        unsigned int y;
+        unsigned int height;
+        std::vector<Span> free;
+    };
+
+    struct Entry
+    {
+        unsigned int code;
+        Region region;
+        int shelf;
+        int prev;
+        int next;
+    };
+
+    /**
+     * Hidden copy constructor.
+     */
+    GlyphAtlas(const GlyphAtlas&);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    GlyphAtlas& operator=(const GlyphAtlas&);
+
+    bool allocate(unsigned int width, unsigned int height, int* shelf, unsigned int* x);
+
+    void release(int shelf, unsigned int x, unsigned int width);
+
+    void evict(int index);
+
+    void link(int index);
+
+    void unlink(int index);
+
+    unsigned int _width;
+    unsigned int _height;
+    unsigned int _padding;
+    unsigned int _shelfEnd;
+    unsigned int _glyphCount;
+    unsigned int _evictionCount;
+    std::vector<Shelf> _shelves;
+    std::vector<Entry> _entries;
+    std::vector<int> _freeEntries;
+    int _head;
+    int _tail;
+    btHashMap<btHashInt, int> _lookup;
+};
+
+}
+
+#endif
@@ -2,24 +2,87 @@
 #include "HeightField.h"
 #include "Image.h"
 #include "FileSystem.h"
+#include "Stream.h"
+#include "MathUtil.h"
 
 namespace gameplay
 {
 
+// The largest quantized height value.
+#define QUANTIZED_MAX 65535
+
+template <class T> static float getHeight(const T* array, unsigned int cols, unsigned int rows, float column, float row);
+
 HeightField::HeightField(unsigned int columns, unsigned int rows)
-    : _array(NULL), _cols(columns), _rows(rows)
+    : _array(NULL), _quantized(NULL), _cols(columns), _rows(rows), _bits(0), _heightMin(0), _heightMax(1), _tileSize(0), _tileCols(0), _quantizedTiles(false)
 {
-    _array = new float[columns * rows];
 }
 
 HeightField::~HeightField()
 {
     SAFE_DELETE_ARRAY(_array);
+    SAFE_DELETE_ARRAY(_quantized);
+    for (size_t i = 0, count = _tiles.size(); i < count; ++i)
+    {
+        SAFE_DELETE_ARRAY(_tiles[i].heights);
+        SAFE_DELETE_ARRAY(_tiles[i].quantized);
+    }
 }
 
 HeightField* HeightField::create(unsigned int columns, unsigned int rows)
 {
-    return new HeightField(columns, rows);
+    HeightField* heightfield = new HeightField(columns, rows);
+    heightfield->_array = new float[columns * rows];
+    return heightfield;
+}
+
+HeightField* HeightField::createTiled(const char* path, unsigned int width, unsigned int height, unsigned int tileSize, float heightMin, float heightMax, bool quantized)
+{
+    GP_ASSERT(path);
+    GP_ASSERT(heightMax >= heightMin);
+
+    std::string ext = FileSystem::getExtension(path);
+    if (ext != ".RAW" && ext != ".R16")
+    {
+        GP_WARN("Tiled heightfields must be created from a RAW file: %s.", path);
+        return NULL;
+    }
+
+    if (width < 2 || height < 2 || tileSize < 1)
+    {
+        GP_WARN("Invalid 'width', 'height' or 'tileSize' parameter for tiled heightfield: %s.", path);
+        return NULL;
+    }
+
+    // Determine if the RAW file is 8-bit or 16-bit based on file size, without reading it.
+    Stream* stream = FileSystem::open(path);
+    if (stream == NULL)
+    {
+        GP_WARN("Failed to open RAW heightfield image: %s.", path);
+        return NULL;
+    }
+    size_t fileSize = stream->length();
+    stream->close();
+    SAFE_DELETE(stream);
+
+    unsigned int bits = (unsigned int)(fileSize / (width * height)) * 8;
+    if (bits != 8 && bits != 16)
+    {
+        GP_WARN("Invalid RAW file - must be 8-bit or 16-bit, but found neither: %s.", path);
+        return NULL;
+    }
+
+    HeightField* heightfield = new HeightField(width, height);
+    heightfield->_path = path;
+    heightfield->_bits = bits;
+    heightfield->_heightMin = heightMin;
+    heightfield->_heightMax = heightMax;
+    heightfield->_tileSize = tileSize;
+    heightfield->_quantizedTiles = quantized;
+    heightfield->_tileCols = (width - 2) / tileSize + 1;
+    heightfield->_tiles.resize(heightfield->_tileCols * ((height - 2) / tileSize + 1));
+
+    return heightfield;
 }
 
 /**
@@ -35,17 +98,17 @@ float normalizedHeightPacked(float r, float g, float b)
     return (256.0f*r + g + 0.00390625f*b) / 65536.0f;
 }
 
-HeightField* HeightField::createFromImage(const char* path, float heightMin, float heightMax)
+HeightField* HeightField::createFromImage(const char* path, float heightMin, float heightMax, bool quantized)
 {
-    return create(path, 0, 0, heightMin, heightMax);
+    return create(path, 0, 0, heightMin, heightMax, quantized);
 }
 
-HeightField* HeightField::createFromRAW(const char* path, unsigned int width, unsigned int height, float heightMin, float heightMax)
+HeightField* HeightField::createFromRAW(const char* path, unsigned int width, unsigned int height, float heightMin, float heightMax, bool quantized)
 {
-    return create(path, width, height, heightMin, heightMax);
+    return create(path, width, height, heightMin, heightMax, quantized);
 }
 
-HeightField* HeightField::create(const char* path, unsigned int width, unsigned int height, float heightMin, float heightMax)
+HeightField* HeightField::create(const char* path, unsigned int width, unsigned int height, float heightMin, float heightMax, bool quantized)
 {
     GP_ASSERT(path);
     GP_ASSERT(heightMax >= heightMin);
@@ -79,16 +142,21 @@ HeightField* HeightField::create(const char* path, unsigned int width, unsigned
         }
 
         // Calculate the heights for each pixel.
-        heightfield = HeightField::create(image->getWidth(), image->getHeight());
-        float* heights = heightfield->getArray();
+        heightfield = quantized ? createQuantized(image->getWidth(), image->getHeight(), heightMin, heightMax) : HeightField::create(image->getWidth(), image->getHeight());
+        float* heights = heightfield->_array;
+        unsigned short* quantizedHeights = heightfield->_quantized;
         unsigned char* data = image->getData();
         int idx;
         for (int y = image->getHeight()-1, i = 0; y >= 0; --y)
         {
-            for (unsigned int x = 0, w = image->getWidth(); x < w; ++x)
+            for (unsigned int x = 0, w = image->getWidth(); x < w; ++x, ++i)
             {
                 idx = (y*w + x) * pixelSize;
-                heights[i++] = heightMin + normalizedHeightPacked(data[idx], data[idx + 1], data[idx + 2]) * heightScale;
+                float h = normalizedHeightPacked(data[idx], data[idx + 1], data[idx + 2]);
+                if (quantizedHeights)
+                    quantizedHeights[i] = (unsigned short)(std::min(h, 1.0f) * QUANTIZED_MAX + 0.5f);
+                else
+                    heights[i] = heightMin + h * heightScale;
             }
         }
 
@@ -121,10 +189,22 @@ HeightField* HeightField::create(const char* path, unsigned int width, unsigned
             return NULL;
         }
 
-        heightfield = HeightField::create(width, height);
-        float* heights = heightfield->getArray();
+        heightfield = quantized ? createQuantized(width, height, heightMin, heightMax) : HeightField::create(width, height);
+        float* heights = heightfield->_array;
+        unsigned short* quantizedHeights = heightfield->_quantized;
 
-        if (bits == 16)
+        if (quantizedHeights)
+        {
+            // Quantized storage uses the same 0-65535 range as RAW16, so no precision is lost.
+            for (unsigned int i = 0, count = width * height; i < count; ++i)
+            {
+                if (bits == 16)
+                    quantizedHeights[i] = (unsigned short)(bytes[i << 1] | (int)bytes[(i << 1) + 1] << 8);
+                else
+                    quantizedHeights[i] = (unsigned short)(bytes[i] * 257);
+            }
+        }
+        else if (bits == 16)
         {
             // 16-bit (0-65535)
             int idx;
@@ -159,17 +239,331 @@ HeightField* HeightField::create(const char* path, unsigned int width, unsigned
     return heightfield;
 }
 
+HeightField* HeightField::createQuantized(unsigned int columns, unsigned int rows, float heightMin, float heightMax)
+{
+    HeightField* heightfield = new HeightField(columns, rows);
+    heightfield->_quantized = new unsigned short[columns * rows];
+    heightfield->_heightMin = heightMin;
+    heightfield->_heightMax = heightMax;
+    return heightfield;
+}
+
 float* HeightField::getArray() const
 {
     return _array;
 }
 
+unsigned short* HeightField::getQuantizedArray() const
+{
+    return _quantized;
+}
+
+bool HeightField::isQuantized() const
+{
+    return _quantized != NULL || _quantizedTiles;
+}
+
+void HeightField::quantize()
+{
+    if (_array == NULL)
+        return;
+
+    // Find the range of heights to quantize
+    unsigned int count = _cols * _rows;
+    float heightMin = FLT_MAX, heightMax = -FLT_MAX;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (_array[i] < heightMin)
+            heightMin = _array[i];
+        if (_array[i] > heightMax)
+            heightMax = _array[i];
+    }
+
+    // Round each height to the nearest quantized value
+    float scale = heightMax > heightMin ? QUANTIZED_MAX / (heightMax - heightMin) : 0.0f;
+    _quantized = new unsigned short[count];
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        _quantized[i] = (unsigned short)((_array[i] - heightMin) * scale + 0.5f);
+    }
+
+    _heightMin = heightMin;
+    _heightMax = heightMax;
+    SAFE_DELETE_ARRAY(_array);
+}
+
+float HeightField::getQuantizedMin() const
+{
+    return isQuantized() ? _heightMin : 0.0f;
+}
+
+float HeightField::getQuantizedStep() const
+{
+    return isQuantized() ? (_heightMax - _heightMin) / QUANTIZED_MAX : 0.0f;
+}
+
+size_t HeightField::getMemoryUsage() const
+{
+    if (_array)
+        return _cols * _rows * sizeof(float);
+    if (_quantized)
+        return _cols * _rows * sizeof(unsigned short);
+
+    size_t size = 0;
+    for (size_t i = 0, count = _tiles.size(); i < count; ++i)
+    {
+        const Tile& tile = _tiles[i];
+        if (tile.heights)
+            size += tile.width * tile.height * sizeof(float);
+        else if (tile.quantized)
+            size += tile.width * tile.height * sizeof(unsigned short);
+    }
+    return size;
+}
+
 float HeightField::getHeight(float column, float row) const
 {
+    if (_quantized)
+        return _heightMin + gameplay::getHeight(_quantized, _cols, _rows, column, row) * getQuantizedStep();
+
+    if (_tileSize == 0)
+        return gameplay::getHeight(_array, _cols, _rows, column, row);
+
     // Clamp to heightfield boundaries
     column = column < 0 ? 0 : (column > (_cols-1) ? (_cols-1) : column);
     row = row < 0 ? 0 : (row > (_rows-1) ? (_rows-1) : row);
 
+    // Find the tile containing this point. The last sample row/column belongs to the last tile.
+    unsigned int tileColumn = std::min((unsigned int)column, _cols - 2) / _tileSize;
+    unsigned int tileRow = std::min((unsigned int)row, _rows - 2) / _tileSize;
+    const Tile& tile = _tiles[tileRow * _tileCols + tileColumn];
+
+    // Tiles are read with a border, so interpolation never needs to cross into a neighboring tile.
+    if (tile.quantized)
+        return _heightMin + gameplay::getHeight(tile.quantized, tile.width, tile.height, column - tile.x, row - tile.z) * getQuantizedStep();
+    if (tile.heights)
+        return gameplay::getHeight(tile.heights, tile.width, tile.height, column - tile.x, row - tile.z);
+    return 0.0f;
+}
+
+void HeightField::getHeights(const Vector2* points, float* heights, size_t count) const
+{
+    GP_ASSERT(points);
+    GP_ASSERT(heights);
+
+    if (_tileSize > 0)
+    {
+        // Tiles are looked up per point
+        for (size_t i = 0; i < count; ++i)
+            heights[i] = getHeight(points[i].x, points[i].y);
+        return;
+    }
+
+    // Process points in groups of four: corner heights are gathered for each point and
+    // the groups are then interpolated together.
+    float corners[16];
+    float fx[4];
+    float fy[4];
+    float result[4];
+    float maxColumn = (float)(_cols - 1);
+    float maxRow = (float)(_rows - 1);
+    for (size_t i = 0; i < count; i += 4)
+    {
+        size_t n = std::min(count - i, (size_t)4);
+        for (size_t j = 0; j < 4; ++j)
+        {
+            // Pad the last group by repeating its last point
+            const Vector2& point = points[i + std::min(j, n - 1)];
+
+            // Clamp to heightfield boundaries
+            float column = point.x < 0 ? 0 : (point.x > maxColumn ? maxColumn : point.x);
+            float row = point.y < 0 ? 0 : (point.y > maxRow ? maxRow : point.y);
+
+            unsigned int x1 = (unsigned int)column;
+            unsigned int y1 = (unsigned int)row;
+            unsigned int x2 = std::min(x1 + 1, _cols - 1);
+            unsigned int y2 = std::min(y1 + 1, _rows - 1);
+            fx[j] = column - x1;
+            fy[j] = row - y1;
+
+            if (_quantized)
+            {
+                corners[j] = _quantized[x1 + y1 * _cols];
+                corners[j + 4] = _quantized[x2 + y1 * _cols];
+                corners[j + 8] = _quantized[x1 + y2 * _cols];
+                corners[j + 12] = _quantized[x2 + y2 * _cols];
+            }
+            else
+            {
+                corners[j] = _array[x1 + y1 * _cols];
+                corners[j + 4] = _array[x2 + y1 * _cols];
+                corners[j + 8] = _array[x1 + y2 * _cols];
+                corners[j + 12] = _array[x2 + y2 * _cols];
+            }
+        }
+
+        MathUtil::interpolateBilinear4(corners, fx, fy, result);
+
+        if (_quantized)
+        {
+            // Quantized values interpolate linearly, so they can be converted after interpolation
+            float step = getQuantizedStep();
+            for (size_t j = 0; j < n; ++j)
+                heights[i + j] = _heightMin + result[j] * step;
+        }
+        else
+        {
+            for (size_t j = 0; j < n; ++j)
+                heights[i + j] = result[j];
+        }
+    }
+}
+
+unsigned int HeightField::getColumnCount() const
+{
+    return _cols;
+}
+
+unsigned int HeightField::getRowCount() const
+{
+    return _rows;
+}
+
+bool HeightField::isTiled() const
+{
+    return _tileSize > 0;
+}
+
+unsigned int HeightField::getTileSize() const
+{
+    return _tileSize;
+}
+
+bool HeightField::isTileLoaded(unsigned int row, unsigned int column) const
+{
+    unsigned int index = row * _tileCols + column;
+    return index < _tiles.size() && (_tiles[index].heights != NULL || _tiles[index].quantized != NULL);
+}
+
+bool HeightField::readTile(unsigned int row, unsigned int column, unsigned int border, Tile* tile) const
+{
+    GP_ASSERT(_tileSize > 0);
+    GP_ASSERT(tile);
+
+    // Compute the sample region covered by this tile, extended by the border
+    unsigned int x1 = column * _tileSize;
+    unsigned int z1 = row * _tileSize;
+    unsigned int x2 = std::min(x1 + _tileSize, _cols - 1);
+    unsigned int z2 = std::min(z1 + _tileSize, _rows - 1);
+    x1 = x1 > border ? x1 - border : 0;
+    z1 = z1 > border ? z1 - border : 0;
+    x2 = std::min(x2 + border, _cols - 1);
+    z2 = std::min(z2 + border, _rows - 1);
+
+    tile->x = x1;
+    tile->z = z1;
+    tile->width = x2 - x1 + 1;
+    tile->height = z2 - z1 + 1;
+
+    Stream* stream = FileSystem::open(_path.c_str());
+    if (stream == NULL)
+    {
+        GP_WARN("Failed to open RAW heightfield image: %s.", _path.c_str());
+        return false;
+    }
+
+    // Read one row of the tile at a time, directly from its location in the RAW file
+    unsigned int bytesPerSample = _bits / 8;
+    unsigned char* bytes = new unsigned char[tile->width * bytesPerSample];
+    float heightScale = _heightMax - _heightMin;
+    float* heights = NULL;
+    unsigned short* quantized = NULL;
+    if (_quantizedTiles)
+        tile->quantized = quantized = new unsigned short[tile->width * tile->height];
+    else
+        tile->heights = heights = new float[tile->width * tile->height];
+    bool result = true;
+    for (unsigned int z = z1; z <= z2; ++z)
+    {
+        if (!stream->seek((long int)(z * _cols + x1) * bytesPerSample, SEEK_SET) ||
+            stream->read(bytes, bytesPerSample, tile->width) != tile->width)
+        {
+            GP_WARN("Failed to read tile (%d, %d) from RAW heightfield image: %s.", row, column, _path.c_str());
+            result = false;
+            break;
+        }
+
+        if (quantized)
+        {
+            // Quantized storage uses the same 0-65535 range as RAW16, so no precision is lost.
+            for (unsigned int x = 0; x < tile->width; ++x)
+            {
+                if (_bits == 16)
+                    *quantized++ = (unsigned short)(bytes[x << 1] | (int)bytes[(x << 1) + 1] << 8);
+                else
+                    *quantized++ = (unsigned short)(bytes[x] * 257);
+            }
+        }
+        else if (_bits == 16)
+        {
+            // 16-bit (0-65535)
+            for (unsigned int x = 0, idx = 0; x < tile->width; ++x, idx += 2)
+            {
+                *heights++ = _heightMin + ((bytes[idx] | (int)bytes[idx+1] << 8) / 65535.0f) * heightScale;
+            }
+        }
+        else
+        {
+            // 8-bit (0-255)
+            for (unsigned int x = 0; x < tile->width; ++x)
+            {
+                *heights++ = _heightMin + (bytes[x] / 255.0f) * heightScale;
+            }
+        }
+    }
+
+    SAFE_DELETE_ARRAY(bytes);
+    stream->close();
+    SAFE_DELETE(stream);
+
+    if (!result)
+    {
+        SAFE_DELETE_ARRAY(tile->heights);
+        SAFE_DELETE_ARRAY(tile->quantized);
+    }
+
+    return result;
+}
+
+void HeightField::setTile(unsigned int row, unsigned int column, const Tile& tile)
+{
+    unsigned int index = row * _tileCols + column;
+    GP_ASSERT(index < _tiles.size());
+
+    SAFE_DELETE_ARRAY(_tiles[index].heights);
+    SAFE_DELETE_ARRAY(_tiles[index].quantized);
+    _tiles[index] = tile;
+}
+
+void HeightField::releaseTile(unsigned int row, unsigned int column)
+{
+    unsigned int index = row * _tileCols + column;
+    GP_ASSERT(index < _tiles.size());
+
+    SAFE_DELETE_ARRAY(_tiles[index].heights);
+    SAFE_DELETE_ARRAY(_tiles[index].quantized);
+}
+
+HeightField::Tile::Tile() : heights(NULL), quantized(NULL), x(0), z(0), width(0), height(0)
+{
+}
+
+template <class T> static float getHeight(const T* array, unsigned int cols, unsigned int rows, float column, float row)
+{
+    // Clamp to heightfield boundaries
+    column = column < 0 ? 0 : (column > (cols-1) ? (cols-1) : column);
+    row = row < 0 ? 0 : (row > (rows-1) ? (rows-1) : row);
+
     unsigned int x1 = column;
     unsigned int y1 = row;
     unsigned int x2 = x1 + 1;
@@ -180,17 +574,17 @@ float HeightField::getHeight(float column, float row) const
     float xFactorI = 1.0f - xFactor;
     float yFactorI = 1.0f - yFactor;
 
-    if (x2 >= _cols && y2 >= _rows)
+    if (x2 >= cols && y2 >= rows)
     {
-        return _array[x1 + y1 * _cols];
+        return array[x1 + y1 * cols];
     }
-    else if (x2 >= _cols)
+    else if (x2 >= cols)
     {
-        return _array[x1 + y1 * _cols] * yFactorI + _array[x1 + y2 * _cols] * yFactor;
+        return array[x1 + y1 * cols] * yFactorI + array[x1 + y2 * cols] * yFactor;
     }
-    else if (y2 >= _rows)
+    else if (y2 >= rows)
     {
-        return _array[x1 + y1 * _cols] * xFactorI + _array[x2 + y1 * _cols] * xFactor;
+        return array[x1 + y1 * cols] * xFactorI + array[x2 + y1 * cols] * xFactor;
     }
     else
     {
@@ -198,19 +592,9 @@ float HeightField::getHeight(float column, float row) const
         float b = xFactorI * yFactor;
         float c = xFactor * yFactor;
         float d = xFactor * yFactorI;
-        return _array[x1 + y1 * _cols] * a + _array[x1 + y2 * _cols] * b +
-            _array[x2 + y2 * _cols] * c + _array[x2 + y1 * _cols] * d;
+        return array[x1 + y1 * cols] * a + array[x1 + y2 * cols] * b +
+            array[x2 + y2 * cols] * c + array[x2 + y1 * cols] * d;
     }
 }
 
-unsigned int HeightField::getColumnCount() const
-{
-    return _cols;
-}
-
-unsigned int HeightField::getRowCount() const
-{
-    return _rows;
-}
-
 }
@@ -2,6 +2,7 @@
 #define HEIGHTFIELD_H_
 
 #include "Ref.h"
+#include "Vector2.h"
 
 namespace gameplay
 {
@@ -12,6 +13,12 @@ namespace gameplay
      * Heightfields can be used to construct both Terrain objects as well as PhysicsCollisionShape
      * heightfield defintions, which are used in heightfield rigid body creation. Heightfields can
      * be populated manually, or loaded from images and RAW files.
+     *
+     * Heights are normally stored as 32-bit floating point values. To reduce memory usage for
+     * large heightfields, heights can instead be stored quantized to 16-bit unsigned values
+     * that are mapped linearly onto a [min, max] height range, which halves the size of the
+     * height array. The error introduced by quantization is at most half of the quantized height
+     * step, (max - min) / 131070. RAW16 data is stored quantized without any loss of precision.
      */
     class HeightField : public Ref
     {
@@ -40,10 +47,11 @@ namespace gameplay
          * @param path Path to a heightfield image.
          * @param heightMin Minimum height value for a zero intensity pixel.
          * @param heightMax Maximum height value for a full intensity heightfield pixel (must be >= minHeight).
+         * @param quantized True to store heights as quantized 16-bit values rather than floats.
          *
          * @return The new HeightField.
          */
-        static HeightField* createFromImage(const char* path, float heightMin = 0, float heightMax = 1);
+        static HeightField* createFromImage(const char* path, float heightMin = 0, float heightMax = 1, bool quantized = false);
 
         /**
          * Creates a HeightField from the specified RAW8 or RAW16 file.
@@ -67,10 +75,35 @@ namespace gameplay
          * @param height Height of the RAW data.
          * @param heightMin Minimum height value for a zero intensity pixel.
          * @param heightMax Maximum height value for a full intensity heightfield pixel (must be >= minHeight).
+         * @param quantized True to store heights as quantized 16-bit values rather than floats.
          *
          * @return The new HeightField.
          */
-        static HeightField* createFromRAW(const char* path, unsigned int width, unsigned int height, float heightMin = 0, float heightMax = 1);
+        static HeightField* createFromRAW(const char* path, unsigned int width, unsigned int height, float heightMin = 0, float heightMax = 1, bool quantized = false);
+
+        /**
+         * Creates a tiled HeightField that pages its height data in from the specified RAW8 or RAW16 file.
+         *
+         * Tiled heightfields do not keep the full height array in memory. Instead, the RAW file is
+         * divided into square tiles of tileSize quads, which are read from disk on demand (normally
+         * from a background thread by a paged Terrain) and released again when no longer needed.
+         * This allows heightfields that are much larger than available memory to be used.
+         *
+         * The RAW file requirements and the minHeight, maxHeight and quantized parameters are the
+         * same as for createFromRAW. Quantized tiles take half the memory of float tiles.
+         *
+         * @param path Path to the RAW file (must end in a .raw or .r16 file extension).
+         * @param width Width of the RAW data.
+         * @param height Height of the RAW data.
+         * @param tileSize Size of each tile, in quads.
+         * @param heightMin Minimum height value for a zero intensity pixel.
+         * @param heightMax Maximum height value for a full intensity heightfield pixel (must be >= minHeight).
+         * @param quantized True to store the heights of loaded tiles as quantized 16-bit values rather than floats.
+         *
+         * @return The new HeightField.
+         * @script{ignore}
+         */
+        static HeightField* createTiled(const char* path, unsigned int width, unsigned int height, unsigned int tileSize, float heightMin = 0, float heightMax = 1, bool quantized = false);
 
         /**
          * Returns a pointer to the underlying height array.
@@ -78,10 +111,69 @@ namespace gameplay
          * The array is packed in row major order, meaning that the data is aligned in rows,
          * from top left to bottom right.
          *
+         * Tiled heightfields do not have a single height array, and quantized heightfields store
+         * their heights in the quantized array instead, so NULL is returned for both of them.
+         *
          * @return The underlying height array.
          */
         float* getArray() const;
 
+        /**
+         * Returns a pointer to the underlying quantized height array.
+         *
+         * The array is packed in the same order as the height array returned from getArray().
+         * A quantized value q represents the height getQuantizedMin() + q * getQuantizedStep().
+         *
+         * Tiled heightfields store quantized heights per tile, so NULL is returned for them.
+         *
+         * @return The underlying quantized height array, or NULL if the heightfield is not quantized.
+         * @script{ignore}
+         */
+        unsigned short* getQuantizedArray() const;
+
+        /**
+         * Determines if the heights of this heightfield are stored quantized to 16 bits.
+         *
+         * @return True if the heightfield is quantized, false otherwise.
+         */
+        bool isQuantized() const;
+
+        /**
+         * Converts the heights of this heightfield to quantized 16-bit storage.
+         *
+         * The quantized range is set to the minimum and maximum height currently stored in
+         * the heightfield. The floating point height array is released, so any pointer
+         * previously returned from getArray() becomes invalid.
+         *
+         * This method does nothing if the heightfield is already quantized or is tiled.
+         */
+        void quantize();
+
+        /**
+         * Returns the height represented by a quantized value of zero.
+         *
+         * @return The minimum quantized height, or zero if the heightfield is not quantized.
+         */
+        float getQuantizedMin() const;
+
+        /**
+         * Returns the height difference between two consecutive quantized values.
+         *
+         * The maximum error of any quantized height is half of this value.
+         *
+         * @return The quantized height step, or zero if the heightfield is not quantized.
+         */
+        float getQuantizedStep() const;
+
+        /**
+         * Returns the number of bytes used by the height data of this heightfield.
+         *
+         * For tiled heightfields, only the tiles that are currently loaded are included.
+         *
+         * @return The size of the height data, in bytes.
+         */
+        size_t getMemoryUsage() const;
+
         /**
          * Returns the height at the specified row and column.
          *
@@ -92,6 +184,8 @@ namespace gameplay
          * If the specified point lies outside the heightfield, it is clamped to the boundary
          * of the heightfield.
          *
+         * For tiled heightfields, zero is returned if the tile containing the point is not loaded.
+         *
          * @param column The column of the height value to query.
          * @param row The row of the height value to query.
          *
@@ -99,6 +193,20 @@ namespace gameplay
          */
         float getHeight(float column, float row) const;
 
+        /**
+         * Returns the heights at many points at once.
+         *
+         * This produces the same results as calling getHeight for each point, but is
+         * considerably faster for large numbers of points, since the interpolation is
+         * performed for several points at a time.
+         *
+         * @param points Array of (column, row) points to query.
+         * @param heights Array that receives the height of each point.
+         * @param count The number of points.
+         * @script{ignore}
+         */
+        void getHeights(const Vector2* points, float* heights, size_t count) const;
+
         /**
          * Returns the number of rows in the heightfield.
          *
@@ -113,8 +221,49 @@ namespace gameplay
          */
         unsigned int getColumnCount() const;
 
+        /**
+         * Determines if this heightfield is tiled.
+         *
+         * @return True if the height data is paged in as tiles, false if it is stored in a single array.
+         */
+        bool isTiled() const;
+
+        /**
+         * Returns the size of the tiles in a tiled heightfield, in quads.
+         *
+         * @return The tile size, or zero if the heightfield is not tiled.
+         */
+        unsigned int getTileSize() const;
+
+        /**
+         * Determines if the specified tile is currently loaded.
+         *
+         * @param row The tile row.
+         * @param column The tile column.
+         *
+         * @return True if the tile is loaded, false otherwise.
+         */
+        bool isTileLoaded(unsigned int row, unsigned int column) const;
+
     private:
 
+        friend class TerrainPager;
+
+        /**
+         * Height data for a single tile of a tiled heightfield.
+         */
+        struct Tile
+        {
+            Tile();
+
+            float* heights;
+            unsigned short* quantized;
+            unsigned int x;
+            unsigned int z;
+            unsigned int width;
+            unsigned int height;
+        };
+
         /**
          * Hidden constructor.
          */
@@ -128,11 +277,44 @@ namespace gameplay
         /**
          * Internal method for creating a HeightField.
          */
-        static HeightField* create(const char* path, unsigned int width, unsigned int height, float heightMin, float heightMax);
+        static HeightField* create(const char* path, unsigned int width, unsigned int height, float heightMin, float heightMax, bool quantized);
+
+        /**
+         * Internal method for creating a quantized HeightField, with uninitialized height data.
+         */
+        static HeightField* createQuantized(unsigned int columns, unsigned int rows, float heightMin, float heightMax);
+
+        /**
+         * Reads the heights for the specified tile from disk.
+         *
+         * The tile is extended by border samples on each side (clamped to the heightfield),
+         * so that neighboring heights can be sampled without accessing other tiles. This
+         * method does not modify the heightfield and may be called from any thread.
+         */
+        bool readTile(unsigned int row, unsigned int column, unsigned int border, Tile* tile) const;
+
+        /**
+         * Stores a tile previously read with readTile, taking ownership of its height data.
+         */
+        void setTile(unsigned int row, unsigned int column, const Tile& tile);
+
+        /**
+         * Releases the height data for the specified tile.
+         */
+        void releaseTile(unsigned int row, unsigned int column);
 
         float* _array;
+        unsigned short* _quantized;
         unsigned int _cols;
         unsigned int _rows;
+        std::string _path;
+        unsigned int _bits;
+        float _heightMin;
+        float _heightMax;
+        unsigned int _tileSize;
+        unsigned int _tileCols;
+        bool _quantizedTiles;
+        std::vector<Tile> _tiles;
     };
 
 }
@@ -1,18 +1,28 @@
 #include "Base.h"
 #include "ImageControl.h"
+#include "FileSystem.h"
+
+// Images up to this size are packed into a texture atlas shared by all image controls
+#define IMAGE_ATLAS_MAX_IMAGE_SIZE 256
+
+// Width and height of the pages of the shared image atlas
+#define IMAGE_ATLAS_PAGE_SIZE 1024
 
 namespace gameplay
 {
 
+static TextureAtlas* __imageAtlas = NULL;
+
 ImageControl::ImageControl() :
-    _srcRegion(Rectangle::empty()), _dstRegion(Rectangle::empty()), _batch(NULL),
-    _tw(0.0f), _th(0.0f), _uvs(Theme::UVs::full())
+    _srcRegion(Rectangle::empty()), _dstRegion(Rectangle::empty()), _batch(NULL), _atlas(NULL),
+    _imageRegion(Rectangle::empty()), _tw(0.0f), _th(0.0f), _uvs(Theme::UVs::full())
 {
 }
 
 ImageControl::~ImageControl()
 {
     SAFE_DELETE(_batch);
+    releaseAtlas();
 }
 
 ImageControl* ImageControl::create(const char* id, Theme::Style* style)
@@ -60,25 +70,88 @@ void ImageControl::initialize(const char* typeName, Theme::Style* style, Propert
 
 void ImageControl::setImage(const char* path)
 {
+    GP_ASSERT(path);
+
     SAFE_DELETE(_batch);
-    Texture* texture = Texture::create(path);
+    releaseAtlas();
+
+    // Pack small images into a texture shared by all image controls, so that
+    // forms can draw them in the same batch.
+    Texture* texture = NULL;
+    if (FileSystem::getExtension(path) == ".PNG")
+    {
+        if (__imageAtlas == NULL)
+            __imageAtlas = TextureAtlas::create(IMAGE_ATLAS_PAGE_SIZE, IMAGE_ATLAS_PAGE_SIZE);
+        else
+            __imageAtlas->addRef();
+        _atlas = __imageAtlas;
+
+        const TextureAtlas::Region* region = _atlas->find(path);
+        if (region == NULL)
+        {
+            Image* image = Image::create(path);
+            if (image && image->getWidth() <= IMAGE_ATLAS_MAX_IMAGE_SIZE && image->getHeight() <= IMAGE_ATLAS_MAX_IMAGE_SIZE)
+                region = _atlas->add(path, image);
+            SAFE_RELEASE(image);
+        }
+
+        if (region)
+        {
+            texture = _atlas->getTexture(region->page);
+            texture->addRef();
+            _imageRegion.set(region->x, region->y, region->width, region->height);
+        }
+        else
+        {
+            releaseAtlas();
+        }
+    }
+
+    if (texture == NULL)
+    {
+        texture = Texture::create(path);
+        if (texture == NULL)
+        {
+            GP_WARN("Failed to load image '%s' for image control '%s'.", path, _id.c_str());
+            return;
+        }
+        _imageRegion.set(0, 0, texture->getWidth(), texture->getHeight());
+    }
+
     _batch = SpriteBatch::create(texture);
     _tw = 1.0f / texture->getWidth();
     _th = 1.0f / texture->getHeight();
     texture->release();
 
+    // Map the source region, or the whole image if none is set, onto the region of the new image.
+    const Rectangle srcRegion = _srcRegion;
+    setRegionSrc(srcRegion.isEmpty() ? Rectangle(_imageRegion.width, _imageRegion.height) : srcRegion);
+    _srcRegion = srcRegion;
+
     if (_autoSize != AUTO_SIZE_NONE)
         setDirty(DIRTY_BOUNDS);
 }
 
+void ImageControl::releaseAtlas()
+{
+    if (_atlas)
+    {
+        if (_atlas->getRefCount() == 1)
+            __imageAtlas = NULL;
+        SAFE_RELEASE(_atlas);
+    }
+}
+
 void ImageControl::setRegionSrc(float x, float y, float width, float height)
 {
     _srcRegion.set(x, y, width, height);
 
-    _uvs.u1 = x * _tw;
-    _uvs.u2 = (x + width) * _tw;
-    _uvs.v1 = 1.0f - (y * _th);
-    _uvs.v2 = 1.0f - ((y + height) * _th);
+    // Rows of the texture run bottom up, so the top of the image is at its highest row.
+    const float top = _imageRegion.y + _imageRegion.height;
+    _uvs.u1 = (_imageRegion.x + x) * _tw;
+    _uvs.u2 = (_imageRegion.x + x + width) * _tw;
+    _uvs.v1 = (top - y) * _th;
+    _uvs.v2 = (top - y - height) * _th;
 }
 
 void ImageControl::setRegionSrc(const Rectangle& region)
@@ -144,12 +217,12 @@ void ImageControl::updateBounds()
     {
         if (_autoSize & AUTO_SIZE_WIDTH)
         {
-            setWidthInternal(_batch->getSampler()->getTexture()->getWidth());
+            setWidthInternal(_imageRegion.width);
         }
 
         if (_autoSize & AUTO_SIZE_HEIGHT)
         {
-            setHeightInternal(_batch->getSampler()->getTexture()->getWidth());
+            setHeightInternal(_imageRegion.height);
         }
     }
 
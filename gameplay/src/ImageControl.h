@@ -4,6 +4,7 @@
 #include "Control.h"
 #include "Theme.h"
 #include "Image.h"
+#include "TextureAtlas.h"
 #include "SpriteBatch.h"
 #include "Rectangle.h"
 
@@ -130,11 +131,17 @@ private:
 
     ImageControl(const ImageControl& copy);
 
+    void releaseAtlas();
+
     // Source region.
     Rectangle _srcRegion;
     // Destination region.
     Rectangle _dstRegion;
     SpriteBatch* _batch;
+    // Atlas shared by image controls that the image was packed into, if any.
+    TextureAtlas* _atlas;
+    // Region of the texture occupied by the image, in pixels.
+    Rectangle _imageRegion;
 
     // One over texture width and height, for use when calculating UVs from a new source region.
     float _tw;
@@ -224,6 +224,7 @@ bool JoystickControl::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned i
                     notifyListeners(Control::Listener::VALUE_CHANGED);
                 }
 
+                setDirty(DIRTY_STATE);
                 return true;
             }
             break;
@@ -258,6 +259,7 @@ bool JoystickControl::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned i
                     notifyListeners(Control::Listener::VALUE_CHANGED);
                 }
 
+                setDirty(DIRTY_STATE);
                 return true;
             }
             break;
@@ -278,6 +280,7 @@ bool JoystickControl::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned i
                     notifyListeners(Control::Listener::VALUE_CHANGED);
                 }
 
+                setDirty(DIRTY_STATE);
                 return true;
             }
             break;
@@ -4,7 +4,16 @@
 namespace gameplay
 {
 
-Label::Label() : _text(""), _font(NULL)
+Label::TextLayout::TextLayout() : text(NULL), font(NULL), fontSize(0), justify(Font::ALIGN_TOP_LEFT), rightToLeft(false)
+{
+}
+
+Label::TextLayout::~TextLayout()
+{
+    SAFE_DELETE(text);
+}
+
+Label::Label() : _text(""), _font(NULL), _measuredFont(NULL), _measuredFontSize(0), _measuredWidth(0), _measuredHeight(0)
 {
 }
 
@@ -62,6 +71,8 @@ void Label::setText(const char* text)
         _text = text ? text : "";
         if (_autoSize != AUTO_SIZE_NONE)
             setDirty(DIRTY_BOUNDS);
+        else
+            setDirty(DIRTY_STATE);
     }
 }
 
@@ -95,8 +106,18 @@ void Label::updateBounds()
         // Measure bounds based only on normal state so that bounds updates are not always required on state changes.
         // This is a trade-off for functionality vs performance, but changing the size of UI controls on hover/focus/etc
         // is a pretty bad practice so we'll prioritize performance here.
-        unsigned int w, h;
-        _font->measureText(_text.c_str(), getFontSize(NORMAL), &w, &h);
+        // The measured size is cached, since bounds updates are frequent and the text rarely changes.
+        unsigned int fontSize = getFontSize(NORMAL);
+        if (_measuredFont != _font || _measuredFontSize != fontSize || _measuredText != _text)
+        {
+            _font->measureText(_text.c_str(), fontSize, &_measuredWidth, &_measuredHeight);
+            _measuredFont = _font;
+            _measuredFontSize = fontSize;
+            _measuredText = _text;
+        }
+
+        unsigned int w = _measuredWidth;
+        unsigned int h = _measuredHeight;
         if (_autoSize & AUTO_SIZE_WIDTH)
         {
             setWidthInternal(w + getBorder(NORMAL).left + getBorder(NORMAL).right + getPadding().left + getPadding().right);
@@ -125,7 +146,7 @@ unsigned int Label::drawText(Form* form, const Rectangle& clip)
 
         SpriteBatch* batch = _font->getSpriteBatch(fontSize);
         startBatch(form, batch);
-        _font->drawText(_text.c_str(), _textBounds, _textColor, fontSize, getTextAlignment(state), true, getTextRightToLeft(state), &_viewportClipBounds);
+        drawTextLayout(&_textLayout, _text.c_str(), fontSize, getTextAlignment(state), getTextRightToLeft(state));
         finishBatch(form, batch);
 
         return 1;
@@ -134,6 +155,34 @@ unsigned int Label::drawText(Form* form, const Rectangle& clip)
     return 0;
 }
 
+void Label::drawTextLayout(TextLayout* layout, const char* text, unsigned int fontSize, Font::Justify justify, bool rightToLeft)
+{
+    GP_ASSERT(layout);
+    GP_ASSERT(text);
+    GP_ASSERT(_font);
+
+    if (layout->text == NULL || layout->font != _font || layout->fontSize != fontSize || layout->justify != justify ||
+        layout->rightToLeft != rightToLeft || layout->bounds != _textBounds || layout->clip != _viewportClipBounds ||
+        !layout->text->isValid() || strcmp(layout->text->getText(), text) != 0)
+    {
+        SAFE_DELETE(layout->text);
+        layout->text = _font->createText(text, _textBounds, _textColor, fontSize, justify, true, rightToLeft, &_viewportClipBounds);
+        layout->font = _font;
+        layout->fontSize = fontSize;
+        layout->justify = justify;
+        layout->rightToLeft = rightToLeft;
+        layout->bounds = _textBounds;
+        layout->clip = _viewportClipBounds;
+    }
+    else
+    {
+        // Opacity changes are applied to the vertices without laying the text out again.
+        layout->text->setColor(_textColor);
+    }
+
+    _font->drawText(layout->text);
+}
+
 const char* Label::getType() const
 {
     return "label";
@@ -65,6 +65,68 @@ public:
 
 protected:
 
+    /**
+     * A string of text laid out for drawing, which is kept between frames and only
+     * laid out again when the text or the parameters it was laid out with change.
+     *
+     * @script{ignore}
+     */
+    class TextLayout
+    {
+    public:
+
+        /**
+         * Constructor.
+         */
+        TextLayout();
+
+        /**
+         * Destructor.
+         */
+        ~TextLayout();
+
+        /**
+         * The laid out text, or NULL if it has not been laid out.
+         */
+        Font::Text* text;
+
+        /**
+         * The font the text was laid out with.
+         */
+        Font* font;
+
+        /**
+         * The font size the text was laid out with.
+         */
+        unsigned int fontSize;
+
+        /**
+         * The alignment the text was laid out with.
+         */
+        Font::Justify justify;
+
+        /**
+         * Whether the text was laid out from right to left.
+         */
+        bool rightToLeft;
+
+        /**
+         * The text area the text was laid out within.
+         */
+        Rectangle bounds;
+
+        /**
+         * The clip region the text was laid out with.
+         */
+        Rectangle clip;
+
+    private:
+
+        TextLayout(const TextLayout&);
+
+        TextLayout& operator=(const TextLayout&);
+    };
+
     /**
      * Constructor.
      */
@@ -116,6 +178,21 @@ protected:
      */
     virtual unsigned int drawText(Form* form, const Rectangle& clip);
 
+    /**
+     * Draws text within this control's text area, using the current text color.
+     *
+     * The text is laid out again only if it, the font, the font size, the alignment or the
+     * text area have changed since it was last drawn with the given layout. The caller must
+     * have started the font's sprite batch.
+     *
+     * @param layout The layout to reuse for the text.
+     * @param text The text to draw.
+     * @param fontSize The font size to draw the text with.
+     * @param justify The alignment of the text within the text area.
+     * @param rightToLeft Whether to draw the text from right to left.
+     */
+    void drawTextLayout(TextLayout* layout, const char* text, unsigned int fontSize, Font::Justify justify, bool rightToLeft);
+
     /**
      * The text displayed by this label.
      */
@@ -136,6 +213,28 @@ protected:
      */
     Rectangle _textBounds;
 
+    /**
+     * The cached layout of this label's text.
+     */
+    TextLayout _textLayout;
+
+    /**
+     * The text that was last measured to size this label.
+     */
+    std::string _measuredText;
+
+    /**
+     * The font and font size the text was last measured with.
+     */
+    Font* _measuredFont;
+    unsigned int _measuredFontSize;
+
+    /**
+     * The last measured size of the text.
+     */
+    unsigned int _measuredWidth;
+    unsigned int _measuredHeight;
+
 private:
 
     /**
@@ -12,6 +12,7 @@ class MathUtil
 {
     friend class Matrix;
     friend class Vector3;
+    friend class HeightField;
 
 public:
 
@@ -66,6 +67,14 @@ private:
 
     inline static void crossVector3(const float* v1, const float* v2, float* dst);
 
+    /**
+     * Bilinearly interpolates four samples at once.
+     *
+     * The corner values are laid out as four consecutive groups of four: the top left,
+     * top right, bottom left and bottom right corners of each sample.
+     */
+    inline static void interpolateBilinear4(const float* corners, const float* fx, const float* fy, float* dst);
+
     MathUtil();
 };
 
@@ -172,6 +172,27 @@ inline void MathUtil::crossVector3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline void MathUtil::interpolateBilinear4(const float* corners, const float* fx, const float* fy, float* dst)
+{
+#ifdef USE_SSE
+    __m128 topLeft = _mm_loadu_ps(corners);
+    __m128 topRight = _mm_loadu_ps(corners + 4);
+    __m128 bottomLeft = _mm_loadu_ps(corners + 8);
+    __m128 bottomRight = _mm_loadu_ps(corners + 12);
+    __m128 x = _mm_loadu_ps(fx);
+    __m128 top = _mm_add_ps(topLeft, _mm_mul_ps(_mm_sub_ps(topRight, topLeft), x));
+    __m128 bottom = _mm_add_ps(bottomLeft, _mm_mul_ps(_mm_sub_ps(bottomRight, bottomLeft), x));
+    _mm_storeu_ps(dst, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_loadu_ps(fy))));
+#else
+    for (int i = 0; i < 4; ++i)
+    {
+        float top = corners[i] + (corners[i + 4] - corners[i]) * fx[i];
+        float bottom = corners[i + 8] + (corners[i + 12] - corners[i + 8]) * fx[i];
+        dst[i] = top + (bottom - top) * fy[i];
+    }
+#endif
+}
+
 }
 
 
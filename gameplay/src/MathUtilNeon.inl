@@ -226,4 +226,26 @@ inline void MathUtil::crossVector3(const float* v1, const float* v2, float* dst)
     );
 }
 
+inline void MathUtil::interpolateBilinear4(const float* corners, const float* fx, const float* fy, float* dst)
+{
+    asm volatile(
+        "vld1.32    {q0, q1}, [%1]!     \n\t" // C[top left, top right]
+        "vld1.32    {q2, q3}, [%1]      \n\t" // C[bottom left, bottom right]
+        "vld1.32    {q4}, [%2]          \n\t" // FX
+        "vld1.32    {q5}, [%3]          \n\t" // FY
+
+        "vsub.f32   q1, q1, q0          \n\t" // top right - top left
+        "vsub.f32   q3, q3, q2          \n\t" // bottom right - bottom left
+        "vmla.f32   q0, q1, q4          \n\t" // top = top left + (top right - top left) * fx
+        "vmla.f32   q2, q3, q4          \n\t" // bottom = bottom left + (bottom right - bottom left) * fx
+        "vsub.f32   q2, q2, q0          \n\t" // bottom - top
+        "vmla.f32   q0, q2, q5          \n\t" // DST = top + (bottom - top) * fy
+
+        "vst1.32    {q0}, [%0]          \n\t" // DST
+        :
+        : "r"(dst), "r"(corners), "r"(fx), "r"(fy)
+        : "q0", "q1", "q2", "q3", "q4", "q5", "memory"
+    );
+}
+
 }
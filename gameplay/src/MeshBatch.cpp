@@ -5,9 +5,60 @@
 namespace gameplay
 {
 
+/**
+ * Determines whether 32-bit indices can be drawn, which OpenGL ES 2 only supports through an extension.
+ */
+static bool isIndex32Supported()
+{
+#ifdef OPENGL_ES
+    static int supported = -1;
+    if (supported < 0)
+    {
+        const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+        supported = (extensions && strstr(extensions, "GL_OES_element_index_uint")) ? 1 : 0;
+    }
+    return supported == 1;
+#else
+    return true;
+#endif
+}
+
+/**
+ * Appends indices to the index array of a batch, offset to refer to the vertices added with them.
+ */
+template <class T>
+static void appendIndices(T* dst, const unsigned short* indices, unsigned int indexCount, unsigned int firstVertex, bool connectStrips)
+{
+    if (connectStrips)
+    {
+        // Create a degenerate triangle to connect separate triangle strips
+        // by duplicating the previous and next vertices.
+        dst[0] = dst[-1];
+        dst[1] = (T)firstVertex;
+        dst += 2;
+    }
+
+    for (unsigned int i = 0; i < indexCount; ++i)
+    {
+        dst[i] = (T)(indices[i] + firstVertex);
+    }
+}
+
+/**
+ * Copies indices between index arrays of possibly different formats.
+ */
+template <class S, class D>
+static void copyIndices(const S* src, D* dst, unsigned int indexCount)
+{
+    for (unsigned int i = 0; i < indexCount; ++i)
+    {
+        dst[i] = (D)src[i];
+    }
+}
+
 MeshBatch::MeshBatch(const VertexFormat& vertexFormat, Mesh::PrimitiveType primitiveType, Material* material, bool indexed, unsigned int initialCapacity, unsigned int growSize)
     : _vertexFormat(vertexFormat), _primitiveType(primitiveType), _material(material), _indexed(indexed), _capacity(0), _growSize(growSize),
-    _vertexCapacity(0), _indexCapacity(0), _vertexCount(0), _indexCount(0), _vertices(NULL), _verticesPtr(NULL), _indices(NULL), _indicesPtr(NULL), _started(false)
+    _vertexCapacity(0), _indexCapacity(0), _vertexCount(0), _indexCount(0), _vertices(NULL), _verticesPtr(NULL), _indices(NULL), _indexFormat(Mesh::INDEX16), _started(false)
 {
     resize(initialCapacity);
 }
@@ -16,7 +67,10 @@ MeshBatch::~MeshBatch()
 {
     SAFE_RELEASE(_material);
     SAFE_DELETE_ARRAY(_vertices);
-    SAFE_DELETE_ARRAY(_indices);
+    if (_indexFormat == Mesh::INDEX32)
+        delete[] static_cast<unsigned int*>(_indices);
+    else
+        delete[] static_cast<unsigned short*>(_indices);
 }
 
 MeshBatch* MeshBatch::create(const VertexFormat& vertexFormat, Mesh::PrimitiveType primitiveType, const char* materialPath, bool indexed, unsigned int initialCapacity, unsigned int growSize)
@@ -53,11 +107,23 @@ void MeshBatch::add(const void* vertices, size_t size, unsigned int vertexCount,
         newIndexCount += 2; // need an extra 2 indices for connecting strips with degenerate triangles
     
     // Do we need to grow the batch?
-    while (newVertexCount > _vertexCapacity || (_indexed && newIndexCount > _indexCapacity))
+    if (newVertexCount > _vertexCapacity || (_indexed && newIndexCount > _indexCapacity))
     {
         if (_growSize == 0)
             return; // growing disabled, just clip batch
-        if (!resize(_capacity + _growSize))
+
+        // Grow geometrically, so that the batch is only copied a few times while it fills up.
+        unsigned int capacity = _capacity;
+        unsigned int vertexCapacity;
+        do
+        {
+            capacity = std::max(capacity + _growSize, capacity * 2);
+            vertexCapacity = getVertexCapacity(capacity);
+            if (vertexCapacity == 0)
+                return; // unsupported primitive type
+        } while (newVertexCount > vertexCapacity || (_indexed && newIndexCount > vertexCapacity));
+
+        if (!resize(capacity))
             return; // failed to grow
     }
     
@@ -70,32 +136,15 @@ void MeshBatch::add(const void* vertices, size_t size, unsigned int vertexCount,
     if (_indexed)
     {
         GP_ASSERT(indices);
-        GP_ASSERT(_indicesPtr);
+        GP_ASSERT(_indices);
 
-        if (_vertexCount == 0)
-        {
-            // Simply copy values directly into the start of the index array.
-            memcpy(_indicesPtr, indices, indexCount * sizeof(unsigned short));
-        }
+        // Insert the indices with their values offset by 'vertexCount', so that they
+        // are relative to the first newly inserted vertex.
+        const bool connectStrips = _primitiveType == Mesh::TRIANGLE_STRIP && _vertexCount > 0;
+        if (_indexFormat == Mesh::INDEX32)
+            appendIndices(static_cast<unsigned int*>(_indices) + _indexCount, indices, indexCount, _vertexCount, connectStrips);
         else
-        {
-            if (_primitiveType == Mesh::TRIANGLE_STRIP)
-            {
-                // Create a degenerate triangle to connect separate triangle strips
-                // by duplicating the previous and next vertices.
-                _indicesPtr[0] = *(_indicesPtr-1);
-                _indicesPtr[1] = _vertexCount;
-                _indicesPtr += 2;
-            }
-            
-            // Loop through all indices and insert them, with their values offset by
-            // 'vertexCount' so that they are relative to the first newly inserted vertex.
-            for (unsigned int i = 0; i < indexCount; ++i)
-            {
-                _indicesPtr[i] = indices[i] + _vertexCount;
-            }
-        }
-        _indicesPtr += indexCount;
+            appendIndices(static_cast<unsigned short*>(_indices) + _indexCount, indices, indexCount, _vertexCount, connectStrips);
         _indexCount = newIndexCount;
     }
     
@@ -133,6 +182,30 @@ void MeshBatch::setCapacity(unsigned int capacity)
     resize(capacity);
 }
 
+Mesh::IndexFormat MeshBatch::getIndexFormat() const
+{
+    return _indexFormat;
+}
+
+unsigned int MeshBatch::getVertexCapacity(unsigned int capacity) const
+{
+    switch (_primitiveType)
+    {
+    case Mesh::LINES:
+        return capacity * 2;
+    case Mesh::LINE_STRIP:
+        return capacity + 1;
+    case Mesh::POINTS:
+        return capacity;
+    case Mesh::TRIANGLES:
+        return capacity * 3;
+    case Mesh::TRIANGLE_STRIP:
+        return capacity + 2;
+    default:
+        return 0;
+    }
+}
+
 bool MeshBatch::resize(unsigned int capacity)
 {
     if (capacity == 0)
@@ -146,27 +219,12 @@ bool MeshBatch::resize(unsigned int capacity)
 
     // Store old batch data.
     unsigned char* oldVertices = _vertices;
-    unsigned short* oldIndices = _indices;
+    void* oldIndices = _indices;
+    Mesh::IndexFormat oldIndexFormat = _indexFormat;
 
-    unsigned int vertexCapacity = 0;
-    switch (_primitiveType)
+    unsigned int vertexCapacity = getVertexCapacity(capacity);
+    if (vertexCapacity == 0)
     {
-    case Mesh::LINES:
-        vertexCapacity = capacity * 2;
-        break;
-    case Mesh::LINE_STRIP:
-        vertexCapacity = capacity + 1;
-        break;
-    case Mesh::POINTS:
-        vertexCapacity = capacity;
-        break;
-    case Mesh::TRIANGLES:
-        vertexCapacity = capacity * 3;
-        break;
-    case Mesh::TRIANGLE_STRIP:
-        vertexCapacity = capacity + 2;
-        break;
-    default:
         GP_ERROR("Unsupported primitive type for mesh batch (%d).", _primitiveType);
         return false;
     }
@@ -175,10 +233,16 @@ bool MeshBatch::resize(unsigned int capacity)
     // (we only know how many indices will be stored). Assume the worst case
     // for now, which is the same number of vertices as indices.
     unsigned int indexCapacity = vertexCapacity;
+    Mesh::IndexFormat indexFormat = Mesh::INDEX16;
     if (_indexed && indexCapacity > USHRT_MAX)
     {
-        GP_ERROR("Index capacity is greater than the maximum unsigned short value (%d > %d).", indexCapacity, USHRT_MAX);
-        return false;
+        // Switch to 32-bit indices when the vertices can no longer be addressed with 16 bits.
+        if (!isIndex32Supported())
+        {
+            GP_ERROR("Index capacity is greater than the maximum unsigned short value (%d > %d) and 32-bit indices are not supported.", indexCapacity, USHRT_MAX);
+            return false;
+        }
+        indexFormat = Mesh::INDEX32;
     }
 
     // Allocate new data and reset pointers.
@@ -189,13 +253,18 @@ bool MeshBatch::resize(unsigned int capacity)
         voffset = vBytes - 1;
     _verticesPtr = _vertices + voffset;
 
+    if (_vertexCount > vertexCapacity)
+        _vertexCount = vertexCapacity;
+
     if (_indexed)
     {
-        unsigned int ioffset = _indicesPtr - _indices;
-        _indices = new unsigned short[indexCapacity];
-        if (ioffset >= indexCapacity)
-            ioffset = indexCapacity - 1;
-        _indicesPtr = _indices + ioffset;
+        if (indexFormat == Mesh::INDEX32)
+            _indices = new unsigned int[indexCapacity];
+        else
+            _indices = new unsigned short[indexCapacity];
+        _indexFormat = indexFormat;
+        if (_indexCount > indexCapacity)
+            _indexCount = indexCapacity;
     }
 
     // Copy old data back in
@@ -203,8 +272,28 @@ bool MeshBatch::resize(unsigned int capacity)
         memcpy(_vertices, oldVertices, std::min(_vertexCapacity, vertexCapacity) * _vertexFormat.getVertexSize());
     SAFE_DELETE_ARRAY(oldVertices);
     if (oldIndices)
-        memcpy(_indices, oldIndices, std::min(_indexCapacity, indexCapacity) * sizeof(unsigned short));
-    SAFE_DELETE_ARRAY(oldIndices);
+    {
+        // Only the indices added so far need to be kept, converting them if the format changed.
+        const unsigned int indexCount = _indexCount;
+        if (oldIndexFormat == Mesh::INDEX32)
+        {
+            unsigned int* src = static_cast<unsigned int*>(oldIndices);
+            if (indexFormat == Mesh::INDEX32)
+                copyIndices(src, static_cast<unsigned int*>(_indices), indexCount);
+            else
+                copyIndices(src, static_cast<unsigned short*>(_indices), indexCount);
+            delete[] src;
+        }
+        else
+        {
+            unsigned short* src = static_cast<unsigned short*>(oldIndices);
+            if (indexFormat == Mesh::INDEX32)
+                copyIndices(src, static_cast<unsigned int*>(_indices), indexCount);
+            else
+                copyIndices(src, static_cast<unsigned short*>(_indices), indexCount);
+            delete[] src;
+        }
+    }
 
     // Assign new capacities
     _capacity = capacity;
@@ -227,7 +316,6 @@ void MeshBatch::start()
     _vertexCount = 0;
     _indexCount = 0;
     _verticesPtr = _vertices;
-    _indicesPtr = _indices;
     _started = true;
 }
 
@@ -266,7 +354,7 @@ void MeshBatch::draw()
 
         if (_indexed)
         {
-            GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, (GLvoid*)_indices) );
+            GL_ASSERT( glDrawElements(_primitiveType, _indexCount, _indexFormat, (GLvoid*)_indices) );
         }
         else
         {
@@ -23,7 +23,8 @@ public:
      * @param materialPath Path to a material file to be used for drawing the batch.
      * @param indexed True if the batched primitives will contain index data, false otherwise.
      * @param initialCapacity The initial capacity of the batch, in triangles.
-     * @param growSize Amount to grow the batch by when it overflows (a value of zero prevents batch growing).
+     * @param growSize Minimum amount to grow the batch by when it overflows. The capacity of the batch is at least
+     *      doubled each time it grows (a value of zero prevents batch growing).
      *
      * @return A new mesh batch.
      * @script{create}
@@ -38,7 +39,8 @@ public:
      * @param material Material to be used for drawing the batch.
      * @param indexed True if the batched primitives will contain index data, false otherwise.
      * @param initialCapacity The initial capacity of the batch, in triangles.
-     * @param growSize Amount to grow the batch by when it overflows (a value of zero prevents batch growing).
+     * @param growSize Minimum amount to grow the batch by when it overflows. The capacity of the batch is at least
+     *      doubled each time it grows (a value of zero prevents batch growing).
      *
      * @return A new mesh batch.
      * @script{create}
@@ -64,6 +66,17 @@ public:
      */
     void setCapacity(unsigned int capacity);
 
+    /**
+     * Returns the format of the indices stored in the batch.
+     *
+     * Indices are stored in 16 bits while the batch can hold up to 65536 vertices. Larger
+     * batches store them in 32 bits, if the graphics device supports drawing 32-bit indices
+     * (OpenGL ES 2 requires the GL_OES_element_index_uint extension).
+     *
+     * @return The index format.
+     */
+    Mesh::IndexFormat getIndexFormat() const;
+
     /**
      * Returns the material for this mesh batch.
      *
@@ -164,6 +177,8 @@ private:
 
     bool resize(unsigned int capacity);
 
+    unsigned int getVertexCapacity(unsigned int capacity) const;
+
     const VertexFormat _vertexFormat;
     Mesh::PrimitiveType _primitiveType;
     Material* _material;
@@ -176,8 +191,8 @@ private:
     unsigned int _indexCount;
     unsigned char* _vertices;
     unsigned char* _verticesPtr;
-    unsigned short* _indices;
-    unsigned short* _indicesPtr;
+    void* _indices;
+    Mesh::IndexFormat _indexFormat;
     bool _started;
 
 };
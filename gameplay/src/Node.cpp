@@ -79,7 +79,18 @@ void Node::setId(const char* id)
 {
     if (id)
     {
-        _id = id;
+        if (_agent)
+        {
+            // The AIController indexes agents by the ID string of their node.
+            AIController* aiController = Game::getInstance()->getAIController();
+            aiController->unindexAgent(_agent);
+            _id = id;
+            aiController->indexAgent(_agent);
+        }
+        else
+        {
+            _id = id;
+        }
     }
 }
 
@@ -24,6 +24,7 @@ namespace gameplay
 class PhysicsCharacter : public PhysicsGhostObject
 {
     friend class Node;
+    friend class PhysicsController;
 
 public:
 
@@ -231,7 +231,8 @@ bool PhysicsCollisionObject::CollisionPair::operator < (const CollisionPair& col
 }
 
 PhysicsCollisionObject::PhysicsMotionState::PhysicsMotionState(Node* node, PhysicsCollisionObject* collisionObject, const Vector3* centerOfMassOffset) :
-    _node(node), _collisionObject(collisionObject), _centerOfMassOffset(btTransform::getIdentity())
+    _node(node), _collisionObject(collisionObject), _centerOfMassOffset(btTransform::getIdentity()),
+    _previousTransform(btTransform::getIdentity()), _currentTransform(btTransform::getIdentity()), _step(0), _interpolated(false)
 {
     if (centerOfMassOffset)
     {
@@ -244,6 +245,15 @@ PhysicsCollisionObject::PhysicsMotionState::PhysicsMotionState(Node* node, Physi
 
 PhysicsCollisionObject::PhysicsMotionState::~PhysicsMotionState()
 {
+    if (_interpolated)
+    {
+        PhysicsController* controller = Game::getInstance()->getPhysicsController();
+        GP_ASSERT(controller);
+        std::vector<PhysicsMotionState*>& motionStates = controller->_motionStates;
+        std::vector<PhysicsMotionState*>::iterator itr = std::find(motionStates.begin(), motionStates.end(), this);
+        if (itr != motionStates.end())
+            motionStates.erase(itr);
+    }
 }
 
 void PhysicsCollisionObject::PhysicsMotionState::getWorldTransform(btTransform &transform) const
@@ -261,10 +271,54 @@ void PhysicsCollisionObject::PhysicsMotionState::setWorldTransform(const btTrans
 {
     GP_ASSERT(_node);
 
+    PhysicsController* controller = Game::getInstance()->getPhysicsController();
+    GP_ASSERT(controller);
+    if (controller->_fixedTimeStep > 0.0f)
+    {
+        // Bullet passes an extrapolated transform here, so track the body's simulated
+        // transform instead and let the controller interpolate the node after stepping.
+        GP_ASSERT(_collisionObject && _collisionObject->getCollisionObject());
+        if (_interpolated)
+        {
+            _previousTransform = _currentTransform;
+        }
+        else
+        {
+            // Start from the transform the node currently has.
+            _previousTransform = _worldTransform * _centerOfMassOffset.inverse();
+            controller->_motionStates.push_back(this);
+            _interpolated = true;
+        }
+        _currentTransform = _collisionObject->getCollisionObject()->getWorldTransform();
+        _step = controller->_stepCount;
+        _worldTransform = _currentTransform * _centerOfMassOffset;
+        return;
+    }
+
     _worldTransform = transform * _centerOfMassOffset;
-        
-    const btQuaternion& rot = _worldTransform.getRotation();
-    const btVector3& pos = _worldTransform.getOrigin();
+    applyTransform(_worldTransform);
+}
+
+void PhysicsCollisionObject::PhysicsMotionState::interpolate(float alpha)
+{
+    GP_ASSERT(_interpolated);
+
+    if (alpha >= 1.0f)
+    {
+        applyTransform(_worldTransform);
+        return;
+    }
+
+    btTransform transform;
+    transform.setOrigin(_previousTransform.getOrigin().lerp(_currentTransform.getOrigin(), alpha));
+    transform.setRotation(_previousTransform.getRotation().slerp(_currentTransform.getRotation(), alpha));
+    applyTransform(transform * _centerOfMassOffset);
+}
+
+void PhysicsCollisionObject::PhysicsMotionState::applyTransform(const btTransform& transform)
+{
+    const btQuaternion& rot = transform.getRotation();
+    const btVector3& pos = transform.getOrigin();
 
     _node->setRotation(rot.x(), rot.y(), rot.z(), rot.w());
     _node->setTranslation(pos.x(), pos.y(), pos.z());
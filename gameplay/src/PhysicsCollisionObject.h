@@ -371,6 +371,7 @@ private:
     class PhysicsMotionState : public btMotionState
     {
         friend class PhysicsConstraint;
+        friend class PhysicsController;
         
     public:
         
@@ -395,6 +396,10 @@ private:
         
         /**
          * @see btMotionState::setWorldTransform
+         *
+         * When the physics controller uses a fixed time step, the node transform is not
+         * updated here. The simulated transform is recorded instead, and the physics
+         * controller interpolates the node transform once all steps for the frame are done.
          */
         virtual void setWorldTransform(const btTransform &transform);
         
@@ -407,13 +412,30 @@ private:
          * Sets the center of mass offset for the associated collision shape.
          */
         void setCenterOfMassOffset(const Vector3& centerOfMassOffset);
+
+        /**
+         * Sets the node transform to an interpolation between the two most recently
+         * simulated transforms.
+         *
+         * @param alpha The interpolation factor, between 0 (previous) and 1 (current).
+         */
+        void interpolate(float alpha);
         
     private:
+
+        /**
+         * Sets the node rotation and translation from the given center of mass transform.
+         */
+        void applyTransform(const btTransform& transform);
         
         Node* _node;
         PhysicsCollisionObject* _collisionObject;
         btTransform _centerOfMassOffset;
         mutable btTransform _worldTransform;
+        btTransform _previousTransform;
+        btTransform _currentTransform;
+        unsigned int _step;
+        bool _interpolated;
     };
 
     /** 
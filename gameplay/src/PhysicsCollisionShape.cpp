@@ -26,6 +26,8 @@ PhysicsCollisionShape::~PhysicsCollisionShape()
             if (_shapeData.meshData)
             {
                 SAFE_DELETE_ARRAY(_shapeData.meshData->vertexData);
+                if (_shapeData.meshData->bvhData)
+                    btAlignedFree(_shapeData.meshData->bvhData);
                 for (unsigned int i = 0; i < _shapeData.meshData->indexData.size(); i++)
                 {
                     SAFE_DELETE_ARRAY(_shapeData.meshData->indexData[i]);
@@ -41,6 +43,7 @@ PhysicsCollisionShape::~PhysicsCollisionShape()
             if (_shapeData.heightfieldData)
             {
                 SAFE_RELEASE(_shapeData.heightfieldData->heightfield);
+                SAFE_DELETE_ARRAY(_shapeData.heightfieldData->heights);
                 SAFE_DELETE(_shapeData.heightfieldData);
             }
             break;
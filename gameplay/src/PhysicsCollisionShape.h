@@ -241,11 +241,13 @@ private:
     {
         float* vertexData;
         std::vector<unsigned char*> indexData;
+        unsigned char* bvhData;
     };
 
     struct HeightfieldData
     {
         HeightField* heightfield;
+        float* heights;
         bool inverseIsDirty;
         Matrix inverse;
         float minHeight;
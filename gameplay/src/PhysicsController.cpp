@@ -2,16 +2,22 @@
 #include "PhysicsController.h"
 #include "PhysicsRigidBody.h"
 #include "PhysicsCharacter.h"
+#include "PhysicsVehicle.h"
 #include "Game.h"
 #include "MeshPart.h"
 #include "Bundle.h"
 #include "Terrain.h"
+#include "ThreadPool.h"
 
 #ifdef GP_USE_MEM_LEAK_DETECTION
 #undef new
 #endif
 #include "BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h"
 #include "BulletCollision/CollisionShapes/btShapeHull.h"
+#include "BulletCollision/CollisionDispatch/btConvexConvexAlgorithm.h"
+#include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h"
 #ifdef GP_USE_MEM_LEAK_DETECTION
 #define new DEBUG_NEW
 #endif
@@ -19,29 +25,594 @@
 // The initial capacity of the Bullet debug drawer's vertex batch.
 #define INITIAL_CAPACITY 280
 
+// The minimum number of overlapping pairs for which contacts are computed in parallel.
+#define PARALLEL_DISPATCH_MIN_PAIRS 64
+
+// The number of overlapping pairs processed by a thread at a time.
+#define PARALLEL_DISPATCH_GRAIN_SIZE 16
+
+// The number of ray or sweep tests of a batch processed by a thread at a time.
+#define QUERY_BATCH_GRAIN_SIZE 32
+
+// The initial size of the stack used to traverse the broadphase tree during a query.
+#define QUERY_STACK_SIZE 128
+
+// The default world bounds and maximum number of objects for the axis sweep broadphase.
+#define DEFAULT_WORLD_EXTENT 1000.0f
+#define DEFAULT_MAX_PROXIES 16384
+
+// The default maximum number of simulation steps performed in a single frame.
+#define DEFAULT_MAX_SUB_STEPS 10
+
+// The deactivation distance used when it is not larger than the activation distance, relative to the activation distance.
+#define DEFAULT_DEACTIVATION_SCALE 1.25f
+
+// The identifier and version written at the start of shape cache files.
+static const char SHAPE_CACHE_IDENTIFIER[] = { 'G', 'P', 'S', 'C' };
+#define SHAPE_CACHE_VERSION 1
+
+// The identifier and version written at the start of snapshots.
+static const char SNAPSHOT_IDENTIFIER[] = { 'G', 'P', 'P', 'S' };
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HEADER_SIZE 20
+
+// The kinds of object records in a snapshot.
+#define SNAPSHOT_NONE 0
+#define SNAPSHOT_RIGID_BODY 1
+#define SNAPSHOT_CHARACTER 2
+#define SNAPSHOT_VEHICLE 3
+
 namespace gameplay
 {
 
-const int PhysicsController::DIRTY         = 0x01;
+#ifdef GP_USE_MEM_LEAK_DETECTION
+#undef new
+#endif
+
+/**
+ * Convex collision algorithm that owns its simplex solver.
+ *
+ * Bullet's default convex algorithms share a single simplex solver, which
+ * prevents contacts from being computed on several threads at once.
+ *
+ * @script{ignore}
+ */
+class ParallelConvexConvexAlgorithm : public btConvexConvexAlgorithm
+{
+public:
+
+    ParallelConvexConvexAlgorithm(btPersistentManifold* manifold, const btCollisionAlgorithmConstructionInfo& ci,
+                                  const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap,
+                                  btConvexPenetrationDepthSolver* pdSolver)
+        // The base class only stores the solver pointer, so it may refer to the member constructed after it.
+        : btConvexConvexAlgorithm(manifold, ci, body0Wrap, body1Wrap, &_simplexSolver, pdSolver, 0, 3)
+    {
+    }
+
+    /**
+     * Creates ParallelConvexConvexAlgorithm instances.
+     */
+    struct CreateFunc : public btCollisionAlgorithmCreateFunc
+    {
+        btCollisionAlgorithm* CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci,
+                                                       const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap)
+        {
+            void* mem = ci.m_dispatcher1->allocateCollisionAlgorithm(sizeof(ParallelConvexConvexAlgorithm));
+            return new(mem) ParallelConvexConvexAlgorithm(ci.m_manifold, ci, body0Wrap, body1Wrap, &pdSolver);
+        }
+
+        btGjkEpaPenetrationDepthSolver pdSolver;
+    };
+
+private:
+
+    btVoronoiSimplexSolver _simplexSolver;
+};
+
+#ifdef GP_USE_MEM_LEAK_DETECTION
+#define new DEBUG_NEW
+#endif
+
+/**
+ * Collision dispatcher that computes the contacts of overlapping pairs on several threads.
+ *
+ * Each pair is processed by a single thread, while the dispatcher state shared
+ * between pairs (the manifold and algorithm pools) is guarded by a mutex.
+ *
+ * @script{ignore}
+ */
+class ParallelCollisionDispatcher : public btCollisionDispatcher
+{
+public:
+
+    ParallelCollisionDispatcher(btCollisionConfiguration* configuration, ThreadPool* threadPool)
+        : btCollisionDispatcher(configuration), _threadPool(threadPool), _pairs(NULL), _dispatchInfo(NULL)
+    {
+        GP_ASSERT(_threadPool);
+
+        // Replace the shared-state convex algorithm wherever the configuration uses it.
+        btCollisionAlgorithmCreateFunc* convexCreateFunc = configuration->getCollisionAlgorithmCreateFunc(CONVEX_HULL_SHAPE_PROXYTYPE, CONVEX_HULL_SHAPE_PROXYTYPE);
+        for (int i = 0; i < MAX_BROADPHASE_COLLISION_TYPES; ++i)
+        {
+            for (int j = 0; j < MAX_BROADPHASE_COLLISION_TYPES; ++j)
+            {
+                if (configuration->getCollisionAlgorithmCreateFunc(i, j) == convexCreateFunc)
+                    registerCollisionCreateFunc(i, j, &_convexCreateFunc);
+            }
+        }
+    }
+
+    btPersistentManifold* getNewManifold(const btCollisionObject* b0, const btCollisionObject* b1)
+    {
+        _mutex.lock();
+        btPersistentManifold* manifold = btCollisionDispatcher::getNewManifold(b0, b1);
+        _mutex.unlock();
+        return manifold;
+    }
+
+    void releaseManifold(btPersistentManifold* manifold)
+    {
+        _mutex.lock();
+        btCollisionDispatcher::releaseManifold(manifold);
+        _mutex.unlock();
+    }
+
+    void* allocateCollisionAlgorithm(int size)
+    {
+        _mutex.lock();
+        void* mem = btCollisionDispatcher::allocateCollisionAlgorithm(size);
+        _mutex.unlock();
+        return mem;
+    }
+
+    void freeCollisionAlgorithm(void* ptr)
+    {
+        _mutex.lock();
+        btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+        _mutex.unlock();
+    }
+
+    void dispatchAllCollisionPairs(btOverlappingPairCache* pairCache, const btDispatcherInfo& dispatchInfo, btDispatcher* dispatcher)
+    {
+        GP_ASSERT(pairCache);
+
+        unsigned int count = (unsigned int)pairCache->getNumOverlappingPairs();
+        if (count < PARALLEL_DISPATCH_MIN_PAIRS)
+        {
+            btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+            return;
+        }
+
+        _pairs = pairCache->getOverlappingPairArrayPtr();
+        _dispatchInfo = &dispatchInfo;
+        _threadPool->execute(&dispatchPairs, this, count, PARALLEL_DISPATCH_GRAIN_SIZE);
+        _pairs = NULL;
+        _dispatchInfo = NULL;
+
+        sortManifolds(pairCache);
+    }
+
+private:
+
+    // Manifolds are created in whichever order the threads reach their pairs. Put them in the order of the pairs,
+    // so the solver sees contacts in an order that does not depend on thread timing and the results are reproducible.
+    void sortManifolds(btOverlappingPairCache* pairCache)
+    {
+        int manifoldCount = m_manifoldsPtr.size();
+        for (int i = 0; i < manifoldCount; ++i)
+        {
+            m_manifoldsPtr[i]->m_index1a = -1;
+        }
+
+        _sortedManifolds.resize(0);
+        btBroadphasePairArray& pairs = pairCache->getOverlappingPairArray();
+        for (int i = 0, count = pairs.size(); i < count; ++i)
+        {
+            if (pairs[i].m_algorithm == NULL)
+                continue;
+
+            _pairManifolds.resize(0);
+            pairs[i].m_algorithm->getAllContactManifolds(_pairManifolds);
+            for (int j = 0; j < _pairManifolds.size(); ++j)
+            {
+                btPersistentManifold* manifold = _pairManifolds[j];
+                if (manifold->m_index1a < 0)
+                {
+                    manifold->m_index1a = _sortedManifolds.size();
+                    _sortedManifolds.push_back(manifold);
+                }
+            }
+        }
+
+        // Keep any manifolds that no pair owns after the others, in their existing order.
+        for (int i = 0; i < manifoldCount; ++i)
+        {
+            btPersistentManifold* manifold = m_manifoldsPtr[i];
+            if (manifold->m_index1a < 0)
+            {
+                manifold->m_index1a = _sortedManifolds.size();
+                _sortedManifolds.push_back(manifold);
+            }
+        }
+
+        GP_ASSERT(_sortedManifolds.size() == manifoldCount);
+        for (int i = 0; i < manifoldCount; ++i)
+        {
+            m_manifoldsPtr[i] = _sortedManifolds[i];
+        }
+    }
+
+    static void dispatchPairs(void* arg, unsigned int begin, unsigned int end)
+    {
+        ParallelCollisionDispatcher* dispatcher = static_cast<ParallelCollisionDispatcher*>(arg);
+        btNearCallback nearCallback = dispatcher->getNearCallback();
+        for (unsigned int i = begin; i < end; ++i)
+        {
+            nearCallback(dispatcher->_pairs[i], *dispatcher, *dispatcher->_dispatchInfo);
+        }
+    }
+
+    ThreadPool* _threadPool;
+    Mutex _mutex;
+    ParallelConvexConvexAlgorithm::CreateFunc _convexCreateFunc;
+    btBroadphasePair* _pairs;
+    const btDispatcherInfo* _dispatchInfo;
+    btManifoldArray _sortedManifolds;
+    btManifoldArray _pairManifolds;
+};
+
+template <class T>
+static void writeSnapshot(std::vector<unsigned char>* snapshot, const T& value)
+{
+    size_t offset = snapshot->size();
+    snapshot->resize(offset + sizeof(T));
+    memcpy(&(*snapshot)[offset], &value, sizeof(T));
+}
+
+static void writeSnapshot(std::vector<unsigned char>* snapshot, const btVector3& value)
+{
+    writeSnapshot(snapshot, value.x());
+    writeSnapshot(snapshot, value.y());
+    writeSnapshot(snapshot, value.z());
+}
+
+static void writeSnapshot(std::vector<unsigned char>* snapshot, const btTransform& value)
+{
+    // The full basis is saved, since converting it to a quaternion would not restore it exactly.
+    writeSnapshot(snapshot, value.getBasis()[0]);
+    writeSnapshot(snapshot, value.getBasis()[1]);
+    writeSnapshot(snapshot, value.getBasis()[2]);
+    writeSnapshot(snapshot, value.getOrigin());
+}
+
+/**
+ * Reads values from a snapshot, failing once the end of the snapshot is reached.
+ * @script{ignore}
+ */
+class SnapshotReader
+{
+public:
+
+    SnapshotReader(const unsigned char* data, unsigned int size)
+        : _data(data), _size(size), _position(0)
+    {
+    }
+
+    template <class T>
+    bool read(T* value)
+    {
+        if (_position + sizeof(T) > _size)
+            return false;
+        memcpy(value, _data + _position, sizeof(T));
+        _position += sizeof(T);
+        return true;
+    }
+
+    bool read(btVector3* value)
+    {
+        float v[3];
+        if (!read(&v[0]) || !read(&v[1]) || !read(&v[2]))
+            return false;
+        value->setValue(v[0], v[1], v[2]);
+        return true;
+    }
+
+    bool read(btTransform* value)
+    {
+        btVector3 rows[3];
+        btVector3 origin;
+        if (!read(&rows[0]) || !read(&rows[1]) || !read(&rows[2]) || !read(&origin))
+            return false;
+        value->getBasis().setValue(rows[0].x(), rows[0].y(), rows[0].z(), rows[1].x(), rows[1].y(), rows[1].z(), rows[2].x(), rows[2].y(), rows[2].z());
+        value->setOrigin(origin);
+        return true;
+    }
+
+    bool atEnd() const
+    {
+        return _position == _size;
+    }
+
+private:
+
+    const unsigned char* _data;
+    unsigned int _size;
+    unsigned int _position;
+};
+
+/**
+ * Ray test callback that applies a PhysicsController::HitFilter.
+ * @script{ignore}
+ */
+class RayTestCallback : public btCollisionWorld::ClosestRayResultCallback
+{
+private:
+
+    PhysicsController::HitFilter* filter;
+    PhysicsController::HitResult hitResult;
+
+public:
+
+    RayTestCallback(const btVector3& rayFromWorld, const btVector3& rayToWorld, PhysicsController::HitFilter* filter)
+        : btCollisionWorld::ClosestRayResultCallback(rayFromWorld, rayToWorld), filter(filter)
+    {
+    }
+
+    virtual bool needsCollision(btBroadphaseProxy* proxy0) const
+    {
+        if (!btCollisionWorld::ClosestRayResultCallback::needsCollision(proxy0))
+            return false;
+
+        btCollisionObject* co = reinterpret_cast<btCollisionObject*>(proxy0->m_clientObject);
+        PhysicsCollisionObject* object = reinterpret_cast<PhysicsCollisionObject*>(co->getUserPointer());
+        if (object == NULL)
+            return false;
+
+        return filter ? !filter->filter(object) : true;
+    }
+
+    btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace)
+    {
+        GP_ASSERT(rayResult.m_collisionObject);
+        PhysicsCollisionObject* object = reinterpret_cast<PhysicsCollisionObject*>(rayResult.m_collisionObject->getUserPointer());
+
+        if (object == NULL)
+            return 1.0f; // ignore
+
+        float result = btCollisionWorld::ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+
+        hitResult.object = object;
+        hitResult.point.set(m_hitPointWorld.x(), m_hitPointWorld.y(), m_hitPointWorld.z());
+        hitResult.fraction = m_closestHitFraction;
+        hitResult.normal.set(m_hitNormalWorld.x(), m_hitNormalWorld.y(), m_hitNormalWorld.z());
+
+        if (filter && !filter->hit(hitResult))
+            return 1.0f; // process next collision
+
+        return result; // continue normally
+    }
+};
+
+/**
+ * Sweep test callback that applies a PhysicsController::HitFilter.
+ * @script{ignore}
+ */
+class SweepTestCallback : public btCollisionWorld::ClosestConvexResultCallback
+{
+private:
+
+    PhysicsCollisionObject* me;
+    PhysicsController::HitFilter* filter;
+    PhysicsController::HitResult hitResult;
+
+public:
+
+    SweepTestCallback(PhysicsCollisionObject* me, PhysicsController::HitFilter* filter)
+        : btCollisionWorld::ClosestConvexResultCallback(btVector3(0.0, 0.0, 0.0), btVector3(0.0, 0.0, 0.0)), me(me), filter(filter)
+    {
+    }
+
+    virtual bool needsCollision(btBroadphaseProxy* proxy0) const
+    {
+        if (!btCollisionWorld::ClosestConvexResultCallback::needsCollision(proxy0))
+            return false;
+
+        btCollisionObject* co = reinterpret_cast<btCollisionObject*>(proxy0->m_clientObject);
+        PhysicsCollisionObject* object = reinterpret_cast<PhysicsCollisionObject*>(co->getUserPointer());
+        if (object == NULL || object == me)
+            return false;
+
+        return filter ? !filter->filter(object) : true;
+    }
+
+    btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace)
+    {
+        GP_ASSERT(convexResult.m_hitCollisionObject);
+        PhysicsCollisionObject* object = reinterpret_cast<PhysicsCollisionObject*>(convexResult.m_hitCollisionObject->getUserPointer());
+
+        if (object == NULL)
+            return 1.0f;
+
+        float result = ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
+
+        hitResult.object = object;
+        hitResult.point.set(m_hitPointWorld.x(), m_hitPointWorld.y(), m_hitPointWorld.z());
+        hitResult.fraction = m_closestHitFraction;
+        hitResult.normal.set(m_hitNormalWorld.x(), m_hitNormalWorld.y(), m_hitNormalWorld.z());
+
+        if (filter && !filter->hit(hitResult))
+            return 1.0f;
+
+        return result;
+    }
+};
+
+/**
+ * Broadphase query along a ray, matching the broadphase callbacks used by
+ * btCollisionWorld::rayTest and btCollisionWorld::convexSweepTest.
+ * @script{ignore}
+ */
+struct BroadphaseQuery
+{
+    BroadphaseQuery(const btVector3& rayFromWorld, const btVector3& rayToWorld)
+    {
+        btVector3 rayDir = rayToWorld - rayFromWorld;
+        rayDir.normalize();
+        rayDirectionInverse.setValue(rayDir[0] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / rayDir[0],
+                                     rayDir[1] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / rayDir[1],
+                                     rayDir[2] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / rayDir[2]);
+        signs[0] = rayDirectionInverse[0] < 0.0;
+        signs[1] = rayDirectionInverse[1] < 0.0;
+        signs[2] = rayDirectionInverse[2] < 0.0;
+        lambdaMax = rayDir.dot(rayToWorld - rayFromWorld);
+    }
+
+    btVector3 rayDirectionInverse;
+    unsigned int signs[3];
+    btScalar lambdaMax;
+};
+
+/**
+ * Traverses a broadphase tree along a ray, visiting the leaves in the same order as
+ * btDbvt::rayTestInternal. Unlike btDbvt, the traversal stack is owned by the caller,
+ * so several queries may traverse the same tree at once.
+ */
+template <class Query>
+static void rayTestTree(const btDbvt& tree, const btVector3& rayFrom, const btVector3& aabbMin, const btVector3& aabbMax,
+                        Query& query, btAlignedObjectArray<const btDbvtNode*>& stack)
+{
+    if (!tree.m_root)
+        return;
+
+    int depth = 1;
+    int threshold = QUERY_STACK_SIZE - 2;
+    stack.resize(QUERY_STACK_SIZE);
+    stack[0] = tree.m_root;
+    btVector3 bounds[2];
+    do
+    {
+        const btDbvtNode* node = stack[--depth];
+        bounds[0] = node->volume.Mins() - aabbMax;
+        bounds[1] = node->volume.Maxs() - aabbMin;
+        btScalar tmin = 1.0f;
+        if (btRayAabb2(rayFrom, query.rayDirectionInverse, query.signs, bounds, tmin, 0.0f, query.lambdaMax))
+        {
+            if (node->isinternal())
+            {
+                if (depth > threshold)
+                {
+                    stack.resize(stack.size() * 2);
+                    threshold = stack.size() - 2;
+                }
+                stack[depth++] = node->childs[0];
+                stack[depth++] = node->childs[1];
+            }
+            else
+            {
+                query.process(static_cast<const btDbvtProxy*>(node->data));
+            }
+        }
+    }
+    while (depth);
+}
+
+/**
+ * Ray query equivalent to the one performed by btCollisionWorld::rayTest.
+ * @script{ignore}
+ */
+struct RayQuery : public BroadphaseQuery
+{
+    RayQuery(const btVector3& rayFromWorld, const btVector3& rayToWorld, btCollisionWorld::RayResultCallback& callback)
+        : BroadphaseQuery(rayFromWorld, rayToWorld), rayFromTrans(btMatrix3x3::getIdentity(), rayFromWorld),
+          rayToTrans(btMatrix3x3::getIdentity(), rayToWorld), callback(callback)
+    {
+    }
+
+    void process(const btBroadphaseProxy* proxy)
+    {
+        if (callback.m_closestHitFraction == btScalar(0.0f))
+            return;
+
+        btCollisionObject* collisionObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        if (callback.needsCollision(collisionObject->getBroadphaseHandle()))
+        {
+            btCollisionWorld::rayTestSingle(rayFromTrans, rayToTrans, collisionObject, collisionObject->getCollisionShape(),
+                                            collisionObject->getWorldTransform(), callback);
+        }
+    }
+
+    btTransform rayFromTrans;
+    btTransform rayToTrans;
+    btCollisionWorld::RayResultCallback& callback;
+};
+
+/**
+ * Sweep query equivalent to the one performed by btCollisionWorld::convexSweepTest.
+ * @script{ignore}
+ */
+struct SweepQuery : public BroadphaseQuery
+{
+    SweepQuery(const btConvexShape* shape, const btTransform& from, const btTransform& to,
+               btCollisionWorld::ConvexResultCallback& callback, btScalar allowedPenetration)
+        : BroadphaseQuery(from.getOrigin(), to.getOrigin()), shape(shape), from(from), to(to),
+          callback(callback), allowedPenetration(allowedPenetration)
+    {
+    }
+
+    void process(const btBroadphaseProxy* proxy)
+    {
+        if (callback.m_closestHitFraction == btScalar(0.0f))
+            return;
+
+        btCollisionObject* collisionObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        if (callback.needsCollision(collisionObject->getBroadphaseHandle()))
+        {
+            btCollisionWorld::objectQuerySingle(shape, from, to, collisionObject, collisionObject->getCollisionShape(),
+                                                collisionObject->getWorldTransform(), callback, allowedPenetration);
+        }
+    }
+
+    const btConvexShape* shape;
+    btTransform from;
+    btTransform to;
+    btCollisionWorld::ConvexResultCallback& callback;
+    btScalar allowedPenetration;
+};
+
+/**
+ * The arguments of a batch of ray or sweep tests processed by the thread pool.
+ * @script{ignore}
+ */
+struct QueryBatch
+{
+    PhysicsController* controller;
+    const Ray* rays;
+    const float* distances;
+    PhysicsCollisionObject* const* objects;
+    const Vector3* endPositions;
+    PhysicsController::HitResult* results;
+    PhysicsController::HitFilter* filter;
+};
+
+const int PhysicsController::CONTACT       = 0x01;
 const int PhysicsController::COLLISION     = 0x02;
 const int PhysicsController::REGISTERED    = 0x04;
 const int PhysicsController::REMOVE        = 0x08;
 
 PhysicsController::PhysicsController()
   : _isUpdating(false), _collisionConfiguration(NULL), _dispatcher(NULL),
-    _overlappingPairCache(NULL), _solver(NULL), _world(NULL), _ghostPairCallback(NULL),
+    _overlappingPairCache(NULL), _dbvtBroadphase(NULL), _solver(NULL), _world(NULL), _ghostPairCallback(NULL),
+    _activationDistance(0.0f), _deactivationDistance(0.0f),
     _debugDrawer(NULL), _status(PhysicsController::Listener::DEACTIVATED), _listeners(NULL),
-    _gravity(btScalar(0.0), btScalar(-9.8), btScalar(0.0)), _collisionCallback(NULL)
+    _gravity(btScalar(0.0), btScalar(-9.8), btScalar(0.0)), _ticked(false), _threadPool(NULL),
+    _fixedTimeStep(0.0f), _maxSubSteps(DEFAULT_MAX_SUB_STEPS), _accumulator(0.0f), _stepCount(0)
 {
     // Default gravity is 9.8 along the negative Y axis.
-    _collisionCallback = new CollisionCallback(this);
-
     addScriptEvent("statusEvent", "[PhysicsController::Listener::EventType]");
 }
 
 PhysicsController::~PhysicsController()
 {
-    SAFE_DELETE(_collisionCallback);
     SAFE_DELETE(_ghostPairCallback);
     SAFE_DELETE(_debugDrawer);
     SAFE_DELETE(_listeners);
@@ -155,11 +726,122 @@ void PhysicsController::setGravity(const Vector3& gravity)
         _world->setGravity(BV(_gravity));
 }
 
+float PhysicsController::getFixedTimeStep() const
+{
+    return _fixedTimeStep;
+}
+
+void PhysicsController::setFixedTimeStep(float step)
+{
+    step = std::max(step, 0.0f);
+    if (step == _fixedTimeStep)
+        return;
+
+    _fixedTimeStep = step;
+    _accumulator = 0.0f;
+
+    // Nodes are no longer interpolated when switching back to variable steps.
+    if (_fixedTimeStep == 0.0f)
+        clearMotionStates();
+}
+
+unsigned int PhysicsController::getMaxSubSteps() const
+{
+    return _maxSubSteps;
+}
+
+void PhysicsController::setMaxSubSteps(unsigned int maxSubSteps)
+{
+    GP_ASSERT(maxSubSteps > 0);
+    _maxSubSteps = std::max(maxSubSteps, 1u);
+}
+
+void PhysicsController::addFocusNode(Node* node)
+{
+    GP_ASSERT(node);
+    if (std::find(_focusNodes.begin(), _focusNodes.end(), node) == _focusNodes.end())
+    {
+        node->addRef();
+        _focusNodes.push_back(node);
+    }
+}
+
+void PhysicsController::removeFocusNode(Node* node)
+{
+    std::vector<Node*>::iterator itr = std::find(_focusNodes.begin(), _focusNodes.end(), node);
+    if (itr != _focusNodes.end())
+    {
+        _focusNodes.erase(itr);
+        SAFE_RELEASE(node);
+    }
+}
+
+float PhysicsController::getActivationDistance() const
+{
+    return _activationDistance;
+}
+
+float PhysicsController::getDeactivationDistance() const
+{
+    return _deactivationDistance;
+}
+
+void PhysicsController::setActivationDistance(float activationDistance, float deactivationDistance)
+{
+    GP_ASSERT(activationDistance >= 0.0f);
+    float distance = std::max(activationDistance, 0.0f);
+    if (distance != _activationDistance)
+    {
+        // Frozen objects are held in cells the size of the activation distance, so they are regrouped.
+        if (_regionCells.size() > 0)
+        {
+            btAlignedObjectArray<PhysicsCollisionObject*> frozen;
+            for (int i = 0, count = _regionCells.size(); i < count; ++i)
+            {
+                const btAlignedObjectArray<PhysicsCollisionObject*>* cell = _regionCells.getAtIndex(i);
+                for (int j = 0; j < cell->size(); ++j)
+                    frozen.push_back((*cell)[j]);
+            }
+            _regionCells.clear();
+
+            _activationDistance = distance;
+            for (int i = 0; i < frozen.size(); ++i)
+            {
+                PhysicsCollisionObject* object = frozen[i];
+                RegionObject* region = _regionObjects.find(btHashPtr(object));
+                GP_ASSERT(region && region->frozen);
+                if (distance > 0.0f)
+                {
+                    region->cell = getRegionCell(object->getNode()->getTranslationWorld());
+                    if (_regionCells.find(region->cell) == NULL)
+                        _regionCells.insert(region->cell, btAlignedObjectArray<PhysicsCollisionObject*>());
+                    addRegionObject(_regionCells.find(region->cell), object, region);
+                }
+                else
+                {
+                    // Region activation is turned off, so all frozen objects are restored.
+                    addToWorld(object);
+                    region->frozen = false;
+                    addRegionObject(&_regionActive, object, region);
+                }
+            }
+        }
+        _activationDistance = distance;
+    }
+    _deactivationDistance = deactivationDistance > distance ? deactivationDistance : distance * DEFAULT_DEACTIVATION_SCALE;
+}
+
 void PhysicsController::drawDebug(const Matrix& viewProjection)
 {
-    GP_ASSERT(_debugDrawer);
     GP_ASSERT(_world);
 
+    // The debug drawer is created on first use, so the simulation can run without a graphics context.
+    if (!_debugDrawer)
+    {
+        _debugDrawer = new DebugDrawer();
+        _world->setDebugDrawer(_debugDrawer);
+    }
+
     _debugDrawer->begin(viewProjection);
     _world->debugDrawWorld();
     _debugDrawer->end();
@@ -167,62 +849,121 @@ void PhysicsController::drawDebug(const Matrix& viewProjection)
 
 bool PhysicsController::rayTest(const Ray& ray, float distance, PhysicsController::HitResult* result, PhysicsController::HitFilter* filter)
 {
-    class RayTestCallback : public btCollisionWorld::ClosestRayResultCallback
-    {
-    private:
+    btVector3 rayFromWorld(BV(ray.getOrigin()));
+    btVector3 rayToWorld(rayFromWorld + BV(ray.getDirection() * distance));
+    return rayTest(rayFromWorld, rayToWorld, result, filter, NULL);
+}
+
+bool PhysicsController::sweepTest(PhysicsCollisionObject* object, const Vector3& endPosition, PhysicsController::HitResult* result, PhysicsController::HitFilter* filter)
+{
+    // Define the start transform.
+    btTransform start;
+    if (!getSweepStart(object, &start))
+        return false; // unsupported type
 
-        HitFilter* filter;
-        HitResult hitResult;
+    // Define the end transform.
+    btTransform end(start);
+    end.setOrigin(BV(endPosition));
 
-    public:
+    return sweepTest(object, start, end, result, filter, NULL);
+}
 
-        RayTestCallback(const btVector3& rayFromWorld, const btVector3& rayToWorld, PhysicsController::HitFilter* filter)
-            : btCollisionWorld::ClosestRayResultCallback(rayFromWorld, rayToWorld), filter(filter)
+unsigned int PhysicsController::rayTest(const Ray* rays, const float* distances, unsigned int count, PhysicsController::HitResult* results, PhysicsController::HitFilter* filter)
+{
+    GP_ASSERT(rays || count == 0);
+    GP_ASSERT(distances || count == 0);
+    GP_ASSERT(results || count == 0);
+
+    QueryBatch batch;
+    memset(&batch, 0, sizeof(batch));
+    batch.controller = this;
+    batch.rays = rays;
+    batch.distances = distances;
+    batch.results = results;
+    batch.filter = filter;
+
+    // Queries can only run in parallel with the DBVT broadphase, whose trees can be traversed from several threads.
+    if (_threadPool && _dbvtBroadphase)
+        _threadPool->execute(&rayTestBatch, &batch, count, QUERY_BATCH_GRAIN_SIZE);
+    else
+    {
+        for (unsigned int i = 0; i < count; ++i)
         {
+            if (!rayTest(rays[i], distances[i], &results[i], filter))
+                results[i].object = NULL;
         }
+    }
 
-        virtual bool needsCollision(btBroadphaseProxy* proxy0) const
-        {
-            if (!btCollisionWorld::ClosestRayResultCallback::needsCollision(proxy0))
-                return false;
+    unsigned int hitCount = 0;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (results[i].object)
+            ++hitCount;
+    }
+    return hitCount;
+}
 
-            btCollisionObject* co = reinterpret_cast<btCollisionObject*>(proxy0->m_clientObject);
-            PhysicsCollisionObject* object = reinterpret_cast<PhysicsCollisionObject*>(co->getUserPointer());
-            if (object == NULL)
-                return false;
+unsigned int PhysicsController::sweepTest(PhysicsCollisionObject* const* objects, const Vector3* endPositions, unsigned int count, PhysicsController::HitResult* results, PhysicsController::HitFilter* filter)
+{
+    GP_ASSERT(objects || count == 0);
+    GP_ASSERT(endPositions || count == 0);
+    GP_ASSERT(results || count == 0);
 
-            return filter ? !filter->filter(object) : true;
+    if (_threadPool && _dbvtBroadphase)
+    {
+        // Node world matrices are computed on demand, so get the start transforms before using other threads.
+        _sweepTransforms.resize(count);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            if (!getSweepStart(objects[i], &_sweepTransforms[i]))
+                _sweepTransforms[i].setIdentity();
         }
 
-        btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace)
+        QueryBatch batch;
+        memset(&batch, 0, sizeof(batch));
+        batch.controller = this;
+        batch.objects = objects;
+        batch.endPositions = endPositions;
+        batch.results = results;
+        batch.filter = filter;
+        _threadPool->execute(&sweepTestBatch, &batch, count, QUERY_BATCH_GRAIN_SIZE);
+    }
+    else
+    {
+        for (unsigned int i = 0; i < count; ++i)
         {
-            GP_ASSERT(rayResult.m_collisionObject);
-            PhysicsCollisionObject* object = reinterpret_cast<PhysicsCollisionObject*>(rayResult.m_collisionObject->getUserPointer());
-
-            if (object == NULL)
-                return 1.0f; // ignore
-
-            float result = btCollisionWorld::ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
-
-            hitResult.object = object;
-            hitResult.point.set(m_hitPointWorld.x(), m_hitPointWorld.y(), m_hitPointWorld.z());
-            hitResult.fraction = m_closestHitFraction;
-            hitResult.normal.set(m_hitNormalWorld.x(), m_hitNormalWorld.y(), m_hitNormalWorld.z());
-
-            if (filter && !filter->hit(hitResult))
-                return 1.0f; // process next collision
-
-            return result; // continue normally
+            if (!sweepTest(objects[i], endPositions[i], &results[i], filter))
+                results[i].object = NULL;
         }
-    };
+    }
 
+    unsigned int hitCount = 0;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (results[i].object)
+            ++hitCount;
+    }
+    return hitCount;
+}
+
+bool PhysicsController::rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld, HitResult* result, HitFilter* filter, btAlignedObjectArray<const btDbvtNode*>* stack)
+{
     GP_ASSERT(_world);
 
-    btVector3 rayFromWorld(BV(ray.getOrigin()));
-    btVector3 rayToWorld(rayFromWorld + BV(ray.getDirection() * distance));
+    RayTestCallback callback(rayFromWorld, rayToWorld, filter);
+    if (stack)
+    {
+        GP_ASSERT(_dbvtBroadphase);
+        RayQuery query(rayFromWorld, rayToWorld, callback);
+        btVector3 zero(0.0f, 0.0f, 0.0f);
+        rayTestTree(_dbvtBroadphase->m_sets[0], rayFromWorld, zero, zero, query, *stack);
+        rayTestTree(_dbvtBroadphase->m_sets[1], rayFromWorld, zero, zero, query, *stack);
+    }
+    else
+    {
+        _world->rayTest(rayFromWorld, rayToWorld, callback);
+    }
 
-    RayTestCallback callback(rayFromWorld, rayToWorld, filter);
-    _world->rayTest(rayFromWorld, rayToWorld, callback);
     if (callback.hasHit())
     {
         if (result)
@@ -239,67 +980,17 @@ bool PhysicsController::rayTest(const Ray& ray, float distance, PhysicsControlle
     return false;
 }
 
-bool PhysicsController::sweepTest(PhysicsCollisionObject* object, const Vector3& endPosition, PhysicsController::HitResult* result, PhysicsController::HitFilter* filter)
+bool PhysicsController::getSweepStart(PhysicsCollisionObject* object, btTransform* start) const
 {
-    class SweepTestCallback : public btCollisionWorld::ClosestConvexResultCallback
-    {
-    private:
-
-        PhysicsCollisionObject* me;
-        PhysicsController::HitFilter* filter;
-        PhysicsController::HitResult hitResult;
-
-    public:
-
-        SweepTestCallback(PhysicsCollisionObject* me, PhysicsController::HitFilter* filter)
-            : btCollisionWorld::ClosestConvexResultCallback(btVector3(0.0, 0.0, 0.0), btVector3(0.0, 0.0, 0.0)), me(me), filter(filter)
-        {
-        }
-
-        virtual bool needsCollision(btBroadphaseProxy* proxy0) const
-        {
-            if (!btCollisionWorld::ClosestConvexResultCallback::needsCollision(proxy0))
-                return false;
-
-            btCollisionObject* co = reinterpret_cast<btCollisionObject*>(proxy0->m_clientObject);
-            PhysicsCollisionObject* object = reinterpret_cast<PhysicsCollisionObject*>(co->getUserPointer());
-            if (object == NULL || object == me)
-                return false;
-
-            return filter ? !filter->filter(object) : true;
-        }
-
-        btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace)
-        {
-            GP_ASSERT(convexResult.m_hitCollisionObject);
-            PhysicsCollisionObject* object = reinterpret_cast<PhysicsCollisionObject*>(convexResult.m_hitCollisionObject->getUserPointer());
-
-            if (object == NULL)
-                return 1.0f;
-
-            float result = ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
-
-            hitResult.object = object;
-            hitResult.point.set(m_hitPointWorld.x(), m_hitPointWorld.y(), m_hitPointWorld.z());
-            hitResult.fraction = m_closestHitFraction;
-            hitResult.normal.set(m_hitNormalWorld.x(), m_hitNormalWorld.y(), m_hitNormalWorld.z());
-
-            if (filter && !filter->hit(hitResult))
-                return 1.0f;
-
-            return result;
-        }
-    };
-
     GP_ASSERT(object && object->getCollisionShape());
+    GP_ASSERT(start);
+
     PhysicsCollisionShape* shape = object->getCollisionShape();
     PhysicsCollisionShape::Type type = shape->getType();
     if (type != PhysicsCollisionShape::SHAPE_BOX && type != PhysicsCollisionShape::SHAPE_SPHERE && type != PhysicsCollisionShape::SHAPE_CAPSULE)
-        return false; // unsupported type
+        return false;
 
-    // Define the start transform.
-    btTransform start;
-    start.setIdentity();
+    start->setIdentity();
     if (object->getNode())
     {
         Vector3 translation;
@@ -308,14 +999,17 @@ bool PhysicsController::sweepTest(PhysicsCollisionObject* object, const Vector3&
         m.getTranslation(&translation);
         m.getRotation(&rotation);
 
-        start.setIdentity();
-        start.setOrigin(BV(translation));
-        start.setRotation(BQ(rotation));
+        start->setOrigin(BV(translation));
+        start->setRotation(BQ(rotation));
     }
 
-    // Define the end transform.
-    btTransform end(start);
-    end.setOrigin(BV(endPosition));
+    return true;
+}
+
+bool PhysicsController::sweepTest(PhysicsCollisionObject* object, const btTransform& start, const btTransform& end, HitResult* result, HitFilter* filter, btAlignedObjectArray<const btDbvtNode*>* stack)
+{
+    GP_ASSERT(object && object->getCollisionShape());
+    btConvexShape* shape = static_cast<btConvexShape*>(object->getCollisionShape()->getShape());
 
     // Perform bullet convex sweep test.
     SweepTestCallback callback(object, filter);
@@ -327,16 +1021,37 @@ bool PhysicsController::sweepTest(PhysicsCollisionObject* object, const Vector3&
     {
     case PhysicsCollisionObject::GHOST_OBJECT:
     case PhysicsCollisionObject::CHARACTER:
-        static_cast<PhysicsGhostObject*>(object)->_ghostObject->convexSweepTest(static_cast<btConvexShape*>(shape->getShape()), start, end, callback, _world->getDispatchInfo().m_allowedCcdPenetration);
+        static_cast<PhysicsGhostObject*>(object)->_ghostObject->convexSweepTest(shape, start, end, callback, _world->getDispatchInfo().m_allowedCcdPenetration);
         break;
 
     default:
-        _world->convexSweepTest(static_cast<btConvexShape*>(shape->getShape()), start, end, callback, _world->getDispatchInfo().m_allowedCcdPenetration);
+        _world->convexSweepTest(shape, start, end, callback, _world->getDispatchInfo().m_allowedCcdPenetration);
         break;
     }*/
 
     GP_ASSERT(_world);
-    _world->convexSweepTest(static_cast<btConvexShape*>(shape->getShape()), start, end, callback, _world->getDispatchInfo().m_allowedCcdPenetration);
+    btScalar allowedPenetration = _world->getDispatchInfo().m_allowedCcdPenetration;
+    if (stack)
+    {
+        GP_ASSERT(_dbvtBroadphase);
+
+        // Compute the bounds of the shape over its rotation during the sweep, as btCollisionWorld::convexSweepTest does.
+        btVector3 linearVelocity, angularVelocity;
+        btTransformUtil::calculateVelocity(start, end, 1.0f, linearVelocity, angularVelocity);
+        btTransform rotation;
+        rotation.setIdentity();
+        rotation.setRotation(start.getRotation());
+        btVector3 aabbMin, aabbMax;
+        shape->calculateTemporalAabb(rotation, btVector3(0.0f, 0.0f, 0.0f), angularVelocity, 1.0f, aabbMin, aabbMax);
+
+        SweepQuery query(shape, start, end, callback, allowedPenetration);
+        rayTestTree(_dbvtBroadphase->m_sets[0], start.getOrigin(), aabbMin, aabbMax, query, *stack);
+        rayTestTree(_dbvtBroadphase->m_sets[1], start.getOrigin(), aabbMin, aabbMax, query, *stack);
+    }
+    else
+    {
+        _world->convexSweepTest(shape, start, end, callback, allowedPenetration);
+    }
 
     // Check for hits and store results.
     if (callback.hasHit())
@@ -355,89 +1070,104 @@ bool PhysicsController::sweepTest(PhysicsCollisionObject* object, const Vector3&
     return false;
 }
 
-btScalar PhysicsController::CollisionCallback::addSingleResult(btManifoldPoint& cp, const btCollisionObjectWrapper* a, int partIdA, int indexA, 
-    const btCollisionObjectWrapper* b, int partIdB, int indexB)
+void PhysicsController::rayTestBatch(void* arg, unsigned int begin, unsigned int end)
 {
-    GP_ASSERT(_pc);
-
-    // Get pointers to the PhysicsCollisionObject objects.
-    PhysicsCollisionObject* objectA = _pc->getCollisionObject(a->m_collisionObject);
-    PhysicsCollisionObject* objectB = _pc->getCollisionObject(b->m_collisionObject);
+    QueryBatch* batch = static_cast<QueryBatch*>(arg);
+    GP_ASSERT(batch && batch->controller);
 
-    // If the given collision object pair has collided in the past, then
-    // we notify the listeners only if the pair was not colliding
-    // during the previous frame. Otherwise, it's a new pair, so add a
-    // new entry to the cache with the appropriate listeners and notify them.
-    PhysicsCollisionObject::CollisionPair pair(objectA, objectB);
-
-    CollisionInfo* collisionInfo;
-    if (_pc->_collisionStatus.count(pair) > 0)
+    btAlignedObjectArray<const btDbvtNode*> stack;
+    for (unsigned int i = begin; i < end; ++i)
     {
-        collisionInfo = &_pc->_collisionStatus[pair];
+        btVector3 rayFromWorld(BV(batch->rays[i].getOrigin()));
+        btVector3 rayToWorld(rayFromWorld + BV(batch->rays[i].getDirection() * batch->distances[i]));
+        if (!batch->controller->rayTest(rayFromWorld, rayToWorld, &batch->results[i], batch->filter, &stack))
+            batch->results[i].object = NULL;
     }
-    else
-    {
-        // Add a new collision pair for these objects.
-        collisionInfo = &_pc->_collisionStatus[pair];
+}
 
-        // Add the appropriate listeners.
-        PhysicsCollisionObject::CollisionPair p1(pair.objectA, NULL);
-        if (_pc->_collisionStatus.count(p1) > 0)
-        {
-            const CollisionInfo& ci = _pc->_collisionStatus[p1];
-            std::vector<PhysicsCollisionObject::CollisionListener*>::const_iterator iter = ci._listeners.begin();
-            for (; iter != ci._listeners.end(); iter++)
-            {
-                GP_ASSERT(*iter);
-                collisionInfo->_listeners.push_back(*iter);
-            }
-        }
-        PhysicsCollisionObject::CollisionPair p2(pair.objectB, NULL);
-        if (_pc->_collisionStatus.count(p2) > 0)
-        {
-            const CollisionInfo& ci = _pc->_collisionStatus[p2];
-            std::vector<PhysicsCollisionObject::CollisionListener*>::const_iterator iter = ci._listeners.begin();
-            for (; iter != ci._listeners.end(); iter++)
-            {
-                GP_ASSERT(*iter);
-                collisionInfo->_listeners.push_back(*iter);
-            }
-        }
-    }
+void PhysicsController::sweepTestBatch(void* arg, unsigned int begin, unsigned int end)
+{
+    QueryBatch* batch = static_cast<QueryBatch*>(arg);
+    GP_ASSERT(batch && batch->controller);
 
-    // Fire collision event.
-    if ((collisionInfo->_status & COLLISION) == 0)
+    btAlignedObjectArray<const btDbvtNode*> stack;
+    for (unsigned int i = begin; i < end; ++i)
     {
-        std::vector<PhysicsCollisionObject::CollisionListener*>::const_iterator iter = collisionInfo->_listeners.begin();
-        for (; iter != collisionInfo->_listeners.end(); iter++)
+        PhysicsCollisionObject* object = batch->objects[i];
+        PhysicsCollisionShape::Type type = object->getCollisionShape()->getType();
+        if (type != PhysicsCollisionShape::SHAPE_BOX && type != PhysicsCollisionShape::SHAPE_SPHERE && type != PhysicsCollisionShape::SHAPE_CAPSULE)
         {
-            GP_ASSERT(*iter);
-            if ((collisionInfo->_status & REMOVE) == 0)
-            {
-                (*iter)->collisionEvent(PhysicsCollisionObject::CollisionListener::COLLIDING, pair, Vector3(cp.getPositionWorldOnA().x(), cp.getPositionWorldOnA().y(), cp.getPositionWorldOnA().z()),
-                    Vector3(cp.getPositionWorldOnB().x(), cp.getPositionWorldOnB().y(), cp.getPositionWorldOnB().z()));
-            }
+            batch->results[i].object = NULL;
+            continue;
         }
-    }
 
-    // Update the collision status cache (we remove the dirty bit
-    // set in the controller's update so that this particular collision pair's
-    // status is not reset to 'no collision' when the controller's update completes).
-    collisionInfo->_status &= ~DIRTY;
-    collisionInfo->_status |= COLLISION;
-    return 0.0f;
+        const btTransform& start = batch->controller->_sweepTransforms[i];
+        btTransform end(start);
+        end.setOrigin(BV(batch->endPositions[i]));
+        if (!batch->controller->sweepTest(object, start, end, &batch->results[i], batch->filter, &stack))
+            batch->results[i].object = NULL;
+    }
 }
 
 void PhysicsController::initialize()
 {
-    _collisionConfiguration = bullet_new<btDefaultCollisionConfiguration>();
-    _dispatcher = bullet_new<btCollisionDispatcher>(_collisionConfiguration);
-    _overlappingPairCache = bullet_new<btDbvtBroadphase>();
+    // Read the optional world settings from the game config.
+    Properties* config = Game::getInstance()->getConfig()->getNamespace("physics", true);
+    unsigned int threadCount = 1;
+    const char* broadphase = NULL;
+    if (config)
+    {
+        if (config->exists("threads"))
+            threadCount = (unsigned int)std::max(config->getInt("threads"), 0);
+        broadphase = config->getString("broadphase");
+        const char* shapeCache = config->getString("shapeCache");
+        if (shapeCache)
+            _shapeCachePath = shapeCache;
+    }
+    if (threadCount == 0)
+        threadCount = Thread::getHardwareConcurrency();
+
+    btDefaultCollisionConstructionInfo constructionInfo;
+    if (threadCount > 1)
+    {
+        _threadPool = ThreadPool::create(threadCount);
+        constructionInfo.m_customCollisionAlgorithmMaxElementSize = sizeof(ParallelConvexConvexAlgorithm);
+    }
+    _collisionConfiguration = bullet_new<btDefaultCollisionConfiguration>(constructionInfo);
+    if (_threadPool && _threadPool->getThreadCount() > 1)
+        _dispatcher = bullet_new<ParallelCollisionDispatcher>(_collisionConfiguration, _threadPool);
+    else
+        _dispatcher = bullet_new<btCollisionDispatcher>(_collisionConfiguration);
+
+    if (broadphase && strcmp(broadphase, "AXIS_SWEEP") == 0)
+    {
+        Vector3 worldMin(-DEFAULT_WORLD_EXTENT, -DEFAULT_WORLD_EXTENT, -DEFAULT_WORLD_EXTENT);
+        Vector3 worldMax(DEFAULT_WORLD_EXTENT, DEFAULT_WORLD_EXTENT, DEFAULT_WORLD_EXTENT);
+        if (config->exists("worldMin"))
+            config->getVector3("worldMin", &worldMin);
+        if (config->exists("worldMax"))
+            config->getVector3("worldMax", &worldMax);
+        unsigned int maxProxies = config->exists("maxProxies") ? (unsigned int)std::max(config->getInt("maxProxies"), 2) : DEFAULT_MAX_PROXIES;
+
+        // The 16-bit version is faster, but is limited in the number of objects it can hold.
+        if (maxProxies <= DEFAULT_MAX_PROXIES)
+            _overlappingPairCache = bullet_new<btAxisSweep3>(BV(worldMin), BV(worldMax), (unsigned short)maxProxies);
+        else
+            _overlappingPairCache = bullet_new<bt32BitAxisSweep3>(BV(worldMin), BV(worldMax), maxProxies);
+    }
+    else
+    {
+        if (broadphase && strcmp(broadphase, "DBVT") != 0)
+            GP_WARN("Unsupported physics broadphase '%s'; using DBVT.", broadphase);
+        _dbvtBroadphase = bullet_new<btDbvtBroadphase>();
+        _overlappingPairCache = _dbvtBroadphase;
+    }
     _solver = bullet_new<btSequentialImpulseConstraintSolver>();
 
     // Create the world.
     _world = bullet_new<btDiscreteDynamicsWorld>(_dispatcher, _overlappingPairCache, _solver, _collisionConfiguration);
     _world->setGravity(BV(_gravity));
+    _world->setInternalTickCallback(&tickCallback, this);
 
     // Register ghost pair callback so bullet detects collisions with ghost objects (used for character collisions).
     GP_ASSERT(_world->getPairCache());
@@ -445,20 +1175,39 @@ void PhysicsController::initialize()
     _world->getPairCache()->setInternalGhostPairCallback(_ghostPairCallback);
     _world->getDispatchInfo().m_allowedCcdPenetration = 0.0001f;
 
-    // Set up debug drawing.
-    _debugDrawer = new DebugDrawer();
-    _world->setDebugDrawer(_debugDrawer);
+    // Read the optional simulation settings.
+    if (config)
+    {
+        if (config->exists("maxSubSteps"))
+            setMaxSubSteps((unsigned int)std::max(config->getInt("maxSubSteps"), 1));
+        setFixedTimeStep(config->getFloat("fixedTimeStep"));
+        if (config->exists("activationDistance"))
+            setActivationDistance(config->getFloat("activationDistance"), config->getFloat("deactivationDistance"));
+    }
 }
 
 void PhysicsController::finalize()
 {
+    clearMotionStates();
+
+    for (size_t i = 0, count = _focusNodes.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_focusNodes[i]);
+    }
+    _focusNodes.clear();
+    _regionObjects.clear();
+    _regionActive.clear();
+    _regionCells.clear();
+
     // Clean up the world and its various components.
     SAFE_DELETE(_world);
     SAFE_DELETE(_ghostPairCallback);
     SAFE_DELETE(_solver);
     SAFE_DELETE(_overlappingPairCache);
+    _dbvtBroadphase = NULL;
     SAFE_DELETE(_dispatcher);
     SAFE_DELETE(_collisionConfiguration);
+    SAFE_DELETE(_threadPool);
 }
 
 void PhysicsController::pause()
@@ -474,135 +1223,567 @@ void PhysicsController::resume()
 void PhysicsController::update(float elapsedTime)
 {
     GP_ASSERT(_world);
+
+    // Objects can only be added to and removed from the world before stepping it.
+    updateRegions();
+
     _isUpdating = true;
+    _ticked = false;
 
-    // Update the physics simulation, with a maximum
-    // of 10 simulation steps being performed in a given frame.
+    // Update the physics simulation.
     //
     // Note that stepSimulation takes elapsed time in seconds
     // so we divide by 1000 to convert from milliseconds.
-    _world->stepSimulation(elapsedTime * 0.001f, 10);
+    if (_fixedTimeStep > 0.0f)
+        stepFixed(elapsedTime * 0.001f);
+    else
+        _world->stepSimulation(elapsedTime * 0.001f, _maxSubSteps);
 
-    // If we have status listeners, then check if our status has changed.
-    if (_listeners || _callbacks["statusEvent"])
+    // If we have status listeners, then check if our status has changed. The simulation
+    // islands are only known if the simulation was stepped during this update.
+    if (_ticked && (_listeners || hasScriptCallbacks("statusEvent")))
     {
         Listener::EventType oldStatus = _status;
+        _status = hasActiveIsland() ? Listener::ACTIVATED : Listener::DEACTIVATED;
 
-        if (_status == Listener::DEACTIVATED)
+        // If the status has changed, notify our listeners.
+        if (oldStatus != _status)
         {
-            for (int i = 0; i < _world->getNumCollisionObjects(); i++)
+            if (_listeners)
             {
-                GP_ASSERT(_world->getCollisionObjectArray()[i]);
-                if (_world->getCollisionObjectArray()[i]->isActive())
+                for (unsigned int k = 0; k < _listeners->size(); k++)
                 {
-                    _status = Listener::ACTIVATED;
-                    break;
+                    GP_ASSERT((*_listeners)[k]);
+                    (*_listeners)[k]->statusEvent(_status);
                 }
             }
+
+            fireScriptEvent<void>("statusEvent", _status);
         }
-        else
+    }
+
+    // Fire collision events for the contacts found during the simulation steps.
+    updateCollisionStatus();
+
+    _isUpdating = false;
+}
+
+void PhysicsController::step(unsigned int count)
+{
+    GP_ASSERT(_world);
+    if (_fixedTimeStep <= 0.0f)
+    {
+        GP_ERROR("The physics simulation can only be stepped explicitly with a fixed time step.");
+        return;
+    }
+
+    _isUpdating = true;
+    _ticked = false;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        ++_stepCount;
+        _world->stepSimulation(_fixedTimeStep, 0);
+    }
+    interpolateMotionStates(_accumulator / _fixedTimeStep);
+
+    updateCollisionStatus();
+
+    _isUpdating = false;
+}
+
+void PhysicsController::saveSnapshot(std::vector<unsigned char>* snapshot) const
+{
+    GP_ASSERT(snapshot);
+    GP_ASSERT(_world);
+    GP_ASSERT(!_isUpdating);
+
+    snapshot->clear();
+    const btCollisionObjectArray& objects = _world->getCollisionObjectArray();
+    snapshot->insert(snapshot->end(), SNAPSHOT_IDENTIFIER, SNAPSHOT_IDENTIFIER + 4);
+    writeSnapshot(snapshot, (unsigned int)SNAPSHOT_VERSION);
+    writeSnapshot(snapshot, (unsigned int)objects.size());
+    writeSnapshot(snapshot, _stepCount);
+    writeSnapshot(snapshot, _accumulator);
+
+    for (int i = 0, count = objects.size(); i < count; ++i)
+    {
+        const btCollisionObject* collisionObject = objects[i];
+        unsigned char kind = getSnapshotKind(collisionObject);
+        writeSnapshot(snapshot, kind);
+
+        if (kind == SNAPSHOT_RIGID_BODY || kind == SNAPSHOT_VEHICLE)
+        {
+            const btRigidBody* body = static_cast<const btRigidBody*>(collisionObject);
+            writeSnapshot(snapshot, body->getWorldTransform());
+            writeSnapshot(snapshot, body->getInterpolationWorldTransform());
+            writeSnapshot(snapshot, body->getLinearVelocity());
+            writeSnapshot(snapshot, body->getAngularVelocity());
+            writeSnapshot(snapshot, body->getInterpolationLinearVelocity());
+            writeSnapshot(snapshot, body->getInterpolationAngularVelocity());
+            writeSnapshot(snapshot, body->getActivationState());
+            writeSnapshot(snapshot, body->getDeactivationTime());
+            writeSnapshot(snapshot, body->getHitFraction());
+        }
+
+        if (kind == SNAPSHOT_VEHICLE)
+        {
+            const PhysicsCollisionObject* object = getCollisionObject(collisionObject);
+            const PhysicsVehicle* vehicle = static_cast<const PhysicsVehicle*>(object->getNode()->getCollisionObject());
+            GP_ASSERT(vehicle->_vehicle);
+            writeSnapshot(snapshot, vehicle->_speedSmoothed);
+            writeSnapshot(snapshot, (unsigned int)vehicle->_vehicle->getNumWheels());
+            for (int j = 0; j < vehicle->_vehicle->getNumWheels(); ++j)
+            {
+                const btWheelInfo& wheel = vehicle->_vehicle->getWheelInfo(j);
+                writeSnapshot(snapshot, wheel.m_rotation);
+                writeSnapshot(snapshot, wheel.m_deltaRotation);
+                writeSnapshot(snapshot, wheel.m_steering);
+                writeSnapshot(snapshot, wheel.m_engineForce);
+                writeSnapshot(snapshot, wheel.m_brake);
+            }
+        }
+        else if (kind == SNAPSHOT_CHARACTER)
+        {
+            // The node of a character is moved by the character, and the ghost object follows the node.
+            const PhysicsCharacter* character = static_cast<const PhysicsCharacter*>(getCollisionObject(collisionObject));
+            Node* node = character->getNode();
+            writeSnapshot(snapshot, node->getTranslation());
+            writeSnapshot(snapshot, node->getRotation());
+            writeSnapshot(snapshot, character->_moveVelocity);
+            writeSnapshot(snapshot, character->_forwardVelocity);
+            writeSnapshot(snapshot, character->_rightVelocity);
+            writeSnapshot(snapshot, character->_verticalVelocity);
+            writeSnapshot(snapshot, character->_currentVelocity);
+            writeSnapshot(snapshot, character->_normalizedVelocity);
+            writeSnapshot(snapshot, (unsigned char)(character->_colliding ? 1 : 0));
+            writeSnapshot(snapshot, character->_collisionNormal);
+            writeSnapshot(snapshot, character->_currentPosition);
+        }
+    }
+}
+
+bool PhysicsController::restoreSnapshot(const unsigned char* snapshot, unsigned int size)
+{
+    GP_ASSERT(snapshot || size == 0);
+    GP_ASSERT(_world);
+    GP_ASSERT(!_isUpdating);
+
+    SnapshotReader reader(snapshot, size);
+    char identifier[4];
+    unsigned int version, objectCount, stepCount;
+    float accumulator;
+    if (!reader.read(&identifier) || memcmp(identifier, SNAPSHOT_IDENTIFIER, 4) != 0 ||
+        !reader.read(&version) || version != SNAPSHOT_VERSION)
+    {
+        GP_ERROR("Invalid physics snapshot.");
+        return false;
+    }
+    if (!reader.read(&objectCount) || objectCount != (unsigned int)_world->getNumCollisionObjects() ||
+        !reader.read(&stepCount) || !reader.read(&accumulator))
+    {
+        GP_ERROR("Physics snapshot does not match the collision objects in the simulation.");
+        return false;
+    }
+
+    // Check the whole snapshot before restoring anything, so a mismatch leaves the simulation unchanged.
+    const unsigned char* objects = snapshot + SNAPSHOT_HEADER_SIZE;
+    if (!readSnapshotObjects(objects, size - SNAPSHOT_HEADER_SIZE, false))
+    {
+        GP_ERROR("Physics snapshot does not match the collision objects in the simulation.");
+        return false;
+    }
+
+    // Move the nodes of interpolated bodies to their current transforms, so nothing is interpolated from before the snapshot.
+    clearMotionStates();
+
+    _stepCount = stepCount;
+    _accumulator = accumulator;
+    readSnapshotObjects(objects, size - SNAPSHOT_HEADER_SIZE, true);
+
+    // The cached contacts are not part of the snapshot. Discard them, so that re-simulated steps
+    // only depend on the snapshot and not on the steps simulated since it was saved.
+    resetBroadphase();
+
+    return true;
+}
+
+unsigned char PhysicsController::getSnapshotKind(const btCollisionObject* collisionObject) const
+{
+    GP_ASSERT(collisionObject);
+    const PhysicsCollisionObject* object = getCollisionObject(collisionObject);
+    if (object == NULL)
+        return SNAPSHOT_NONE;
+
+    switch (object->getType())
+    {
+    case PhysicsCollisionObject::RIGID_BODY:
+        if (collisionObject->isStaticObject())
+            return SNAPSHOT_NONE;
+        if (object->getNode() && object->getNode()->getCollisionObject() &&
+            object->getNode()->getCollisionObject()->getType() == PhysicsCollisionObject::VEHICLE)
+        {
+            return SNAPSHOT_VEHICLE;
+        }
+        return SNAPSHOT_RIGID_BODY;
+
+    case PhysicsCollisionObject::CHARACTER:
+        return SNAPSHOT_CHARACTER;
+
+    default:
+        return SNAPSHOT_NONE;
+    }
+}
+
+bool PhysicsController::readSnapshotObjects(const unsigned char* data, unsigned int size, bool apply)
+{
+    SnapshotReader reader(data, size);
+    btCollisionObjectArray& objects = _world->getCollisionObjectArray();
+    for (int i = 0, count = objects.size(); i < count; ++i)
+    {
+        btCollisionObject* collisionObject = objects[i];
+        unsigned char kind;
+        if (!reader.read(&kind) || kind != getSnapshotKind(collisionObject))
+            return false;
+
+        if (kind == SNAPSHOT_RIGID_BODY || kind == SNAPSHOT_VEHICLE)
         {
-            bool allInactive = true;
-            for (int i = 0; i < _world->getNumCollisionObjects(); i++)
+            btTransform transform, interpolationTransform;
+            btVector3 linearVelocity, angularVelocity, interpolationLinearVelocity, interpolationAngularVelocity;
+            int activationState;
+            float deactivationTime, hitFraction;
+            if (!reader.read(&transform) || !reader.read(&interpolationTransform) ||
+                !reader.read(&linearVelocity) || !reader.read(&angularVelocity) ||
+                !reader.read(&interpolationLinearVelocity) || !reader.read(&interpolationAngularVelocity) ||
+                !reader.read(&activationState) || !reader.read(&deactivationTime) || !reader.read(&hitFraction))
+            {
+                return false;
+            }
+
+            if (apply)
             {
-                GP_ASSERT(_world->getCollisionObjectArray()[i]);
-                if (_world->getCollisionObjectArray()[i]->isActive())
+                btRigidBody* body = static_cast<btRigidBody*>(collisionObject);
+                body->setWorldTransform(transform);
+                body->setInterpolationWorldTransform(interpolationTransform);
+                body->setLinearVelocity(linearVelocity);
+                body->setAngularVelocity(angularVelocity);
+                body->setInterpolationLinearVelocity(interpolationLinearVelocity);
+                body->setInterpolationAngularVelocity(interpolationAngularVelocity);
+                body->forceActivationState(activationState);
+                body->setDeactivationTime(deactivationTime);
+                body->setHitFraction(hitFraction);
+                body->clearForces();
+
+                // Move the node to the restored transform.
+                PhysicsCollisionObject::PhysicsMotionState* motionState = getCollisionObject(collisionObject)->_motionState;
+                if (motionState && !body->isKinematicObject())
                 {
-                    allInactive = false;
-                    break;
+                    motionState->_worldTransform = transform * motionState->_centerOfMassOffset;
+                    motionState->applyTransform(motionState->_worldTransform);
                 }
             }
-
-            if (allInactive)
-                _status = Listener::DEACTIVATED;
         }
 
-        // If the status has changed, notify our listeners.
-        if (oldStatus != _status)
+        if (kind == SNAPSHOT_VEHICLE)
         {
-            if (_listeners)
+            PhysicsVehicle* vehicle = static_cast<PhysicsVehicle*>(getCollisionObject(collisionObject)->getNode()->getCollisionObject());
+            GP_ASSERT(vehicle->_vehicle);
+            float speedSmoothed;
+            unsigned int wheelCount;
+            if (!reader.read(&speedSmoothed) || !reader.read(&wheelCount) || wheelCount != (unsigned int)vehicle->_vehicle->getNumWheels())
+                return false;
+            if (apply)
+                vehicle->_speedSmoothed = speedSmoothed;
+
+            for (unsigned int j = 0; j < wheelCount; ++j)
             {
-                for (unsigned int k = 0; k < _listeners->size(); k++)
+                float rotation, deltaRotation, steering, engineForce, brake;
+                if (!reader.read(&rotation) || !reader.read(&deltaRotation) || !reader.read(&steering) ||
+                    !reader.read(&engineForce) || !reader.read(&brake))
                 {
-                    GP_ASSERT((*_listeners)[k]);
-                    (*_listeners)[k]->statusEvent(_status);
+                    return false;
+                }
+
+                if (apply)
+                {
+                    btWheelInfo& wheel = vehicle->_vehicle->getWheelInfo(j);
+                    wheel.m_rotation = rotation;
+                    wheel.m_deltaRotation = deltaRotation;
+                    wheel.m_steering = steering;
+                    wheel.m_engineForce = engineForce;
+                    wheel.m_brake = brake;
                 }
             }
+        }
+        else if (kind == SNAPSHOT_CHARACTER)
+        {
+            Vector3 translation;
+            Quaternion rotation;
+            btVector3 moveVelocity, verticalVelocity, currentVelocity, normalizedVelocity, collisionNormal, currentPosition;
+            float forwardVelocity, rightVelocity;
+            unsigned char colliding;
+            if (!reader.read(&translation) || !reader.read(&rotation) || !reader.read(&moveVelocity) ||
+                !reader.read(&forwardVelocity) || !reader.read(&rightVelocity) || !reader.read(&verticalVelocity) ||
+                !reader.read(&currentVelocity) || !reader.read(&normalizedVelocity) || !reader.read(&colliding) ||
+                !reader.read(&collisionNormal) || !reader.read(&currentPosition))
+            {
+                return false;
+            }
 
-            fireScriptEvent<void>("statusEvent", _status);
+            if (apply)
+            {
+                PhysicsCharacter* character = static_cast<PhysicsCharacter*>(getCollisionObject(collisionObject));
+                character->getNode()->setTranslation(translation);
+                character->getNode()->setRotation(rotation);
+                character->_moveVelocity = moveVelocity;
+                character->_forwardVelocity = forwardVelocity;
+                character->_rightVelocity = rightVelocity;
+                character->_verticalVelocity = verticalVelocity;
+                character->_currentVelocity = currentVelocity;
+                character->_normalizedVelocity = normalizedVelocity;
+                character->_colliding = colliding != 0;
+                character->_collisionNormal = collisionNormal;
+                character->_currentPosition = currentPosition;
+            }
+        }
+    }
+
+    return reader.atEnd();
+}
+
+void PhysicsController::resetBroadphase()
+{
+    GP_ASSERT(_world);
+    btBroadphaseInterface* broadphase = _world->getBroadphase();
+    btCollisionObjectArray& objects = _world->getCollisionObjectArray();
+
+    // Remove all proxies, which also removes all overlapping pairs and their contact manifolds.
+    std::vector<short> filters(objects.size() * 2);
+    for (int i = objects.size() - 1; i >= 0; --i)
+    {
+        btBroadphaseProxy* proxy = objects[i]->getBroadphaseHandle();
+        if (proxy)
+        {
+            filters[i * 2] = proxy->m_collisionFilterGroup;
+            filters[i * 2 + 1] = proxy->m_collisionFilterMask;
+            broadphase->destroyProxy(proxy, _dispatcher);
+            objects[i]->setBroadphaseHandle(NULL);
+        }
+    }
+    broadphase->resetPool(_dispatcher);
+
+    // Add the proxies back in order, as btCollisionWorld::addCollisionObject does.
+    for (int i = 0, count = objects.size(); i < count; ++i)
+    {
+        btCollisionObject* collisionObject = objects[i];
+        btVector3 aabbMin, aabbMax;
+        collisionObject->getCollisionShape()->getAabb(collisionObject->getWorldTransform(), aabbMin, aabbMax);
+        collisionObject->setBroadphaseHandle(broadphase->createProxy(aabbMin, aabbMax, collisionObject->getCollisionShape()->getShapeType(),
+            collisionObject, filters[i * 2], filters[i * 2 + 1], _dispatcher, 0));
+    }
+
+    // The solver's random seed is only used with randomized solver modes, but is reset for completeness.
+    _solver->reset();
+}
+
+void PhysicsController::stepFixed(float elapsedTime)
+{
+    GP_ASSERT(_world);
+    GP_ASSERT(_fixedTimeStep > 0.0f);
+
+    _accumulator += elapsedTime;
+
+    // Perform as many whole steps as the accumulated time allows, within the step budget.
+    // Each call to stepSimulation with no sub steps performs exactly one step of the given size.
+    unsigned int steps = 0;
+    while (_accumulator >= _fixedTimeStep && steps < _maxSubSteps)
+    {
+        ++_stepCount;
+        _world->stepSimulation(_fixedTimeStep, 0);
+        _accumulator -= _fixedTimeStep;
+        ++steps;
+    }
+
+    // Drop the time that could not be simulated within the budget. Carrying it over
+    // would only make the following frames slower, until the game can never catch up.
+    if (_accumulator >= _fixedTimeStep)
+        _accumulator = std::fmod(_accumulator, _fixedTimeStep);
+
+    interpolateMotionStates(_accumulator / _fixedTimeStep);
+}
+
+void PhysicsController::interpolateMotionStates(float alpha)
+{
+    for (size_t i = 0; i < _motionStates.size(); )
+    {
+        PhysicsCollisionObject::PhysicsMotionState* motionState = _motionStates[i];
+        GP_ASSERT(motionState);
+
+        if (motionState->_step == _stepCount)
+        {
+            motionState->interpolate(alpha);
+            ++i;
+        }
+        else
+        {
+            // The body did not move during the last step (it is sleeping or has been removed
+            // from the world), so move its node to the final transform and stop tracking it.
+            motionState->interpolate(1.0f);
+            motionState->_interpolated = false;
+            _motionStates[i] = _motionStates.back();
+            _motionStates.pop_back();
+        }
+    }
+}
+
+void PhysicsController::clearMotionStates()
+{
+    for (size_t i = 0, count = _motionStates.size(); i < count; ++i)
+    {
+        GP_ASSERT(_motionStates[i]);
+        _motionStates[i]->interpolate(1.0f);
+        _motionStates[i]->_interpolated = false;
+    }
+    _motionStates.clear();
+}
+
+void PhysicsController::tickCallback(btDynamicsWorld* world, btScalar timeStep)
+{
+    GP_ASSERT(world);
+    PhysicsController* controller = static_cast<PhysicsController*>(world->getWorldUserInfo());
+    GP_ASSERT(controller);
+    controller->gatherContacts();
+}
+
+void PhysicsController::gatherContacts()
+{
+    GP_ASSERT(_dispatcher);
+    _ticked = true;
+
+    if (_collisionStatus.size() == 0)
+        return;
+
+    // The dispatcher's persistent manifolds hold the contacts computed during the step,
+    // so there is no need to run the narrow phase again for the listened pairs.
+    for (int i = 0, count = _dispatcher->getNumManifolds(); i < count; ++i)
+    {
+        btPersistentManifold* manifold = _dispatcher->getManifoldByIndexInternal(i);
+        GP_ASSERT(manifold);
+        if (manifold->getNumContacts() == 0)
+            continue;
+
+        PhysicsCollisionObject* objectA = getCollisionObject(manifold->getBody0());
+        PhysicsCollisionObject* objectB = getCollisionObject(manifold->getBody1());
+        if (!objectA || !objectB)
+            continue;
+
+        CollisionPairKey key(objectA, objectB);
+        int index = _collisionStatus.findIndex(key);
+        if (index == BT_HASH_NULL)
+        {
+            // Track the pair if either object has listeners for all of its collisions,
+            // with the listened object first.
+            const CollisionInfo* infoA = _collisionStatus.find(CollisionPairKey(objectA, NULL));
+            const CollisionInfo* infoB = _collisionStatus.find(CollisionPairKey(objectB, NULL));
+            bool listenedA = infoA && (infoA->_status & REMOVE) == 0;
+            bool listenedB = infoB && (infoB->_status & REMOVE) == 0;
+            if (!listenedA && !listenedB)
+                continue;
+
+            _collisionStatus.insert(listenedA ? key : CollisionPairKey(objectB, objectA), CollisionInfo());
+            index = _collisionStatus.findIndex(key);
+            GP_ASSERT(index != BT_HASH_NULL);
+        }
+        CollisionInfo* info = _collisionStatus.getAtIndex(index);
+        GP_ASSERT(info);
+
+        // Store the contact points in the order of the pair's objects.
+        const btManifoldPoint& point = manifold->getContactPoint(0);
+        const btVector3& pointA = point.getPositionWorldOnA();
+        const btVector3& pointB = point.getPositionWorldOnB();
+        if (_collisionStatus.getKeyAtIndex(index).pair.objectA == objectA)
+        {
+            info->_contactPointA.set(pointA.x(), pointA.y(), pointA.z());
+            info->_contactPointB.set(pointB.x(), pointB.y(), pointB.z());
+        }
+        else
+        {
+            info->_contactPointA.set(pointB.x(), pointB.y(), pointB.z());
+            info->_contactPointB.set(pointA.x(), pointA.y(), pointA.z());
         }
+        info->_status |= CONTACT;
     }
+}
 
-    // All statuses are set with the DIRTY bit before collision processing occurs.
-    // During collision processing, if a collision occurs, the status is 
-    // set to COLLISION and the DIRTY bit is cleared. Then, after collision processing 
-    // is finished, if a given status is still dirty, the COLLISION bit is cleared.
-    //
-    // If an entry was marked for removal in the last frame, fire NOT_COLLIDING if appropriate and remove it now.
-
-    // Dirty the collision status cache entries.
-    std::map<PhysicsCollisionObject::CollisionPair, CollisionInfo>::iterator iter = _collisionStatus.begin();
-    for (; iter != _collisionStatus.end();)
+void PhysicsController::updateCollisionStatus()
+{
+    // The status of each pair is only known if the simulation was stepped during this update.
+    // Entries are visited in reverse since removing an entry moves the last entry into its place.
+    for (int i = _collisionStatus.size() - 1; i >= 0; --i)
     {
-        if ((iter->second._status & REMOVE) != 0)
+        CollisionInfo* info = _collisionStatus.getAtIndex(i);
+        GP_ASSERT(info);
+        PhysicsCollisionObject::CollisionPair pair = _collisionStatus.getKeyAtIndex(i).pair;
+
+        // If an entry was marked for removal, fire NOT_COLLIDING if appropriate and remove it now.
+        if ((info->_status & REMOVE) != 0)
         {
-            if ((iter->second._status & COLLISION) != 0 && iter->first.objectB)
-            {
-                size_t size = iter->second._listeners.size();
-                for (size_t i = 0; i < size; i++)
-                {
-                    PhysicsCollisionObject::CollisionPair cp(iter->first.objectA, NULL);
-                    iter->second._listeners[i]->collisionEvent(PhysicsCollisionObject::CollisionListener::NOT_COLLIDING, cp);
-                }
-            }
+            // Only the first object is passed to the listeners, since the second may have been destroyed.
+            if ((info->_status & COLLISION) != 0 && pair.objectB)
+                queueCollisionEvent(*info, PhysicsCollisionObject::CollisionListener::NOT_COLLIDING, pair, PhysicsCollisionObject::CollisionPair(pair.objectA, NULL));
+            _collisionStatus.remove(CollisionPairKey(pair.objectA, pair.objectB));
+            continue;
+        }
 
-            std::map<PhysicsCollisionObject::CollisionPair, CollisionInfo>::iterator eraseIter = iter;
-            iter++;
-            _collisionStatus.erase(eraseIter);
+        if (!_ticked || !pair.objectB)
+            continue;
+
+        bool contact = (info->_status & CONTACT) != 0;
+        info->_status &= ~CONTACT;
+        if (contact && (info->_status & COLLISION) == 0)
+        {
+            info->_status |= COLLISION;
+            queueCollisionEvent(*info, PhysicsCollisionObject::CollisionListener::COLLIDING, pair, pair);
         }
-        else
+        else if (!contact && (info->_status & COLLISION) != 0)
         {
-            iter->second._status |= DIRTY;
-            iter++;
+            info->_status &= ~COLLISION;
+            queueCollisionEvent(*info, PhysicsCollisionObject::CollisionListener::NOT_COLLIDING, pair, pair);
         }
+
+        // Pairs that were only tracked for the listeners of one of their objects are dropped once they separate.
+        if ((info->_status & (REGISTERED | COLLISION)) == 0)
+            _collisionStatus.remove(CollisionPairKey(pair.objectA, pair.objectB));
     }
 
-    // Go through the collision status cache and perform all registered collision tests.
-    iter = _collisionStatus.begin();
-    for (; iter != _collisionStatus.end(); iter++)
+    // Fire the events once the cache is no longer being modified, since listeners may add or remove listeners.
+    for (size_t i = 0, count = _collisionEvents.size(); i < count; ++i)
     {
-        // If this collision pair was one that was registered for listening, then perform the collision test.
-        // (In the case where we register for all collisions with a rigid body, there will be a lot
-        // of collision pairs in the status cache that we did not explicitly register for.)
-        if ((iter->second._status & REGISTERED) != 0 && (iter->second._status & REMOVE) == 0)
-        {
-            if (iter->first.objectB)
-                _world->contactPairTest(iter->first.objectA->getCollisionObject(), iter->first.objectB->getCollisionObject(), *_collisionCallback);
-            else
-                _world->contactTest(iter->first.objectA->getCollisionObject(), *_collisionCallback);
-        }
+        const CollisionEvent& e = _collisionEvents[i];
+        GP_ASSERT(e.listener);
+        if (e.type == PhysicsCollisionObject::CollisionListener::COLLIDING)
+            e.listener->collisionEvent(e.type, e.pair, e.contactPointA, e.contactPointB);
+        else
+            e.listener->collisionEvent(e.type, e.pair);
     }
+    _collisionEvents.clear();
+}
 
-    // Update all the collision status cache entries.
-    iter = _collisionStatus.begin();
-    for ( ; iter != _collisionStatus.end(); iter++)
+void PhysicsController::queueCollisionEvent(const CollisionInfo& info, PhysicsCollisionObject::CollisionListener::EventType type,
+                                            const PhysicsCollisionObject::CollisionPair& pair, const PhysicsCollisionObject::CollisionPair& eventPair)
+{
+    // Notify the listeners of the pair itself, followed by the listeners for all collisions of either object.
+    const CollisionInfo* listeners[3] = { &info, _collisionStatus.find(CollisionPairKey(pair.objectA, NULL)), _collisionStatus.find(CollisionPairKey(pair.objectB, NULL)) };
+    for (unsigned int i = 0; i < 3; ++i)
     {
-        if ((iter->second._status & DIRTY) != 0)
-        {
-            if ((iter->second._status & COLLISION) != 0 && iter->first.objectB)
-            {
-                size_t size = iter->second._listeners.size();
-                for (size_t i = 0; i < size; i++)
-                {
-                    iter->second._listeners[i]->collisionEvent(PhysicsCollisionObject::CollisionListener::NOT_COLLIDING, iter->first);
-                }
-            }
+        if (!listeners[i] || (i > 0 && (listeners[i]->_status & REMOVE) != 0))
+            continue;
 
-            iter->second._status &= ~COLLISION;
+        for (size_t j = 0, count = listeners[i]->_listeners.size(); j < count; ++j)
+        {
+            _collisionEvents.push_back(CollisionEvent(listeners[i]->_listeners[j], type, eventPair, info._contactPointA, info._contactPointB));
         }
     }
-
-    _isUpdating = false;
 }
 
 void PhysicsController::addCollisionListener(PhysicsCollisionObject::CollisionListener* listener, PhysicsCollisionObject* objectA, PhysicsCollisionObject* objectB)
@@ -611,24 +1792,34 @@ void PhysicsController::addCollisionListener(PhysicsCollisionObject::CollisionLi
     
     // One of the collision objects in the pair must be non-null.
     GP_ASSERT(objectA || objectB);
-    PhysicsCollisionObject::CollisionPair pair(objectA, objectB);
+    if (!objectA)
+        std::swap(objectA, objectB);
+    CollisionPairKey key(objectA, objectB);
 
     // Add the listener and ensure the status includes that this collision pair is registered.
-    CollisionInfo& info = _collisionStatus[pair];
-    info._listeners.push_back(listener);
-    info._status |= PhysicsController::REGISTERED;
+    CollisionInfo* info = _collisionStatus.find(key);
+    if (!info)
+    {
+        _collisionStatus.insert(key, CollisionInfo());
+        info = _collisionStatus.find(key);
+        GP_ASSERT(info);
+    }
+    info->_listeners.push_back(listener);
+    info->_status |= PhysicsController::REGISTERED;
 }
 
 void PhysicsController::removeCollisionListener(PhysicsCollisionObject::CollisionListener* listener, PhysicsCollisionObject* objectA, PhysicsCollisionObject* objectB)
 {
     // One of the collision objects in the pair must be non-null.
     GP_ASSERT(objectA || objectB);
-    PhysicsCollisionObject::CollisionPair pair(objectA, objectB);
+    if (!objectA)
+        std::swap(objectA, objectB);
 
     // Mark the collision pair for these objects for removal.
-    if (_collisionStatus.count(pair) > 0)
+    CollisionInfo* info = _collisionStatus.find(CollisionPairKey(objectA, objectB));
+    if (info)
     {
-        _collisionStatus[pair]._status |= REMOVE;
+        info->_status |= REMOVE;
     }
 }
 
@@ -640,6 +1831,22 @@ void PhysicsController::addCollisionObject(PhysicsCollisionObject* object)
     // Assign user pointer for the bullet collision object to allow efficient
     // lookups of bullet objects -> gameplay objects.
     object->getCollisionObject()->setUserPointer(object);
+    addToWorld(object);
+
+    // Rigid bodies and ghost objects may be frozen by region activation.
+    PhysicsCollisionObject::Type type = object->getType();
+    if ((type == PhysicsCollisionObject::RIGID_BODY || type == PhysicsCollisionObject::GHOST_OBJECT) && object->getNode())
+    {
+        _regionObjects.insert(btHashPtr(object), RegionObject());
+        addRegionObject(&_regionActive, object, _regionObjects.find(btHashPtr(object)));
+    }
+}
+
+void PhysicsController::addToWorld(PhysicsCollisionObject* object)
+{
+    GP_ASSERT(object && object->getCollisionObject());
+    GP_ASSERT(_world);
+
     short group = (short)object->_group;
     short mask = (short)object->_mask;
 
@@ -660,7 +1867,7 @@ void PhysicsController::addCollisionObject(PhysicsCollisionObject* object)
 
     default:
         GP_ERROR("Unsupported collision object type (%d).", object->getType());
-        break;
+        return;
     }
 }
 
@@ -670,7 +1877,45 @@ void PhysicsController::removeCollisionObject(PhysicsCollisionObject* object, bo
     GP_ASSERT(_world);
     GP_ASSERT(!_isUpdating);
 
-    // Remove the collision object from the world.
+    // Remove the collision object from the world, unless it is frozen and so already removed.
+    RegionObject* region = _regionObjects.find(btHashPtr(object));
+    if (region)
+    {
+        if (region->frozen)
+        {
+            btAlignedObjectArray<PhysicsCollisionObject*>* cell = _regionCells.find(region->cell);
+            GP_ASSERT(cell);
+            removeRegionObject(cell, region);
+        }
+        else
+        {
+            removeRegionObject(&_regionActive, region);
+            removeFromWorld(object);
+        }
+        _regionObjects.remove(btHashPtr(object));
+    }
+    else
+    {
+        removeFromWorld(object);
+    }
+
+    // Find all references to the object in the collision status cache and mark them for removal.
+    if (removeListeners)
+    {
+        for (int i = 0, count = _collisionStatus.size(); i < count; ++i)
+        {
+            PhysicsCollisionObject::CollisionPair pair = _collisionStatus.getKeyAtIndex(i).pair;
+            if (pair.objectA == object || pair.objectB == object)
+                _collisionStatus.getAtIndex(i)->_status |= REMOVE;
+        }
+    }
+}
+
+void PhysicsController::removeFromWorld(PhysicsCollisionObject* object)
+{
+    GP_ASSERT(object);
+    GP_ASSERT(_world);
+
     if (object->getCollisionObject())
     {
         switch (object->getType())
@@ -689,19 +1934,158 @@ void PhysicsController::removeCollisionObject(PhysicsCollisionObject* object, bo
             break;
         }
     }
+}
 
-    // Find all references to the object in the collision status cache and mark them for removal.
-    if (removeListeners)
+void PhysicsController::updateRegions()
+{
+    if (_activationDistance <= 0.0f || _focusNodes.empty())
+        return;
+
+    std::vector<Vector3> focusPositions(_focusNodes.size());
+    for (size_t i = 0, count = _focusNodes.size(); i < count; ++i)
+    {
+        GP_ASSERT(_focusNodes[i]);
+        focusPositions[i] = _focusNodes[i]->getTranslationWorld();
+    }
+
+    // Freeze the simulated objects that are beyond the deactivation distance of every focus node.
+    // Bullet keeps the transform, velocities and activation state of objects removed from the world.
+    float deactivationDistanceSq = _deactivationDistance * _deactivationDistance;
+    for (int i = _regionActive.size() - 1; i >= 0; --i)
+    {
+        PhysicsCollisionObject* object = _regionActive[i];
+        GP_ASSERT(object && object->getNode());
+
+        // Constrained rigid bodies and the rigid bodies of vehicles are not frozen.
+        if (object->getNode()->getCollisionObject() != object ||
+            (object->getType() == PhysicsCollisionObject::RIGID_BODY && static_cast<PhysicsRigidBody*>(object)->_constraints &&
+             !static_cast<PhysicsRigidBody*>(object)->_constraints->empty()))
+        {
+            continue;
+        }
+
+        Vector3 position = object->getNode()->getTranslationWorld();
+        bool near = false;
+        for (size_t j = 0, count = focusPositions.size(); j < count && !near; ++j)
+            near = position.distanceSquared(focusPositions[j]) <= deactivationDistanceSq;
+        if (near)
+            continue;
+
+        // The object moved into this slot from the end of the array has already been visited.
+        RegionObject* region = _regionObjects.find(btHashPtr(object));
+        GP_ASSERT(region && region->slot == i);
+        removeRegionObject(&_regionActive, region);
+        removeFromWorld(object);
+        region->frozen = true;
+        region->cell = getRegionCell(position);
+        if (_regionCells.find(region->cell) == NULL)
+            _regionCells.insert(region->cell, btAlignedObjectArray<PhysicsCollisionObject*>());
+        addRegionObject(_regionCells.find(region->cell), object, region);
+    }
+
+    // Restore the frozen objects within the activation distance of a focus node. Since the cells
+    // are the size of the activation distance, only the cells around each focus node are visited.
+    float activationDistanceSq = _activationDistance * _activationDistance;
+    Vector3 extent(_activationDistance, _activationDistance, _activationDistance);
+    for (size_t i = 0, count = focusPositions.size(); i < count; ++i)
     {
-        std::map<PhysicsCollisionObject::CollisionPair, CollisionInfo>::iterator iter = _collisionStatus.begin();
-        for (; iter != _collisionStatus.end(); iter++)
+        const Vector3& focus = focusPositions[i];
+        RegionCellKey minCell = getRegionCell(focus - extent);
+        RegionCellKey maxCell = getRegionCell(focus + extent);
+        for (int x = minCell.x; x <= maxCell.x; ++x)
         {
-            if (iter->first.objectA == object || iter->first.objectB == object)
-                iter->second._status |= REMOVE;
+            for (int y = minCell.y; y <= maxCell.y; ++y)
+            {
+                for (int z = minCell.z; z <= maxCell.z; ++z)
+                {
+                    btAlignedObjectArray<PhysicsCollisionObject*>* cell = _regionCells.find(RegionCellKey(x, y, z));
+                    if (cell == NULL)
+                        continue;
+
+                    for (int j = cell->size() - 1; j >= 0; --j)
+                    {
+                        PhysicsCollisionObject* object = (*cell)[j];
+                        if (object->getNode()->getTranslationWorld().distanceSquared(focus) <= activationDistanceSq)
+                            restoreFrozenObject(object);
+                    }
+                }
+            }
         }
     }
 }
 
+void PhysicsController::restoreFrozenObject(PhysicsCollisionObject* object)
+{
+    RegionObject* region = _regionObjects.find(btHashPtr(object));
+    if (region == NULL || !region->frozen)
+        return;
+
+    btAlignedObjectArray<PhysicsCollisionObject*>* cell = _regionCells.find(region->cell);
+    GP_ASSERT(cell);
+    removeRegionObject(cell, region);
+    region->frozen = false;
+    addRegionObject(&_regionActive, object, region);
+    addToWorld(object);
+}
+
+PhysicsController::RegionCellKey PhysicsController::getRegionCell(const Vector3& position) const
+{
+    GP_ASSERT(_activationDistance > 0.0f);
+    float scale = 1.0f / _activationDistance;
+    return RegionCellKey((int)floorf(position.x * scale), (int)floorf(position.y * scale), (int)floorf(position.z * scale));
+}
+
+void PhysicsController::addRegionObject(btAlignedObjectArray<PhysicsCollisionObject*>* objects, PhysicsCollisionObject* object, RegionObject* region)
+{
+    GP_ASSERT(objects && object && region);
+    region->slot = objects->size();
+    objects->push_back(object);
+}
+
+void PhysicsController::removeRegionObject(btAlignedObjectArray<PhysicsCollisionObject*>* objects, RegionObject* region)
+{
+    GP_ASSERT(objects && region);
+    GP_ASSERT(region->slot >= 0 && region->slot < objects->size());
+
+    int last = objects->size() - 1;
+    if (region->slot != last)
+    {
+        PhysicsCollisionObject* moved = (*objects)[last];
+        RegionObject* movedRegion = _regionObjects.find(btHashPtr(moved));
+        GP_ASSERT(movedRegion);
+        movedRegion->slot = region->slot;
+        (*objects)[region->slot] = moved;
+    }
+    objects->pop_back();
+    region->slot = -1;
+}
+
+bool PhysicsController::hasActiveIsland() const
+{
+    // Bullet puts a simulation island to sleep only when all of its objects can sleep, so the
+    // first object of an island holds the state of the whole island. The island manager keeps the
+    // objects that the simulation moves sorted by island, with their index in the world.
+    GP_ASSERT(_world);
+    btSimulationIslandManager* islandManager = static_cast<btDiscreteDynamicsWorld*>(_world)->getSimulationIslandManager();
+    GP_ASSERT(islandManager);
+    btUnionFind& islands = islandManager->getUnionFind();
+    const btCollisionObjectArray& objects = _world->getCollisionObjectArray();
+    for (int start = 0, count = islands.getNumElements(); start < count;)
+    {
+        const btElement& first = islands.getElement(start);
+        GP_ASSERT(first.m_sz >= 0 && first.m_sz < objects.size());
+        if (objects[first.m_sz]->isActive())
+            return true;
+
+        // Skip the rest of the island.
+        do
+        {
+            ++start;
+        } while (start < count && islands.getElement(start).m_id == first.m_id);
+    }
+    return false;
+}
+
 PhysicsCollisionObject* PhysicsController::getCollisionObject(const btCollisionObject* collisionObject) const
 {
     // Gameplay collision objects are stored in the userPointer data of Bullet collision objects.
@@ -709,6 +2093,81 @@ PhysicsCollisionObject* PhysicsController::getCollisionObject(const btCollisionO
     return reinterpret_cast<PhysicsCollisionObject*>(collisionObject->getUserPointer());
 }
 
+PhysicsController::CollisionPairKey::CollisionPairKey(PhysicsCollisionObject* objectA, PhysicsCollisionObject* objectB)
+    : pair(objectA, objectB)
+{
+}
+
+unsigned int PhysicsController::CollisionPairKey::getHash() const
+{
+    // Combine the object addresses in a fixed order so the hash does not depend on the order of the pair.
+    size_t a = (size_t)pair.objectA;
+    size_t b = (size_t)pair.objectB;
+    if (a > b)
+        std::swap(a, b);
+    return (unsigned int)(a >> 3) * 73856093u ^ (unsigned int)(b >> 3) * 19349663u;
+}
+
+bool PhysicsController::CollisionPairKey::equals(const CollisionPairKey& other) const
+{
+    return (pair.objectA == other.pair.objectA && pair.objectB == other.pair.objectB) ||
+           (pair.objectA == other.pair.objectB && pair.objectB == other.pair.objectA);
+}
+
+PhysicsController::ShapeKey::ShapeKey(PhysicsCollisionShape::Type type, float x, float y, float z, const char* url, bool dynamic)
+    : type(type), url(url ? url : ""), dynamic(dynamic)
+{
+    // Adding zero turns negative zero into zero, which compares equal but hashes differently.
+    values[0] = x + 0.0f;
+    values[1] = y + 0.0f;
+    values[2] = z + 0.0f;
+}
+
+unsigned int PhysicsController::ShapeKey::getHash() const
+{
+    // FNV-1a hash of the key's values and url.
+    unsigned int hash = 2166136261u;
+    const unsigned char* bytes = (const unsigned char*)values;
+    for (size_t i = 0; i < sizeof(values); ++i)
+        hash = (hash ^ bytes[i]) * 16777619u;
+    for (size_t i = 0, count = url.size(); i < count; ++i)
+        hash = (hash ^ (unsigned char)url[i]) * 16777619u;
+    hash = (hash ^ (unsigned int)type) * 16777619u;
+    return (hash ^ (dynamic ? 1u : 0u)) * 16777619u;
+}
+
+bool PhysicsController::ShapeKey::equals(const ShapeKey& other) const
+{
+    return type == other.type && dynamic == other.dynamic && values[0] == other.values[0] &&
+           values[1] == other.values[1] && values[2] == other.values[2] && url == other.url;
+}
+
+PhysicsController::RegionCellKey::RegionCellKey(int x, int y, int z)
+    : x(x), y(y), z(z)
+{
+}
+
+unsigned int PhysicsController::RegionCellKey::getHash() const
+{
+    return (unsigned int)x * 73856093u ^ (unsigned int)y * 19349663u ^ (unsigned int)z * 83492791u;
+}
+
+bool PhysicsController::RegionCellKey::equals(const RegionCellKey& other) const
+{
+    return x == other.x && y == other.y && z == other.z;
+}
+
+PhysicsController::RegionObject::RegionObject()
+    : frozen(false), cell(0, 0, 0), slot(-1)
+{
+}
+
+PhysicsController::CollisionEvent::CollisionEvent(PhysicsCollisionObject::CollisionListener* listener, PhysicsCollisionObject::CollisionListener::EventType type,
+                                                  const PhysicsCollisionObject::CollisionPair& pair, const Vector3& contactPointA, const Vector3& contactPointB)
+    : listener(listener), type(type), pair(pair), contactPointA(contactPointA), contactPointB(contactPointB)
+{
+}
+
 static void getBoundingBox(Node* node, BoundingBox* out, bool merge = false)
 {
     GP_ASSERT(node);
@@ -914,27 +2373,15 @@ PhysicsCollisionShape* PhysicsController::createBox(const Vector3& extents, cons
 {
     btVector3 halfExtents(scale.x * 0.5 * extents.x, scale.y * 0.5 * extents.y, scale.z * 0.5 * extents.z);
 
-    PhysicsCollisionShape* shape;
-
     // Return the box shape from the cache if it already exists.
-    for (unsigned int i = 0; i < _shapes.size(); ++i)
-    {
-        shape = _shapes[i];
-        GP_ASSERT(shape);
-        if (shape->getType() == PhysicsCollisionShape::SHAPE_BOX)
-        {
-            btBoxShape* box = static_cast<btBoxShape*>(shape->_shape);
-            if (box && box->getHalfExtentsWithMargin() == halfExtents)
-            {
-                shape->addRef();
-                return shape;
-            }
-        }
-    }
+    ShapeKey key(PhysicsCollisionShape::SHAPE_BOX, halfExtents.x(), halfExtents.y(), halfExtents.z());
+    PhysicsCollisionShape* shape = findShape(key);
+    if (shape)
+        return shape;
 
     // Create the box shape and add it to the cache.
     shape = new PhysicsCollisionShape(PhysicsCollisionShape::SHAPE_BOX, bullet_new<btBoxShape>(halfExtents));
-    _shapes.push_back(shape);
+    addShape(key, shape);
 
     return shape;
 }
@@ -951,27 +2398,15 @@ PhysicsCollisionShape* PhysicsController::createSphere(float radius, const Vecto
 
     float scaledRadius = radius * uniformScale;
 
-    PhysicsCollisionShape* shape;
-
     // Return the sphere shape from the cache if it already exists.
-    for (unsigned int i = 0; i < _shapes.size(); ++i)
-    {
-        shape = _shapes[i];
-        GP_ASSERT(shape);
-        if (shape->getType() == PhysicsCollisionShape::SHAPE_SPHERE)
-        {
-            btSphereShape* sphere = static_cast<btSphereShape*>(shape->_shape);
-            if (sphere && sphere->getRadius() == scaledRadius)
-            {
-                shape->addRef();
-                return shape;
-            }
-        }
-    }
+    ShapeKey key(PhysicsCollisionShape::SHAPE_SPHERE, scaledRadius);
+    PhysicsCollisionShape* shape = findShape(key);
+    if (shape)
+        return shape;
 
     // Create the sphere shape and add it to the cache.
     shape = new PhysicsCollisionShape(PhysicsCollisionShape::SHAPE_SPHERE, bullet_new<btSphereShape>(scaledRadius));
-    _shapes.push_back(shape);
+    addShape(key, shape);
 
     return shape;
 }
@@ -984,27 +2419,15 @@ PhysicsCollisionShape* PhysicsController::createCapsule(float radius, float heig
     float scaledRadius = radius * girthScale;
     float scaledHeight = height * scale.y - radius * 2;
 
-    PhysicsCollisionShape* shape;
-
     // Return the capsule shape from the cache if it already exists.
-    for (unsigned int i = 0; i < _shapes.size(); i++)
-    {
-        shape = _shapes[i];
-        GP_ASSERT(shape);
-        if (shape->getType() == PhysicsCollisionShape::SHAPE_CAPSULE)
-        {
-            btCapsuleShape* capsule = static_cast<btCapsuleShape*>(shape->_shape);
-            if (capsule && capsule->getRadius() == scaledRadius && capsule->getHalfHeight() == 0.5f * scaledHeight)
-            {
-                shape->addRef();
-                return shape;
-            }
-        }
-    }
+    ShapeKey key(PhysicsCollisionShape::SHAPE_CAPSULE, scaledRadius, scaledHeight);
+    PhysicsCollisionShape* shape = findShape(key);
+    if (shape)
+        return shape;
 
     // Create the capsule shape and add it to the cache.
     shape = new PhysicsCollisionShape(PhysicsCollisionShape::SHAPE_CAPSULE, bullet_new<btCapsuleShape>(scaledRadius, scaledHeight));
-    _shapes.push_back(shape);
+    addShape(key, shape);
 
     return shape;
 }
@@ -1015,16 +2438,54 @@ PhysicsCollisionShape* PhysicsController::createHeightfield(Node* node, HeightFi
     GP_ASSERT(heightfield);
     GP_ASSERT(centerOfMassOffset);
 
-    // Inspect the height array for the min and max values
+    // Tiled heightfields only keep the loaded portion of their heights in memory
+    if (heightfield->isTiled())
+    {
+        GP_WARN("Heightfield collision shapes are not supported for tiled (paged) heightfields.");
+        return NULL;
+    }
+
+    // Bullet requires float heights, so quantized heightfields are expanded into a copy that
+    // is owned by the collision shape.
+    // The min and max values are found while expanding, and computed from the quantized values.
+    unsigned int count = heightfield->getColumnCount() * heightfield->getRowCount();
     float* heights = heightfield->getArray();
+    float* dequantizedHeights = NULL;
     float minHeight = FLT_MAX, maxHeight = -FLT_MAX;
-    for (unsigned int i = 0, count = heightfield->getColumnCount()*heightfield->getRowCount(); i < count; ++i)
+    if (heightfield->isQuantized())
+    {
+        const unsigned short* quantizedHeights = heightfield->getQuantizedArray();
+        float quantizedMin = heightfield->getQuantizedMin();
+        float quantizedStep = heightfield->getQuantizedStep();
+        unsigned short minQuantized = USHRT_MAX, maxQuantized = 0;
+        dequantizedHeights = new float[count];
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            unsigned short q = quantizedHeights[i];
+            if (q < minQuantized)
+                minQuantized = q;
+            if (q > maxQuantized)
+                maxQuantized = q;
+            dequantizedHeights[i] = quantizedMin + q * quantizedStep;
+        }
+        if (count > 0)
+        {
+            minHeight = quantizedMin + minQuantized * quantizedStep;
+            maxHeight = quantizedMin + maxQuantized * quantizedStep;
+        }
+        heights = dequantizedHeights;
+    }
+    else
     {
-        float h = heights[i];
-        if (h < minHeight)
-            minHeight = h;
-        if (h > maxHeight)
-            maxHeight = h;
+        // Inspect the height array for the min and max values
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            float h = heights[i];
+            if (h < minHeight)
+                minHeight = h;
+            if (h > maxHeight)
+                maxHeight = h;
+        }
     }
 
     // Compute initial heightfield scale by pulling the current world scale out of the node
@@ -1046,23 +2507,23 @@ PhysicsCollisionShape* PhysicsController::createHeightfield(Node* node, HeightFi
     PhysicsCollisionShape::HeightfieldData* heightfieldData = new PhysicsCollisionShape::HeightfieldData();
     heightfieldData->heightfield = heightfield;
     heightfieldData->heightfield->addRef();
+    heightfieldData->heights = dequantizedHeights;
     heightfieldData->inverseIsDirty = true;
     heightfieldData->minHeight = minHeight;
     heightfieldData->maxHeight = maxHeight;
 
     // Create the bullet terrain shape
     btHeightfieldTerrainShape* terrainShape = bullet_new<btHeightfieldTerrainShape>(
-        heightfield->getColumnCount(), heightfield->getRowCount(), heightfield->getArray(), 1.0f, minHeight, maxHeight, 1, PHY_FLOAT, false);
+        heightfield->getColumnCount(), heightfield->getRowCount(), heights, 1.0f, minHeight, maxHeight, 1, PHY_FLOAT, false);
 
     // Set initial bullet local scaling for the heightfield
     terrainShape->setLocalScaling(BV(scale));
 
     // Create our collision shape object and store heightfieldData in it.
+    // Heightfield shapes are not shared, since their scaling follows the node they are attached to.
     PhysicsCollisionShape* shape = new PhysicsCollisionShape(PhysicsCollisionShape::SHAPE_HEIGHTFIELD, terrainShape);
     shape->_shapeData.heightfieldData = heightfieldData;
 
-    _shapes.push_back(shape);
-
     return shape;
 }
 
@@ -1107,6 +2568,44 @@ PhysicsCollisionShape* PhysicsController::createMesh(Mesh* mesh, const Vector3&
         }
     }
 
+    // Return the mesh shape from the cache if it already exists.
+    ShapeKey key(PhysicsCollisionShape::SHAPE_MESH, scale.x, scale.y, scale.z, mesh->getUrl(), dynamic);
+    PhysicsCollisionShape* shape = findShape(key);
+    if (shape)
+        return shape;
+
+    // The size of the bundle is used to detect out of date shape cache files.
+    unsigned int sourceLength = 0;
+    if (!_shapeCachePath.empty())
+    {
+        std::string url(mesh->getUrl());
+        std::auto_ptr<Stream> stream(FileSystem::open(url.substr(0, url.find('#')).c_str()));
+        if (stream.get())
+            sourceLength = (unsigned int)stream->length();
+    }
+
+    // Dynamic meshes only need their cached convex hull, so the mesh data is not read.
+    if (dynamic && sourceLength > 0)
+    {
+        unsigned int dataSize;
+        unsigned char* points = readShapeCache(key, sourceLength, 0, 0, &dataSize);
+        if (points)
+        {
+            btConvexHullShape* hullShape = bullet_new<btConvexHullShape>((btScalar*)points, (int)(dataSize / (sizeof(float) * 3)), (int)(sizeof(float) * 3));
+            btAlignedFree(points);
+
+            PhysicsCollisionShape::MeshData* shapeMeshData = new PhysicsCollisionShape::MeshData();
+            shapeMeshData->vertexData = NULL;
+            shapeMeshData->bvhData = NULL;
+
+            shape = new PhysicsCollisionShape(PhysicsCollisionShape::SHAPE_MESH, hullShape);
+            shape->_shapeData.meshData = shapeMeshData;
+            addShape(key, shape);
+
+            return shape;
+        }
+    }
+
     // Read mesh data from URL
     Bundle::MeshData* data = Bundle::readMeshData(mesh->getUrl());
     if (data == NULL)
@@ -1118,6 +2617,7 @@ PhysicsCollisionShape* PhysicsController::createMesh(Mesh* mesh, const Vector3&
     // Create mesh data to be populated and store in returned collision shape.
     PhysicsCollisionShape::MeshData* shapeMeshData = new PhysicsCollisionShape::MeshData();
     shapeMeshData->vertexData = NULL;
+    shapeMeshData->bvhData = NULL;
 
     // Copy the scaled vertex position data to the rigid body's local buffer.
     Matrix m;
@@ -1146,15 +2646,33 @@ PhysicsCollisionShape* PhysicsController::createMesh(Mesh* mesh, const Vector3&
         // Create a hull approximation for better performance
 	    btShapeHull* hull = bullet_new<btShapeHull>(originalConvexShape);
 	    hull->buildHull(originalConvexShape->getMargin());
-	    collisionShape = bullet_new<btConvexHullShape>((btScalar*)hull->getVertexPointer(), hull->numVertices());
+	    btConvexHullShape* hullShape = bullet_new<btConvexHullShape>((btScalar*)hull->getVertexPointer(), hull->numVertices());
+        collisionShape = hullShape;
 
         SAFE_DELETE(hull);
         SAFE_DELETE(originalConvexShape);
+
+        // Save the hull points to the shape cache.
+        if (sourceLength > 0)
+        {
+            int pointCount = hullShape->getNumPoints();
+            const btVector3* hullPoints = hullShape->getUnscaledPoints();
+            float* points = new float[pointCount * 3];
+            for (int i = 0; i < pointCount; ++i)
+            {
+                points[i * 3] = hullPoints[i].x();
+                points[i * 3 + 1] = hullPoints[i].y();
+                points[i * 3 + 2] = hullPoints[i].z();
+            }
+            writeShapeCache(key, sourceLength, 0, 0, points, pointCount * 3 * sizeof(float));
+            SAFE_DELETE_ARRAY(points);
+        }
     }
     else
     {
         // For static meshes, use btBvhTriangleMeshShape
         meshInterface = bullet_new<btTriangleIndexVertexArray>();
+        unsigned int triangleCount = 0;
 
         size_t partCount = data->parts.size();
         if (partCount > 0)
@@ -1199,6 +2717,7 @@ PhysicsCollisionShape* PhysicsController::createMesh(Mesh* mesh, const Vector3&
                 btIndexedMesh indexedMesh;
                 indexedMesh.m_indexType = indexType;
                 indexedMesh.m_numTriangles = meshPart->indexCount / 3; // assume TRIANGLES primitive type
+                triangleCount += indexedMesh.m_numTriangles;
                 indexedMesh.m_numVertices = meshPart->indexCount;
                 indexedMesh.m_triangleIndexBase = (const unsigned char*)shapeMeshData->indexData[i];
                 indexedMesh.m_triangleIndexStride = indexStride*3;
@@ -1224,6 +2743,7 @@ PhysicsCollisionShape* PhysicsController::createMesh(Mesh* mesh, const Vector3&
             btIndexedMesh indexedMesh;
             indexedMesh.m_indexType = PHY_INTEGER;
             indexedMesh.m_numTriangles = data->vertexCount / 3; // assume TRIANGLES primitive type
+            triangleCount = indexedMesh.m_numTriangles;
             indexedMesh.m_numVertices = data->vertexCount;
             indexedMesh.m_triangleIndexBase = shapeMeshData->indexData[0];
             indexedMesh.m_triangleIndexStride = sizeof(unsigned int);
@@ -1235,15 +2755,49 @@ PhysicsCollisionShape* PhysicsController::createMesh(Mesh* mesh, const Vector3&
             meshInterface->addIndexedMesh(indexedMesh, indexedMesh.m_indexType);
         }
 
-        // Create our collision shape object and store shapeMeshData in it.
-        collisionShape = bullet_new<btBvhTriangleMeshShape>(meshInterface, true);
+        // Use the cached bounding volume hierarchy when there is one, rather than building it.
+        btBvhTriangleMeshShape* meshShape = NULL;
+        if (sourceLength > 0)
+        {
+            unsigned int dataSize;
+            unsigned char* bvhData = readShapeCache(key, sourceLength, data->vertexCount, triangleCount, &dataSize);
+            if (bvhData)
+            {
+                btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(bvhData, dataSize, false);
+                if (bvh)
+                {
+                    meshShape = bullet_new<btBvhTriangleMeshShape>(meshInterface, true, false);
+                    meshShape->setOptimizedBvh(bvh);
+                    shapeMeshData->bvhData = bvhData;
+                }
+                else
+                {
+                    btAlignedFree(bvhData);
+                }
+            }
+        }
+
+        if (meshShape == NULL)
+        {
+            meshShape = bullet_new<btBvhTriangleMeshShape>(meshInterface, true);
+
+            // Save the bounding volume hierarchy to the shape cache.
+            if (sourceLength > 0 && meshShape->getOptimizedBvh())
+            {
+                unsigned int dataSize = meshShape->getOptimizedBvh()->calculateSerializeBufferSize();
+                void* bvhData = btAlignedAlloc(dataSize, 16);
+                if (meshShape->getOptimizedBvh()->serializeInPlace(bvhData, dataSize, false))
+                    writeShapeCache(key, sourceLength, data->vertexCount, triangleCount, bvhData, dataSize);
+                btAlignedFree(bvhData);
+            }
+        }
+        collisionShape = meshShape;
     }
 
     // Create our collision shape object and store shapeMeshData in it.
-    PhysicsCollisionShape* shape = new PhysicsCollisionShape(PhysicsCollisionShape::SHAPE_MESH, collisionShape, meshInterface);
+    shape = new PhysicsCollisionShape(PhysicsCollisionShape::SHAPE_MESH, collisionShape, meshInterface);
     shape->_shapeData.meshData = shapeMeshData;
-
-    _shapes.push_back(shape);
+    addShape(key, shape);
 
     // Free the temporary mesh data now that it's stored in physics system.
     SAFE_DELETE(data);
@@ -1258,9 +2812,12 @@ void PhysicsController::destroyShape(PhysicsCollisionShape* shape)
         if (shape->getRefCount() == 1)
         {
             // Remove shape from shape cache.
-            std::vector<PhysicsCollisionShape*>::iterator shapeItr = std::find(_shapes.begin(), _shapes.end(), shape);
-            if (shapeItr != _shapes.end())
-                _shapes.erase(shapeItr);
+            ShapeKey* key = _shapeKeys.find(btHashPtr(shape));
+            if (key)
+            {
+                _shapes.remove(*key);
+                _shapeKeys.remove(btHashPtr(shape));
+            }
         }
 
         // Release the shape.
@@ -1268,12 +2825,106 @@ void PhysicsController::destroyShape(PhysicsCollisionShape* shape)
     }
 }
 
+PhysicsCollisionShape* PhysicsController::findShape(const ShapeKey& key)
+{
+    PhysicsCollisionShape** shape = _shapes.find(key);
+    if (shape)
+    {
+        GP_ASSERT(*shape);
+        (*shape)->addRef();
+        return *shape;
+    }
+    return NULL;
+}
+
+void PhysicsController::addShape(const ShapeKey& key, PhysicsCollisionShape* shape)
+{
+    GP_ASSERT(shape);
+    _shapes.insert(key, shape);
+    _shapeKeys.insert(btHashPtr(shape), key);
+}
+
+std::string PhysicsController::getShapeCacheFile(const ShapeKey& key) const
+{
+    char name[16];
+    sprintf(name, "%08x", key.getHash());
+    std::string path(_shapeCachePath);
+    if (!path.empty() && path[path.size() - 1] != '/')
+        path += '/';
+    path += name;
+    path += key.dynamic ? ".hull" : ".bvh";
+    return path;
+}
+
+unsigned char* PhysicsController::readShapeCache(const ShapeKey& key, unsigned int sourceLength, unsigned int vertexCount, unsigned int triangleCount, unsigned int* dataSize) const
+{
+    GP_ASSERT(dataSize);
+
+    std::string path = getShapeCacheFile(key);
+    if (!FileSystem::fileExists(path.c_str()))
+        return NULL;
+    std::auto_ptr<Stream> stream(FileSystem::open(path.c_str()));
+    if (stream.get() == NULL)
+        return NULL;
+
+    // Check that the file was written for the same mesh, scale and bundle.
+    char identifier[4];
+    unsigned int header[5];
+    float scale[3];
+    if (stream->read(identifier, 1, 4) != 4 || memcmp(identifier, SHAPE_CACHE_IDENTIFIER, 4) != 0 ||
+        stream->read(header, 4, 5) != 5 || header[0] != SHAPE_CACHE_VERSION || header[1] != key.url.size() ||
+        header[2] != sourceLength || header[3] != vertexCount || header[4] != triangleCount ||
+        stream->read(scale, 4, 3) != 3 || memcmp(scale, key.values, sizeof(scale)) != 0)
+    {
+        return NULL;
+    }
+    std::string url(key.url.size(), '\0');
+    if (!url.empty() && stream->read(&url[0], 1, url.size()) != url.size())
+        return NULL;
+    if (url != key.url || stream->read(dataSize, 4, 1) != 1 || *dataSize == 0)
+        return NULL;
+
+    unsigned char* data = (unsigned char*)btAlignedAlloc(*dataSize, 16);
+    if (stream->read(data, 1, *dataSize) != *dataSize)
+    {
+        GP_WARN("Failed to read shape cache file '%s'.", path.c_str());
+        btAlignedFree(data);
+        return NULL;
+    }
+    return data;
+}
+
+void PhysicsController::writeShapeCache(const ShapeKey& key, unsigned int sourceLength, unsigned int vertexCount, unsigned int triangleCount, const void* data, unsigned int dataSize) const
+{
+    std::string path = getShapeCacheFile(key);
+    std::auto_ptr<Stream> stream(FileSystem::open(path.c_str(), FileSystem::WRITE));
+    if (stream.get() == NULL)
+    {
+        GP_WARN("Failed to create shape cache file '%s'.", path.c_str());
+        return;
+    }
+
+    unsigned int header[5] = { SHAPE_CACHE_VERSION, (unsigned int)key.url.size(), sourceLength, vertexCount, triangleCount };
+    stream->write(SHAPE_CACHE_IDENTIFIER, 1, 4);
+    stream->write(header, 4, 5);
+    stream->write(key.values, 4, 3);
+    stream->write(key.url.c_str(), 1, key.url.size());
+    stream->write(&dataSize, 4, 1);
+    if (stream->write(data, 1, dataSize) != dataSize)
+        GP_WARN("Failed to write shape cache file '%s'.", path.c_str());
+}
+
 void PhysicsController::addConstraint(PhysicsRigidBody* a, PhysicsRigidBody* b, PhysicsConstraint* constraint)
 {
     GP_ASSERT(a);
     GP_ASSERT(constraint);
     GP_ASSERT(_world);
 
+    // Constrained rigid bodies are always simulated.
+    restoreFrozenObject(a);
+    if (b)
+        restoreFrozenObject(b);
+
     a->addConstraint(constraint);
     if (b)
     {
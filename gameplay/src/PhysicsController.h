@@ -16,21 +16,78 @@ namespace gameplay
 {
 
 class ScriptListener;
+class ThreadPool;
 
 /**
  * Defines a class for controlling game physics.
  *
+ * By default the simulation is advanced by Bullet's internal 1/60 second step, and node
+ * transforms are extrapolated by Bullet from the last step. A fixed time step may instead
+ * be set, either through setFixedTimeStep or with the following game.config properties:
+ *
+ * @code
+ * physics
+ * {
+ *     fixedTimeStep = 0.0166667
+ *     maxSubSteps = 5
+ *     threads = 0
+ *     broadphase = AXIS_SWEEP
+ *     worldMin = -500, -100, -500
+ *     worldMax = 500, 100, 500
+ *     maxProxies = 16384
+ *     shapeCache = res/cache/physics
+ *     activationDistance = 200
+ *     deactivationDistance = 250
+ * }
+ * @endcode
+ *
+ * In fixed time step mode the elapsed frame time is accumulated and the simulation is
+ * stepped in whole steps, up to maxSubSteps per frame. The transforms of the nodes of
+ * dynamic rigid bodies are interpolated between the two most recent simulation steps,
+ * so motion remains smooth when the frame rate differs from the simulation rate. Any
+ * time that cannot be simulated within the maxSubSteps budget is dropped, which slows
+ * the simulation down rather than stalling the game when a frame takes too long.
+ *
+ * The threads property sets the number of threads used to compute contacts between
+ * overlapping objects, where zero uses all hardware threads. The default of one thread
+ * computes contacts on the game thread. Contacts computed on several threads are put back
+ * in the order of the overlapping pairs, so the simulation is reproducible either way.
+ *
+ * The broadphase property selects the algorithm used to find potentially colliding objects.
+ * The default, DBVT, is a dynamic bounding volume tree suitable for most scenes. AXIS_SWEEP
+ * uses sweep and prune over the fixed world bounds given by worldMin and worldMax, which is
+ * faster for scenes with many static objects. Objects should stay within the world bounds,
+ * and maxProxies bounds the number of collision objects in the world.
+ *
+ * Collision shapes are shared between collision objects with the same shape and scale.
+ * When shapeCache is set to an existing directory, the bounding volume hierarchies built
+ * for static mesh shapes and the convex hulls built for dynamic mesh shapes are saved to
+ * it, and loaded instead of being rebuilt the next time the same mesh is used at the same
+ * scale. Cache files are ignored when the size of the bundle containing the mesh changes,
+ * but the directory should be cleared whenever meshes are re-encoded.
+ *
+ * For large worlds, an activation distance may be set along with focus nodes, such as
+ * the player and the active camera, added with addFocusNode. See setActivationDistance.
+ *
+ * The state of the simulation can be saved with saveSnapshot and restored with
+ * restoreSnapshot, for example to roll back and re-simulate steps with step. The results
+ * of stepping from a restored snapshot are reproducible when a fixed time step is used
+ * and no objects are frozen by region activation, but can differ slightly from the steps
+ * first simulated after saving the snapshot (see restoreSnapshot).
+ *
  * @see http://blackberry.github.io/GamePlay/docs/file-formats.html#wiki-Physics
  */
 class PhysicsController : public ScriptTarget
 {
     friend class Game;
+    friend class HeadlessGame;
     friend class PhysicsConstraint;
     friend class PhysicsRigidBody;
     friend class PhysicsCharacter;
     friend class PhysicsVehicle;
     friend class PhysicsCollisionObject;
     friend class PhysicsGhostObject;
+    friend class PhysicsCollisionObject::PhysicsMotionState;
 
 public:
 
@@ -289,6 +346,138 @@ public:
      */
     void setGravity(const Vector3& gravity);
 
+    /**
+     * Gets the fixed time step used to advance the simulation.
+     *
+     * @return The fixed time step, in seconds, or zero if the default
+     *      Bullet stepping is used.
+     */
+    float getFixedTimeStep() const;
+
+    /**
+     * Sets the fixed time step used to advance the simulation.
+     *
+     * When the time step is greater than zero, the transforms of dynamic rigid
+     * bodies are interpolated between simulation steps. Setting a time step of zero
+     * (the default) restores the default Bullet stepping.
+     *
+     * @param step The fixed time step, in seconds.
+     */
+    void setFixedTimeStep(float step);
+
+    /**
+     * Gets the maximum number of simulation steps performed in a single frame.
+     *
+     * @return The maximum number of steps per frame.
+     */
+    unsigned int getMaxSubSteps() const;
+
+    /**
+     * Sets the maximum number of simulation steps performed in a single frame.
+     *
+     * Elapsed time in excess of this number of steps is dropped. The default is 10.
+     *
+     * @param maxSubSteps The maximum number of steps per frame (must be at least 1).
+     */
+    void setMaxSubSteps(unsigned int maxSubSteps);
+
+    /**
+     * Adds a focus node, around which collision objects are simulated when an activation distance is set.
+     *
+     * @param node The focus node, such as the player or the node of the active camera.
+     */
+    void addFocusNode(Node* node);
+
+    /**
+     * Removes a focus node.
+     *
+     * @param node The focus node to remove.
+     */
+    void removeFocusNode(Node* node);
+
+    /**
+     * Gets the distance from the focus nodes within which frozen collision objects are simulated again.
+     *
+     * @return The activation distance, or zero if all collision objects are always simulated.
+     */
+    float getActivationDistance() const;
+
+    /**
+     * Gets the distance from the focus nodes beyond which collision objects are frozen.
+     *
+     * @return The deactivation distance.
+     */
+    float getDeactivationDistance() const;
+
+    /**
+     * Sets the distances from the focus nodes used to decide which collision objects are simulated.
+     *
+     * Rigid bodies and ghost objects farther than the deactivation distance from every focus node
+     * are frozen: they are removed from the simulation with their transform, velocities and sleep
+     * state preserved. Frozen objects are simulated again once a focus node comes within the
+     * activation distance of them, so the cost of the simulation depends on the objects near the
+     * focus nodes rather than on the size of the world. Characters, vehicles and rigid bodies with
+     * constraints are never frozen. Frozen objects are found using the position they were frozen
+     * at, so nodes should not be moved while their collision objects are frozen.
+     *
+     * Nothing is frozen while there are no focus nodes. The default activation distance is zero,
+     * which keeps all collision objects in the simulation.
+     *
+     * @param activationDistance The activation distance, or zero to simulate all collision objects.
+     * @param deactivationDistance The deactivation distance, which should be larger than the activation
+     *      distance to keep objects near the boundary from being repeatedly frozen and restored. Values
+     *      not larger than the activation distance use 1.25 times the activation distance.
+     */
+    void setActivationDistance(float activationDistance, float deactivationDistance = 0.0f);
+
+    /**
+     * Advances the simulation by the given number of fixed time steps immediately.
+     *
+     * This is used to re-simulate steps after restoring a snapshot, or to step the
+     * simulation from game logic rather than from the elapsed frame time. Collision
+     * events are fired once the steps are complete. A fixed time step must be set.
+     *
+     * @param count The number of steps to perform.
+     */
+    void step(unsigned int count = 1);
+
+    /**
+     * Saves the state of the simulation into a compact binary snapshot.
+     *
+     * The snapshot holds the step count and accumulated time of the fixed time step,
+     * the transforms, velocities and sleep state of dynamic and kinematic rigid bodies,
+     * the movement state of characters and the wheel state of vehicles. Static objects
+     * and ghost objects are not saved. Forces applied since the last step are not saved,
+     * so snapshots should be saved between updates. Saving a snapshot does not change
+     * the simulation.
+     *
+     * @param snapshot The vector to store the snapshot in. Its capacity is reused, so
+     *      the same vector can be used to save snapshots without allocating memory.
+     * @script{ignore}
+     */
+    void saveSnapshot(std::vector<unsigned char>* snapshot) const;
+
+    /**
+     * Restores the state of the simulation from a snapshot.
+     *
+     * The snapshot must have been saved from the same set of collision objects, added to
+     * the simulation in the same order.
+     *
+     * The contacts cached between objects are not saved, so restoring a snapshot discards
+     * them and rebuilds the broadphase. The first step after restoring recomputes the
+     * contacts without the impulses of the previous step to start the solver from (it is
+     * not warm started), so re-simulated steps can differ slightly from the steps that
+     * followed the snapshot when it was saved. Stepping from the same restored snapshot
+     * always gives the same results.
+     *
+     * @param snapshot The snapshot data.
+     * @param size The size of the snapshot data, in bytes.
+     *
+     * @return true if the snapshot was restored, or false if it does not match the simulation.
+     * @script{ignore}
+     */
+    bool restoreSnapshot(const unsigned char* snapshot, unsigned int size);
+
     /**
      * Draws debugging information (rigid body outlines, etc.) using the given view projection matrix.
      * 
@@ -329,33 +518,50 @@ public:
      */
     bool sweepTest(PhysicsCollisionObject* object, const Vector3& endPosition, PhysicsController::HitResult* result = NULL, PhysicsController::HitFilter* filter = NULL);
 
-private:
-
     /**
-     * Internal class used to integrate with Bullet collision callbacks.
+     * Performs a batch of ray tests on the physics world.
+     *
+     * The results are identical to calling rayTest for each ray in turn. When the physics
+     * controller is configured to use several threads and the world uses the DBVT broadphase,
+     * the rays are tested in parallel, so the filter must be safe to call from several threads
+     * at once. The physics world must not be modified while the batch is being processed.
+     *
+     * @param rays The array of rays to test.
+     * @param distances The array of distances along each ray to test for intersections.
+     * @param count The number of rays to test.
+     * @param results The array of hit results to fill in, one for each ray. The object of a
+     *      result is NULL when its ray did not collide with any physics object.
+     * @param filter Optional filter used for all of the rays.
+     *
+     * @return The number of rays that collided with a physics object.
+     * @script{ignore}
      */
-    class CollisionCallback : public btCollisionWorld::ContactResultCallback
-    {
-    public:
-        /**
-         * Constructor.
-         * 
-         * @param pc The physics controller that owns the callback.
-         */
-        CollisionCallback(PhysicsController* pc) : _pc(pc) {}
+    unsigned int rayTest(const Ray* rays, const float* distances, unsigned int count, PhysicsController::HitResult* results, PhysicsController::HitFilter* filter = NULL);
 
-    protected:
-        /**
-            * Internal function used for Bullet integration (do not use or override).
-            */
-        btScalar addSingleResult(btManifoldPoint& cp, const btCollisionObjectWrapper* a, int partIdA, int indexA, const btCollisionObjectWrapper* b, int partIdB, int indexB);    
+    /**
+     * Performs a batch of sweep tests on the physics world.
+     *
+     * The results are identical to calling sweepTest for each object in turn. When the physics
+     * controller is configured to use several threads and the world uses the DBVT broadphase,
+     * the sweeps are tested in parallel, so the filter must be safe to call from several threads
+     * at once. The physics world must not be modified while the batch is being processed.
+     *
+     * @param objects The array of collision objects to sweep, starting at their current world positions.
+     * @param endPositions The array of end positions of the sweep tests, in world space.
+     * @param count The number of sweep tests.
+     * @param results The array of hit results to fill in, one for each sweep test. The object of a
+     *      result is NULL when its sweep test did not intersect any physics object.
+     * @param filter Optional filter used for all of the sweep tests.
+     *
+     * @return The number of sweep tests that intersected a physics object.
+     * @script{ignore}
+     */
+    unsigned int sweepTest(PhysicsCollisionObject* const* objects, const Vector3* endPositions, unsigned int count, PhysicsController::HitResult* results, PhysicsController::HitFilter* filter = NULL);
 
-    private:
-        PhysicsController* _pc;
-    };
+private:
 
     // Internal constants for the collision status cache.
-    static const int DIRTY;
+    static const int CONTACT;
     static const int COLLISION;
     static const int REGISTERED;
     static const int REMOVE;
@@ -367,6 +573,72 @@ private:
 
         std::vector<PhysicsCollisionObject::CollisionListener*> _listeners;
         int _status;
+        Vector3 _contactPointA;
+        Vector3 _contactPointB;
+    };
+
+    // Hash map key for a collision pair; (A, B) and (B, A) are the same key.
+    struct CollisionPairKey
+    {
+        CollisionPairKey(PhysicsCollisionObject* objectA, PhysicsCollisionObject* objectB);
+
+        unsigned int getHash() const;
+
+        bool equals(const CollisionPairKey& other) const;
+
+        PhysicsCollisionObject::CollisionPair pair;
+    };
+
+    // Identifies a collision shape that can be shared between collision objects.
+    struct ShapeKey
+    {
+        ShapeKey(PhysicsCollisionShape::Type type, float x, float y = 0.0f, float z = 0.0f, const char* url = NULL, bool dynamic = false);
+
+        unsigned int getHash() const;
+
+        bool equals(const ShapeKey& other) const;
+
+        PhysicsCollisionShape::Type type;
+        float values[3];
+        std::string url;
+        bool dynamic;
+    };
+
+    // Identifies a cell of the grid that holds the collision objects frozen by region activation.
+    struct RegionCellKey
+    {
+        RegionCellKey(int x, int y, int z);
+
+        unsigned int getHash() const;
+
+        bool equals(const RegionCellKey& other) const;
+
+        int x;
+        int y;
+        int z;
+    };
+
+    // The region activation state of a collision object.
+    struct RegionObject
+    {
+        RegionObject();
+
+        bool frozen;
+        RegionCellKey cell;
+        int slot;
+    };
+
+    // A collision event queued while the collision status cache is being updated.
+    struct CollisionEvent
+    {
+        CollisionEvent(PhysicsCollisionObject::CollisionListener* listener, PhysicsCollisionObject::CollisionListener::EventType type,
+                       const PhysicsCollisionObject::CollisionPair& pair, const Vector3& contactPointA, const Vector3& contactPointB);
+
+        PhysicsCollisionObject::CollisionListener* listener;
+        PhysicsCollisionObject::CollisionListener::EventType type;
+        PhysicsCollisionObject::CollisionPair pair;
+        Vector3 contactPointA;
+        Vector3 contactPointB;
     };
 
     /**
@@ -404,6 +676,28 @@ private:
      */
     void update(float elapsedTime);
 
+    // Advances the simulation by the given elapsed time (in seconds) using fixed time steps.
+    void stepFixed(float elapsedTime);
+
+    // Applies interpolated transforms to the nodes of rigid bodies updated by fixed time steps.
+    void interpolateMotionStates(float alpha);
+
+    // Applies the latest simulated transforms to all interpolated nodes and stops tracking them.
+    void clearMotionStates();
+
+    // Called by Bullet after each internal simulation step.
+    static void tickCallback(btDynamicsWorld* world, btScalar timeStep);
+
+    // Marks the collision status cache entries of all pairs with contacts in the dispatcher's manifolds.
+    void gatherContacts();
+
+    // Fires collision events for pairs whose collision status changed during the update.
+    void updateCollisionStatus();
+
+    // Queues a collision event for the listeners of the given entry and of its objects.
+    void queueCollisionEvent(const CollisionInfo& info, PhysicsCollisionObject::CollisionListener::EventType type,
+                             const PhysicsCollisionObject::CollisionPair& pair, const PhysicsCollisionObject::CollisionPair& eventPair);
+
     // Adds the given collision listener for the two given collision objects.
     void addCollisionListener(PhysicsCollisionObject::CollisionListener* listener, PhysicsCollisionObject* objectA, PhysicsCollisionObject* objectB);
 
@@ -415,7 +709,56 @@ private:
     
     // Removes the given collision object from the simulated physics world.
     void removeCollisionObject(PhysicsCollisionObject* object, bool removeListeners);
+
+    // Adds the given collision object to the Bullet world.
+    void addToWorld(PhysicsCollisionObject* object);
+
+    // Removes the given collision object from the Bullet world.
+    void removeFromWorld(PhysicsCollisionObject* object);
+
+    // Freezes the simulated collision objects that are far from the focus nodes and restores the frozen ones near them.
+    void updateRegions();
+
+    // Gets the kind of snapshot record saved for the given Bullet collision object.
+    unsigned char getSnapshotKind(const btCollisionObject* collisionObject) const;
+
+    // Reads the object records of a snapshot, checking that they match the simulation, and restores them if apply is true.
+    bool readSnapshotObjects(const unsigned char* data, unsigned int size, bool apply);
+
+    // Recreates the broadphase proxies of all objects in the order of the world's collision object array,
+    // which discards the cached contacts and leaves the broadphase in a state that only depends on that order.
+    void resetBroadphase();
+
+    // Returns the given collision object to the simulation if it is frozen.
+    void restoreFrozenObject(PhysicsCollisionObject* object);
+
+    // Gets the region cell containing the given position.
+    RegionCellKey getRegionCell(const Vector3& position) const;
+
+    // Adds the given collision object to an array of simulated or frozen objects, storing its slot in the array.
+    void addRegionObject(btAlignedObjectArray<PhysicsCollisionObject*>* objects, PhysicsCollisionObject* object, RegionObject* region);
+
+    // Removes the given collision object from the array holding it, by moving the last object of the array into its slot.
+    void removeRegionObject(btAlignedObjectArray<PhysicsCollisionObject*>* objects, RegionObject* region);
+
+    // Returns true if any simulation island was awake after the last simulation step.
+    bool hasActiveIsland() const;
     
+    // Performs a ray test, traversing the broadphase with the given stack (for use from any thread) when it is not NULL.
+    bool rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld, HitResult* result, HitFilter* filter, btAlignedObjectArray<const btDbvtNode*>* stack);
+
+    // Gets the start transform for a sweep test of the given object, returning false if its shape is not supported.
+    bool getSweepStart(PhysicsCollisionObject* object, btTransform* start) const;
+
+    // Performs a sweep test, traversing the broadphase with the given stack (for use from any thread) when it is not NULL.
+    bool sweepTest(PhysicsCollisionObject* object, const btTransform& start, const btTransform& end, HitResult* result, HitFilter* filter, btAlignedObjectArray<const btDbvtNode*>* stack);
+
+    // Processes a range of ray tests of a batch.
+    static void rayTestBatch(void* arg, unsigned int begin, unsigned int end);
+
+    // Processes a range of sweep tests of a batch.
+    static void sweepTestBatch(void* arg, unsigned int begin, unsigned int end);
+
     // Gets the corresponding GamePlay object for the given Bullet object.
     PhysicsCollisionObject* getCollisionObject(const btCollisionObject* collisionObject) const;
 
@@ -441,6 +784,21 @@ private:
     // Destroys a collision shape created through PhysicsController
     void destroyShape(PhysicsCollisionShape* shape);
 
+    // Returns the shared shape with the given key, adding a reference to it, or NULL if there is none.
+    PhysicsCollisionShape* findShape(const ShapeKey& key);
+
+    // Adds the given shape to the shared shapes.
+    void addShape(const ShapeKey& key, PhysicsCollisionShape* shape);
+
+    // Gets the path of the shape cache file for the given key.
+    std::string getShapeCacheFile(const ShapeKey& key) const;
+
+    // Reads the data of a shape cache file into a 16-byte aligned buffer, returning NULL if the file is missing or out of date.
+    unsigned char* readShapeCache(const ShapeKey& key, unsigned int sourceLength, unsigned int vertexCount, unsigned int triangleCount, unsigned int* dataSize) const;
+
+    // Writes the data of a shape cache file.
+    void writeShapeCache(const ShapeKey& key, unsigned int sourceLength, unsigned int vertexCount, unsigned int triangleCount, const void* data, unsigned int dataSize) const;
+
     // Legacy method for grayscale heightmaps: r + g + b, normalized.
     static float normalizedHeightGrayscale(float r, float g, float b);
 
@@ -539,16 +897,33 @@ private:
     btDefaultCollisionConfiguration* _collisionConfiguration;
     btCollisionDispatcher* _dispatcher;
     btBroadphaseInterface* _overlappingPairCache;
+    btDbvtBroadphase* _dbvtBroadphase;
     btSequentialImpulseConstraintSolver* _solver;
     btDynamicsWorld* _world;
     btGhostPairCallback* _ghostPairCallback;
-    std::vector<PhysicsCollisionShape*> _shapes;
+    btHashMap<ShapeKey, PhysicsCollisionShape*> _shapes;
+    btHashMap<btHashPtr, ShapeKey> _shapeKeys;
+    std::string _shapeCachePath;
+    std::vector<Node*> _focusNodes;
+    float _activationDistance;
+    float _deactivationDistance;
+    btHashMap<btHashPtr, RegionObject> _regionObjects;
+    btAlignedObjectArray<PhysicsCollisionObject*> _regionActive;
+    btHashMap<RegionCellKey, btAlignedObjectArray<PhysicsCollisionObject*> > _regionCells;
     DebugDrawer* _debugDrawer;
     Listener::EventType _status;
     std::vector<Listener*>* _listeners;
     Vector3 _gravity;
-    std::map<PhysicsCollisionObject::CollisionPair, CollisionInfo> _collisionStatus;
-    CollisionCallback* _collisionCallback;
+    btHashMap<CollisionPairKey, CollisionInfo> _collisionStatus;
+    std::vector<CollisionEvent> _collisionEvents;
+    bool _ticked;
+    ThreadPool* _threadPool;
+    btAlignedObjectArray<btTransform> _sweepTransforms;
+    float _fixedTimeStep;
+    unsigned int _maxSubSteps;
+    float _accumulator;
+    unsigned int _stepCount;
+    std::vector<PhysicsCollisionObject::PhysicsMotionState*> _motionStates;
 };
 
 }
@@ -22,6 +22,7 @@ class PhysicsVehicleWheel;
 class PhysicsVehicle : public PhysicsCollisionObject
 {
     friend class Node;
+    friend class PhysicsController;
     friend class PhysicsVehicleWheel;
 
 public:
@@ -489,6 +489,7 @@ void RenderState::cloneInto(RenderState* renderState, NodeCloneContext& context)
 RenderState::StateBlock::StateBlock()
     : _cullFaceEnabled(false), _depthTestEnabled(false), _depthWriteEnabled(true), _depthFunction(RenderState::DEPTH_LESS),
       _blendEnabled(false), _blendSrc(RenderState::BLEND_ONE), _blendDst(RenderState::BLEND_ZERO),
+      _blendSeparate(false), _blendSrcAlpha(RenderState::BLEND_ONE), _blendDstAlpha(RenderState::BLEND_ZERO),
       _cullFaceSide(CULL_FACE_SIDE_BACK), _frontFace(FRONT_FACE_CCW), _stencilTestEnabled(false), _stencilWrite(RS_ALL_ONES),
 	  _stencilFunction(RenderState::STENCIL_ALWAYS), _stencilFunctionRef(0), _stencilFunctionMask(RS_ALL_ONES),
 	  _stencilOpSfail(RenderState::STENCIL_OP_KEEP), _stencilOpDpfail(RenderState::STENCIL_OP_KEEP), _stencilOpDppass(RenderState::STENCIL_OP_KEEP),
@@ -535,11 +536,23 @@ void RenderState::StateBlock::bindNoRestore()
             GL_ASSERT( glDisable(GL_BLEND) );
         _defaultState->_blendEnabled = _blendEnabled;
     }
-    if ((_bits & RS_BLEND_FUNC) && (_blendSrc != _defaultState->_blendSrc || _blendDst != _defaultState->_blendDst))
+    if (_bits & RS_BLEND_FUNC)
     {
-        GL_ASSERT( glBlendFunc((GLenum)_blendSrc, (GLenum)_blendDst) );
-        _defaultState->_blendSrc = _blendSrc;
-        _defaultState->_blendDst = _blendDst;
+        // The default state holds the alpha factors currently in use, whether or not they are separate.
+        Blend srcAlpha = _blendSeparate ? _blendSrcAlpha : _blendSrc;
+        Blend dstAlpha = _blendSeparate ? _blendDstAlpha : _blendDst;
+        if (_blendSrc != _defaultState->_blendSrc || _blendDst != _defaultState->_blendDst ||
+            srcAlpha != _defaultState->_blendSrcAlpha || dstAlpha != _defaultState->_blendDstAlpha)
+        {
+            if (srcAlpha == _blendSrc && dstAlpha == _blendDst)
+                GL_ASSERT( glBlendFunc((GLenum)_blendSrc, (GLenum)_blendDst) );
+            else
+                GL_ASSERT( glBlendFuncSeparate((GLenum)_blendSrc, (GLenum)_blendDst, (GLenum)srcAlpha, (GLenum)dstAlpha) );
+            _defaultState->_blendSrc = _blendSrc;
+            _defaultState->_blendDst = _blendDst;
+            _defaultState->_blendSrcAlpha = srcAlpha;
+            _defaultState->_blendDstAlpha = dstAlpha;
+        }
     }
     if ((_bits & RS_CULL_FACE) && (_cullFaceEnabled != _defaultState->_cullFaceEnabled))
     {
@@ -635,6 +648,8 @@ void RenderState::StateBlock::restore(long stateOverrideBits)
         _defaultState->_bits &= ~RS_BLEND_FUNC;
         _defaultState->_blendSrc = RenderState::BLEND_ONE;
         _defaultState->_blendDst = RenderState::BLEND_ZERO;
+        _defaultState->_blendSrcAlpha = RenderState::BLEND_ONE;
+        _defaultState->_blendDstAlpha = RenderState::BLEND_ZERO;
     }
     if (!(stateOverrideBits & RS_CULL_FACE) && (_defaultState->_bits & RS_CULL_FACE))
     {
@@ -728,6 +743,9 @@ void RenderState::StateBlock::cloneInto(StateBlock* state)
     state->_blendEnabled = _blendEnabled;
     state->_blendSrc = _blendSrc;
     state->_blendDst = _blendDst;
+    state->_blendSeparate = _blendSeparate;
+    state->_blendSrcAlpha = _blendSrcAlpha;
+    state->_blendDstAlpha = _blendDstAlpha;
     state->_cullFaceSide = _cullFaceSide;
     state->_frontFace = _frontFace;
 	state->_stencilTestEnabled = _stencilTestEnabled;
@@ -969,6 +987,18 @@ void RenderState::StateBlock::setState(const char* name, const char* value)
     {
         setBlendDst(parseBlend(value));
     }
+    else if (strcmp(name, "blendSeparate") == 0)
+    {
+        setBlendSeparate(parseBoolean(value));
+    }
+    else if (strcmp(name, "blendSrcAlpha") == 0)
+    {
+        setBlendSrcAlpha(parseBlend(value));
+    }
+    else if (strcmp(name, "blendDstAlpha") == 0)
+    {
+        setBlendDstAlpha(parseBlend(value));
+    }
     else if (strcmp(name, "cullFace") == 0)
     {
         setCullFace(parseBoolean(value));
@@ -1047,21 +1077,37 @@ void RenderState::StateBlock::setBlend(bool enabled)
 void RenderState::StateBlock::setBlendSrc(Blend blend)
 {
     _blendSrc = blend;
-    if (_blendSrc == BLEND_ONE && _blendDst == BLEND_ZERO)
-    {
-        // Default blend func
-        _bits &= ~RS_BLEND_FUNC;
-    }
-    else
-    {
-        _bits |= RS_BLEND_FUNC;
-    }
+    updateBlendFunc();
 }
 
 void RenderState::StateBlock::setBlendDst(Blend blend)
 {
     _blendDst = blend;
-    if (_blendSrc == BLEND_ONE && _blendDst == BLEND_ZERO)
+    updateBlendFunc();
+}
+
+void RenderState::StateBlock::setBlendSeparate(bool enabled)
+{
+    _blendSeparate = enabled;
+    updateBlendFunc();
+}
+
+void RenderState::StateBlock::setBlendSrcAlpha(Blend blend)
+{
+    _blendSrcAlpha = blend;
+    updateBlendFunc();
+}
+
+void RenderState::StateBlock::setBlendDstAlpha(Blend blend)
+{
+    _blendDstAlpha = blend;
+    updateBlendFunc();
+}
+
+void RenderState::StateBlock::updateBlendFunc()
+{
+    if (_blendSrc == BLEND_ONE && _blendDst == BLEND_ZERO &&
+        (!_blendSeparate || (_blendSrcAlpha == BLEND_ONE && _blendDstAlpha == BLEND_ZERO)))
     {
         // Default blend func
         _bits &= ~RS_BLEND_FUNC;
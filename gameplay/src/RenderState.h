@@ -313,6 +313,35 @@ public:
          * @param blend Specifies how the destination blending factors are computed.
          */
         void setBlendDst(Blend blend);
+
+        /**
+         * Toggles separate blend factors for the alpha channel.
+         *
+         * By default, the alpha channel is blended with the same factors as the color
+         * channels. When enabled, the factors set by setBlendSrcAlpha and setBlendDstAlpha
+         * are used for the alpha channel instead.
+         *
+         * @param enabled true to enable, false to disable.
+         */
+        void setBlendSeparate(bool enabled);
+
+        /**
+         * Explicitly sets the source used in the blend function for the alpha channel.
+         *
+         * Note that this is only applied when separate alpha blending is enabled.
+         *
+         * @param blend Specifies how the source alpha blending factor is computed.
+         */
+        void setBlendSrcAlpha(Blend blend);
+
+        /**
+         * Explicitly sets the destination used in the blend function for the alpha channel.
+         *
+         * Note that this is only applied when separate alpha blending is enabled.
+         *
+         * @param blend Specifies how the destination alpha blending factor is computed.
+         */
+        void setBlendDstAlpha(Blend blend);
     
         /**
          * Explicitly enables or disables backface culling.
@@ -442,6 +471,8 @@ public:
 
         void cloneInto(StateBlock* state);
 
+        void updateBlendFunc();
+
         // States
         bool _cullFaceEnabled;
         bool _depthTestEnabled;
@@ -450,6 +481,9 @@ public:
         bool _blendEnabled;
         Blend _blendSrc;
         Blend _blendDst;
+        bool _blendSeparate;
+        Blend _blendSrcAlpha;
+        Blend _blendDstAlpha;
         CullFaceSide _cullFaceSide;
         FrontFace _frontFace;
 		bool _stencilTestEnabled;
@@ -128,6 +128,83 @@ static bool getNestedVariable(lua_State* lua, const char* name)
     return false;
 }
 
+/**
+ * Parses the next argument of a function's argument signature.
+ *
+ * @param sig The signature, which is advanced past the parsed argument.
+ * @param type Receives the argument type character.
+ * @param typeName Receives the enumeration type name for '[' or the Lua class name for '<'.
+ *
+ * @return True if an argument was parsed, false if the signature is invalid.
+ */
+static bool parseArgument(const char*& sig, char* type, std::string* typeName)
+{
+    *type = *sig++;
+    switch (*type)
+    {
+    case 'c':
+    case 'h':
+    case 'i':
+    case 'l':
+    case 'b':
+    case 'f':
+    case 'd':
+    case 's':
+    case 'p':
+        return true;
+    case 'u':
+        // Skip past the actual type (long, int, short, char).
+        if (*sig)
+            sig++;
+        return true;
+    case '[':
+    case '<':
+    {
+        const char* end = strchr(sig, *type == '[' ? ']' : '>');
+        if (end == NULL)
+        {
+            GP_ERROR("Missing closing bracket in argument signature.");
+            return false;
+        }
+        typeName->assign(sig, end);
+        sig = end + 1;
+
+        if (*type == '<')
+        {
+            // Calculate the unique Lua type name. We use "" as the replacement here-this must match
+            // the preprocessor define SCOPE_REPLACEMENT from the gameplay-luagen project.
+            size_t i = typeName->find("::");
+            while (i != std::string::npos)
+            {
+                typeName->replace(i, 2, "");
+                i = typeName->find("::");
+            }
+        }
+        return true;
+    }
+    default:
+        GP_ERROR("Invalid argument type '%d'.", *type);
+        return false;
+    }
+}
+
+// The argument signatures of the script callbacks, indexed by ScriptController::ScriptCallback.
+static const char* CALLBACK_ARGS[] =
+{
+    NULL,                                   // INITIALIZE
+    "f",                                    // UPDATE
+    "f",                                    // RENDER
+    NULL,                                   // FINALIZE
+    "uiui",                                 // RESIZE_EVENT
+    "[Keyboard::KeyEvent][Keyboard::Key]",  // KEY_EVENT
+    "[Mouse::MouseEvent]iii",               // MOUSE_EVENT
+    "[Touch::TouchEvent]iiui",              // TOUCH_EVENT
+    "iii",                                  // GESTURE_SWIPE_EVENT
+    "iif",                                  // GESTURE_PINCH_EVENT
+    "ii",                                   // GESTURE_TAP_EVENT
+    "[Gamepad::GamepadEvent]<Gamepad>"      // GAMEPAD_EVENT
+};
+
 namespace gameplay
 {
 
@@ -462,6 +539,9 @@ void ScriptController::loadScript(const char* path, bool forceReload)
             success = true;
         }
 #endif
+        // The script may have redefined functions referenced by ScriptFunction handles.
+        ++_generation;
+
         if (!success && (iter == _loadedScripts.end()))
         {
             iter = _loadedScripts.find(path);
@@ -668,8 +748,11 @@ void ScriptController::print(const char* str1, const char* str2)
     gameplay::print("%s%s", str1, str2);
 }
 
-ScriptController::ScriptController() : _lua(NULL)
+ScriptController::ScriptController()
+    : _lua(NULL), _generation(0), _stateGeneration(0), _gcBudget(0), _gcPause(200), _gcThreshold(0), _gcCollecting(false),
+      _allocFunction(NULL), _allocUserData(NULL)
 {
+    memset(&_gcStats, 0, sizeof(_gcStats));
 }
 
 ScriptController::~ScriptController()
@@ -733,6 +816,12 @@ void ScriptController::initialize()
     _lua = luaL_newstate();
     if (!_lua)
         GP_ERROR("Failed to initialize Lua scripting engine.");
+    _stateGeneration = ++_generation;
+#ifndef LUAJIT_VERSION_NUM
+    // Count allocations for the garbage collection statistics.
+    _allocFunction = lua_getallocf(_lua, &_allocUserData);
+    lua_setallocf(_lua, ScriptController::allocate, this);
+#endif
     luaL_openlibs(_lua);
 
 #ifndef NO_LUA_BINDINGS
@@ -769,13 +858,22 @@ void ScriptController::initialize()
         if (luaL_dostring(_lua, argsStr.c_str()))
             GP_ERROR("Failed to pass command-line arguments with error: '%s'.", lua_tostring(_lua, -1));
     }
+
+    // Configure per-frame garbage collection.
+    Properties* config = Game::getInstance()->getConfig()->getNamespace("script", true);
+    if (config)
+    {
+        if (config->exists("gcPause"))
+            _gcPause = (unsigned int)std::max(config->getInt("gcPause"), 100);
+        setGarbageCollectionBudget(config->getFloat("gcBudget"));
+    }
 }
 
 void ScriptController::initializeGame()
 {
-    std::vector<std::string>& list = _callbacks[INITIALIZE];
+    std::vector<ScriptFunction>& list = _callbacks[INITIALIZE];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str());
+        executeFunction<void>(&list[i]);
 }
 
 void ScriptController::finalize()
@@ -784,12 +882,13 @@ void ScriptController::finalize()
 	{
         lua_close(_lua);
 		_lua = NULL;
+        ++_generation;
 	}
 }
 
 void ScriptController::finalizeGame()
 {
-    std::vector<std::string> finalizeCallbacks = _callbacks[FINALIZE]; // no & : makes a copy of the vector
+    std::vector<ScriptFunction> finalizeCallbacks = _callbacks[FINALIZE]; // no & : makes a copy of the vector
 
 	// Remove any registered callbacks so they don't get called after shutdown
 	for (unsigned int i = 0; i < CALLBACK_COUNT; i++)
@@ -797,7 +896,7 @@ void ScriptController::finalizeGame()
 
 	// Fire script finalize callbacks
     for (size_t i = 0; i < finalizeCallbacks.size(); ++i)
-        executeFunction<void>(finalizeCallbacks[i].c_str());
+        executeFunction<void>(&finalizeCallbacks[i]);
 
     // Perform a full garbage collection cycle.
 	// Note that this does NOT free any global variables declared in scripts, since 
@@ -808,45 +907,141 @@ void ScriptController::finalizeGame()
 
 void ScriptController::update(float elapsedTime)
 {
-    std::vector<std::string>& list = _callbacks[UPDATE];
+    std::vector<ScriptFunction>& list = _callbacks[UPDATE];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "f", elapsedTime);
+        executeFunction<void>(&list[i], elapsedTime);
 }
 
 void ScriptController::render(float elapsedTime)
 {
-    std::vector<std::string>& list = _callbacks[RENDER];
+    std::vector<ScriptFunction>& list = _callbacks[RENDER];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "f", elapsedTime);
+        executeFunction<void>(&list[i], elapsedTime);
+}
+
+float ScriptController::getGarbageCollectionBudget() const
+{
+    return _gcBudget;
+}
+
+void ScriptController::setGarbageCollectionBudget(float budget)
+{
+    _gcBudget = std::max(budget, 0.0f);
+    _gcCollecting = false;
+    if (!_lua)
+        return;
+
+    if (_gcBudget > 0)
+    {
+        lua_gc(_lua, LUA_GCSTOP, 0);
+        _gcThreshold = getMemoryUsage() * _gcPause / 100;
+    }
+    else
+    {
+        lua_gc(_lua, LUA_GCRESTART, 0);
+    }
+}
+
+void ScriptController::getGarbageCollectionStats(GarbageCollectionStats* stats) const
+{
+    GP_ASSERT(stats);
+
+    *stats = _gcStats;
+    stats->memoryUsage = 0;
+    if (_lua)
+        stats->memoryUsage = (size_t)lua_gc(_lua, LUA_GCCOUNT, 0) * 1024 + (size_t)lua_gc(_lua, LUA_GCCOUNTB, 0);
+}
+
+void ScriptController::collectGarbage()
+{
+    if (!_lua || _gcBudget <= 0)
+        return;
+
+    _gcStats.frameStepCount = 0;
+    _gcStats.frameTime = 0;
+
+    size_t memory = getMemoryUsage();
+    if (!_gcCollecting)
+    {
+        if (memory < _gcThreshold)
+            return;
+        _gcCollecting = true;
+    }
+
+    // Finish the cycle regardless of the budget if memory use keeps outgrowing the collector.
+    bool finish = (_gcThreshold > 0 && memory >= _gcThreshold * 2);
+
+    double startTime = Game::getAbsoluteTime();
+    do
+    {
+        ++_gcStats.frameStepCount;
+        if (lua_gc(_lua, LUA_GCSTEP, 0))
+        {
+            // The cycle is complete; wait for memory use to grow before starting the next one.
+            _gcCollecting = false;
+            _gcThreshold = getMemoryUsage() * _gcPause / 100;
+            ++_gcStats.cycleCount;
+            break;
+        }
+    } while (finish || Game::getAbsoluteTime() - startTime < _gcBudget);
+
+    // Stepping re-enables the automatic collector in Lua 5.1 and LuaJIT.
+    lua_gc(_lua, LUA_GCSTOP, 0);
+
+    _gcStats.frameTime = (float)(Game::getAbsoluteTime() - startTime);
+    _gcStats.maxFrameTime = std::max(_gcStats.maxFrameTime, _gcStats.frameTime);
+}
+
+size_t ScriptController::getMemoryUsage() const
+{
+    return (size_t)lua_gc(_lua, LUA_GCCOUNT, 0);
+}
+
+void* ScriptController::allocate(void* userData, void* ptr, size_t oldSize, size_t newSize)
+{
+    ScriptController* sc = (ScriptController*)userData;
+
+    // Lua 5.1 allocates new blocks with a NULL ptr and an oldSize of 0. Blocks that are
+    // reallocated to a different size are not counted, since they are not new objects.
+    if (ptr == NULL && newSize > 0)
+        ++sc->_gcStats.allocationCount;
+    return sc->_allocFunction(sc->_allocUserData, ptr, oldSize, newSize);
+}
+
+const std::vector<std::string>* ScriptController::getDerivedTypes(const char* type) const
+{
+    // Look up without inserting, so failed type checks do not grow the hierarchy.
+    std::map<std::string, std::vector<std::string> >::const_iterator itr = _hierarchy.find(type);
+    return itr != _hierarchy.end() ? &itr->second : NULL;
 }
 
 void ScriptController::resizeEvent(unsigned int width, unsigned int height)
 {
-    std::vector<std::string>& list = _callbacks[RESIZE_EVENT];
+    std::vector<ScriptFunction>& list = _callbacks[RESIZE_EVENT];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "uiui", width, height);
+        executeFunction<void>(&list[i], width, height);
 }
 
 void ScriptController::keyEvent(Keyboard::KeyEvent evt, int key)
 {
-    std::vector<std::string>& list = _callbacks[KEY_EVENT];
+    std::vector<ScriptFunction>& list = _callbacks[KEY_EVENT];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "[Keyboard::KeyEvent][Keyboard::Key]", evt, key);
+        executeFunction<void>(&list[i], evt, key);
 }
 
 void ScriptController::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
 {
-    std::vector<std::string>& list = _callbacks[TOUCH_EVENT];
+    std::vector<ScriptFunction>& list = _callbacks[TOUCH_EVENT];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "[Touch::TouchEvent]iiui", evt, x, y, contactIndex);
+        executeFunction<void>(&list[i], evt, x, y, contactIndex);
 }
 
 bool ScriptController::mouseEvent(Mouse::MouseEvent evt, int x, int y, int wheelDelta)
 {
-    std::vector<std::string>& list = _callbacks[MOUSE_EVENT];
+    std::vector<ScriptFunction>& list = _callbacks[MOUSE_EVENT];
     for (size_t i = 0; i < list.size(); ++i)
     {
-        if (executeFunction<bool>(list[i].c_str(), "[Mouse::MouseEvent]iii", evt, x, y, wheelDelta))
+        if (executeFunction<bool>(&list[i], evt, x, y, wheelDelta))
             return true;
     }
     return false;
@@ -854,23 +1049,23 @@ bool ScriptController::mouseEvent(Mouse::MouseEvent evt, int x, int y, int wheel
 
 void ScriptController::gestureSwipeEvent(int x, int y, int direction)
 {
-    std::vector<std::string>& list = _callbacks[GESTURE_SWIPE_EVENT];
+    std::vector<ScriptFunction>& list = _callbacks[GESTURE_SWIPE_EVENT];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "iii", x, y, direction);
+        executeFunction<void>(&list[i], x, y, direction);
 }
 
 void ScriptController::gesturePinchEvent(int x, int y, float scale)
 {
-    std::vector<std::string>& list = _callbacks[GESTURE_PINCH_EVENT];
+    std::vector<ScriptFunction>& list = _callbacks[GESTURE_PINCH_EVENT];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "iif", x, y, scale);
+        executeFunction<void>(&list[i], x, y, scale);
 }
 
 void ScriptController::gestureTapEvent(int x, int y)
 {
-    std::vector<std::string>& list = _callbacks[GESTURE_TAP_EVENT];
+    std::vector<ScriptFunction>& list = _callbacks[GESTURE_TAP_EVENT];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "ii", x, y);
+        executeFunction<void>(&list[i], x, y);
 }
 
 void ScriptController::gestureLongTapEvent(int x, int y, float duration)
@@ -887,9 +1082,9 @@ void ScriptController::gestureDropEvent(int x, int y)
 
 void ScriptController::gamepadEvent(Gamepad::GamepadEvent evt, Gamepad* gamepad, unsigned int analogIndex)
 {
-    std::vector<std::string>& list = _callbacks[GAMEPAD_EVENT];
+    std::vector<ScriptFunction>& list = _callbacks[GAMEPAD_EVENT];
     for (size_t i = 0; i < list.size(); ++i)
-        executeFunction<void>(list[i].c_str(), "[Gamepad::GamepadEvent]<Gamepad>", evt, gamepad);
+        executeFunction<void>(&list[i], evt, gamepad);
 }
 
 void ScriptController::executeFunctionHelper(int resultCount, const char* func, const char* args, va_list* list)
@@ -909,115 +1104,132 @@ void ScriptController::executeFunctionHelper(int resultCount, const char* func,
         return;
     }
 
-    const char* sig = args;
     int argumentCount = 0;
 
     // Push the arguments to the Lua stack if there are any.
-    if (sig)
+    if (args)
     {
-        while (true)
+        const char* sig = args;
+        char type;
+        std::string typeName;
+        while (*sig)
         {
-            if (!(*sig))
+            if (!parseArgument(sig, &type, &typeName))
                 break;
 
-            switch(*sig++)
-            {
-            // Signed integers.
-            case 'c':
-            case 'h':
-            case 'i':
-            case 'l':
-                lua_pushinteger(_lua, va_arg(*list, int));
-                break;
-            // Unsigned integers.
-            case 'u':
-                // Skip past the actual type (long, int, short, char).
-                sig++;
-                lua_pushunsigned(_lua, va_arg(*list, int));
-                break;
-            // Booleans.
-            case 'b':
-                lua_pushboolean(_lua, va_arg(*list, int));
-                break;
-            // Floating point numbers.
-            case 'f':
-            case 'd':
-                lua_pushnumber(_lua, va_arg(*list, double));
-                break;
-            // Strings.
-            case 's':
-                lua_pushstring(_lua, va_arg(*list, char*));
-                break;
-            // Pointers.
-            case 'p':
-                lua_pushlightuserdata(_lua, va_arg(*list, void*));
-                break;
-            // Enums.
-            case '[':
-            {
-                std::string type = sig;
-                type = type.substr(0, type.find("]"));
+            pushArgument(type, typeName, list);
+            argumentCount++;
+            luaL_checkstack(_lua, 1, "Too many arguments.");
+        }
+    }
 
-                // Skip past the closing ']' (the semi-colon here is intentional-do not remove).
-                while (*sig++ != ']');
+    // Perform the function call.
+    if (lua_pcall(_lua, argumentCount, resultCount, 0) != 0)
+        GP_WARN("Failed to call function '%s' with error '%s'.", func, lua_tostring(_lua, -1));
+}
 
-                unsigned int value = va_arg(*list, int);
-                std::string enumStr = "";
-                for (unsigned int i = 0; enumStr.size() == 0 && i < _stringFromEnum.size(); i++)
-                {
-                    enumStr = (*_stringFromEnum[i])(type, value);
-                }
+bool ScriptController::executeFunctionHelper(int resultCount, ScriptFunction* function, va_list* list)
+{
+    if (!_lua)
+        return false; // handles calling this method after script is finalized
 
-                lua_pushstring(_lua, enumStr.c_str());
-                break;
-            }
-            // Object references/pointers (Lua userdata).
-            case '<':
-            {
-                std::string type = sig;
-                type = type.substr(0, type.find(">"));
+    GP_ASSERT(function);
 
-                // Skip past the closing '>' (the semi-colon here is intentional-do not remove).
-                while (*sig++ != '>');
+    // Resolve the function if a script was loaded since it was last resolved.
+    if (function->_generation != _generation)
+    {
+        function->invalidate();
+        if (getNestedVariable(_lua, function->_name.c_str()) && lua_isfunction(_lua, -1))
+            function->_ref = luaL_ref(_lua, LUA_REGISTRYINDEX);
+        function->_generation = _generation;
+    }
 
-                // Calculate the unique Lua type name.
-                size_t i = type.find("::");
-                while (i != std::string::npos)
-                {
-                    // We use "" as the replacement here-this must match the preprocessor
-                    // define SCOPE_REPLACEMENT from the gameplay-luagen project.
-                    type.replace(i, 2, "");
-                    i = type.find("::");
-                }
+    if (function->_ref == LUA_NOREF)
+    {
+        GP_WARN("Failed to call function '%s'", function->_name.c_str());
+        return false;
+    }
 
-                void* ptr = va_arg(*list, void*);
-                if (ptr == NULL)
-                {
-                    lua_pushnil(_lua);
-                }
-                else
-                {
-                    ScriptUtil::LuaObject* object = (ScriptUtil::LuaObject*)lua_newuserdata(_lua, sizeof(ScriptUtil::LuaObject));
-                    object->instance = ptr;
-                    object->owns = false;
-                    luaL_getmetatable(_lua, type.c_str());
-                    lua_setmetatable(_lua, -2);
-                }
-                break;
-            }
-            default:
-                GP_ERROR("Invalid argument type '%d'.", *(sig - 1));
-                break;
-            }
+    lua_rawgeti(_lua, LUA_REGISTRYINDEX, function->_ref);
+    for (size_t i = 0, count = function->_arguments.size(); i < count; ++i)
+    {
+        ScriptFunction::Argument& argument = function->_arguments[i];
+        pushArgument(argument.type, argument.typeName, list);
+        luaL_checkstack(_lua, 1, "Too many arguments.");
+    }
 
-            argumentCount++;
-            luaL_checkstack(_lua, 1, "Too many arguments.");
-        }
+    if (lua_pcall(_lua, (int)function->_arguments.size(), resultCount, 0) != 0)
+    {
+        GP_WARN("Failed to call function '%s' with error '%s'.", function->_name.c_str(), lua_tostring(_lua, -1));
+        return false;
     }
+    return true;
+}
 
-    // Perform the function call.
-    if (lua_pcall(_lua, argumentCount, resultCount, 0) != 0)
-        GP_WARN("Failed to call function '%s' with error '%s'.", func, lua_tostring(_lua, -1));
+void ScriptController::pushArgument(char type, std::string& typeName, va_list* list)
+{
+    switch (type)
+    {
+    // Signed integers.
+    case 'c':
+    case 'h':
+    case 'i':
+    case 'l':
+        lua_pushinteger(_lua, va_arg(*list, int));
+        break;
+    // Unsigned integers.
+    case 'u':
+        lua_pushunsigned(_lua, va_arg(*list, int));
+        break;
+    // Booleans.
+    case 'b':
+        lua_pushboolean(_lua, va_arg(*list, int));
+        break;
+    // Floating point numbers.
+    case 'f':
+    case 'd':
+        lua_pushnumber(_lua, va_arg(*list, double));
+        break;
+    // Strings.
+    case 's':
+        lua_pushstring(_lua, va_arg(*list, char*));
+        break;
+    // Pointers.
+    case 'p':
+        lua_pushlightuserdata(_lua, va_arg(*list, void*));
+        break;
+    // Enums.
+    case '[':
+    {
+        unsigned int value = va_arg(*list, int);
+        std::string enumStr = "";
+        for (unsigned int i = 0; enumStr.size() == 0 && i < _stringFromEnum.size(); i++)
+        {
+            enumStr = (*_stringFromEnum[i])(typeName, value);
+        }
+
+        lua_pushstring(_lua, enumStr.c_str());
+        break;
+    }
+    // Object references/pointers (Lua userdata).
+    case '<':
+    {
+        void* ptr = va_arg(*list, void*);
+        if (ptr == NULL)
+        {
+            lua_pushnil(_lua);
+        }
+        else
+        {
+            ScriptUtil::LuaObject* object = (ScriptUtil::LuaObject*)lua_newuserdata(_lua, sizeof(ScriptUtil::LuaObject));
+            object->instance = ptr;
+            object->owns = false;
+            luaL_getmetatable(_lua, typeName.c_str());
+            lua_setmetatable(_lua, -2);
+        }
+        break;
+    }
+    }
 }
 
 void ScriptController::registerCallback(const char* callback, const char* function)
@@ -1025,7 +1237,7 @@ void ScriptController::registerCallback(const char* callback, const char* functi
     ScriptCallback scb = toCallback(callback);
     if (scb < INVALID_CALLBACK)
     {
-        _callbacks[scb].push_back(function);
+        _callbacks[scb].push_back(ScriptFunction(function, CALLBACK_ARGS[scb]));
     }
     else
     {
@@ -1038,10 +1250,15 @@ void ScriptController::unregisterCallback(const char* callback, const char* func
     ScriptCallback scb = toCallback(callback);
     if (scb < INVALID_CALLBACK)
     {
-        std::vector<std::string>& list = _callbacks[scb];
-        std::vector<std::string>::iterator itr = std::find(list.begin(), list.end(), std::string(function));
-        if (itr != list.end())
-            list.erase(itr);
+        std::vector<ScriptFunction>& list = _callbacks[scb];
+        for (std::vector<ScriptFunction>::iterator itr = list.begin(); itr != list.end(); ++itr)
+        {
+            if (itr->_name == function)
+            {
+                list.erase(itr);
+                break;
+            }
+        }
     }
     else
     {
@@ -1370,4 +1587,242 @@ template<> std::string ScriptController::executeFunction<std::string>(const char
     SCRIPT_EXECUTE_FUNCTION_PARAM_LIST(std::string, luaL_checkstring);
 }
 
+#define SCRIPT_EXECUTE_HANDLE_PARAM(type) \
+    va_list list; \
+    va_start(list, function); \
+    type value = executeFunction<type>(function, &list); \
+    va_end(list); \
+    return value;
+
+#define SCRIPT_EXECUTE_HANDLE_PARAM_LIST(type, checkfunc, defaultValue) \
+    int top = lua_gettop(_lua); \
+    type value = executeFunctionHelper(1, function, list) ? (type)checkfunc(_lua, -1) : (defaultValue); \
+    lua_settop(_lua, top); \
+    return value;
+
+/** Template specialization. */
+template<> void ScriptController::executeFunction<void>(ScriptFunction* function, ...)
+{
+    int top = lua_gettop(_lua);
+    va_list list;
+    va_start(list, function);
+    executeFunctionHelper(0, function, &list);
+    va_end(list);
+    lua_settop(_lua, top);
+}
+
+/** Template specialization. */
+template<> bool ScriptController::executeFunction<bool>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(bool);
+}
+
+/** Template specialization. */
+template<> char ScriptController::executeFunction<char>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(char);
+}
+
+/** Template specialization. */
+template<> short ScriptController::executeFunction<short>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(short);
+}
+
+/** Template specialization. */
+template<> int ScriptController::executeFunction<int>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(int);
+}
+
+/** Template specialization. */
+template<> long ScriptController::executeFunction<long>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(long);
+}
+
+/** Template specialization. */
+template<> unsigned char ScriptController::executeFunction<unsigned char>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(unsigned char);
+}
+
+/** Template specialization. */
+template<> unsigned short ScriptController::executeFunction<unsigned short>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(unsigned short);
+}
+
+/** Template specialization. */
+template<> unsigned int ScriptController::executeFunction<unsigned int>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(unsigned int);
+}
+
+/** Template specialization. */
+template<> unsigned long ScriptController::executeFunction<unsigned long>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(unsigned long);
+}
+
+/** Template specialization. */
+template<> float ScriptController::executeFunction<float>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(float);
+}
+
+/** Template specialization. */
+template<> double ScriptController::executeFunction<double>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(double);
+}
+
+/** Template specialization. */
+template<> std::string ScriptController::executeFunction<std::string>(ScriptFunction* function, ...)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM(std::string);
+}
+
+/** Template specialization. */
+template<> void ScriptController::executeFunction<void>(ScriptFunction* function, va_list* list)
+{
+    int top = lua_gettop(_lua);
+    executeFunctionHelper(0, function, list);
+    lua_settop(_lua, top);
+}
+
+/** Template specialization. */
+template<> bool ScriptController::executeFunction<bool>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(bool, ScriptUtil::luaCheckBool, false);
+}
+
+/** Template specialization. */
+template<> char ScriptController::executeFunction<char>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(char, luaL_checkint, 0);
+}
+
+/** Template specialization. */
+template<> short ScriptController::executeFunction<short>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(short, luaL_checkint, 0);
+}
+
+/** Template specialization. */
+template<> int ScriptController::executeFunction<int>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(int, luaL_checkint, 0);
+}
+
+/** Template specialization. */
+template<> long ScriptController::executeFunction<long>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(long, luaL_checklong, 0);
+}
+
+/** Template specialization. */
+template<> unsigned char ScriptController::executeFunction<unsigned char>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(unsigned char, luaL_checkunsigned, 0);
+}
+
+/** Template specialization. */
+template<> unsigned short ScriptController::executeFunction<unsigned short>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(unsigned short, luaL_checkunsigned, 0);
+}
+
+/** Template specialization. */
+template<> unsigned int ScriptController::executeFunction<unsigned int>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(unsigned int, luaL_checkunsigned, 0);
+}
+
+/** Template specialization. */
+template<> unsigned long ScriptController::executeFunction<unsigned long>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(unsigned long, luaL_checkunsigned, 0);
+}
+
+/** Template specialization. */
+template<> float ScriptController::executeFunction<float>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(float, luaL_checknumber, 0);
+}
+
+/** Template specialization. */
+template<> double ScriptController::executeFunction<double>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(double, luaL_checknumber, 0);
+}
+
+/** Template specialization. */
+template<> std::string ScriptController::executeFunction<std::string>(ScriptFunction* function, va_list* list)
+{
+    SCRIPT_EXECUTE_HANDLE_PARAM_LIST(std::string, luaL_checkstring, std::string());
+}
+
+ScriptFunction::ScriptFunction(const char* name, const char* args)
+    : _name(name ? name : ""), _ref(LUA_NOREF), _generation(0)
+{
+    if (args)
+    {
+        const char* sig = args;
+        char type;
+        std::string typeName;
+        while (*sig)
+        {
+            if (!parseArgument(sig, &type, &typeName))
+                break;
+            _arguments.push_back(Argument(type, typeName));
+        }
+    }
+}
+
+ScriptFunction::ScriptFunction(const ScriptFunction& copy)
+    : _name(copy._name), _arguments(copy._arguments), _ref(LUA_NOREF), _generation(0)
+{
+}
+
+ScriptFunction::~ScriptFunction()
+{
+    invalidate();
+}
+
+ScriptFunction& ScriptFunction::operator=(const ScriptFunction& copy)
+{
+    if (this != &copy)
+    {
+        invalidate();
+        _name = copy._name;
+        _arguments = copy._arguments;
+    }
+    return *this;
+}
+
+const char* ScriptFunction::getName() const
+{
+    return _name.c_str();
+}
+
+void ScriptFunction::invalidate()
+{
+    if (_ref != LUA_NOREF)
+    {
+        // Only release the reference if it belongs to the current Lua state.
+        Game* game = Game::getInstance();
+        ScriptController* sc = game ? game->getScriptController() : NULL;
+        if (sc && sc->_lua && _generation >= sc->_stateGeneration)
+            luaL_unref(sc->_lua, LUA_REGISTRYINDEX, _ref);
+        _ref = LUA_NOREF;
+    }
+    _generation = 0;
+}
+
+ScriptFunction::Argument::Argument(char type, const std::string& typeName)
+    : type(type), typeName(typeName)
+{
+}
+
 }
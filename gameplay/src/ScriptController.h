@@ -43,6 +43,8 @@ public:
 
     /**
      * Creates a LuaArray to store a single pointer value.
+     *
+     * The pointer is not owned by the LuaArray, so no memory is allocated to track it.
      */
     LuaArray(T* param);
 
@@ -96,9 +98,28 @@ private:
         int refCount;
     };
 
+    void release();
+
+    T* _value;
     Data* _data;
 };
 
+/**
+ * Pushes a copy of the given value onto the Lua stack as a full userdata that stores
+ * the value inline, without a separate heap allocation for the object.
+ *
+ * The value is freed along with the userdata by the Lua garbage collector without its
+ * destructor being called, so this must only be used for types with trivial destructors
+ * (such as the math value types returned by value from the bindings).
+ *
+ * @param state The Lua state to push the value onto.
+ * @param value The value to push.
+ * @param type The name of the value type's metatable.
+ *
+ * @script{ignore}
+ */
+template<typename T> void pushValue(lua_State* state, const T& value, const char* type);
+
 /**
  * Registers the given library with Lua.
  * 
@@ -340,6 +361,80 @@ bool luaCheckBool(lua_State* state, int n);
 
 }
 
+/**
+ * Defines a handle to a Lua function that can be called repeatedly without looking it up by name.
+ *
+ * The argument signature is parsed when the handle is created. The function is looked up the
+ * first time the handle is called and is then held through a Lua registry reference. Loading
+ * a script invalidates all handles, so they follow functions that are redefined by a reloaded
+ * script.
+ *
+ * @script{ignore}
+ */
+class ScriptFunction
+{
+    friend class ScriptController;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param name The name of the Lua function, which may be a '.' separated list of nested tables
+     *      ending with the function name.
+     * @param args The argument signature of the function (see ScriptController::executeFunction).
+     */
+    ScriptFunction(const char* name, const char* args = NULL);
+
+    /**
+     * Copy constructor.
+     */
+    ScriptFunction(const ScriptFunction& copy);
+
+    /**
+     * Destructor.
+     */
+    ~ScriptFunction();
+
+    /**
+     * Copy assignment operator.
+     */
+    ScriptFunction& operator=(const ScriptFunction& copy);
+
+    /**
+     * Returns the name of the Lua function.
+     *
+     * @return The function name.
+     */
+    const char* getName() const;
+
+    /**
+     * Invalidates the handle so that the function is looked up again the next time it is called.
+     *
+     * This only needs to be called when a script assigns a new function to the name without
+     * loading a script.
+     */
+    void invalidate();
+
+private:
+
+    /**
+     * A parsed argument of the function's signature.
+     */
+    struct Argument
+    {
+        Argument(char type, const std::string& typeName);
+
+        char type;
+        std::string typeName;
+    };
+
+    std::string _name;
+    std::vector<Argument> _arguments;
+    int _ref;
+    unsigned int _generation;
+};
+
 /**
  * Controls and manages all scripts.
  */
@@ -347,6 +442,7 @@ class ScriptController
 {
     friend class Game;
     friend class Platform;
+    friend class ScriptFunction;
 
 public:
 
@@ -451,6 +547,30 @@ public:
      */
     template<typename T> T executeFunction(const char* func, const char* args, va_list* list);
 
+    /**
+     * Calls the Lua function referenced by the given handle using the given parameters.
+     *
+     * This is faster than calling a function by name, since the function and its argument
+     * signature are only resolved once.
+     *
+     * @param function The handle of the function to call.
+     *
+     * @return The return value of the executed Lua function.
+     * @script{ignore}
+     */
+    template<typename T> T executeFunction(ScriptFunction* function, ...);
+
+    /**
+     * Calls the Lua function referenced by the given handle using the given parameters.
+     *
+     * @param function The handle of the function to call.
+     * @param list The variable argument list containing the function's parameters.
+     *
+     * @return The return value of the executed Lua function.
+     * @script{ignore}
+     */
+    template<typename T> T executeFunction(ScriptFunction* function, va_list* list);
+
     /**
      * Gets the global boolean script variable with the given name.
      * 
@@ -754,6 +874,62 @@ public:
      */
     static void print(const char* str1, const char* str2);
 
+    /**
+     * Defines statistics about the Lua garbage collector.
+     *
+     * @script{ignore}
+     */
+    struct GarbageCollectionStats
+    {
+        /** The memory in use by Lua, in bytes. */
+        size_t memoryUsage;
+        /** The number of collection cycles completed by the per-frame collector. */
+        unsigned int cycleCount;
+        /** The number of incremental steps performed in the last frame. */
+        unsigned int frameStepCount;
+        /** The time spent collecting garbage in the last frame, in milliseconds. */
+        float frameTime;
+        /** The longest time spent collecting garbage in a single frame, in milliseconds. */
+        float maxFrameTime;
+        /**
+         * The number of new memory blocks Lua has allocated since the script controller was
+         * initialized. Blocks that Lua reallocates to a different size are not counted. This is
+         * always zero when the engine is built against LuaJIT, which does not support custom
+         * allocators on every platform.
+         */
+        unsigned int allocationCount;
+    };
+
+    /**
+     * Returns the time each frame that may be spent collecting Lua garbage.
+     *
+     * @return The garbage collection budget, in milliseconds, or zero if Lua collects garbage automatically.
+     */
+    float getGarbageCollectionBudget() const;
+
+    /**
+     * Sets the time each frame that may be spent collecting Lua garbage.
+     *
+     * With a budget, Lua's automatic collector is stopped and the garbage is instead collected in
+     * incremental steps at the end of each frame until the budget is spent. A collection cycle
+     * starts once memory use has grown by the collector's pause percentage (the "gcPause" setting
+     * of the "script" config namespace, 200 by default) since the end of the previous cycle. If
+     * memory use doubles again before the cycle completes, the cycle is finished regardless of
+     * the budget.
+     *
+     * @param budget The garbage collection budget, in milliseconds, or zero to let Lua collect
+     *      garbage automatically.
+     */
+    void setGarbageCollectionBudget(float budget);
+
+    /**
+     * Gets statistics about the Lua garbage collector.
+     *
+     * @param stats Receives the garbage collection statistics.
+     * @script{ignore}
+     */
+    void getGarbageCollectionStats(GarbageCollectionStats* stats) const;
+
 private:
 
     /**
@@ -822,6 +998,27 @@ private:
      */
     void render(float elapsedTime);
 
+    /**
+     * Collects Lua garbage within the per-frame budget. Called at the end of each frame.
+     */
+    void collectGarbage();
+
+    /**
+     * Returns the memory in use by Lua, in kilobytes.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * Lua memory allocation function that counts allocations before forwarding them
+     * to Lua's original allocator.
+     */
+    static void* allocate(void* userData, void* ptr, size_t oldSize, size_t newSize);
+
+    /**
+     * Returns the types registered as derived from the given type, or NULL if there are none.
+     */
+    const std::vector<std::string>* getDerivedTypes(const char* type) const;
+
     /**
      * Script callback for game resize events.
      *
@@ -959,6 +1156,26 @@ private:
      */
     void executeFunctionHelper(int resultCount, const char* func, const char* args, va_list* list);
 
+    /**
+     * Calls the Lua function referenced by the given handle, resolving it first if needed.
+     *
+     * @param resultCount The expected number of returned values.
+     * @param function The handle of the function to call.
+     * @param list The variable argument list.
+     *
+     * @return true if the function was called successfully, false otherwise.
+     */
+    bool executeFunctionHelper(int resultCount, ScriptFunction* function, va_list* list);
+
+    /**
+     * Pushes a single argument of a function call onto the Lua stack.
+     *
+     * @param type The argument type character.
+     * @param typeName The enumeration type name for '[' or the Lua class name for '<'.
+     * @param list The variable argument list to read the argument from.
+     */
+    void pushArgument(char type, std::string& typeName, va_list* list);
+
     /**
      * Converts the given string to a valid script callback enumeration value
      * or to ScriptController::INVALID_CALLBACK if there is no valid conversion.
@@ -1021,9 +1238,18 @@ private:
     lua_State* _lua;
     unsigned int _returnCount;
     std::map<std::string, std::vector<std::string> > _hierarchy;
-    std::vector<std::string> _callbacks[CALLBACK_COUNT];
+    std::vector<ScriptFunction> _callbacks[CALLBACK_COUNT];
     std::set<std::string> _loadedScripts;
     std::vector<luaStringEnumConversionFunction> _stringFromEnum;
+    unsigned int _generation;
+    unsigned int _stateGeneration;
+    float _gcBudget;
+    unsigned int _gcPause;
+    size_t _gcThreshold;
+    bool _gcCollecting;
+    GarbageCollectionStats _gcStats;
+    lua_Alloc _allocFunction;
+    void* _allocUserData;
 };
 
 /** Template specialization. */
@@ -1107,6 +1333,60 @@ template<> double ScriptController::executeFunction<double>(const char* func, co
 /** Template specialization. */
 template<> std::string ScriptController::executeFunction<std::string>(const char* func, const char* args, va_list* list);
 
+/** Template specialization. */
+template<> void ScriptController::executeFunction<void>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> bool ScriptController::executeFunction<bool>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> char ScriptController::executeFunction<char>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> short ScriptController::executeFunction<short>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> int ScriptController::executeFunction<int>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> long ScriptController::executeFunction<long>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> unsigned char ScriptController::executeFunction<unsigned char>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> unsigned short ScriptController::executeFunction<unsigned short>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> unsigned int ScriptController::executeFunction<unsigned int>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> unsigned long ScriptController::executeFunction<unsigned long>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> float ScriptController::executeFunction<float>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> double ScriptController::executeFunction<double>(ScriptFunction* function, ...);
+/** Template specialization. */
+template<> std::string ScriptController::executeFunction<std::string>(ScriptFunction* function, ...);
+
+/** Template specialization. */
+template<> void ScriptController::executeFunction<void>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> bool ScriptController::executeFunction<bool>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> char ScriptController::executeFunction<char>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> short ScriptController::executeFunction<short>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> int ScriptController::executeFunction<int>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> long ScriptController::executeFunction<long>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> unsigned char ScriptController::executeFunction<unsigned char>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> unsigned short ScriptController::executeFunction<unsigned short>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> unsigned int ScriptController::executeFunction<unsigned int>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> unsigned long ScriptController::executeFunction<unsigned long>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> float ScriptController::executeFunction<float>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> double ScriptController::executeFunction<double>(ScriptFunction* function, va_list* list);
+/** Template specialization. */
+template<> std::string ScriptController::executeFunction<std::string>(ScriptFunction* function, va_list* list);
+
 }
 
 #include "ScriptController.inl"
@@ -4,13 +4,8 @@ namespace gameplay
 {
 
 template <typename T>
-ScriptUtil::LuaArray<T>::LuaArray(T* param)
+ScriptUtil::LuaArray<T>::LuaArray(T* param) : _value(param), _data(NULL)
 {
-    _data = new ScriptUtil::LuaArray<T>::Data();
-    _data->value = param;
-
-    // Initial ref count of zero means no memory management
-    _data->refCount = 0;
 }
 
 template <typename T>
@@ -23,39 +18,45 @@ ScriptUtil::LuaArray<T>::LuaArray(int count)
     // int DebugMem configurations.
     _data->value = (T*)new unsigned char[sizeof(T) * count];
 
-    // Positive ref count means we automatically cleanup memory
+    // Ref counted data means we automatically cleanup memory
     _data->refCount = 1;
+    _value = _data->value;
 }
 
 template <typename T>
-ScriptUtil::LuaArray<T>::LuaArray(const ScriptUtil::LuaArray<T>& copy)
+ScriptUtil::LuaArray<T>::LuaArray(const ScriptUtil::LuaArray<T>& copy) : _value(copy._value), _data(copy._data)
 {
-    _data = copy._data;
-    ++_data->refCount;
+    if (_data)
+        ++_data->refCount;
 }
 
 template <typename T>
 ScriptUtil::LuaArray<T>::~LuaArray()
 {
-    if ((--_data->refCount) <= 0)
-    {
-        // Non managed arrays/pointers start with ref count zero, so only delete data if
-        // the decremented ref count == 0 (otherwise it will be -1).
-        if (_data->refCount == 0)
-        {
-            unsigned char* value = (unsigned char*)_data->value;
-            SAFE_DELETE_ARRAY(value);
-        }
-
-        SAFE_DELETE(_data);
-    }
+    release();
 }
 
 template <typename T>
 ScriptUtil::LuaArray<T>& ScriptUtil::LuaArray<T>::operator = (const ScriptUtil::LuaArray<T>& p)
 {
+    if (p._data)
+        ++p._data->refCount;
+    release();
+    _value = p._value;
     _data = p._data;
-    ++_data->refCount;
+    return *this;
+}
+
+template <typename T>
+void ScriptUtil::LuaArray<T>::release()
+{
+    // Single pointer values are not managed and have no data.
+    if (_data && (--_data->refCount) == 0)
+    {
+        unsigned char* value = (unsigned char*)_data->value;
+        SAFE_DELETE_ARRAY(value);
+        SAFE_DELETE(_data);
+    }
 }
 
 template <typename T>
@@ -72,21 +73,41 @@ void ScriptUtil::LuaArray<T>::set(unsigned int index, const T* itemPtr)
     // If the old object is deleted, the vtable on the new object would point to addressess
     // for functions that no longer exist.
     if (itemPtr)
-        memcpy((void*)&_data->value[index], (void*)itemPtr, sizeof(T));
+        memcpy((void*)&_value[index], (void*)itemPtr, sizeof(T));
     else
-        memset((void*)&_data->value[index], 0, sizeof(T));
+        memset((void*)&_value[index], 0, sizeof(T));
 }
 
 template <typename T>
 ScriptUtil::LuaArray<T>::operator T* () const
 {
-    return _data->value;
+    return _value;
 }
 
 template <typename T>
 T& ScriptUtil::LuaArray<T>::operator[] (int index)
 {
-    return _data->value[index];
+    return _value[index];
+}
+
+template<typename T>
+void ScriptUtil::pushValue(lua_State* state, const T& value, const char* type)
+{
+    // Store the value directly after the LuaObject in the same userdata block.
+    LuaObject* object = (LuaObject*)lua_newuserdata(state, sizeof(LuaObject) + sizeof(T));
+    void* storage = (void*)(object + 1);
+#ifdef GP_USE_MEM_LEAK_DETECTION
+#undef new
+    object->instance = (void*)new (storage) T(value);
+#define new DEBUG_NEW
+#else
+    object->instance = (void*)new (storage) T(value);
+#endif
+
+    // The memory belongs to the userdata, so the object's destructor must not delete it.
+    object->owns = false;
+    luaL_getmetatable(state, type);
+    lua_setmetatable(state, -2);
 }
 
 template<typename T>
@@ -166,11 +187,11 @@ ScriptUtil::LuaArray<T> ScriptUtil::getObjectPointer(int index, const char* type
                         lua_pop(sc->_lua, 1);
 
                         // Check if it matches any of the derived types' metatables.
-                        const std::vector<std::string>& types = sc->_hierarchy[type];
-                        for (size_t k = 0, count = types.size(); k < count; k++)
+                        const std::vector<std::string>* types = sc->getDerivedTypes(type);
+                        for (size_t k = 0, count = types ? types->size() : 0; k < count; k++)
                         {
                             // Push dervied type metatable.
-                            luaL_getmetatable(sc->_lua, types[k].c_str());
+                            luaL_getmetatable(sc->_lua, (*types)[k].c_str());
                             if (lua_rawequal(sc->_lua, -1, -2))
                             {
                                 // Pop derived type metatable.
@@ -234,11 +255,11 @@ ScriptUtil::LuaArray<T> ScriptUtil::getObjectPointer(int index, const char* type
             lua_pop(sc->_lua, 1);
 
             // Check if it matches any of the derived types' metatables.
-            const std::vector<std::string>& types = sc->_hierarchy[type];
-            for (size_t i = 0, count = types.size(); i < count; i++)
+            const std::vector<std::string>* types = sc->getDerivedTypes(type);
+            for (size_t i = 0, count = types ? types->size() : 0; i < count; i++)
             {
                 // Push derived type metatable.
-                luaL_getmetatable(sc->_lua, types[i].c_str());
+                luaL_getmetatable(sc->_lua, (*types)[i].c_str());
                 if (lua_rawequal(sc->_lua, -1, -2))
                 {
                     // Pop both metatables.
@@ -299,6 +320,29 @@ template<typename T> T ScriptController::executeFunction(const char* func, const
     return value;
 }
 
+template<typename T> T ScriptController::executeFunction(ScriptFunction* function, ...)
+{
+    va_list list;
+    va_start(list, function);
+    T value = executeFunction<T>(function, &list);
+    va_end(list);
+    return value;
+}
+
+template<typename T> T ScriptController::executeFunction(ScriptFunction* function, va_list* list)
+{
+    int top = lua_gettop(_lua);
+    T value = NULL;
+    if (executeFunctionHelper(1, function, list))
+    {
+        ScriptUtil::LuaObject* object = (ScriptUtil::LuaObject*)lua_touserdata(_lua, -1);
+        if (object)
+            value = (T)object->instance;
+    }
+    lua_settop(_lua, top);
+    return value;
+}
+
 template<typename T>T* ScriptController::getObjectPointer(const char* type, const char* name)
 {
     lua_getglobal(_lua, name);
@@ -13,91 +13,64 @@ ScriptTarget::ScriptTarget()
 
 ScriptTarget::~ScriptTarget()
 {
-    std::map<std::string, std::vector<Callback>* >::iterator iter = _callbacks.begin();
-    for (; iter != _callbacks.end(); iter++)
+    for (size_t i = 0, count = _events.size(); i < count; ++i)
     {
-        SAFE_DELETE(iter->second);
+        ScriptEvent* event = _events[i];
+        for (size_t j = 0, callbackCount = event->callbacks.size(); j < callbackCount; ++j)
+        {
+            SAFE_DELETE(event->callbacks[j]);
+        }
+        SAFE_DELETE(event);
     }
 }
 
 template<> void ScriptTarget::fireScriptEvent<void>(const char* eventName, ...)
 {
-    va_list list;
-    va_start(list, eventName);
-
-    std::map<std::string, std::vector<Callback>* >::iterator iter = _callbacks.find(eventName);
-    if (iter != _callbacks.end() && iter->second != NULL)
+    ScriptEvent* event = getScriptEvent(eventName);
+    if (event && !event->callbacks.empty())
     {
         ScriptController* sc = Game::getInstance()->getScriptController();
 
-        if (_events[eventName].size() > 0)
+        for (size_t i = 0; i < event->callbacks.size(); i++)
         {
-            for (unsigned int i = 0; i < iter->second->size(); i++)
-            {
-                sc->executeFunction<void>((*iter->second)[i].function.c_str(), _events[eventName].c_str(), &list);
-            }
-        }
-        else
-        {
-            for (unsigned int i = 0; i < iter->second->size(); i++)
-            {
-                sc->executeFunction<void>((*iter->second)[i].function.c_str(), _events[eventName].c_str());
-            }
+            // Each call consumes the argument list, so it is restarted for every callback.
+            va_list list;
+            va_start(list, eventName);
+            sc->executeFunction<void>(event->callbacks[i], &list);
+            va_end(list);
         }
     }
-
-    va_end(list);
 }
 
 template<> bool ScriptTarget::fireScriptEvent<bool>(const char* eventName, ...)
 {
-    va_list list;
-    va_start(list, eventName);
-
-    std::map<std::string, std::vector<Callback>* >::iterator iter = _callbacks.find(eventName);
-    if (iter != _callbacks.end() && iter->second)
+    ScriptEvent* event = getScriptEvent(eventName);
+    if (event && !event->callbacks.empty())
     {
         ScriptController* sc = Game::getInstance()->getScriptController();
 
-        if (_events[eventName].size() > 0)
+        for (size_t i = 0; i < event->callbacks.size(); i++)
         {
-            for (unsigned int i = 0; i < iter->second->size(); i++)
-            {
-                if (sc->executeFunction<bool>((*iter->second)[i].function.c_str(), _events[eventName].c_str(), &list))
-                {
-                    va_end(list);
-                    return true;
-                }
-            }
-        }
-        else
-        {
-            for (unsigned int i = 0; i < iter->second->size(); i++)
-            {
-                if (sc->executeFunction<bool>((*iter->second)[i].function.c_str(), _events[eventName].c_str()))
-                {
-                    va_end(list);
-                    return true;
-                }
-            }
+            va_list list;
+            va_start(list, eventName);
+            bool result = sc->executeFunction<bool>(event->callbacks[i], &list);
+            va_end(list);
+            if (result)
+                return true;
         }
     }
 
-    va_end(list);
     return false;
 }
 
 void ScriptTarget::addScriptCallback(const std::string& eventName, const std::string& function)
 {
-    std::map<std::string, std::vector<Callback>* >::iterator iter = _callbacks.find(eventName);
-    if (iter != _callbacks.end())
+    ScriptEvent* event = getScriptEvent(eventName.c_str());
+    if (event)
     {
-        if (!iter->second)
-            iter->second = new std::vector<Callback>();
-
         // Add the function to the list of callbacks.
         std::string functionName = Game::getInstance()->getScriptController()->loadUrl(function.c_str());
-        iter->second->push_back(Callback(functionName));
+        event->callbacks.push_back(new ScriptFunction(functionName.c_str(), event->args.c_str()));
     }
     else
     {
@@ -107,12 +80,9 @@ void ScriptTarget::addScriptCallback(const std::string& eventName, const std::st
 
 void ScriptTarget::removeScriptCallback(const std::string& eventName, const std::string& function)
 {
-    std::map<std::string, std::vector<Callback>* >::iterator iter = _callbacks.find(eventName);
-    if (iter != _callbacks.end())
+    ScriptEvent* event = getScriptEvent(eventName.c_str());
+    if (event)
     {
-        if (!iter->second)
-            return;
-
         std::string file;
         std::string id;
         splitURL(function, &file, &id);
@@ -122,11 +92,12 @@ void ScriptTarget::removeScriptCallback(const std::string& eventName, const std:
             return;
 
         // Remove the function from the list of callbacks.
-        for (unsigned int i = 0; i < iter->second->size(); i++)
+        for (size_t i = 0, count = event->callbacks.size(); i < count; i++)
         {
-            if ((*iter->second)[i].function == id)
+            if (id == event->callbacks[i]->getName())
             {
-                iter->second->erase(iter->second->begin() + i);
+                SAFE_DELETE(event->callbacks[i]);
+                event->callbacks.erase(event->callbacks.begin() + i);
                 return;
             }
         }
@@ -139,11 +110,32 @@ void ScriptTarget::removeScriptCallback(const std::string& eventName, const std:
 
 void ScriptTarget::addScriptEvent(const std::string& eventName, const char* argsString)
 {
-    _events[eventName] = (argsString ? argsString : "");
-    _callbacks[eventName] = NULL;
+    ScriptEvent* event = getScriptEvent(eventName.c_str());
+    if (event)
+        event->args = (argsString ? argsString : "");
+    else
+        _events.push_back(new ScriptEvent(eventName, argsString));
+}
+
+bool ScriptTarget::hasScriptCallbacks(const char* eventName) const
+{
+    ScriptEvent* event = getScriptEvent(eventName);
+    return (event && !event->callbacks.empty());
+}
+
+ScriptTarget::ScriptEvent* ScriptTarget::getScriptEvent(const char* eventName) const
+{
+    // Targets only support a handful of events, so a linear search is faster than a map lookup.
+    for (size_t i = 0, count = _events.size(); i < count; ++i)
+    {
+        if (_events[i]->name == eventName)
+            return _events[i];
+    }
+    return NULL;
 }
 
-ScriptTarget::Callback::Callback(const std::string& function) : function(function)
+ScriptTarget::ScriptEvent::ScriptEvent(const std::string& name, const char* args)
+    : name(name), args(args ? args : "")
 {
 }
 
@@ -6,6 +6,8 @@
 namespace gameplay
 {
 
+class ScriptFunction;
+
 /**
  * Defines an interface for supporting script callbacks.
  */
@@ -59,20 +61,40 @@ protected:
      */
     template<typename T> T fireScriptEvent(const char* eventName, ...);
 
-    /** Used to store a script callbacks for given event. */
-    struct Callback
+    /**
+     * Determines whether any script callbacks are registered for the given event.
+     *
+     * @param eventName The name of the event.
+     *
+     * @return true if the event has script callbacks, false otherwise.
+     */
+    bool hasScriptCallbacks(const char* eventName) const;
+
+    /** Used to store a supported event and the script callbacks registered for it. */
+    struct ScriptEvent
     {
         /** Constructor. */
-        Callback(const std::string& string);
-
-        /** Holds the Lua script callback function. */
-        std::string function;
+        ScriptEvent(const std::string& name, const char* args);
+
+        /** Holds the name of the event. */
+        std::string name;
+        /** Holds the argument string for the event. */
+        std::string args;
+        /** Holds the Lua script callback functions. */
+        std::vector<ScriptFunction*> callbacks;
     };
 
+    /**
+     * Returns the supported event with the given name.
+     *
+     * @param eventName The name of the event.
+     *
+     * @return The event, or NULL if the event is not supported.
+     */
+    ScriptEvent* getScriptEvent(const char* eventName) const;
+
     /** Holds the supported events for this script target. */
-    std::map<std::string, std::string> _events;
-    /** Holds the callbacks for this script target's events. */
-    std::map<std::string, std::vector<Callback>*> _callbacks;
+    std::vector<ScriptEvent*> _events;
 };
 
 template<typename T> T ScriptTarget::fireScriptEvent(const char* eventName, ...)
@@ -101,6 +101,7 @@ void Slider::setValue(float value)
     if (value != _value)
     {
         _value = value;
+        setDirty(DIRTY_STATE);
         notifyListeners(Control::Listener::VALUE_CHANGED);
     }
 
@@ -485,7 +486,7 @@ unsigned int Slider::drawText(Form* form, const Rectangle& clip)
 
         SpriteBatch* batch = _font->getSpriteBatch(fontSize);
         startBatch(form, batch);
-        _font->drawText(_valueText.c_str(), _textBounds, _textColor, fontSize, _valueTextAlignment, true, getTextRightToLeft(state), &_viewportClipBounds);
+        drawTextLayout(&_valueTextLayout, _valueText.c_str(), fontSize, _valueTextAlignment, getTextRightToLeft(state));
         finishBatch(form, batch);
 
         ++drawCalls;
@@ -321,6 +321,11 @@ private:
      */
     std::string _valueText;
 
+    /**
+     * The cached layout of the value text.
+     */
+    TextLayout _valueTextLayout;
+
     float _trackHeight;
 
     float _gamepadValue;
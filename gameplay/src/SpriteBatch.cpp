@@ -15,6 +15,14 @@
     vtx.u = vu; vtx.v = vv; \
     vtx.r = vr; vtx.g = vg; vtx.b = vb; vtx.a = va
 
+// Number of indices after which a multi-texture batch is flushed, which keeps its
+// indices within 16 bits while leaving the batch room to grow
+#define SPRITE_BATCH_MAX_MERGED_INDICES 32768
+
+// Number of sprites written and added to the batch at a time by the bulk draw method,
+// which keeps the indices of each block within 16 bits
+#define SPRITE_BATCH_INSTANCE_CHUNK 1024
+
 // Default sprite shaders
 #define SPRITE_VSH "res/shaders/sprite.vert"
 #define SPRITE_FSH "res/shaders/sprite.frag"
@@ -23,17 +31,37 @@ namespace gameplay
 {
 
 static Effect* __spriteEffect = NULL;
+static Effect* __multiTextureEffect = NULL;
 
 SpriteBatch::SpriteBatch()
-    : _batch(NULL), _sampler(NULL), _textureWidthRatio(0.0f), _textureHeightRatio(0.0f)
+    : _batch(NULL), _sampler(NULL), _customEffect(false), _alphaTexture(false), _textureWidthRatio(0.0f), _textureHeightRatio(0.0f),
+      _target(NULL), _multiTexture(false), _textureCount(0), _mergedIndexCount(0)
 {
+    memset(_textures, 0, sizeof(_textures));
+    memset(_textureParameters, 0, sizeof(_textureParameters));
 }
 
 SpriteBatch::~SpriteBatch()
 {
     SAFE_DELETE(_batch);
     SAFE_RELEASE(_sampler);
-    if (!_customEffect)
+    for (unsigned int i = 0; i < _textureCount; ++i)
+    {
+        SAFE_RELEASE(_textures[i]);
+    }
+    if (_multiTexture)
+    {
+        if (__multiTextureEffect && __multiTextureEffect->getRefCount() == 1)
+        {
+            __multiTextureEffect->release();
+            __multiTextureEffect = NULL;
+        }
+        else
+        {
+            __multiTextureEffect->release();
+        }
+    }
+    else if (!_customEffect)
     {
         if (__spriteEffect && __spriteEffect->getRefCount() == 1)
         {
@@ -140,14 +168,96 @@ SpriteBatch* SpriteBatch::create(Texture* texture,  Effect* effect, unsigned int
     return batch;
 }
 
+SpriteBatch* SpriteBatch::createMultiTexture(unsigned int initialCapacity)
+{
+    // Create our static multi-texture effect.
+    if (__multiTextureEffect == NULL)
+    {
+        __multiTextureEffect = Effect::createFromFile(SPRITE_VSH, SPRITE_FSH, "MULTI_TEXTURE");
+        if (__multiTextureEffect == NULL)
+        {
+            GP_ERROR("Unable to load multi-texture sprite effect.");
+            return NULL;
+        }
+    }
+    else
+    {
+        __multiTextureEffect->addRef();
+    }
+
+    // Wrap the effect in a material
+    Material* material = Material::create(__multiTextureEffect); // +ref effect
+
+    // Set initial material state
+    material->getStateBlock()->setBlend(true);
+    material->getStateBlock()->setBlendSrc(RenderState::BLEND_SRC_ALPHA);
+    material->getStateBlock()->setBlendDst(RenderState::BLEND_ONE_MINUS_SRC_ALPHA);
+
+    // Define the vertex format for the batch. The second texture coordinate holds the
+    // texture index and whether only the alpha channel of the texture is used.
+    VertexFormat::Element vertexElements[] =
+    {
+        VertexFormat::Element(VertexFormat::POSITION, 3),
+        VertexFormat::Element(VertexFormat::TEXCOORD0, 2),
+        VertexFormat::Element(VertexFormat::COLOR, 4),
+        VertexFormat::Element(VertexFormat::TEXCOORD1, 2)
+    };
+    VertexFormat vertexFormat(vertexElements, 4);
+
+    // Create the mesh batch
+    MeshBatch* meshBatch = MeshBatch::create(vertexFormat, Mesh::TRIANGLE_STRIP, material, true, initialCapacity > 0 ? initialCapacity : SPRITE_BATCH_DEFAULT_SIZE);
+    material->release(); // don't call SAFE_RELEASE since material is used below
+
+    // Create the batch
+    SpriteBatch* batch = new SpriteBatch();
+    batch->_multiTexture = true;
+    batch->_batch = meshBatch;
+    for (unsigned int i = 0; i < MAX_TEXTURES; ++i)
+    {
+        char name[16];
+        sprintf(name, "u_texture%u", i);
+        batch->_textureParameters[i] = material->getParameter(name);
+    }
+
+    // Bind an ortho projection to the material by default (user can override with setProjectionMatrix)
+    Game* game = Game::getInstance();
+    Matrix::createOrthographicOffCenter(0, game->getViewport().width, game->getViewport().height, 0, 0, 1, &batch->_projectionMatrix);
+    material->getParameter("u_projectionMatrix")->bindValue(batch, &SpriteBatch::getProjectionMatrix);
+
+    return batch;
+}
+
 void SpriteBatch::start()
 {
+    // Sprites are added to the target, which is started by its owner.
+    if (_target)
+        return;
+
     _batch->start();
+    _mergedIndexCount = 0;
 }
 
 bool SpriteBatch::isStarted() const
 {
-    return _batch->isStarted();
+    return _target ? true : _batch->isStarted();
+}
+
+bool SpriteBatch::setTarget(SpriteBatch* target)
+{
+    GP_ASSERT(target != this);
+    GP_ASSERT(target == NULL || target->_multiTexture);
+
+    // The target reproduces the default sprite effect and the effect of bitmap fonts only.
+    if (target && (_multiTexture || (_customEffect && !_alphaTexture)))
+        return false;
+
+    _target = target;
+    return true;
+}
+
+SpriteBatch* SpriteBatch::getTarget() const
+{
+    return _target;
 }
 
 void SpriteBatch::draw(const Rectangle& dst, const Rectangle& src, const Vector4& color)
@@ -229,7 +339,7 @@ void SpriteBatch::draw(float x, float y, float z, float width, float height, flo
     
     static unsigned short indices[4] = { 0, 1, 2, 3 };
 
-    _batch->add(v, 4, indices, 4);
+    add(v, 4, indices, 4);
 }
 
 void SpriteBatch::draw(const Vector3& position, const Vector3& right, const Vector3& forward, float width, float height,
@@ -294,7 +404,7 @@ void SpriteBatch::draw(const Vector3& position, const Vector3& right, const Vect
     SPRITE_ADD_VERTEX(v[3], p3.x, p3.y, p3.z, u2, v2, color.x, color.y, color.z, color.w);
     
     static const unsigned short indices[4] = { 0, 1, 2, 3 };
-    _batch->add(v, 4, const_cast<unsigned short*>(indices), 4);
+    add(v, 4, indices, 4);
 }
 
 void SpriteBatch::draw(float x, float y, float width, float height, float u1, float v1, float u2, float v2, const Vector4& color)
@@ -328,7 +438,7 @@ void SpriteBatch::addSprite(float x, float y, float width, float height, float u
     SPRITE_ADD_VERTEX(vertices[3], x2, y2, 0, u2, v2, color.x, color.y, color.z, color.w);
 }
 
-void SpriteBatch::addSprite(float x, float y, float width, float height, float u1, float v1, float u2, float v2, const Vector4& color, const Rectangle& clip, SpriteBatch::SpriteVertex* vertices)
+bool SpriteBatch::addSprite(float x, float y, float width, float height, float u1, float v1, float u2, float v2, const Vector4& color, const Rectangle& clip, SpriteBatch::SpriteVertex* vertices)
 {
     GP_ASSERT(vertices);
 
@@ -341,7 +451,9 @@ void SpriteBatch::addSprite(float x, float y, float width, float height, float u
         SPRITE_ADD_VERTEX(vertices[1], x, y2, 0, u1, v2, color.x, color.y, color.z, color.w);
         SPRITE_ADD_VERTEX(vertices[2], x2, y, 0, u2, v1, color.x, color.y, color.z, color.w);
         SPRITE_ADD_VERTEX(vertices[3], x2, y2, 0, u2, v2, color.x, color.y, color.z, color.w);
+        return true;
     }
+    return false;
 }
 
 void SpriteBatch::draw(SpriteBatch::SpriteVertex* vertices, unsigned int vertexCount, unsigned short* indices, unsigned int indexCount)
@@ -349,7 +461,7 @@ void SpriteBatch::draw(SpriteBatch::SpriteVertex* vertices, unsigned int vertexC
     GP_ASSERT(vertices);
     GP_ASSERT(indices);
 
-    _batch->add(vertices, vertexCount, indices, indexCount);
+    add(vertices, vertexCount, indices, indexCount);
 }
 
 void SpriteBatch::draw(float x, float y, float z, float width, float height, float u1, float v1, float u2, float v2, const Vector4& color, bool positionIsCenter)
@@ -372,14 +484,144 @@ void SpriteBatch::draw(float x, float y, float z, float width, float height, flo
 
     static unsigned short indices[4] = { 0, 1, 2, 3 };
 
-    _batch->add(v, 4, indices, 4);
+    add(v, 4, indices, 4);
+}
+
+void SpriteBatch::draw(const SpriteInstance* instances, unsigned int count)
+{
+    GP_ASSERT(instances || count == 0);
+
+    // Indices of a full block of sprites, joining each sprite to the previous one with a
+    // degenerate triangle pair. Shorter blocks use the start of the same pattern.
+    static unsigned short indices[SPRITE_BATCH_INSTANCE_CHUNK * 6 - 2];
+    static bool indicesInitialized = false;
+    if (!indicesInitialized)
+    {
+        unsigned short* index = indices;
+        for (unsigned short i = 0; i < SPRITE_BATCH_INSTANCE_CHUNK; ++i)
+        {
+            const unsigned short first = i * 4;
+            if (i > 0)
+            {
+                *index++ = first - 1;
+                *index++ = first;
+            }
+            *index++ = first;
+            *index++ = first + 1;
+            *index++ = first + 2;
+            *index++ = first + 3;
+        }
+        indicesInitialized = true;
+    }
+
+    if (_instanceVertices.empty())
+        _instanceVertices.resize(SPRITE_BATCH_INSTANCE_CHUNK * 4);
+
+    while (count > 0)
+    {
+        const unsigned int chunk = std::min(count, (unsigned int)SPRITE_BATCH_INSTANCE_CHUNK);
+
+        // Write the corners in the same order and with the same texture coordinates as the
+        // unrotated draw methods and addSprite, with (u1, v1) at the top left corner. The
+        // rotated draw method puts (u1, v1) at the bottom left corner instead. The edges of
+        // each sprite are rotated rather than each corner about the rotation point.
+        SpriteVertex* v = &_instanceVertices[0];
+        for (unsigned int i = 0; i < chunk; ++i, v += 4)
+        {
+            const SpriteInstance& s = instances[i];
+            const float rightX = s.width * s.rotationCos;
+            const float rightY = s.width * s.rotationSin;
+            const float downX = -s.height * s.rotationSin;
+            const float downY = s.height * s.rotationCos;
+            const float x = s.x + s.originX * (s.width - rightX) - s.originY * downX;
+            const float y = s.y + s.originY * (s.height - downY) - s.originX * rightY;
+
+            SPRITE_ADD_VERTEX(v[0], x, y, s.z, s.u1, s.v1, s.r, s.g, s.b, s.a);
+            SPRITE_ADD_VERTEX(v[1], x + downX, y + downY, s.z, s.u1, s.v2, s.r, s.g, s.b, s.a);
+            SPRITE_ADD_VERTEX(v[2], x + rightX, y + rightY, s.z, s.u2, s.v1, s.r, s.g, s.b, s.a);
+            SPRITE_ADD_VERTEX(v[3], x + rightX + downX, y + rightY + downY, s.z, s.u2, s.v2, s.r, s.g, s.b, s.a);
+        }
+
+        add(&_instanceVertices[0], chunk * 4, indices, chunk * 6 - 2);
+
+        instances += chunk;
+        count -= chunk;
+    }
+}
+
+void SpriteBatch::add(const SpriteBatch::SpriteVertex* vertices, unsigned int vertexCount, const unsigned short* indices, unsigned int indexCount)
+{
+    if (_target)
+        _target->addMerged(this, vertices, vertexCount, indices, indexCount);
+    else
+        _batch->add(vertices, vertexCount, indices, indexCount);
+}
+
+void SpriteBatch::addMerged(SpriteBatch* source, const SpriteBatch::SpriteVertex* vertices, unsigned int vertexCount, const unsigned short* indices, unsigned int indexCount)
+{
+    GP_ASSERT(_multiTexture);
+    GP_ASSERT(source && source->_sampler);
+
+    if (_mergedIndexCount + indexCount + 2 > SPRITE_BATCH_MAX_MERGED_INDICES)
+        flush();
+    _mergedIndexCount += indexCount + 2;
+
+    // Find the slot of the source texture, flushing the batch if all slots are in use.
+    Texture* texture = source->_sampler->getTexture();
+    unsigned int slot = 0;
+    while (slot < _textureCount && _textures[slot]->getTexture() != texture)
+        ++slot;
+    if (slot == MAX_TEXTURES)
+    {
+        flush();
+        slot = 0;
+    }
+    if (slot == _textureCount)
+    {
+        _textures[slot] = source->_sampler;
+        _textures[slot]->addRef();
+        if (_textureParameters[slot])
+            _textureParameters[slot]->setValue(source->_sampler);
+        ++_textureCount;
+    }
+
+    _mergedVertices.resize(vertexCount);
+    const float alphaTexture = source->_alphaTexture ? 1.0f : 0.0f;
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        MultiTextureVertex& v = _mergedVertices[i];
+        v.sprite = vertices[i];
+        v.texture = (float)slot;
+        v.alphaTexture = alphaTexture;
+    }
+    _batch->add(&_mergedVertices[0], vertexCount, indices, indexCount);
+}
+
+void SpriteBatch::flush()
+{
+    finish();
+    start();
 }
 
 void SpriteBatch::finish()
 {
+    // Draw what has been added to the target so far, so later changes to the texture do not affect it.
+    if (_target)
+    {
+        _target->flush();
+        return;
+    }
+
     // Finish and draw the batch
     _batch->finish();
     _batch->draw();
+
+    // Release the textures of a multi-texture batch, so that they can be reassigned.
+    for (unsigned int i = 0; i < _textureCount; ++i)
+    {
+        SAFE_RELEASE(_textures[i]);
+    }
+    _textureCount = 0;
 }
 
 RenderState::StateBlock* SpriteBatch::getStateBlock() const
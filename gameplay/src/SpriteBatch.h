@@ -29,6 +29,78 @@ class SpriteBatch
 
 public:
 
+    /**
+     * The maximum number of textures a multi-texture batch draws with at once.
+     */
+    static const unsigned int MAX_TEXTURES = 4;
+
+    /**
+     * Defines a sprite drawn with the bulk draw method.
+     *
+     * The rotation of the sprite is given by the cosine and sine of its angle rather
+     * than by the angle itself, so that no trigonometry is evaluated per sprite when
+     * drawing. Sprites that do not rotate use a cosine of 1 and a sine of 0.
+     *
+     * @script{ignore}
+     */
+    struct SpriteInstance
+    {
+        /**
+         * The x coordinate of the top-left corner of the unrotated sprite.
+         */
+        float x;
+
+        /**
+         * The y coordinate of the top-left corner of the unrotated sprite.
+         */
+        float y;
+
+        /**
+         * The z coordinate of the sprite.
+         */
+        float z;
+
+        /**
+         * The sprite width.
+         */
+        float width;
+
+        /**
+         * The sprite height.
+         */
+        float height;
+
+        /**
+         * The x coordinate of the rotation point, as a fraction of the width.
+         */
+        float originX;
+
+        /**
+         * The y coordinate of the rotation point, as a fraction of the height.
+         */
+        float originY;
+
+        /**
+         * The cosine of the rotation angle.
+         */
+        float rotationCos;
+
+        /**
+         * The sine of the rotation angle.
+         */
+        float rotationSin;
+
+        /**
+         * The texture coordinates of the sprite.
+         */
+        float u1, v1, u2, v2;
+
+        /**
+         * The color to tint the sprite. Use white for no tint.
+         */
+        float r, g, b, a;
+    };
+
     /**
      * Creates a new SpriteBatch for drawing sprites with the given texture.
      *
@@ -83,6 +155,22 @@ public:
      */
     static SpriteBatch* create(Texture* texture, Effect* effect = NULL, unsigned int initialCapacity = 0);
 
+    /**
+     * Creates a new SpriteBatch that draws the sprites of other batches, using several textures at once.
+     *
+     * Sprites are added to a multi-texture batch by setting it as the target of other
+     * sprite batches (see setTarget), rather than by drawing into it directly. Each vertex
+     * selects one of up to MAX_TEXTURES textures, so sprites from different batches are
+     * drawn together, in the order they were drawn. The batch is flushed when a sprite
+     * needs a texture beyond that limit.
+     *
+     * @param initialCapacity An optional initial capacity of the batch (number of sprites).
+     *
+     * @return A new multi-texture SpriteBatch.
+     * @script{ignore}
+     */
+    static SpriteBatch* createMultiTexture(unsigned int initialCapacity = 0);
+
     /**
      * Destructor.
      */
@@ -103,6 +191,30 @@ public:
      */
     bool isStarted() const;
 
+    /**
+     * Sets a multi-texture batch to draw the sprites of this batch into.
+     *
+     * While a target is set, sprites drawn with this batch are added to the target along
+     * with the texture of this batch, and are drawn when the target is finished. Starting
+     * this batch has no effect, and finishing it flushes the target. This is only supported
+     * for batches using the default sprite effect or the effect of a bitmap font, since the
+     * target reproduces those effects.
+     *
+     * @param target A started multi-texture batch, or NULL to draw into this batch again.
+     *
+     * @return True if the target was set, false if this batch cannot be drawn into the target.
+     * @script{ignore}
+     */
+    bool setTarget(SpriteBatch* target);
+
+    /**
+     * Gets the multi-texture batch that the sprites of this batch are drawn into.
+     *
+     * @return The target batch, or NULL if sprites are drawn into this batch.
+     * @script{ignore}
+     */
+    SpriteBatch* getTarget() const;
+
     /**
      * Draws a single sprite.
      * 
@@ -261,6 +373,19 @@ public:
      */
     void draw(float x, float y, float z, float width, float height, float u1, float v1, float u2, float v2, const Vector4& color, bool positionIsCenter = false);
 
+    /**
+     * Draws many sprites at once.
+     *
+     * This is considerably faster than drawing each sprite with one of the other draw
+     * methods, since the vertices of all sprites are written in a single pass and are
+     * added to the batch in large blocks.
+     *
+     * @param instances The sprites to draw.
+     * @param count The number of sprites in the instances array.
+     * @script{ignore}
+     */
+    void draw(const SpriteInstance* instances, unsigned int count);
+
     /**
      * Finishes sprite drawing.
      *
@@ -275,6 +400,8 @@ public:
      * This return texture sampler is used when sampling the texture in the
      * effect. This can be modified for controlling sampler setting such as
      * filtering modes.
+     *
+     * Multi-texture batches have no sampler of their own and return NULL.
      */
     Texture::Sampler* getSampler() const;
 
@@ -333,6 +460,16 @@ private:
         float a;
     };
 
+    /**
+     * Vertex structure used by multi-texture batches, which also selects the texture.
+     */
+    struct MultiTextureVertex
+    {
+        SpriteVertex sprite;
+        float texture;
+        float alphaTexture;
+    };
+
     /**
      * Constructor.
      */
@@ -375,8 +512,10 @@ private:
      * @param color The color to tint the sprite. Use white for no tint.
      * @param clip The clip rectangle.
      * @param vertices The vertices to draw.
+     *
+     * @return True if the sprite was added, false if it was entirely outside the clip rectangle.
      */
-    void addSprite(float x, float y, float width, float height, float u1, float v1, float u2, float v2, const Vector4& color, const Rectangle& clip, SpriteBatch::SpriteVertex* vertices);
+    bool addSprite(float x, float y, float width, float height, float u1, float v1, float u2, float v2, const Vector4& color, const Rectangle& clip, SpriteBatch::SpriteVertex* vertices);
 
     /**
      * Draws an array of vertices.
@@ -388,6 +527,21 @@ private:
      */
     void draw(SpriteBatch::SpriteVertex* vertices, unsigned int vertexCount, unsigned short* indices, unsigned int indexCount);
 
+    /**
+     * Adds vertices to the batch, or to the target batch if one is set.
+     */
+    void add(const SpriteBatch::SpriteVertex* vertices, unsigned int vertexCount, const unsigned short* indices, unsigned int indexCount);
+
+    /**
+     * Adds the vertices of another batch to this multi-texture batch.
+     */
+    void addMerged(SpriteBatch* source, const SpriteBatch::SpriteVertex* vertices, unsigned int vertexCount, const unsigned short* indices, unsigned int indexCount);
+
+    /**
+     * Draws the sprites added to this multi-texture batch so far and starts it again.
+     */
+    void flush();
+
     /**
      * Clip position and size to fit within clip region.
      *
@@ -398,9 +552,18 @@ private:
     MeshBatch* _batch;
     Texture::Sampler* _sampler;
     bool _customEffect;
+    bool _alphaTexture;
     float _textureWidthRatio;
     float _textureHeightRatio;
     mutable Matrix _projectionMatrix;
+    SpriteBatch* _target;
+    bool _multiTexture;
+    Texture::Sampler* _textures[MAX_TEXTURES];
+    MaterialParameter* _textureParameters[MAX_TEXTURES];
+    unsigned int _textureCount;
+    unsigned int _mergedIndexCount;
+    std::vector<MultiTextureVertex> _mergedVertices;
+    std::vector<SpriteVertex> _instanceVertices;
 };
 
 }
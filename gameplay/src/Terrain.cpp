@@ -1,8 +1,10 @@
 #include "Base.h"
 #include "Terrain.h"
 #include "TerrainPatch.h"
+#include "TerrainPager.h"
 #include "Node.h"
 #include "FileSystem.h"
+#include "Scene.h"
 
 namespace gameplay
 {
@@ -28,12 +30,13 @@ static const unsigned int DIRTY_FLAG_INVERSE_WORLD = 1;
 static float getDefaultHeight(unsigned int width, unsigned int height);
 
 Terrain::Terrain() :
-    _heightfield(NULL), _node(NULL), _normalMap(NULL), _flags(FRUSTUM_CULLING | LEVEL_OF_DETAIL), _dirtyFlags(DIRTY_FLAG_INVERSE_WORLD)
+    _heightfield(NULL), _node(NULL), _pager(NULL), _normalMap(NULL), _compactVertices(false), _skirtScale(0), _flags(FRUSTUM_CULLING | LEVEL_OF_DETAIL), _dirtyFlags(DIRTY_FLAG_INVERSE_WORLD)
 {
 }
 
 Terrain::~Terrain()
 {
+    SAFE_DELETE(_pager);
     for (size_t i = 0, count = _patches.size(); i < count; ++i)
     {
         SAFE_DELETE(_patches[i]);
@@ -65,6 +68,8 @@ Terrain* Terrain::create(const char* path, Properties* properties)
     float skirtScale = 0;
     const char* normalMap = NULL;
     std::string materialPath;
+    Vector2 heightRange(0, 1);
+    bool hasHeightRange = false;
 
     if (!p && path)
     {
@@ -100,11 +105,27 @@ Terrain* Terrain::create(const char* path, Properties* properties)
             return NULL;
         }
 
+        // Heights are normalized unless the heightmap specifies the range they map to,
+        // such as the range written alongside RAW16 heightmaps by the encoder
+        if (pHeightmap->exists("heightRange"))
+        {
+            if (pHeightmap->getVector2("heightRange", &heightRange) && heightRange.y >= heightRange.x)
+            {
+                hasHeightRange = true;
+            }
+            else
+            {
+                GP_WARN("Invalid 'heightRange' value ('%s') in heightmap section of terrain definition: %s", pHeightmap->getString("heightRange"), path);
+                heightRange.set(0, 1);
+            }
+        }
+        bool quantized = pHeightmap->getBool("quantized");
+
         std::string ext = FileSystem::getExtension(heightmap.c_str());
         if (ext == ".PNG")
         {
-            // Read normalized height values from heightmap image
-            heightfield = HeightField::createFromImage(heightmap.c_str(), 0, 1);
+            // Read height values from heightmap image
+            heightfield = HeightField::createFromImage(heightmap.c_str(), heightRange.x, heightRange.y, quantized);
         }
         else if (ext == ".RAW" || ext == ".R16")
         {
@@ -118,8 +139,19 @@ Terrain* Terrain::create(const char* path, Properties* properties)
                 return NULL;
             }
 
-            // Read normalized height values from RAW file
-            heightfield = HeightField::createFromRAW(heightmap.c_str(), (unsigned int)imageSize.x, (unsigned int)imageSize.y, 0, 1);
+            if (pHeightmap->getBool("paged"))
+            {
+                // Page height values in from the RAW file, using tiles of one patch each
+                int tileSize = pTerrain->exists("patchSize") ? pTerrain->getInt("patchSize") : DEFAULT_TERRAIN_PATCH_SIZE;
+                if (tileSize <= 0)
+                    tileSize = DEFAULT_TERRAIN_PATCH_SIZE;
+                heightfield = HeightField::createTiled(heightmap.c_str(), (unsigned int)imageSize.x, (unsigned int)imageSize.y, (unsigned int)tileSize, heightRange.x, heightRange.y, quantized);
+            }
+            else
+            {
+                // Read height values from RAW file
+                heightfield = HeightField::createFromRAW(heightmap.c_str(), (unsigned int)imageSize.x, (unsigned int)imageSize.y, heightRange.x, heightRange.y, quantized);
+            }
         }
         else
         {
@@ -207,7 +239,9 @@ Terrain* Terrain::create(const char* path, Properties* properties)
 
     if (terrainSize.isZero())
     {
-        terrainSize.set(heightfield->getColumnCount(), getDefaultHeight(heightfield->getColumnCount(), heightfield->getRowCount()), heightfield->getRowCount());
+        // Heights with an explicit range are used unscaled
+        float terrainHeight = hasHeightRange ? 1.0f : getDefaultHeight(heightfield->getColumnCount(), heightfield->getRowCount());
+        terrainSize.set(heightfield->getColumnCount(), terrainHeight, heightfield->getRowCount());
     }
 
     if (patchSize <= 0 || patchSize > (int)heightfield->getColumnCount() || patchSize > (int)heightfield->getRowCount())
@@ -227,6 +261,12 @@ Terrain* Terrain::create(const char* path, Properties* properties)
     // Create terrain
     Terrain* terrain = create(heightfield, scale, (unsigned int)patchSize, (unsigned int)detailLevels, skirtScale, normalMap, materialPath.c_str(), pTerrain);
 
+    // Read 'pageRadius'
+    if (terrain && pTerrain->exists("pageRadius"))
+    {
+        terrain->setPageRadius((unsigned int)std::max(0, pTerrain->getInt("pageRadius")));
+    }
+
     if (!externalProperties)
         SAFE_DELETE(p);
 
@@ -261,6 +301,21 @@ Terrain* Terrain::create(HeightField* heightfield, const Vector3& scale,
     if (normalMapPath)
         terrain->_normalMap = Texture::Sampler::create(normalMapPath, true);
 
+    // Compact vertices derive the texture coordinates of skirts from the skirt scale
+    terrain->_skirtScale = skirtScale;
+
+    // Compact vertices must be chosen before any patch geometry is built
+    if (properties)
+        terrain->_compactVertices = properties->getBool("compactVertices");
+
+    // The grid coordinates of compact vertices, including a skirt on either side, must fit the packed range
+    unsigned int maxPatchSize = heightfield->isTiled() ? heightfield->getTileSize() : patchSize;
+    if (terrain->_compactVertices && maxPatchSize + 2 >= TERRAINPATCH_PACK_SIZE)
+    {
+        GP_WARN("Terrain patch size %u is too large for compact vertices (maximum %u), using full vertices instead.", maxPatchSize, TERRAINPATCH_PACK_SIZE - 3);
+        terrain->_compactVertices = false;
+    }
+
     float halfWidth = (width - 1) * 0.5f;
     float halfHeight = (height - 1) * 0.5f;
 
@@ -269,25 +324,39 @@ Terrain* Terrain::create(HeightField* heightfield, const Vector3& scale,
     // level detail terrain patch.
     unsigned int maxStep = (unsigned int)std::pow(2.0, (double)(detailLevels-1));
 
-    // Create terrain patches
-    unsigned int x1, x2, z1, z2;
-    unsigned int row = 0, column = 0;
-    for (unsigned int z = 0; z < height-1; z = z2, ++row)
+    if (heightfield->isTiled())
     {
-        z1 = z;
-        z2 = std::min(z1 + patchSize, height-1);
-
-        for (unsigned int x = 0; x < width-1; x = x2, ++column)
+        // Paged terrain: patches are created around the camera as their tiles are loaded
+        terrain->_pager = new TerrainPager(terrain, heightfield, maxStep, skirtScale);
+        terrain->_patches.resize(terrain->_pager->_rows * terrain->_pager->_columns, NULL);
+        bounds.set(terrain->_pager->getBoundingBox());
+    }
+    else
+    {
+        TerrainPatch::Heights heights = heightfield->isQuantized() ?
+            TerrainPatch::Heights(heightfield->getQuantizedArray(), 0, 0, width, heightfield->getQuantizedMin(), heightfield->getQuantizedStep()) :
+            TerrainPatch::Heights(heightfield->getArray(), 0, 0, width);
+
+        // Create terrain patches
+        unsigned int x1, x2, z1, z2;
+        unsigned int row = 0, column = 0;
+        for (unsigned int z = 0; z < height-1; z = z2, ++row)
         {
-            x1 = x;
-            x2 = std::min(x1 + patchSize, width-1);
+            z1 = z;
+            z2 = std::min(z1 + patchSize, height-1);
+
+            for (unsigned int x = 0; x < width-1; x = x2, ++column)
+            {
+                x1 = x;
+                x2 = std::min(x1 + patchSize, width-1);
 
-            // Create this patch
-            TerrainPatch* patch = TerrainPatch::create(terrain, terrain->_patches.size(), row, column, heightfield->getArray(), width, height, x1, z1, x2, z2, -halfWidth, -halfHeight, maxStep, skirtScale);
-            terrain->_patches.push_back(patch);
+                // Create this patch
+                TerrainPatch* patch = TerrainPatch::create(terrain, terrain->_patches.size(), row, column, heights, width, height, x1, z1, x2, z2, -halfWidth, -halfHeight, maxStep, skirtScale);
+                terrain->_patches.push_back(patch);
 
-            // Append the new patch's local bounds to the terrain local bounds
-            bounds.merge(patch->getBoundingBox(false));
+                // Append the new patch's local bounds to the terrain local bounds
+                bounds.merge(patch->getBoundingBox(false));
+            }
         }
     }
 
@@ -366,7 +435,10 @@ Terrain* Terrain::create(HeightField* heightfield, const Vector3& scale,
 
     // Load materials for all patches
     for (size_t i = 0, count = terrain->_patches.size(); i < count; ++i)
-        terrain->_patches[i]->updateMaterial();
+    {
+        if (terrain->_patches[i])
+            terrain->_patches[i]->updateMaterial();
+    }
 
     return terrain;
 }
@@ -390,7 +462,8 @@ void Terrain::setNode(Node* node)
         // Update patch node bindings
         for (size_t i = 0, count = _patches.size(); i < count; ++i)
         {
-            _patches[i]->updateNodeBindings();
+            if (_patches[i])
+                _patches[i]->updateNodeBindings();
         }
 
         _dirtyFlags |= DIRTY_FLAG_INVERSE_WORLD;
@@ -426,11 +499,38 @@ bool Terrain::setLayer(int index, const char* texturePath, const Vector2& textur
     if (!texturePath)
         return false;
 
+    // Paged terrains need to remember layers, so that they can be applied to patches loaded later
+    if (_pager)
+    {
+        Layer layer;
+        layer.index = index;
+        layer.texturePath = texturePath;
+        layer.textureRepeat = textureRepeat;
+        layer.blendPath = blendPath ? blendPath : "";
+        layer.blendChannel = blendChannel;
+        layer.row = row;
+        layer.column = column;
+
+        std::vector<Layer>::iterator itr = _layers.begin();
+        for (; itr != _layers.end(); ++itr)
+        {
+            if (itr->index == index && itr->row == row && itr->column == column)
+            {
+                *itr = layer;
+                break;
+            }
+        }
+        if (itr == _layers.end())
+            _layers.push_back(layer);
+    }
+
     // Set layer on applicable patches
     bool result = true;
     for (size_t i = 0, count = _patches.size(); i < count; ++i)
     {
         TerrainPatch* patch = _patches[i];
+        if (!patch)
+            continue;
 
         if ((row == -1 || (int)patch->_row == row) && (column == -1 || (int)patch->_column == column))
         {
@@ -442,6 +542,24 @@ bool Terrain::setLayer(int index, const char* texturePath, const Vector2& textur
     return result;
 }
 
+void Terrain::applyLayers(TerrainPatch* patch)
+{
+    GP_ASSERT(patch);
+
+    for (size_t i = 0, count = _layers.size(); i < count; ++i)
+    {
+        const Layer& layer = _layers[i];
+        if ((layer.row == -1 || (int)patch->_row == layer.row) && (layer.column == -1 || (int)patch->_column == layer.column))
+        {
+            if (!patch->setLayer(layer.index, layer.texturePath.c_str(), layer.textureRepeat,
+                layer.blendPath.empty() ? NULL : layer.blendPath.c_str(), layer.blendChannel))
+            {
+                GP_WARN("Failed to load terrain layer: %s", layer.texturePath.c_str());
+            }
+        }
+    }
+}
+
 Node* Terrain::getNode() const
 {
     return _node;
@@ -477,7 +595,10 @@ void Terrain::setFlag(Flags flag, bool on)
     {
         // Dirty all materials since they need to be updated to support debug drawing
         for (size_t i = 0, count = _patches.size(); i < count; ++i)
-            _patches[i]->setMaterialDirty();
+        {
+            if (_patches[i])
+                _patches[i]->setMaterialDirty();
+        }
     }
 }
 
@@ -486,11 +607,44 @@ unsigned int Terrain::getPatchCount() const
     return _patches.size();
 }
 
+size_t Terrain::getMemoryUsage() const
+{
+    size_t size = _heightfield->getMemoryUsage();
+    for (size_t i = 0, count = _patches.size(); i < count; ++i)
+    {
+        if (_patches[i])
+            size += _patches[i]->getMemoryUsage();
+    }
+    return size;
+}
+
 TerrainPatch* Terrain::getPatch(unsigned int index) const
 {
     return _patches[index];
 }
 
+bool Terrain::isPaged() const
+{
+    return _pager != NULL;
+}
+
+void Terrain::setPageRadius(unsigned int radius)
+{
+    if (_pager && _pager->_radius != radius)
+    {
+        _pager->_radius = radius;
+
+        // Force the loaded region to be re-evaluated on the next draw
+        _pager->_centerRow = -1;
+        _pager->_centerColumn = -1;
+    }
+}
+
+unsigned int Terrain::getPageRadius() const
+{
+    return _pager ? _pager->_radius : 0;
+}
+
 const BoundingBox& Terrain::getBoundingBox() const
 {
     return _boundingBox;
@@ -508,7 +662,8 @@ float Terrain::getHeight(float x, float z) const
     // Since the specified coordinates are in world space, we need to use the 
     // inverse of our world matrix to transform the world x,z coords back into
     // local heightfield coordinates for indexing into the height array.
-    Vector3 v = getInverseWorldMatrix() * Vector3(x, 0.0f, z);
+    Vector3 v;
+    getInverseWorldMatrix().transformPoint(Vector3(x, 0.0f, z), &v);
     x = v.x + (cols - 1) * 0.5f;
     z = v.z + (rows - 1) * 0.5f;
 
@@ -529,9 +684,106 @@ float Terrain::getHeight(float x, float z) const
     return height;
 }
 
+void Terrain::getHeights(const Vector2* xz, float* heights, size_t count) const
+{
+    getHeights(xz, heights, NULL, count);
+}
+
+void Terrain::getHeights(const Vector2* xz, float* heights, Vector3* normals, size_t count) const
+{
+    GP_ASSERT(xz);
+    GP_ASSERT(heights);
+
+    // Number of positions processed at a time, which bounds the size of the sample arrays below.
+    static const size_t BATCH_SIZE = 64;
+
+    float halfCols = (_heightfield->getColumnCount() - 1) * 0.5f;
+    float halfRows = (_heightfield->getRowCount() - 1) * 0.5f;
+
+    // Evaluate the transform and height scale once for all positions
+    const Matrix& m = getInverseWorldMatrix();
+    float heightScale = _localScale.y;
+    if (_node)
+    {
+        Vector3 worldScale;
+        _node->getWorldMatrix().getScale(&worldScale);
+        heightScale *= worldScale.y;
+    }
+
+    // Normals are sampled from the neighboring heights of each position, so every position
+    // needs five samples: center, west, east, north and south.
+    unsigned int samples = normals ? 5 : 1;
+    Vector2 points[BATCH_SIZE * 5];
+    float values[BATCH_SIZE * 5];
+
+    for (size_t i = 0; i < count; i += BATCH_SIZE)
+    {
+        size_t n = std::min(count - i, BATCH_SIZE);
+
+        // Transform world x,z into heightfield column and row coordinates
+        for (size_t j = 0; j < n; ++j)
+        {
+            const Vector2& p = xz[i + j];
+            float column = m.m[0] * p.x + m.m[8] * p.y + m.m[12] + halfCols;
+            float row = m.m[2] * p.x + m.m[10] * p.y + m.m[14] + halfRows;
+            Vector2* s = points + j * samples;
+            s[0].set(column, row);
+            if (normals)
+            {
+                s[1].set(column - 1.0f, row);
+                s[2].set(column + 1.0f, row);
+                s[3].set(column, row - 1.0f);
+                s[4].set(column, row + 1.0f);
+            }
+        }
+
+        _heightfield->getHeights(points, values, n * samples);
+
+        for (size_t j = 0; j < n; ++j)
+        {
+            const float* v = values + j * samples;
+            heights[i + j] = v[0] * heightScale;
+
+            if (normals)
+            {
+                // Normal in unscaled heightfield space, transformed to world space by the
+                // inverse transpose of the world matrix (which includes the local scale).
+                float nx = (v[1] - v[2]) * 0.5f;
+                float nz = (v[3] - v[4]) * 0.5f;
+                Vector3& normal = normals[i + j];
+                normal.set(m.m[0] * nx + m.m[1] + m.m[2] * nz,
+                           m.m[4] * nx + m.m[5] + m.m[6] * nz,
+                           m.m[8] * nx + m.m[9] + m.m[10] * nz);
+                normal.normalize();
+            }
+        }
+    }
+}
+
 unsigned int Terrain::draw(bool wireframe)
 {
     size_t visibleCount = 0;
+
+    if (_pager)
+    {
+        // Update the loaded region of a paged terrain around the active camera
+        Scene* scene = _node ? _node->getScene() : NULL;
+        Camera* camera = scene ? scene->getActiveCamera() : NULL;
+        if (camera && camera->getNode())
+        {
+            Vector3 v;
+            getInverseWorldMatrix().transformPoint(camera->getNode()->getTranslationWorld(), &v);
+            _pager->update(v.x + (_heightfield->getColumnCount() - 1) * 0.5f, v.z + (_heightfield->getRowCount() - 1) * 0.5f);
+        }
+
+        const std::vector<unsigned int>& loaded = _pager->_loaded;
+        for (size_t i = 0, count = loaded.size(); i < count; ++i)
+        {
+            visibleCount += _patches[loaded[i]]->draw(wireframe);
+        }
+        return visibleCount;
+    }
+
     for (size_t i = 0, count = _patches.size(); i < count; ++i)
     {
         visibleCount += _patches[i]->draw(wireframe);
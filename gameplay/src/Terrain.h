@@ -13,6 +13,7 @@ namespace gameplay
 
 class Node;
 class TerrainPatch;
+class TerrainPager;
 class TerrainAutoBindingResolver;
 
 /**
@@ -78,6 +79,28 @@ class TerrainAutoBindingResolver;
  * approaches. In practice, the skirts are often not noticeable at all unless the LOD variation
  * is very large and the terrain is excessively hilly on the edge of a LOD transition.
  *
+ * Terrains that are too large to keep in memory can be paged, by creating them from a tiled
+ * HeightField (or by setting the "paged" property in the heightmap section of a terrain file).
+ * Paged terrains use the heightfield tile size as their patch size, and only keep the patches
+ * within a configurable radius of the active camera loaded. Height data is read and patch
+ * geometry is built on a background thread as the camera moves. Height queries are only
+ * answered for loaded patches, and paged terrains cannot be used as physics heightfields.
+ *
+ * Memory usage of large terrains can be reduced further in two ways. Setting the "quantized"
+ * property in the heightmap section stores the heightfield as 16-bit values instead of floats
+ * (see HeightField). Setting the "compactVertices" property of the terrain stores each vertex
+ * as a grid coordinate, height and packed normal (12 bytes, or 8 bytes with a normal map)
+ * instead of a full position, normal and texture coordinate (32 or 20 bytes); the terrain
+ * vertex shader derives the rest from the grid coordinate and per-patch parameters. Compact
+ * vertices require the terrain material to use the built-in terrain shaders (or shaders that
+ * support the COMPACT_VERTICES definition), and patches of at most 4093 quads; terrains with
+ * larger patches use full vertices. getMemoryUsage reports the resulting memory use.
+ *
+ * Heights read from a heightmap are normalized to [0, 1] and scaled by the terrain height.
+ * Setting the "heightRange" property of the heightmap section (min, max) maps them onto that
+ * range instead, and the terrain height then defaults to 1. The encoder writes this range to
+ * a terrain file alongside the quantized RAW16 heightmaps it generates.
+ *
  * @see http://blackberry.github.io/GamePlay/docs/file-formats.html#wiki-Terrain
  */
 class Terrain : public Ref, private Transform::Listener
@@ -86,6 +109,7 @@ class Terrain : public Ref, private Transform::Listener
     friend class PhysicsController;
     friend class PhysicsRigidBody;
     friend class TerrainPatch;
+    friend class TerrainPager;
     friend class TerrainAutoBindingResolver;
 
 public:
@@ -153,6 +177,9 @@ public:
      *
      * The newly created terrain increases the reference count of the HeightField.
      *
+     * If the heightfield is tiled, the terrain is paged and patches are loaded around the
+     * active camera. In this case the tile size of the heightfield is used as the patch size.
+     *
      * @param heightfield The heightfield object containing height data for the terrain.
      * @param scale A scale to apply to the terrain along the X, Y and Z axes. The terrain and any associated
      *      physics heightfield is scaled by this amount. Pass Vector3::one() to use the exact dimensions and heights
@@ -202,11 +229,43 @@ public:
      */
     unsigned int getPatchCount() const;
 
+    /**
+     * Gets the number of bytes used by the height data and the patch geometry of this terrain.
+     *
+     * For paged terrains, only the tiles and patches that are currently loaded are included.
+     *
+     * @return The memory usage of the terrain, in bytes.
+     */
+    size_t getMemoryUsage() const;
+
     /**
      * Gets a terrain patch
+     *
+     * For paged terrains, NULL is returned for patches that are not currently loaded.
      */
     TerrainPatch* getPatch(unsigned int index) const;
 
+    /**
+     * Determines if this terrain is paged.
+     *
+     * @return True if patches are loaded around the camera from a tiled heightfield.
+     */
+    bool isPaged() const;
+
+    /**
+     * Sets the radius, in patches, of the region kept loaded around the camera for paged terrains.
+     *
+     * @param radius The page radius (the default is 8). Has no effect if the terrain is not paged.
+     */
+    void setPageRadius(unsigned int radius);
+
+    /**
+     * Gets the radius, in patches, of the region kept loaded around the camera for paged terrains.
+     *
+     * @return The page radius, or zero if the terrain is not paged.
+     */
+    unsigned int getPageRadius() const;
+
     /**
      * Gets the local bounding box for this terrain.
      *
@@ -220,6 +279,7 @@ public:
      * The specified X and Z coordinates should be in world units and may fall between height values.
      * In this case, an interpolated value will be returned between neighboring heightfield heights.
      * If the specified point lies outside of the terrain, it is clamped to the terrain boundaries.
+     * For paged terrains, zero is returned if the patch containing the point is not loaded.
      *
      * @param x The X coordinate, in world space.
      * @param z The Z coordinate, in world space.
@@ -228,6 +288,35 @@ public:
      */
     float getHeight(float x, float z) const;
 
+    /**
+     * Gets the world-space heights of the terrain at many positions on the X,Z plane at once.
+     *
+     * This returns the same heights as calling getHeight for each position, but the terrain
+     * transform is only evaluated once and the heights are interpolated several at a time,
+     * which makes it much faster for large numbers of queries (such as placing many objects
+     * on the terrain every frame).
+     *
+     * @param xz Array of positions on the X,Z plane, in world space (x in the x component, z in the y component).
+     * @param heights Array that receives the height at each position.
+     * @param count The number of positions.
+     * @script{ignore}
+     */
+    void getHeights(const Vector2* xz, float* heights, size_t count) const;
+
+    /**
+     * Gets the world-space heights and surface normals of the terrain at many positions on the X,Z plane at once.
+     *
+     * Heights are computed as for getHeights(const Vector2*, float*, size_t). Normals are computed
+     * from the slope of the heightfield at each position and are returned in world space.
+     *
+     * @param xz Array of positions on the X,Z plane, in world space (x in the x component, z in the y component).
+     * @param heights Array that receives the height at each position.
+     * @param normals Array that receives the unit length world-space normal at each position.
+     * @param count The number of positions.
+     * @script{ignore}
+     */
+    void getHeights(const Vector2* xz, float* heights, Vector3* normals, size_t count) const;
+
     /**
      * Draws the terrain.
      *
@@ -279,6 +368,20 @@ public:
 
 private:
 
+    /**
+     * Layer definition, kept by paged terrains so that it can be applied to patches as they load.
+     */
+    struct Layer
+    {
+        int index;
+        std::string texturePath;
+        Vector2 textureRepeat;
+        std::string blendPath;
+        int blendChannel;
+        int row;
+        int column;
+    };
+
     /**
      * Constructor.
      */
@@ -332,12 +435,21 @@ private:
      */
     BoundingBox getBoundingBox(bool worldSpace) const;
 
+    /**
+     * Applies the stored layer definitions to a newly loaded patch of a paged terrain.
+     */
+    void applyLayers(TerrainPatch* patch);
+
     std::string _materialPath;
     HeightField* _heightfield;
     Node* _node;
     Vector3 _localScale;
     std::vector<TerrainPatch*> _patches;
+    TerrainPager* _pager;
+    std::vector<Layer> _layers;
     Texture::Sampler* _normalMap;
+    bool _compactVertices;
+    float _skirtScale;
     unsigned int _flags;
     mutable Matrix _inverseWorldMatrix;
     mutable unsigned int _dirtyFlags;
@@ -0,0 +1,261 @@
+#include "Base.h"
+#include "TerrainPager.h"
+#include "Terrain.h"
+
+namespace gameplay
+{
+
+// The default radius, in patches, of the region of terrain kept loaded around the camera.
+static const unsigned int DEFAULT_PAGE_RADIUS = 8;
+
+// The maximum number of loaded patches that are published (uploaded to the GPU) per frame.
+static const unsigned int MAX_PATCHES_PER_FRAME = 4;
+
+TerrainPager::TerrainPager(Terrain* terrain, HeightField* heightfield, unsigned int maxStep, float skirtScale) :
+    _terrain(terrain), _heightfield(heightfield), _patchSize(heightfield->getTileSize()), _rows(0), _columns(0),
+    _maxStep(maxStep), _skirtScale(skirtScale), _scale(terrain->_localScale), _normals(terrain->_normalMap == NULL),
+    _compact(terrain->_compactVertices), _radius(DEFAULT_PAGE_RADIUS), _centerRow(-1), _centerColumn(-1), _thread(NULL), _quit(false)
+{
+    GP_ASSERT(_patchSize > 0);
+
+    _rows = (heightfield->getRowCount() - 2) / _patchSize + 1;
+    _columns = (heightfield->getColumnCount() - 2) / _patchSize + 1;
+
+    _thread = Thread::create(&threadFunc, this);
+}
+
+TerrainPager::~TerrainPager()
+{
+    // Stop the loader thread
+    _mutex.lock();
+    _quit = true;
+    _condition.broadcast();
+    _mutex.unlock();
+    SAFE_DELETE(_thread);
+
+    // Delete any requests that were never published
+    for (size_t i = 0, count = _pending.size(); i < count; ++i)
+        deleteRequest(_pending[i]);
+    for (size_t i = 0, count = _completed.size(); i < count; ++i)
+        deleteRequest(_completed[i]);
+    for (size_t i = 0, count = _ready.size(); i < count; ++i)
+        deleteRequest(_ready[i]);
+}
+
+BoundingBox TerrainPager::getBoundingBox() const
+{
+    // Patch geometry is not available up front, so bound the terrain by its full height range.
+    float halfWidth = (_heightfield->getColumnCount() - 1) * 0.5f;
+    float halfHeight = (_heightfield->getRowCount() - 1) * 0.5f;
+    return BoundingBox(-halfWidth * _scale.x, _heightfield->_heightMin * _scale.y, -halfHeight * _scale.z,
+                       halfWidth * _scale.x, _heightfield->_heightMax * _scale.y, halfHeight * _scale.z);
+}
+
+bool TerrainPager::isInRange(unsigned int row, unsigned int column, unsigned int radius) const
+{
+    return std::abs((int)row - _centerRow) <= (int)radius && std::abs((int)column - _centerColumn) <= (int)radius;
+}
+
+void TerrainPager::update(float column, float row)
+{
+    // Take ownership of any patches finished by the loader thread
+    _mutex.lock();
+    for (size_t i = 0, count = _completed.size(); i < count; ++i)
+        _ready.push_back(_completed[i]);
+    _completed.clear();
+    _mutex.unlock();
+
+    // Publish a limited number of patches per frame to avoid stalls while the camera moves
+    for (unsigned int i = 0; i < MAX_PATCHES_PER_FRAME && !_ready.empty(); ++i)
+    {
+        Request* request = _ready.front();
+        _ready.pop_front();
+        _requested.erase(request->index);
+
+        if (request->levels.size() > 0 && isInRange(request->row, request->column, _radius + 1))
+            loadPatch(request);
+
+        deleteRequest(request);
+    }
+
+    int centerRow = (int)std::max(0.0f, row) / (int)_patchSize;
+    int centerColumn = (int)std::max(0.0f, column) / (int)_patchSize;
+    centerRow = std::min(centerRow, (int)_rows - 1);
+    centerColumn = std::min(centerColumn, (int)_columns - 1);
+    if (centerRow == _centerRow && centerColumn == _centerColumn)
+        return;
+
+    _centerRow = centerRow;
+    _centerColumn = centerColumn;
+
+    // Unload patches that are no longer in range. Patches are kept one ring beyond the load
+    // radius so that small camera movements do not repeatedly load and unload the same patches.
+    for (size_t i = 0; i < _loaded.size(); )
+    {
+        TerrainPatch* patch = _terrain->_patches[_loaded[i]];
+        if (!isInRange(patch->_row, patch->_column, _radius + 1))
+        {
+            unloadPatch(_loaded[i]);
+            _loaded[i] = _loaded.back();
+            _loaded.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // Build requests for missing patches within range
+    std::vector<Request*> requests;
+    int rowStart = std::max(0, _centerRow - (int)_radius);
+    int rowEnd = std::min((int)_rows - 1, _centerRow + (int)_radius);
+    int columnStart = std::max(0, _centerColumn - (int)_radius);
+    int columnEnd = std::min((int)_columns - 1, _centerColumn + (int)_radius);
+    for (int r = rowStart; r <= rowEnd; ++r)
+    {
+        for (int c = columnStart; c <= columnEnd; ++c)
+        {
+            unsigned int index = r * _columns + c;
+            if (_terrain->_patches[index] == NULL && _requested.find(index) == _requested.end())
+            {
+                Request* request = new Request();
+                request->index = index;
+                request->row = r;
+                request->column = c;
+                requests.push_back(request);
+                _requested.insert(index);
+            }
+        }
+    }
+
+    _mutex.lock();
+
+    // Cancel pending requests that have moved out of range
+    for (size_t i = 0; i < _pending.size(); )
+    {
+        Request* request = _pending[i];
+        if (!isInRange(request->row, request->column, _radius + 1))
+        {
+            _requested.erase(request->index);
+            deleteRequest(request);
+            _pending.erase(_pending.begin() + i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // Queue the new requests and load the patches closest to the camera first
+    _pending.insert(_pending.end(), requests.begin(), requests.end());
+    std::sort(_pending.begin(), _pending.end(), RequestCompare(_centerRow, _centerColumn));
+    if (!_pending.empty())
+        _condition.signal();
+
+    _mutex.unlock();
+}
+
+void TerrainPager::loadPatch(Request* request)
+{
+    GP_ASSERT(_terrain->_patches[request->index] == NULL);
+
+    // Make the tile's heights available for height queries
+    _heightfield->setTile(request->row, request->column, request->tile);
+    request->tile.heights = NULL;
+    request->tile.quantized = NULL;
+
+    TerrainPatch* patch = TerrainPatch::create(_terrain, request->index, request->row, request->column, request->levels);
+    _terrain->_patches[request->index] = patch;
+    _terrain->applyLayers(patch);
+    _loaded.push_back(request->index);
+}
+
+void TerrainPager::unloadPatch(unsigned int index)
+{
+    TerrainPatch* patch = _terrain->_patches[index];
+    GP_ASSERT(patch);
+
+    _heightfield->releaseTile(patch->_row, patch->_column);
+    SAFE_DELETE(_terrain->_patches[index]);
+}
+
+void TerrainPager::buildPatch(Request* request) const
+{
+    if (!_heightfield->readTile(request->row, request->column, _maxStep, &request->tile))
+        return;
+
+    unsigned int width = _heightfield->getColumnCount();
+    unsigned int height = _heightfield->getRowCount();
+    unsigned int x1 = request->column * _patchSize;
+    unsigned int z1 = request->row * _patchSize;
+    unsigned int x2 = std::min(x1 + _patchSize, width - 1);
+    unsigned int z2 = std::min(z1 + _patchSize, height - 1);
+
+    // The tile border is at least maxStep samples wide, which covers every neighboring
+    // height accessed while computing vertex normals for all levels of detail.
+    const HeightField::Tile& tile = request->tile;
+    TerrainPatch::Heights heights = tile.quantized ?
+        TerrainPatch::Heights(tile.quantized, tile.x, tile.z, tile.width, _heightfield->getQuantizedMin(), _heightfield->getQuantizedStep()) :
+        TerrainPatch::Heights(tile.heights, tile.x, tile.z, tile.width);
+    TerrainPatch::buildLODs(heights, width, height,
+                            x1, z1, x2, z2, -(width - 1) * 0.5f, -(height - 1) * 0.5f, _maxStep, _skirtScale,
+                            _scale, _normals, _compact, request->levels);
+}
+
+void TerrainPager::deleteRequest(Request* request)
+{
+    TerrainPatch::deleteLODs(request->levels);
+    SAFE_DELETE_ARRAY(request->tile.heights);
+    SAFE_DELETE_ARRAY(request->tile.quantized);
+    SAFE_DELETE(request);
+}
+
+void TerrainPager::threadFunc(void* arg)
+{
+    static_cast<TerrainPager*>(arg)->run();
+}
+
+void TerrainPager::run()
+{
+    _mutex.lock();
+    while (true)
+    {
+        while (!_quit && _pending.empty())
+            _condition.wait(_mutex);
+
+        if (_quit)
+            break;
+
+        Request* request = _pending.front();
+        _pending.pop_front();
+
+        // Do the expensive work (disk access and geometry generation) without holding the lock
+        _mutex.unlock();
+        buildPatch(request);
+        _mutex.lock();
+
+        _completed.push_back(request);
+    }
+    _mutex.unlock();
+}
+
+TerrainPager::Request::Request() :
+    index(0), row(0), column(0)
+{
+}
+
+TerrainPager::RequestCompare::RequestCompare(int row, int column) :
+    row(row), column(column)
+{
+}
+
+bool TerrainPager::RequestCompare::operator() (const Request* lhs, const Request* rhs) const
+{
+    int lr = (int)lhs->row - row;
+    int lc = (int)lhs->column - column;
+    int rr = (int)rhs->row - row;
+    int rc = (int)rhs->column - column;
+    return (lr * lr + lc * lc) < (rr * rr + rc * rc);
+}
+
+}
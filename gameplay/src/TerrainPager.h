@@ -0,0 +1,126 @@
+#ifndef TERRAINPAGER_H_
+#define TERRAINPAGER_H_
+
+#include "HeightField.h"
+#include "TerrainPatch.h"
+#include "Thread.h"
+
+namespace gameplay
+{
+
+class Terrain;
+
+/**
+ * Streams terrain patches in and out around the camera for terrains created from a
+ * tiled HeightField.
+ *
+ * Height tiles are read from disk and patch geometry for every level of detail is built
+ * on a background thread. Graphics resources are only created on the main thread, when
+ * completed patches are published from update().
+ *
+ * @script{ignore}
+ */
+class TerrainPager
+{
+    friend class Terrain;
+
+private:
+
+    /**
+     * A request to load a single terrain patch.
+     */
+    struct Request
+    {
+        Request();
+
+        unsigned int index;
+        unsigned int row;
+        unsigned int column;
+        HeightField::Tile tile;
+        std::vector<TerrainPatch::LevelData> levels;
+    };
+
+    /**
+     * Orders requests by their distance to the center patch.
+     */
+    struct RequestCompare
+    {
+        RequestCompare(int row, int column);
+
+        bool operator() (const Request* lhs, const Request* rhs) const;
+
+        int row;
+        int column;
+    };
+
+    /**
+     * Constructor.
+     */
+    TerrainPager(Terrain* terrain, HeightField* heightfield, unsigned int maxStep, float skirtScale);
+
+    /**
+     * Hidden copy constructor.
+     */
+    TerrainPager(const TerrainPager&);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    TerrainPager& operator=(const TerrainPager&);
+
+    /**
+     * Destructor.
+     */
+    ~TerrainPager();
+
+    /**
+     * Updates the set of loaded patches for a camera at the specified heightfield row and column.
+     */
+    void update(float column, float row);
+
+    /**
+     * Returns the local bounds of the whole terrain.
+     */
+    BoundingBox getBoundingBox() const;
+
+    bool isInRange(unsigned int row, unsigned int column, unsigned int radius) const;
+
+    void loadPatch(Request* request);
+
+    void unloadPatch(unsigned int index);
+
+    void buildPatch(Request* request) const;
+
+    static void deleteRequest(Request* request);
+
+    static void threadFunc(void* arg);
+
+    void run();
+
+    Terrain* _terrain;
+    HeightField* _heightfield;
+    unsigned int _patchSize;
+    unsigned int _rows;
+    unsigned int _columns;
+    unsigned int _maxStep;
+    float _skirtScale;
+    Vector3 _scale;
+    bool _normals;
+    bool _compact;
+    unsigned int _radius;
+    int _centerRow;
+    int _centerColumn;
+    std::vector<unsigned int> _loaded;
+    std::set<unsigned int> _requested;
+    std::deque<Request*> _ready;
+    Thread* _thread;
+    Mutex _mutex;
+    Condition _condition;
+    std::deque<Request*> _pending;
+    std::vector<Request*> _completed;
+    bool _quit;
+};
+
+}
+
+#endif
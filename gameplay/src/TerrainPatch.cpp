@@ -30,7 +30,7 @@ static TerrainAutoBindingResolver __autoBindingResolver;
 static int __currentPatchIndex = -1;
 
 TerrainPatch::TerrainPatch() :
-    _terrain(NULL), _row(0), _column(0), _camera(NULL), _level(0), _bits(TERRAINPATCH_DIRTY_ALL)
+    _terrain(NULL), _row(0), _column(0), _gridX(0), _gridZ(0), _gridWidth(0), _gridHeight(0), _camera(NULL), _level(0), _bits(TERRAINPATCH_DIRTY_ALL)
 {
 }
 
@@ -52,23 +52,41 @@ TerrainPatch::~TerrainPatch()
 
 TerrainPatch* TerrainPatch::create(Terrain* terrain, unsigned int index,
                                    unsigned int row, unsigned int column,
-                                   float* heights, unsigned int width, unsigned int height,
+                                   const Heights& heights, unsigned int width, unsigned int height,
                                    unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
                                    float xOffset, float zOffset,
                                    unsigned int maxStep, float verticalSkirtSize)
 {
+    // Build patch lods
+    std::vector<LevelData> levels;
+    buildLODs(heights, width, height, x1, z1, x2, z2, xOffset, zOffset, maxStep, verticalSkirtSize,
+              terrain->_localScale, terrain->_normalMap == NULL, terrain->_compactVertices, levels);
+
+    return create(terrain, index, row, column, levels);
+}
+
+TerrainPatch* TerrainPatch::create(Terrain* terrain, unsigned int index,
+                                   unsigned int row, unsigned int column, std::vector<LevelData>& levels)
+{
+    GP_ASSERT(levels.size() > 0);
+
     // Create patch
     TerrainPatch* patch = new TerrainPatch();
     patch->_terrain = terrain;
     patch->_index = index;
     patch->_row = row;
     patch->_column = column;
+    patch->_gridX = levels[0].gridX;
+    patch->_gridZ = levels[0].gridZ;
+    patch->_gridWidth = levels[0].gridWidth;
+    patch->_gridHeight = levels[0].gridHeight;
 
     // Add patch lods
-    for (unsigned int step = 1; step <= maxStep; step *= 2)
+    for (size_t i = 0, count = levels.size(); i < count; ++i)
     {
-        patch->addLOD(heights, width, height, x1, z1, x2, z2, xOffset, zOffset, step, verticalSkirtSize);
+        patch->addLOD(levels[i]);
     }
+    deleteLODs(levels);
 
     // Set our bounding box using the base LOD mesh
     BoundingBox& bounds = patch->_boundingBox;
@@ -101,10 +119,50 @@ Material* TerrainPatch::getMaterial(int index) const
     return _levels[index]->model->getMaterial();
 }
 
-void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int height,
-                          unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
-                          float xOffset, float zOffset,
-                          unsigned int step, float verticalSkirtSize)
+size_t TerrainPatch::getMemoryUsage() const
+{
+    size_t size = 0;
+    for (size_t i = 0, count = _levels.size(); i < count; ++i)
+    {
+        Mesh* mesh = _levels[i]->model->getMesh();
+        size += mesh->getVertexCount() * mesh->getVertexSize();
+        for (unsigned int j = 0, partCount = mesh->getPartCount(); j < partCount; ++j)
+        {
+            MeshPart* part = mesh->getPart(j);
+            unsigned int indexSize = part->getIndexFormat() == Mesh::INDEX32 ? 4 : (part->getIndexFormat() == Mesh::INDEX16 ? 2 : 1);
+            size += part->getIndexCount() * indexSize;
+        }
+    }
+    return size;
+}
+
+void TerrainPatch::buildLODs(const Heights& heights, unsigned int width, unsigned int height,
+                             unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
+                             float xOffset, float zOffset, unsigned int maxStep, float verticalSkirtSize,
+                             const Vector3& scale, bool normals, bool compact, std::vector<LevelData>& levels)
+{
+    for (unsigned int step = 1; step <= maxStep; step *= 2)
+    {
+        LevelData level;
+        if (buildLOD(heights, width, height, x1, z1, x2, z2, xOffset, zOffset, step, verticalSkirtSize, scale, normals, compact, &level))
+            levels.push_back(level);
+    }
+}
+
+void TerrainPatch::deleteLODs(std::vector<LevelData>& levels)
+{
+    for (size_t i = 0, count = levels.size(); i < count; ++i)
+    {
+        SAFE_DELETE_ARRAY(levels[i].vertices);
+        SAFE_DELETE_ARRAY(levels[i].indices);
+    }
+    levels.clear();
+}
+
+bool TerrainPatch::buildLOD(const Heights& heights, unsigned int width, unsigned int height,
+                            unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
+                            float xOffset, float zOffset, unsigned int step, float verticalSkirtSize,
+                            const Vector3& scale, bool normals, bool compact, LevelData* level)
 {
     // Allocate vertex data for this patch
     unsigned int patchWidth;
@@ -121,7 +179,7 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
     }
 
     if (patchWidth < 2 || patchHeight < 2)
-        return; // ignore this level, not enough geometry
+        return false; // ignore this level, not enough geometry
 
     if (verticalSkirtSize > 0.0f)
     {
@@ -130,13 +188,17 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
     }
 
     unsigned int vertexCount = patchHeight * patchWidth;
-    unsigned int vertexElements = _terrain->_normalMap ? 5 : 8; //<x,y,z>[i,j,k]<u,v>
+    unsigned int vertexElements;
+    if (compact)
+        vertexElements = normals ? 3 : 2; //<grid,y>[packed normal]
+    else
+        vertexElements = normals ? 8 : 5; //<x,y,z>[i,j,k]<u,v>
     float* vertices = new float[vertexCount * vertexElements];
     unsigned int index = 0;
     Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX);
     Vector3 max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
-    float stepXScaled = step * _terrain->_localScale.x;
-    float stepZScaled = step * _terrain->_localScale.z;
+    float stepXScaled = step * scale.x;
+    float stepZScaled = step * scale.z;
     bool zskirt = verticalSkirtSize > 0 ? true : false;
     for (unsigned int z = z1; ; )
     {
@@ -149,37 +211,56 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
             index++;
 
             // Compute position - apply the local scale of the terrain into the vertex data
-            v[0] = (x + xOffset) * _terrain->_localScale.x;
-            v[1] = computeHeight(heights, width, x, z);
+            float px = (x + xOffset) * scale.x;
+            float py = heights.get(x, z) * scale.y;
+            float pz = (z + zOffset) * scale.z;
             if (xskirt || zskirt)
-                v[1] -= verticalSkirtSize * _terrain->_localScale.y;
-            v[2] = (z + zOffset) * _terrain->_localScale.z;
+                py -= verticalSkirtSize * scale.y;
 
             // Update bounding box min/max (don't include vertical skirt vertices in bounding box)
             if (!(xskirt || zskirt))
             {
-                if (v[0] < min.x)
-                    min.x = v[0];
-                if (v[1] < min.y)
-                    min.y = v[1];
-                if (v[2] < min.z)
-                    min.z = v[2];
-                if (v[0] > max.x)
-                    max.x = v[0];
-                if (v[1] > max.y)
-                    max.y = v[1];
-                if (v[2] > max.z)
-                    max.z = v[2];
+                if (px < min.x)
+                    min.x = px;
+                if (py < min.y)
+                    min.y = py;
+                if (pz < min.z)
+                    min.z = pz;
+                if (px > max.x)
+                    max.x = px;
+                if (py > max.y)
+                    max.y = py;
+                if (pz > max.z)
+                    max.z = pz;
+            }
+
+            if (compact)
+            {
+                // Store the grid coordinate relative to the patch origin, the shader derives x and z from it.
+                // Coordinates are offset by one so that skirt vertices can be stored one step outside the
+                // patch on either side, which tells the shader to offset their texture coordinates.
+                unsigned int gridX = xskirt ? (x == x1 ? 0 : x2 - x1 + 2) : x - x1 + 1;
+                unsigned int gridZ = zskirt ? (z == z1 ? 0 : z2 - z1 + 2) : z - z1 + 1;
+                v[0] = (float)(gridX + gridZ * TERRAINPATCH_PACK_SIZE);
+                v[1] = py;
+                v += 2;
+            }
+            else
+            {
+                v[0] = px;
+                v[1] = py;
+                v[2] = pz;
+                v += 3;
             }
 
             // Compute normal
-            if (!_terrain->_normalMap)
+            if (normals)
             {
-                Vector3 p(v[0], computeHeight(heights, width, x, z), v[2]);
-                Vector3 w(Vector3(x>=step ? v[0]-stepXScaled : v[0], computeHeight(heights, width, x>=step ? x-step : x, z), v[2]), p);
-                Vector3 e(Vector3(x<width-step ? v[0]+stepXScaled : v[0], computeHeight(heights, width, x<width-step ? x+step : x, z), v[2]), p);
-                Vector3 s(Vector3(v[0], computeHeight(heights, width, x, z>=step ? z-step : z), z>=step ? v[2]-stepZScaled : v[2]), p);
-                Vector3 n(Vector3(v[0], computeHeight(heights, width, x, z<height-step ? z+step : z), z<height-step ? v[2]+stepZScaled : v[2]), p);
+                Vector3 p(px, heights.get(x, z) * scale.y, pz);
+                Vector3 w(Vector3(x>=step ? px-stepXScaled : px, heights.get(x>=step ? x-step : x, z) * scale.y, pz), p);
+                Vector3 e(Vector3(x<width-step ? px+stepXScaled : px, heights.get(x<width-step ? x+step : x, z) * scale.y, pz), p);
+                Vector3 s(Vector3(px, heights.get(x, z>=step ? z-step : z) * scale.y, z>=step ? pz-stepZScaled : pz), p);
+                Vector3 n(Vector3(px, heights.get(x, z<height-step ? z+step : z) * scale.y, z<height-step ? pz+stepZScaled : pz), p);
                 Vector3 normals[4];
                 Vector3::cross(n, w, &normals[0]);
                 Vector3::cross(w, s, &normals[1]);
@@ -187,26 +268,38 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
                 Vector3::cross(s, e, &normals[3]);
                 Vector3 normal = -(normals[0] + normals[1] + normals[2] + normals[3]);
                 normal.normalize();
-                v[3] = normal.x;
-                v[4] = normal.y;
-                v[5] = normal.z;
-                v += 3;
+                if (compact)
+                {
+                    // Terrain normals always point up, so only x and z are stored (12 bits each)
+                    unsigned int nx = (unsigned int)((normal.x * 0.5f + 0.5f) * (TERRAINPATCH_PACK_SIZE - 1) + 0.5f);
+                    unsigned int nz = (unsigned int)((normal.z * 0.5f + 0.5f) * (TERRAINPATCH_PACK_SIZE - 1) + 0.5f);
+                    v[0] = (float)(nx * TERRAINPATCH_PACK_SIZE + nz);
+                    v += 1;
+                }
+                else
+                {
+                    v[0] = normal.x;
+                    v[1] = normal.y;
+                    v[2] = normal.z;
+                    v += 3;
+                }
             }
 
-            v += 3;
-
-            // Compute texture coord
-            v[0] = (float)x / width;
-            v[1] = 1.0f - (float)z / height;
-            if (xskirt)
-            {
-                float offset = verticalSkirtSize / width;
-                v[0] = x == x1 ? v[0]-offset : v[0]+offset;
-            }
-            else if (zskirt)
+            // Compute texture coord (compact vertices derive it from the grid coordinate)
+            if (!compact)
             {
-                float offset = verticalSkirtSize / height;
-                v[1] = z == z1 ? v[1]-offset : v[1]+offset;
+                v[0] = (float)x / width;
+                v[1] = 1.0f - (float)z / height;
+                if (xskirt)
+                {
+                    float offset = verticalSkirtSize / width;
+                    v[0] = x == x1 ? v[0]-offset : v[0]+offset;
+                }
+                else if (zskirt)
+                {
+                    float offset = verticalSkirtSize / height;
+                    v[1] = z == z1 ? v[1]-offset : v[1]+offset;
+                }
             }
 
             if (x == x2)
@@ -244,27 +337,7 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
     }
     GP_ASSERT(index == vertexCount);
 
-    Vector3 center(min + ((max - min) * 0.5f));
-
-    // Create mesh
-    VertexFormat::Element elements[3];
-    elements[0] = VertexFormat::Element(VertexFormat::POSITION, 3);
-    if (_terrain->_normalMap)
-    {
-        elements[1] = VertexFormat::Element(VertexFormat::TEXCOORD0, 2);
-    }
-    else
-    {
-        elements[1] = VertexFormat::Element(VertexFormat::NORMAL, 3);
-        elements[2] = VertexFormat::Element(VertexFormat::TEXCOORD0, 2);
-    }
-    VertexFormat format(elements, _terrain->_normalMap ? 2 : 3);
-    Mesh* mesh = Mesh::createMesh(format, vertexCount);
-    mesh->setVertexData(vertices);
-    mesh->setBoundingBox(BoundingBox(min, max));
-    mesh->setBoundingSphere(BoundingSphere(center, center.distance(max)));
-
-    // Add mesh part for indices
+    // Compute indices
     unsigned int indexCount =
         (patchWidth * 2) *      // # indices per row of tris
         (patchHeight - 1) +     // # rows of tris
@@ -278,7 +351,6 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
         GP_ASSERT(indexCount <= USHRT_MAX);
     }
 
-    MeshPart* part = mesh->addPart(Mesh::TRIANGLE_STRIP, Mesh::INDEX16, indexCount);
     unsigned short* indices = new unsigned short[indexCount];
     index = 0;
     for (unsigned int z = 0; z < patchHeight-1; ++z)
@@ -326,10 +398,51 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
         }
     }
     GP_ASSERT(index == indexCount);
-    part->setIndexData(indices, 0, indexCount);
 
-    SAFE_DELETE_ARRAY(vertices);
-    SAFE_DELETE_ARRAY(indices);
+    level->vertices = vertices;
+    level->vertexCount = vertexCount;
+    level->indices = indices;
+    level->indexCount = indexCount;
+    level->gridX = x1;
+    level->gridZ = z1;
+    level->gridWidth = x2 - x1;
+    level->gridHeight = z2 - z1;
+    level->min = min;
+    level->max = max;
+
+    return true;
+}
+
+void TerrainPatch::addLOD(LevelData& data)
+{
+    Vector3& min = data.min;
+    Vector3& max = data.max;
+    Vector3 center(min + ((max - min) * 0.5f));
+
+    // Create mesh
+    VertexFormat::Element elements[3];
+    unsigned int elementCount = 0;
+    if (_terrain->_compactVertices)
+    {
+        elements[elementCount++] = VertexFormat::Element(VertexFormat::POSITION, 2);
+        if (!_terrain->_normalMap)
+            elements[elementCount++] = VertexFormat::Element(VertexFormat::NORMAL, 1);
+    }
+    else
+    {
+        elements[elementCount++] = VertexFormat::Element(VertexFormat::POSITION, 3);
+        if (!_terrain->_normalMap)
+            elements[elementCount++] = VertexFormat::Element(VertexFormat::NORMAL, 3);
+        elements[elementCount++] = VertexFormat::Element(VertexFormat::TEXCOORD0, 2);
+    }
+    VertexFormat format(elements, elementCount);
+    Mesh* mesh = Mesh::createMesh(format, data.vertexCount);
+    mesh->setVertexData(data.vertices);
+    mesh->setBoundingBox(BoundingBox(min, max));
+    mesh->setBoundingSphere(BoundingSphere(center, center.distance(max)));
+
+    MeshPart* part = mesh->addPart(Mesh::TRIANGLE_STRIP, Mesh::INDEX16, data.indexCount);
+    part->setIndexData(data.indices, 0, data.indexCount);
 
     // Create model
     Model* model = Model::create(mesh);
@@ -486,6 +599,20 @@ std::string TerrainPatch::passCreated(Pass* pass)
     if (_terrain->_normalMap)
         defines << ";NORMAL_MAP";
 
+    if (_terrain->_compactVertices)
+    {
+        // Parameters used to derive the position and texture coord from the grid coordinate
+        unsigned int width = _terrain->_heightfield->getColumnCount();
+        unsigned int height = _terrain->_heightfield->getRowCount();
+        const Vector3& scale = _terrain->_localScale;
+        defines << ";COMPACT_VERTICES";
+        float skirtScale = _terrain->_skirtScale;
+        pass->getParameter("u_gridOrigin")->setValue(Vector2((float)_gridX, (float)_gridZ));
+        pass->getParameter("u_gridSize")->setValue(Vector2((float)_gridWidth, (float)_gridHeight));
+        pass->getParameter("u_gridToPosition")->setValue(Vector4(scale.x, scale.z, -(width - 1) * 0.5f * scale.x, -(height - 1) * 0.5f * scale.z));
+        pass->getParameter("u_gridToTexCoord")->setValue(Vector4(1.0f / width, 1.0f / height, skirtScale / width, skirtScale / height));
+    }
+
     // Append texture and blend index constants to preprocessor definition.
     // We need to do this since older versions of GLSL only allow sampler arrays
     // to be indexed using constant expressions (otherwise we could simply pass an
@@ -673,11 +800,6 @@ void TerrainPatch::setMaterialDirty()
     _bits |= TERRAINPATCH_DIRTY_MATERIAL;
 }
 
-float TerrainPatch::computeHeight(float* heights, unsigned int width, unsigned int x, unsigned int z)
-{
-    return heights[z * width + x] * _terrain->_localScale.y;
-}
-
 TerrainPatch::Layer::Layer() :
     index(0), row(-1), column(-1), textureIndex(-1), blendIndex(-1)
 {
@@ -691,6 +813,27 @@ TerrainPatch::Level::Level() : model(NULL)
 {
 }
 
+TerrainPatch::Heights::Heights(const float* data, unsigned int x, unsigned int z, unsigned int stride) :
+    data(data), quantized(NULL), min(0), step(0), x(x), z(z), stride(stride)
+{
+}
+
+TerrainPatch::Heights::Heights(const unsigned short* quantized, unsigned int x, unsigned int z, unsigned int stride, float min, float step) :
+    data(NULL), quantized(quantized), min(min), step(step), x(x), z(z), stride(stride)
+{
+}
+
+float TerrainPatch::Heights::get(unsigned int x, unsigned int z) const
+{
+    unsigned int i = (z - this->z) * stride + (x - this->x);
+    return quantized ? min + quantized[i] * step : data[i];
+}
+
+TerrainPatch::LevelData::LevelData() :
+    vertices(NULL), vertexCount(0), indices(NULL), indexCount(0), gridX(0), gridZ(0), gridWidth(0), gridHeight(0)
+{
+}
+
 bool TerrainPatch::LayerCompare::operator() (const Layer* lhs, const Layer* rhs) const
 {
     return (lhs->index < rhs->index);
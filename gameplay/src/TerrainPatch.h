@@ -4,6 +4,10 @@
 #include "Model.h"
 #include "Camera.h"
 
+// Two values in the range [0, 4095] are packed into each float of compact vertices (as a + b * 4096),
+// which is exactly representable by a 32-bit float. Must match terrain.vert.
+#define TERRAINPATCH_PACK_SIZE 4096
+
 namespace gameplay
 {
 
@@ -17,6 +21,7 @@ class TerrainPatch : public Camera::Listener
 {
     friend class Terrain;
     friend class TerrainAutoBindingResolver;
+    friend class TerrainPager;
 
 public:
 
@@ -40,6 +45,13 @@ public:
      */
     const BoundingBox& getBoundingBox(bool worldSpace) const;
 
+    /**
+     * Gets the number of bytes used by the vertex and index data of this patch, for all levels of detail.
+     *
+     * @return The size of the geometry of this patch, in bytes.
+     */
+    size_t getMemoryUsage() const;
+
     /**
      * @see Camera::Listener
      */
@@ -105,15 +117,83 @@ private:
         bool operator() (const Layer* lhs, const Layer* rhs) const;
     };
 
+    /**
+     * A region of the height array used to build patch geometry.
+     *
+     * Heights are addressed using heightfield coordinates. The region starts at
+     * the sample (x, z) and has stride samples per row. Heights are either stored
+     * as floats, or quantized to 16 bits with a minimum height and height step.
+     */
+    struct Heights
+    {
+        Heights(const float* data, unsigned int x, unsigned int z, unsigned int stride);
+
+        Heights(const unsigned short* quantized, unsigned int x, unsigned int z, unsigned int stride, float min, float step);
+
+        float get(unsigned int x, unsigned int z) const;
+
+        const float* data;
+        const unsigned short* quantized;
+        float min;
+        float step;
+        unsigned int x;
+        unsigned int z;
+        unsigned int stride;
+    };
+
+    /**
+     * Vertex and index data for a single level of detail, built before any graphics
+     * resources are created for it.
+     */
+    struct LevelData
+    {
+        LevelData();
+
+        float* vertices;
+        unsigned int vertexCount;
+        unsigned short* indices;
+        unsigned int indexCount;
+        unsigned int gridX;
+        unsigned int gridZ;
+        unsigned int gridWidth;
+        unsigned int gridHeight;
+        Vector3 min;
+        Vector3 max;
+    };
+
     static TerrainPatch* create(Terrain* terrain, unsigned int index,
                                 unsigned int row, unsigned int column,
-                                float* heights, unsigned int width, unsigned int height,
+                                const Heights& heights, unsigned int width, unsigned int height,
                                 unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
                                 float xOffset, float zOffset, unsigned int maxStep, float verticalSkirtSize);
 
-    void addLOD(float* heights, unsigned int width, unsigned int height,
-                unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
-                float xOffset, float zOffset, unsigned int step, float verticalSkirtSize);
+    static TerrainPatch* create(Terrain* terrain, unsigned int index,
+                                unsigned int row, unsigned int column, std::vector<LevelData>& levels);
+
+    /**
+     * Builds the vertex and index data for all levels of detail of a patch.
+     *
+     * This method does not access any terrain or graphics state, so it may be called
+     * from any thread.
+     *
+     * Compact vertices store a grid coordinate relative to the patch origin (x1, z1) instead
+     * of the x and z position, a packed normal, and no texture coordinates, which are all
+     * derived in the terrain vertex shader. Skirt vertices are stored one step outside of the
+     * patch, so that the shader can apply the same texture coordinate offset to them.
+     */
+    static void buildLODs(const Heights& heights, unsigned int width, unsigned int height,
+                          unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
+                          float xOffset, float zOffset, unsigned int maxStep, float verticalSkirtSize,
+                          const Vector3& scale, bool normals, bool compact, std::vector<LevelData>& levels);
+
+    static bool buildLOD(const Heights& heights, unsigned int width, unsigned int height,
+                         unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
+                         float xOffset, float zOffset, unsigned int step, float verticalSkirtSize,
+                         const Vector3& scale, bool normals, bool compact, LevelData* level);
+
+    static void deleteLODs(std::vector<LevelData>& levels);
+
+    void addLOD(LevelData& data);
 
 
     bool setLayer(int index, const char* texturePath, const Vector2& textureRepeat, const char* blendPath, int blendChannel);
@@ -132,8 +212,6 @@ private:
 
     void setMaterialDirty();
 
-    float computeHeight(float* heights, unsigned int width, unsigned int x, unsigned int z);
-
     void updateNodeBindings();
 
     std::string passCreated(Pass* pass);
@@ -142,6 +220,10 @@ private:
     unsigned int _index;
     unsigned int _row;
     unsigned int _column;
+    unsigned int _gridX;
+    unsigned int _gridZ;
+    unsigned int _gridWidth;
+    unsigned int _gridHeight;
     std::vector<Level*> _levels;
     std::set<Layer*, LayerCompare> _layers;
     std::vector<Texture::Sampler*> _samplers;
@@ -58,6 +58,7 @@ void TextBox::setCaretLocation(unsigned int index)
     _caretLocation = index;
     if (_caretLocation > _text.length())
         _caretLocation = (unsigned int)_text.length();
+    setDirty(DIRTY_STATE);
 }
 
 bool TextBox::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
@@ -287,6 +288,9 @@ bool TextBox::keyEvent(Keyboard::KeyEvent evt, int key)
 
     _lastKeypress = key;
 
+    // The text or caret may have changed.
+    setDirty(DIRTY_STATE);
+
     return Label::keyEvent(evt, key);
 }
 
@@ -362,7 +366,7 @@ unsigned int TextBox::drawText(Form* form, const Rectangle& clip)
 
         SpriteBatch* batch = _font->getSpriteBatch(fontSize);
         startBatch(form, batch);
-        _font->drawText(displayedText.c_str(), _textBounds, _textColor, fontSize, getTextAlignment(state), true, getTextRightToLeft(state), &_viewportClipBounds);
+        drawTextLayout(&_textLayout, displayedText.c_str(), fontSize, getTextAlignment(state), getTextRightToLeft(state));
         finishBatch(form, batch);
 
         return 1;
@@ -427,7 +431,10 @@ void TextBox::setCaretLocation(int x, int y)
     }
 
     if (index != -1)
+    {
         _caretLocation = index;
+        setDirty(DIRTY_STATE);
+    }
 }
 
 void TextBox::getCaretLocation(Vector2* p)
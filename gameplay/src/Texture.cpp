@@ -848,6 +848,20 @@ TextureHandle Texture::getHandle() const
     return _handle;
 }
 
+void Texture::setData(int x, int y, unsigned int width, unsigned int height, const unsigned char* data)
+{
+    GP_ASSERT(data);
+    GP_ASSERT(!_compressed);
+    GP_ASSERT(x >= 0 && y >= 0 && x + width <= _width && y + height <= _height);
+
+    GL_ASSERT( glBindTexture(GL_TEXTURE_2D, _handle) );
+    GL_ASSERT( glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
+    GL_ASSERT( glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, (GLenum)_format, GL_UNSIGNED_BYTE, data) );
+
+    // Restore the texture id
+    GL_ASSERT( glBindTexture(GL_TEXTURE_2D, __currentTextureId) );
+}
+
 void Texture::generateMipmaps()
 {
     if (!_mipmapped)
@@ -227,6 +227,21 @@ public:
      */
     unsigned int getHeight() const;
 
+    /**
+     * Replaces the pixels of a rectangular region of this texture.
+     *
+     * The data must be in the texture's format with tightly packed rows. Only the base
+     * mipmap level is updated. This is not supported for compressed textures.
+     *
+     * @param x The x position of the region.
+     * @param y The y position of the region.
+     * @param width The width of the region.
+     * @param height The height of the region.
+     * @param data The new pixel data for the region.
+     * @script{ignore}
+     */
+    void setData(int x, int y, unsigned int width, unsigned int height, const unsigned char* data);
+
     /**
      * Generates a full mipmap chain for this texture if it isn't already mipmapped.
      */
@@ -0,0 +1,180 @@
+#include "Base.h"
+#include "TextureAtlas.h"
+
+namespace gameplay
+{
+
+TextureAtlas::TextureAtlas(unsigned int pageWidth, unsigned int pageHeight, unsigned int padding) :
+    _pageWidth(pageWidth), _pageHeight(pageHeight), _padding(padding)
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    for (size_t i = 0, count = _uploads.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_uploads[i].image);
+    }
+    for (size_t i = 0, count = _pages.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_pages[i].texture);
+    }
+}
+
+TextureAtlas* TextureAtlas::create(unsigned int pageWidth, unsigned int pageHeight, unsigned int padding)
+{
+    GP_ASSERT(pageWidth > 0 && pageHeight > 0);
+
+    return new TextureAtlas(pageWidth, pageHeight, padding);
+}
+
+unsigned int TextureAtlas::getPageWidth() const
+{
+    return _pageWidth;
+}
+
+unsigned int TextureAtlas::getPageHeight() const
+{
+    return _pageHeight;
+}
+
+unsigned int TextureAtlas::getPageCount() const
+{
+    return (unsigned int)_pages.size();
+}
+
+const TextureAtlas::Region* TextureAtlas::add(const char* id, Image* image)
+{
+    GP_ASSERT(id);
+    GP_ASSERT(image);
+
+    std::map<std::string, Region>::iterator itr = _regions.find(id);
+    if (itr != _regions.end())
+        return &itr->second;
+
+    const unsigned int width = image->getWidth();
+    const unsigned int height = image->getHeight();
+    const unsigned int paddedWidth = width + _padding;
+    const unsigned int paddedHeight = height + _padding;
+    if (paddedWidth > _pageWidth || paddedHeight > _pageHeight)
+        return NULL;
+
+    Region region;
+    region.width = width;
+    region.height = height;
+
+    // Use the first page with room for the image, or start a new one.
+    unsigned int page = 0;
+    for (unsigned int count = (unsigned int)_pages.size(); page < count; ++page)
+    {
+        if (allocate(_pages[page], paddedWidth, paddedHeight, &region.x, &region.y))
+            break;
+    }
+    if (page == _pages.size())
+    {
+        Page newPage;
+        newPage.shelfEnd = 0;
+        newPage.texture = NULL;
+        _pages.push_back(newPage);
+        allocate(_pages.back(), paddedWidth, paddedHeight, &region.x, &region.y);
+    }
+    region.page = page;
+
+    Upload upload;
+    upload.region = region;
+    upload.image = image;
+    image->addRef();
+    _uploads.push_back(upload);
+
+    return &(_regions[id] = region);
+}
+
+const TextureAtlas::Region* TextureAtlas::find(const char* id) const
+{
+    GP_ASSERT(id);
+
+    std::map<std::string, Region>::const_iterator itr = _regions.find(id);
+    return itr != _regions.end() ? &itr->second : NULL;
+}
+
+Texture* TextureAtlas::getTexture(unsigned int page)
+{
+    GP_ASSERT(page < _pages.size());
+
+    Page& p = _pages[page];
+    if (p.texture == NULL)
+    {
+        // Start from a cleared page so the padding around images is transparent.
+        std::vector<unsigned char> data(_pageWidth * _pageHeight * 4, 0);
+        p.texture = Texture::create(Texture::RGBA, _pageWidth, _pageHeight, &data[0]);
+    }
+
+    // Copy the pending images of this page into its texture.
+    std::vector<unsigned char> pixels;
+    for (size_t i = 0; i < _uploads.size(); )
+    {
+        Upload& upload = _uploads[i];
+        if (upload.region.page != page)
+        {
+            ++i;
+            continue;
+        }
+
+        const Region& region = upload.region;
+        const unsigned char* data = upload.image->getData();
+        if (upload.image->getFormat() == Image::RGB)
+        {
+            // Page textures are RGBA, so give RGB images an opaque alpha channel.
+            const unsigned int pixelCount = region.width * region.height;
+            pixels.resize(pixelCount * 4);
+            for (unsigned int j = 0; j < pixelCount; ++j)
+            {
+                pixels[j * 4] = data[j * 3];
+                pixels[j * 4 + 1] = data[j * 3 + 1];
+                pixels[j * 4 + 2] = data[j * 3 + 2];
+                pixels[j * 4 + 3] = 255;
+            }
+            data = &pixels[0];
+        }
+        p.texture->setData(region.x, region.y, region.width, region.height, data);
+
+        SAFE_RELEASE(upload.image);
+        _uploads.erase(_uploads.begin() + i);
+    }
+
+    return p.texture;
+}
+
+bool TextureAtlas::allocate(Page& page, unsigned int width, unsigned int height, unsigned int* x, unsigned int* y)
+{
+    // Use the shortest shelf that is tall enough and has room left.
+    Shelf* best = NULL;
+    for (size_t i = 0, count = page.shelves.size(); i < count; ++i)
+    {
+        Shelf& shelf = page.shelves[i];
+        if (shelf.height >= height && shelf.x + width <= _pageWidth && (best == NULL || shelf.height < best->height))
+            best = &shelf;
+    }
+
+    if (best == NULL)
+    {
+        // Start a new shelf below the existing ones.
+        if (page.shelfEnd + height > _pageHeight)
+            return false;
+
+        Shelf shelf;
+        shelf.y = page.shelfEnd;
+        shelf.height = height;
+        shelf.x = 0;
+        page.shelves.push_back(shelf);
+        page.shelfEnd += height;
+        best = &page.shelves.back();
+    }
+
+    *x = best->x;
+    *y = best->y;
+    best->x += width;
+    return true;
+}
+
+}
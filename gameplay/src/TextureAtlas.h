@@ -0,0 +1,176 @@
+#ifndef TEXTUREATLAS_H_
+#define TEXTUREATLAS_H_
+
+#include "Ref.h"
+#include "Image.h"
+#include "Texture.h"
+
+namespace gameplay
+{
+
+/**
+ * Packs images into shared texture pages at runtime.
+ *
+ * Images are placed on horizontal shelves within fixed size pages, and a new page is
+ * started when an image does not fit on any of the existing ones. Drawing images from
+ * a few shared pages rather than from a texture each allows them to be batched together.
+ *
+ * Adding an image only decides where it is placed. Its pixels are copied into the page
+ * texture when the texture is next requested, so images can be packed without a
+ * graphics context. The space of an image is only released when the atlas is destroyed.
+ *
+ * @script{ignore}
+ */
+class TextureAtlas : public Ref
+{
+public:
+
+    /**
+     * Defines the region of a page occupied by an image, in pixels.
+     */
+    struct Region
+    {
+        /**
+         * The index of the page containing the image.
+         */
+        unsigned int page;
+
+        /**
+         * The x position of the image within the page.
+         */
+        unsigned int x;
+
+        /**
+         * The y position of the image within the page, in texture rows.
+         */
+        unsigned int y;
+
+        /**
+         * The width of the image.
+         */
+        unsigned int width;
+
+        /**
+         * The height of the image.
+         */
+        unsigned int height;
+    };
+
+    /**
+     * Creates a new texture atlas.
+     *
+     * @param pageWidth The width of each page, in pixels.
+     * @param pageHeight The height of each page, in pixels.
+     * @param padding The number of empty pixels to keep to the right of and below each image.
+     *
+     * @return The new texture atlas.
+     */
+    static TextureAtlas* create(unsigned int pageWidth, unsigned int pageHeight, unsigned int padding = 1);
+
+    /**
+     * Gets the width of each page.
+     *
+     * @return The page width, in pixels.
+     */
+    unsigned int getPageWidth() const;
+
+    /**
+     * Gets the height of each page.
+     *
+     * @return The page height, in pixels.
+     */
+    unsigned int getPageHeight() const;
+
+    /**
+     * Gets the number of pages in the atlas.
+     *
+     * @return The number of pages.
+     */
+    unsigned int getPageCount() const;
+
+    /**
+     * Adds an image to the atlas.
+     *
+     * If an image was already added with the same ID, its region is returned and the
+     * new image is ignored.
+     *
+     * @param id The ID of the image, such as the path it was loaded from.
+     * @param image The image to add.
+     *
+     * @return The region of the image, or NULL if the image is larger than a page.
+     */
+    const Region* add(const char* id, Image* image);
+
+    /**
+     * Finds an image that was added to the atlas.
+     *
+     * @param id The ID of the image.
+     *
+     * @return The region of the image, or NULL if no image was added with the ID.
+     */
+    const Region* find(const char* id) const;
+
+    /**
+     * Gets the texture of a page, copying any images added since the last call into it.
+     *
+     * @param page The index of the page.
+     *
+     * @return The page texture.
+     */
+    Texture* getTexture(unsigned int page);
+
+private:
+
+    struct Shelf
+    {
+        unsigned int y;
+        unsigned int height;
+        unsigned int x;
+    };
+
+    struct Page
+    {
+        std::vector<Shelf> shelves;
+        unsigned int shelfEnd;
+        Texture* texture;
+    };
+
+    struct Upload
+    {
+        Region region;
+        Image* image;
+    };
+
+    /**
+     * Constructor.
+     */
+    TextureAtlas(unsigned int pageWidth, unsigned int pageHeight, unsigned int padding);
+
+    /**
+     * Destructor.
+     */
+    ~TextureAtlas();
+
+    /**
+     * Hidden copy constructor.
+     */
+    TextureAtlas(const TextureAtlas&);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    TextureAtlas& operator=(const TextureAtlas&);
+
+    bool allocate(Page& page, unsigned int width, unsigned int height, unsigned int* x, unsigned int* y);
+
+    unsigned int _pageWidth;
+    unsigned int _pageHeight;
+    unsigned int _padding;
+    std::vector<Page> _pages;
+    std::map<std::string, Region> _regions;
+    std::vector<Upload> _uploads;
+};
+
+}
+
+#endif
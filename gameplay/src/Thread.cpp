@@ -0,0 +1,248 @@
+#include "Base.h"
+#include "Thread.h"
+
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+namespace gameplay
+{
+
+/**
+ * Entry point data passed to the platform thread function.
+ * @script{ignore}
+ */
+struct ThreadStart
+{
+    Thread::Function function;
+    void* arg;
+};
+
+#ifdef WIN32
+
+static DWORD WINAPI threadProc(LPVOID param)
+{
+    ThreadStart* start = (ThreadStart*)param;
+    start->function(start->arg);
+    SAFE_DELETE(start);
+    return 0;
+}
+
+Thread::Thread() : _handle(NULL), _joined(false)
+{
+}
+
+Thread::~Thread()
+{
+    join();
+}
+
+Thread* Thread::create(Function function, void* arg)
+{
+    GP_ASSERT(function);
+
+    ThreadStart* start = new ThreadStart();
+    start->function = function;
+    start->arg = arg;
+
+    HANDLE handle = CreateThread(NULL, 0, threadProc, start, 0, NULL);
+    if (handle == NULL)
+    {
+        GP_WARN("Failed to create thread (error: %d).", GetLastError());
+        SAFE_DELETE(start);
+        return NULL;
+    }
+
+    Thread* thread = new Thread();
+    thread->_handle = handle;
+    return thread;
+}
+
+void Thread::join()
+{
+    if (_joined || !_handle)
+        return;
+
+    WaitForSingleObject((HANDLE)_handle, INFINITE);
+    CloseHandle((HANDLE)_handle);
+    _handle = NULL;
+    _joined = true;
+}
+
+unsigned int Thread::getHardwareConcurrency()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (unsigned int)info.dwNumberOfProcessors : 1;
+}
+
+Mutex::Mutex() : _handle(NULL)
+{
+    CRITICAL_SECTION* cs = new CRITICAL_SECTION();
+    InitializeCriticalSection(cs);
+    _handle = cs;
+}
+
+Mutex::~Mutex()
+{
+    CRITICAL_SECTION* cs = (CRITICAL_SECTION*)_handle;
+    DeleteCriticalSection(cs);
+    SAFE_DELETE(cs);
+}
+
+void Mutex::lock()
+{
+    EnterCriticalSection((CRITICAL_SECTION*)_handle);
+}
+
+void Mutex::unlock()
+{
+    LeaveCriticalSection((CRITICAL_SECTION*)_handle);
+}
+
+Condition::Condition() : _handle(NULL)
+{
+    CONDITION_VARIABLE* cv = new CONDITION_VARIABLE();
+    InitializeConditionVariable(cv);
+    _handle = cv;
+}
+
+Condition::~Condition()
+{
+    CONDITION_VARIABLE* cv = (CONDITION_VARIABLE*)_handle;
+    SAFE_DELETE(cv);
+}
+
+void Condition::wait(Mutex& mutex)
+{
+    SleepConditionVariableCS((CONDITION_VARIABLE*)_handle, (CRITICAL_SECTION*)mutex._handle, INFINITE);
+}
+
+void Condition::signal()
+{
+    WakeConditionVariable((CONDITION_VARIABLE*)_handle);
+}
+
+void Condition::broadcast()
+{
+    WakeAllConditionVariable((CONDITION_VARIABLE*)_handle);
+}
+
+#else
+
+static void* threadProc(void* param)
+{
+    ThreadStart* start = (ThreadStart*)param;
+    start->function(start->arg);
+    SAFE_DELETE(start);
+    return NULL;
+}
+
+Thread::Thread() : _handle(NULL), _joined(false)
+{
+}
+
+Thread::~Thread()
+{
+    join();
+    pthread_t* handle = (pthread_t*)_handle;
+    SAFE_DELETE(handle);
+}
+
+Thread* Thread::create(Function function, void* arg)
+{
+    GP_ASSERT(function);
+
+    ThreadStart* start = new ThreadStart();
+    start->function = function;
+    start->arg = arg;
+
+    pthread_t* handle = new pthread_t();
+    int result = pthread_create(handle, NULL, threadProc, start);
+    if (result != 0)
+    {
+        GP_WARN("Failed to create thread (error: %d).", result);
+        SAFE_DELETE(start);
+        SAFE_DELETE(handle);
+        return NULL;
+    }
+
+    Thread* thread = new Thread();
+    thread->_handle = handle;
+    return thread;
+}
+
+void Thread::join()
+{
+    if (_joined || !_handle)
+        return;
+
+    pthread_join(*(pthread_t*)_handle, NULL);
+    _joined = true;
+}
+
+unsigned int Thread::getHardwareConcurrency()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned int)count : 1;
+}
+
+Mutex::Mutex() : _handle(NULL)
+{
+    pthread_mutex_t* mutex = new pthread_mutex_t();
+    pthread_mutex_init(mutex, NULL);
+    _handle = mutex;
+}
+
+Mutex::~Mutex()
+{
+    pthread_mutex_t* mutex = (pthread_mutex_t*)_handle;
+    pthread_mutex_destroy(mutex);
+    SAFE_DELETE(mutex);
+}
+
+void Mutex::lock()
+{
+    pthread_mutex_lock((pthread_mutex_t*)_handle);
+}
+
+void Mutex::unlock()
+{
+    pthread_mutex_unlock((pthread_mutex_t*)_handle);
+}
+
+Condition::Condition() : _handle(NULL)
+{
+    pthread_cond_t* cond = new pthread_cond_t();
+    pthread_cond_init(cond, NULL);
+    _handle = cond;
+}
+
+Condition::~Condition()
+{
+    pthread_cond_t* cond = (pthread_cond_t*)_handle;
+    pthread_cond_destroy(cond);
+    SAFE_DELETE(cond);
+}
+
+void Condition::wait(Mutex& mutex)
+{
+    pthread_cond_wait((pthread_cond_t*)_handle, (pthread_mutex_t*)mutex._handle);
+}
+
+void Condition::signal()
+{
+    pthread_cond_signal((pthread_cond_t*)_handle);
+}
+
+void Condition::broadcast()
+{
+    pthread_cond_broadcast((pthread_cond_t*)_handle);
+}
+
+#endif
+
+}
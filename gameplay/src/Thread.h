@@ -0,0 +1,163 @@
+#ifndef THREAD_H_
+#define THREAD_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a minimal, platform-independent thread of execution.
+ *
+ * This class is used internally by systems that perform work off of the main
+ * game thread (such as terrain paging). It is intentionally small and only
+ * exposes what those systems require. No graphics or scripting calls may be made
+ * from a thread other than the main game thread.
+ *
+ * @script{ignore}
+ */
+class Thread
+{
+public:
+
+    /**
+     * Defines the entry point function type for threads.
+     */
+    typedef void (*Function)(void* arg);
+
+    /**
+     * Creates and starts a new thread that will execute the specified function.
+     *
+     * @param function The entry point function for the thread.
+     * @param arg The argument to pass to the entry point function.
+     *
+     * @return The new thread, or NULL if the thread could not be created.
+     */
+    static Thread* create(Function function, void* arg);
+
+    /**
+     * Destructor.
+     *
+     * Waits for the thread to complete if it has not already been joined.
+     */
+    ~Thread();
+
+    /**
+     * Blocks the calling thread until this thread has completed.
+     */
+    void join();
+
+    /**
+     * Returns the number of hardware threads available on this device.
+     *
+     * @return The number of hardware threads (always at least one).
+     */
+    static unsigned int getHardwareConcurrency();
+
+private:
+
+    /**
+     * Constructor.
+     */
+    Thread();
+
+    /**
+     * Hidden copy constructor.
+     */
+    Thread(const Thread&);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Thread& operator=(const Thread&);
+
+    void* _handle;
+    bool _joined;
+};
+
+/**
+ * Defines a mutual exclusion lock.
+ *
+ * @script{ignore}
+ */
+class Mutex
+{
+    friend class Condition;
+
+public:
+
+    /**
+     * Constructor.
+     */
+    Mutex();
+
+    /**
+     * Destructor.
+     */
+    ~Mutex();
+
+    /**
+     * Acquires the lock, blocking until it becomes available.
+     */
+    void lock();
+
+    /**
+     * Releases the lock.
+     */
+    void unlock();
+
+private:
+
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+
+    void* _handle;
+};
+
+/**
+ * Defines a condition variable, used together with a Mutex to wait for a
+ * condition to be signaled from another thread.
+ *
+ * @script{ignore}
+ */
+class Condition
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    Condition();
+
+    /**
+     * Destructor.
+     */
+    ~Condition();
+
+    /**
+     * Atomically releases the specified (locked) mutex and waits for this
+     * condition to be signaled. The mutex is locked again before returning.
+     *
+     * @param mutex The mutex protecting the condition, which must be locked by the caller.
+     */
+    void wait(Mutex& mutex);
+
+    /**
+     * Wakes up one thread waiting on this condition.
+     */
+    void signal();
+
+    /**
+     * Wakes up all threads waiting on this condition.
+     */
+    void broadcast();
+
+private:
+
+    Condition(const Condition&);
+    Condition& operator=(const Condition&);
+
+    void* _handle;
+};
+
+}
+
+#endif
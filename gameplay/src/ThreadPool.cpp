@@ -0,0 +1,126 @@
+#include "Base.h"
+#include "ThreadPool.h"
+
+namespace gameplay
+{
+
+ThreadPool::ThreadPool() :
+    _function(NULL), _arg(NULL), _count(0), _grainSize(1), _next(0), _done(0), _generation(0), _quit(false)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    _mutex.lock();
+    _quit = true;
+    _started.broadcast();
+    _mutex.unlock();
+
+    for (size_t i = 0, count = _threads.size(); i < count; ++i)
+    {
+        SAFE_DELETE(_threads[i]);
+    }
+}
+
+ThreadPool* ThreadPool::create(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = Thread::getHardwareConcurrency();
+
+    ThreadPool* pool = new ThreadPool();
+
+    // The thread calling execute is the first thread of the pool.
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        Thread* thread = Thread::create(&threadFunc, pool);
+        if (!thread)
+            break;
+        pool->_threads.push_back(thread);
+    }
+
+    return pool;
+}
+
+unsigned int ThreadPool::getThreadCount() const
+{
+    return (unsigned int)_threads.size() + 1;
+}
+
+void ThreadPool::execute(Function function, void* arg, unsigned int count, unsigned int grainSize)
+{
+    GP_ASSERT(function);
+
+    if (count == 0)
+        return;
+
+    grainSize = std::max(grainSize, 1u);
+    if (_threads.empty() || count <= grainSize)
+    {
+        function(arg, 0, count);
+        return;
+    }
+
+    _mutex.lock();
+    GP_ASSERT(_done == _count);
+    _function = function;
+    _arg = arg;
+    _count = count;
+    _grainSize = grainSize;
+    _next = 0;
+    _done = 0;
+    ++_generation;
+    _started.broadcast();
+
+    process();
+
+    while (_done < _count)
+        _finished.wait(_mutex);
+    _mutex.unlock();
+}
+
+void ThreadPool::threadFunc(void* arg)
+{
+    static_cast<ThreadPool*>(arg)->run();
+}
+
+void ThreadPool::run()
+{
+    _mutex.lock();
+    unsigned int generation = _generation;
+    while (true)
+    {
+        while (!_quit && _generation == generation)
+            _started.wait(_mutex);
+
+        if (_quit)
+            break;
+
+        generation = _generation;
+        process();
+    }
+    _mutex.unlock();
+}
+
+void ThreadPool::process()
+{
+    // Called with the mutex locked.
+    while (_next < _count)
+    {
+        unsigned int begin = _next;
+        unsigned int end = std::min(begin + _grainSize, _count);
+        _next = end;
+
+        Function function = _function;
+        void* arg = _arg;
+
+        _mutex.unlock();
+        function(arg, begin, end);
+        _mutex.lock();
+
+        _done += end - begin;
+        if (_done == _count)
+            _finished.broadcast();
+    }
+}
+
+}
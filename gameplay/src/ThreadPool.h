@@ -0,0 +1,108 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include "Thread.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a pool of worker threads used to process a range of independent work items in parallel.
+ *
+ * The thread calling execute also processes work items, and execute does not return
+ * until all of the work items have been processed. The work function must not call
+ * back into the same thread pool, and execute must only be called from one thread
+ * at a time.
+ *
+ * @script{ignore}
+ */
+class ThreadPool
+{
+public:
+
+    /**
+     * Defines the function type used to process a range of work items.
+     *
+     * @param arg The argument passed to execute.
+     * @param begin The index of the first work item to process.
+     * @param end One past the index of the last work item to process.
+     */
+    typedef void (*Function)(void* arg, unsigned int begin, unsigned int end);
+
+    /**
+     * Creates a new thread pool.
+     *
+     * @param threadCount The total number of threads that process work items, including
+     *      the thread calling execute, or zero to use the number of hardware threads.
+     *
+     * @return The new thread pool.
+     */
+    static ThreadPool* create(unsigned int threadCount = 0);
+
+    /**
+     * Destructor.
+     *
+     * Waits for all worker threads to exit.
+     */
+    ~ThreadPool();
+
+    /**
+     * Gets the total number of threads that process work items, including the thread calling execute.
+     *
+     * @return The number of threads.
+     */
+    unsigned int getThreadCount() const;
+
+    /**
+     * Processes the specified number of work items, blocking until they are all complete.
+     *
+     * Work items are handed out in ranges of up to grainSize items. When the work fits in a
+     * single range, it is processed directly on the calling thread.
+     *
+     * @param function The function that processes a range of work items.
+     * @param arg The argument to pass to the function.
+     * @param count The number of work items.
+     * @param grainSize The maximum number of work items passed to a single function call.
+     */
+    void execute(Function function, void* arg, unsigned int count, unsigned int grainSize = 1);
+
+private:
+
+    /**
+     * Constructor.
+     */
+    ThreadPool();
+
+    /**
+     * Hidden copy constructor.
+     */
+    ThreadPool(const ThreadPool&);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    ThreadPool& operator=(const ThreadPool&);
+
+    static void threadFunc(void* arg);
+
+    void run();
+
+    void process();
+
+    std::vector<Thread*> _threads;
+    Mutex _mutex;
+    Condition _started;
+    Condition _finished;
+    Function _function;
+    void* _arg;
+    unsigned int _count;
+    unsigned int _grainSize;
+    unsigned int _next;
+    unsigned int _done;
+    unsigned int _generation;
+    bool _quit;
+};
+
+}
+
+#endif
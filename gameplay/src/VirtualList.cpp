@@ -0,0 +1,234 @@
+#include "Base.h"
+#include "VirtualList.h"
+
+namespace gameplay
+{
+
+VirtualList::VirtualList()
+    : _dataSource(NULL), _rowHeight(40.0f), _overscan(2), _rowCount(0), _reload(false)
+{
+}
+
+VirtualList::~VirtualList()
+{
+}
+
+VirtualList* VirtualList::create(const char* id, Theme::Style* style)
+{
+    VirtualList* list = new VirtualList();
+    list->_id = id ? id : "";
+    list->_layout = createLayout(Layout::LAYOUT_ABSOLUTE);
+    list->initialize("Container", style, NULL);
+    return list;
+}
+
+Control* VirtualList::create(Theme::Style* style, Properties* properties)
+{
+    VirtualList* list = new VirtualList();
+    list->initialize("Container", style, properties);
+    return list;
+}
+
+void VirtualList::initialize(const char* typeName, Theme::Style* style, Properties* properties)
+{
+    Container::initialize(typeName, style, properties);
+
+    // Rows are positioned explicitly, so only an absolute layout makes sense.
+    if (_layout->getType() != Layout::LAYOUT_ABSOLUTE)
+    {
+        GP_WARN("VirtualList: Only absolute layouts are supported; ignoring the layout of list '%s'.", _id.c_str());
+        setLayout(Layout::LAYOUT_ABSOLUTE);
+    }
+    setScroll(SCROLL_VERTICAL);
+
+    if (properties)
+    {
+        if (properties->exists("rowHeight"))
+            setRowHeight(properties->getFloat("rowHeight"));
+        if (properties->exists("overscan"))
+            setOverscan((unsigned int)properties->getInt("overscan"));
+    }
+}
+
+const char* VirtualList::getType() const
+{
+    return "virtualList";
+}
+
+void VirtualList::setDataSource(DataSource* dataSource)
+{
+    _dataSource = dataSource;
+    reloadData();
+}
+
+VirtualList::DataSource* VirtualList::getDataSource() const
+{
+    return _dataSource;
+}
+
+void VirtualList::setRowHeight(float height)
+{
+    if (height != _rowHeight)
+    {
+        _rowHeight = height;
+        reloadData();
+    }
+}
+
+float VirtualList::getRowHeight() const
+{
+    return _rowHeight;
+}
+
+void VirtualList::setOverscan(unsigned int rows)
+{
+    _overscan = rows;
+}
+
+unsigned int VirtualList::getOverscan() const
+{
+    return _overscan;
+}
+
+unsigned int VirtualList::getRowCount() const
+{
+    return _rowCount;
+}
+
+void VirtualList::reloadData()
+{
+    _reload = true;
+}
+
+Control* VirtualList::getRowControl(unsigned int row) const
+{
+    for (size_t i = 0, count = _rows.size(); i < count; ++i)
+    {
+        if (_rows[i].index == (int)row)
+            return _rows[i].control;
+    }
+    return NULL;
+}
+
+int VirtualList::getRowIndex(Control* control) const
+{
+    for (size_t i = 0, count = _rows.size(); i < count; ++i)
+    {
+        if (_rows[i].control == control)
+            return _rows[i].index;
+    }
+    return -1;
+}
+
+void VirtualList::scrollToRow(unsigned int row)
+{
+    setScrollPosition(Vector2(_scrollPosition.x, -(row * _rowHeight)));
+    setDirty(DIRTY_BOUNDS);
+}
+
+void VirtualList::update(float elapsedTime)
+{
+    // Realize the rows that are in view before the children are updated.
+    updateRows();
+
+    Container::update(elapsedTime);
+}
+
+void VirtualList::updateTotalSize()
+{
+    Container::updateTotalSize();
+
+    // The height covers every row, not just the realized ones.
+    _totalHeight = _rowCount * _rowHeight;
+}
+
+void VirtualList::updateRows()
+{
+    if (_reload)
+    {
+        unsigned int rowCount = _dataSource ? _dataSource->getRowCount(this) : 0;
+        if (rowCount != _rowCount)
+        {
+            _rowCount = rowCount;
+            setDirty(DIRTY_BOUNDS);
+        }
+    }
+
+    // Find the range of rows in view, extended by the overscan on either side.
+    int first = 0;
+    int last = 0;
+    if (_dataSource && _rowHeight > 0.0f)
+    {
+        const float top = -_scrollPosition.y;
+        first = std::max((int)floorf(top / _rowHeight) - (int)_overscan, 0);
+        last = std::min((int)ceilf((top + _viewportBounds.height) / _rowHeight) + (int)_overscan, (int)_rowCount);
+    }
+
+    // Sort the row controls into those still in range and those free for reuse.
+    _visibleRows.assign(std::max(last - first, 0), -1);
+    _freeRows.clear();
+    for (size_t i = 0, count = _rows.size(); i < count; ++i)
+    {
+        const int index = _rows[i].index;
+        if (index >= first && index < last)
+            _visibleRows[index - first] = (int)i;
+        else
+            _freeRows.push_back(i);
+    }
+
+    for (int index = first; index < last; ++index)
+    {
+        int slot = _visibleRows[index - first];
+        if (slot >= 0)
+        {
+            if (_reload)
+                bindRow(_rows[slot], index);
+            continue;
+        }
+
+        if (!_freeRows.empty())
+        {
+            slot = (int)_freeRows.back();
+            _freeRows.pop_back();
+        }
+        else
+        {
+            Control* control = _dataSource->createRowControl(this);
+            if (!control)
+            {
+                GP_WARN("VirtualList: Failed to create a row control for list '%s'.", _id.c_str());
+                break;
+            }
+            addControl(control);
+            control->release();
+
+            Row row = { control, -1 };
+            _rows.push_back(row);
+            slot = (int)_rows.size() - 1;
+        }
+        bindRow(_rows[slot], index);
+    }
+
+    // Hide the row controls that were not reused.
+    for (size_t i = 0, count = _freeRows.size(); i < count; ++i)
+    {
+        Row& row = _rows[_freeRows[i]];
+        row.index = -1;
+        row.control->setVisible(false);
+    }
+
+    _reload = false;
+}
+
+void VirtualList::bindRow(Row& row, int index)
+{
+    Control* control = row.control;
+    row.index = index;
+    control->setY(index * _rowHeight);
+    control->setWidth(1.0f, true);
+    control->setHeight(_rowHeight);
+    control->setVisible(true);
+    _dataSource->bindRowControl(this, control, (unsigned int)index);
+}
+
+}
@@ -0,0 +1,253 @@
+#ifndef VIRTUALLIST_H_
+#define VIRTUALLIST_H_
+
+#include "Container.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a vertically scrolling list for a very large number of rows.
+ *
+ * The rows of the list are provided by a data source. Rather than holding a control for
+ * every row, the list only creates controls for the rows that are currently visible, plus
+ * a few rows above and below them. As the list scrolls, the controls of rows that move out
+ * of this range are reused for the rows that move into it. The number of controls, and the
+ * time spent updating and drawing them, therefore depends on the height of the list rather
+ * than on the number of rows.
+ *
+ * All rows of the list have the same height. The list always uses an absolute layout and
+ * scrolls vertically. It is styled with the "Container" style of its theme by default.
+ *
+ * Since the rows are provided by a C++ data source, the list is not available to scripts.
+ *
+ * @script{ignore}
+ */
+class VirtualList : public Container
+{
+    friend class ControlFactory;
+
+public:
+
+    /**
+     * Provides the rows displayed by a VirtualList.
+     *
+     * @script{ignore}
+     */
+    class DataSource
+    {
+    public:
+
+        /**
+         * Destructor.
+         */
+        virtual ~DataSource() { }
+
+        /**
+         * Gets the number of rows in the list.
+         *
+         * @param list The list requesting the row count.
+         *
+         * @return The number of rows.
+         */
+        virtual unsigned int getRowCount(VirtualList* list) = 0;
+
+        /**
+         * Creates a control to display rows with.
+         *
+         * This is only called when the list has no unused row control left. The list
+         * adds the control to itself and takes ownership of the returned reference.
+         *
+         * @param list The list requesting the control.
+         *
+         * @return A new control, or NULL if no control could be created.
+         */
+        virtual Control* createRowControl(VirtualList* list) = 0;
+
+        /**
+         * Updates a row control to display the specified row.
+         *
+         * The control may previously have displayed any other row.
+         *
+         * @param list The list the control belongs to.
+         * @param control The row control, as returned by createRowControl.
+         * @param row The index of the row to display.
+         */
+        virtual void bindRowControl(VirtualList* list, Control* control, unsigned int row) = 0;
+    };
+
+    /**
+     * Creates a new virtual list.
+     *
+     * @param id The list ID.
+     * @param style The list style (optional).
+     *
+     * @return The new virtual list.
+     */
+    static VirtualList* create(const char* id, Theme::Style* style = NULL);
+
+    /**
+     * @see Control::getType
+     */
+    const char* getType() const;
+
+    /**
+     * Sets the data source that provides the rows of this list.
+     *
+     * The list does not take ownership of the data source.
+     *
+     * @param dataSource The data source, or NULL to display no rows.
+     * @script{ignore}
+     */
+    void setDataSource(DataSource* dataSource);
+
+    /**
+     * Gets the data source that provides the rows of this list.
+     *
+     * @return The data source.
+     * @script{ignore}
+     */
+    DataSource* getDataSource() const;
+
+    /**
+     * Sets the height of every row in this list.
+     *
+     * @param height The row height.
+     */
+    void setRowHeight(float height);
+
+    /**
+     * Gets the height of every row in this list.
+     *
+     * @return The row height.
+     */
+    float getRowHeight() const;
+
+    /**
+     * Sets the number of rows that are kept realized above and below the visible rows.
+     *
+     * Realizing a few extra rows avoids empty gaps at the edges of the list while it scrolls.
+     *
+     * @param rows The number of extra rows on each side.
+     */
+    void setOverscan(unsigned int rows);
+
+    /**
+     * Gets the number of rows that are kept realized above and below the visible rows.
+     *
+     * @return The number of extra rows on each side.
+     */
+    unsigned int getOverscan() const;
+
+    /**
+     * Gets the number of rows in this list, as last reported by the data source.
+     *
+     * @return The number of rows.
+     */
+    unsigned int getRowCount() const;
+
+    /**
+     * Requests the row count and the contents of all realized rows again from the data source.
+     *
+     * This must be called whenever the data displayed by the list changes.
+     */
+    void reloadData();
+
+    /**
+     * Gets the control currently displaying the specified row.
+     *
+     * @param row The index of the row.
+     *
+     * @return The row control, or NULL if the row is not realized.
+     */
+    Control* getRowControl(unsigned int row) const;
+
+    /**
+     * Gets the index of the row displayed by the specified control.
+     *
+     * @param control A row control of this list.
+     *
+     * @return The index of the row, or -1 if the control is not displaying a row.
+     */
+    int getRowIndex(Control* control) const;
+
+    /**
+     * Scrolls the list so that the specified row is at the top of the list.
+     *
+     * @param row The index of the row.
+     */
+    void scrollToRow(unsigned int row);
+
+protected:
+
+    /**
+     * Constructor.
+     */
+    VirtualList();
+
+    /**
+     * Destructor.
+     */
+    ~VirtualList();
+
+    /**
+     * Create a virtual list with a given style and properties.
+     *
+     * @param style The style to apply to this list.
+     * @param properties A properties object containing a definition of the list (optional).
+     *
+     * @return The new virtual list.
+     */
+    static Control* create(Theme::Style* style, Properties* properties = NULL);
+
+    /**
+     * @see Control::initialize
+     */
+    void initialize(const char* typeName, Theme::Style* style, Properties* properties);
+
+    /**
+     * @see Control::update
+     */
+    void update(float elapsedTime);
+
+    /**
+     * @see Container::updateTotalSize
+     */
+    void updateTotalSize();
+
+private:
+
+    struct Row
+    {
+        Control* control;
+        int index;
+    };
+
+    /**
+     * Hidden copy constructor.
+     */
+    VirtualList(const VirtualList& copy);
+
+    /**
+     * Realizes the rows within the visible range and releases the others.
+     */
+    void updateRows();
+
+    /**
+     * Binds a row control to a row and positions it.
+     */
+    void bindRow(Row& row, int index);
+
+    DataSource* _dataSource;
+    float _rowHeight;
+    unsigned int _overscan;
+    unsigned int _rowCount;
+    bool _reload;
+    std::vector<Row> _rows;
+    std::vector<int> _visibleRows;
+    std::vector<size_t> _freeRows;
+};
+
+}
+
+#endif
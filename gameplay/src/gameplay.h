@@ -29,6 +29,7 @@
 
 // Graphics
 #include "Texture.h"
+#include "TextureAtlas.h"
 #include "Image.h"
 #include "Mesh.h"
 #include "MeshPart.h"
@@ -104,6 +105,7 @@
 #include "Slider.h"
 #include "ImageControl.h"
 #include "JoystickControl.h"
+#include "VirtualList.h"
 #include "Layout.h"
 #include "AbsoluteLayout.h"
 #include "VerticalLayout.h"
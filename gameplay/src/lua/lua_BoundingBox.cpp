@@ -89,19 +89,8 @@ int lua_BoundingBox__init(lua_State* state)
     {
         case 0:
         {
-            void* returnPtr = (void*)new BoundingBox();
-            if (returnPtr)
-            {
-                gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                object->instance = returnPtr;
-                object->owns = true;
-                luaL_getmetatable(state, "BoundingBox");
-                lua_setmetatable(state, -2);
-            }
-            else
-            {
-                lua_pushnil(state);
-            }
+            BoundingBox result = BoundingBox();
+            gameplay::ScriptUtil::pushValue(state, result, "BoundingBox");
 
             return 1;
             break;
@@ -118,19 +107,8 @@ int lua_BoundingBox__init(lua_State* state)
                     if (!param1Valid)
                         break;
 
-                    void* returnPtr = (void*)new BoundingBox(*param1);
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "BoundingBox");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    BoundingBox result = BoundingBox(*param1);
+                    gameplay::ScriptUtil::pushValue(state, result, "BoundingBox");
 
                     return 1;
                 }
@@ -159,19 +137,8 @@ int lua_BoundingBox__init(lua_State* state)
                     if (!param2Valid)
                         break;
 
-                    void* returnPtr = (void*)new BoundingBox(*param1, *param2);
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "BoundingBox");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    BoundingBox result = BoundingBox(*param1, *param2);
+                    gameplay::ScriptUtil::pushValue(state, result, "BoundingBox");
 
                     return 1;
                 }
@@ -210,19 +177,8 @@ int lua_BoundingBox__init(lua_State* state)
                     // Get parameter 6 off the stack.
                     float param6 = (float)luaL_checknumber(state, 6);
 
-                    void* returnPtr = (void*)new BoundingBox(param1, param2, param3, param4, param5, param6);
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "BoundingBox");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    BoundingBox result = BoundingBox(param1, param2, param3, param4, param5, param6);
+                    gameplay::ScriptUtil::pushValue(state, result, "BoundingBox");
 
                     return 1;
                 }
@@ -257,19 +213,8 @@ int lua_BoundingBox_getCenter(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     BoundingBox* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getCenter());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    Vector3 result(instance->getCenter());
+                    gameplay::ScriptUtil::pushValue(state, result, "Vector3");
 
                     return 1;
                 }
@@ -545,19 +490,8 @@ int lua_BoundingBox_max(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->max);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        Vector3 result(instance->max);
+        gameplay::ScriptUtil::pushValue(state, result, "Vector3");
 
         return 1;
     }
@@ -649,19 +583,8 @@ int lua_BoundingBox_min(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->min);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        Vector3 result(instance->min);
+        gameplay::ScriptUtil::pushValue(state, result, "Vector3");
 
         return 1;
     }
@@ -86,19 +86,8 @@ int lua_BoundingSphere__init(lua_State* state)
     {
         case 0:
         {
-            void* returnPtr = (void*)new BoundingSphere();
-            if (returnPtr)
-            {
-                gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                object->instance = returnPtr;
-                object->owns = true;
-                luaL_getmetatable(state, "BoundingSphere");
-                lua_setmetatable(state, -2);
-            }
-            else
-            {
-                lua_pushnil(state);
-            }
+            BoundingSphere result = BoundingSphere();
+            gameplay::ScriptUtil::pushValue(state, result, "BoundingSphere");
 
             return 1;
             break;
@@ -115,19 +104,8 @@ int lua_BoundingSphere__init(lua_State* state)
                     if (!param1Valid)
                         break;
 
-                    void* returnPtr = (void*)new BoundingSphere(*param1);
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "BoundingSphere");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    BoundingSphere result = BoundingSphere(*param1);
+                    gameplay::ScriptUtil::pushValue(state, result, "BoundingSphere");
 
                     return 1;
                 }
@@ -153,19 +131,8 @@ int lua_BoundingSphere__init(lua_State* state)
                     // Get parameter 2 off the stack.
                     float param2 = (float)luaL_checknumber(state, 2);
 
-                    void* returnPtr = (void*)new BoundingSphere(*param1, param2);
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "BoundingSphere");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    BoundingSphere result = BoundingSphere(*param1, param2);
+                    gameplay::ScriptUtil::pushValue(state, result, "BoundingSphere");
 
                     return 1;
                 }
@@ -211,19 +178,8 @@ int lua_BoundingSphere_center(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->center);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        Vector3 result(instance->center);
+        gameplay::ScriptUtil::pushValue(state, result, "Vector3");
 
         return 1;
     }
@@ -29,6 +29,7 @@ int lua_Form_getClip(lua_State* state);
 int lua_Form_getClipBounds(lua_State* state);
 int lua_Form_getConsumeInputEvents(lua_State* state);
 int lua_Form_getControl(lua_State* state);
+int lua_Form_getControlAt(lua_State* state);
 int lua_Form_getControlCount(lua_State* state);
 int lua_Form_getCursorColor(lua_State* state);
 int lua_Form_getCursorRegion(lua_State* state);
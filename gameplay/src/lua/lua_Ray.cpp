@@ -89,19 +89,8 @@ int lua_Ray__init(lua_State* state)
     {
         case 0:
         {
-            void* returnPtr = (void*)new Ray();
-            if (returnPtr)
-            {
-                gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                object->instance = returnPtr;
-                object->owns = true;
-                luaL_getmetatable(state, "Ray");
-                lua_setmetatable(state, -2);
-            }
-            else
-            {
-                lua_pushnil(state);
-            }
+            Ray result = Ray();
+            gameplay::ScriptUtil::pushValue(state, result, "Ray");
 
             return 1;
             break;
@@ -118,19 +107,8 @@ int lua_Ray__init(lua_State* state)
                     if (!param1Valid)
                         break;
 
-                    void* returnPtr = (void*)new Ray(*param1);
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Ray");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    Ray result = Ray(*param1);
+                    gameplay::ScriptUtil::pushValue(state, result, "Ray");
 
                     return 1;
                 }
@@ -159,19 +137,8 @@ int lua_Ray__init(lua_State* state)
                     if (!param2Valid)
                         break;
 
-                    void* returnPtr = (void*)new Ray(*param1, *param2);
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Ray");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    Ray result = Ray(*param1, *param2);
+                    gameplay::ScriptUtil::pushValue(state, result, "Ray");
 
                     return 1;
                 }
@@ -210,19 +177,8 @@ int lua_Ray__init(lua_State* state)
                     // Get parameter 6 off the stack.
                     float param6 = (float)luaL_checknumber(state, 6);
 
-                    void* returnPtr = (void*)new Ray(param1, param2, param3, param4, param5, param6);
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Ray");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    Ray result = Ray(param1, param2, param3, param4, param5, param6);
+                    gameplay::ScriptUtil::pushValue(state, result, "Ray");
 
                     return 1;
                 }
@@ -30,7 +30,10 @@ void luaRegister_RenderStateStateBlock()
         {"release", lua_RenderStateStateBlock_release},
         {"setBlend", lua_RenderStateStateBlock_setBlend},
         {"setBlendDst", lua_RenderStateStateBlock_setBlendDst},
+        {"setBlendDstAlpha", lua_RenderStateStateBlock_setBlendDstAlpha},
+        {"setBlendSeparate", lua_RenderStateStateBlock_setBlendSeparate},
         {"setBlendSrc", lua_RenderStateStateBlock_setBlendSrc},
+        {"setBlendSrcAlpha", lua_RenderStateStateBlock_setBlendSrcAlpha},
         {"setCullFace", lua_RenderStateStateBlock_setCullFace},
         {"setCullFaceSide", lua_RenderStateStateBlock_setCullFaceSide},
         {"setDepthFunction", lua_RenderStateStateBlock_setDepthFunction},
@@ -303,6 +306,78 @@ int lua_RenderStateStateBlock_setBlendDst(lua_State* state)
     return 0;
 }
 
+int lua_RenderStateStateBlock_setBlendDstAlpha(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                (lua_type(state, 2) == LUA_TSTRING || lua_type(state, 2) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                RenderState::Blend param1 = (RenderState::Blend)lua_enumFromString_RenderStateBlend(luaL_checkstring(state, 2));
+
+                RenderState::StateBlock* instance = getInstance(state);
+                instance->setBlendDstAlpha(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_RenderStateStateBlock_setBlendDstAlpha - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_RenderStateStateBlock_setBlendSeparate(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TBOOLEAN)
+            {
+                // Get parameter 1 off the stack.
+                bool param1 = gameplay::ScriptUtil::luaCheckBool(state, 2);
+
+                RenderState::StateBlock* instance = getInstance(state);
+                instance->setBlendSeparate(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_RenderStateStateBlock_setBlendSeparate - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_RenderStateStateBlock_setBlendSrc(lua_State* state)
 {
     // Get the number of parameters.
@@ -339,6 +414,42 @@ int lua_RenderStateStateBlock_setBlendSrc(lua_State* state)
     return 0;
 }
 
+int lua_RenderStateStateBlock_setBlendSrcAlpha(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                (lua_type(state, 2) == LUA_TSTRING || lua_type(state, 2) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                RenderState::Blend param1 = (RenderState::Blend)lua_enumFromString_RenderStateBlend(luaL_checkstring(state, 2));
+
+                RenderState::StateBlock* instance = getInstance(state);
+                instance->setBlendSrcAlpha(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_RenderStateStateBlock_setBlendSrcAlpha - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_RenderStateStateBlock_setCullFace(lua_State* state)
 {
     // Get the number of parameters.
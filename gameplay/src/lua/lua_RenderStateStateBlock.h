@@ -12,7 +12,10 @@ int lua_RenderStateStateBlock_getRefCount(lua_State* state);
 int lua_RenderStateStateBlock_release(lua_State* state);
 int lua_RenderStateStateBlock_setBlend(lua_State* state);
 int lua_RenderStateStateBlock_setBlendDst(lua_State* state);
+int lua_RenderStateStateBlock_setBlendDstAlpha(lua_State* state);
+int lua_RenderStateStateBlock_setBlendSeparate(lua_State* state);
 int lua_RenderStateStateBlock_setBlendSrc(lua_State* state);
+int lua_RenderStateStateBlock_setBlendSrcAlpha(lua_State* state);
 int lua_RenderStateStateBlock_setCullFace(lua_State* state);
 int lua_RenderStateStateBlock_setCullFaceSide(lua_State* state);
 int lua_RenderStateStateBlock_setDepthFunction(lua_State* state);
@@ -1,9 +1,16 @@
 SAMPLE_PATH := $(call my-dir)/../../src
 
+# Build with USE_LUAJIT=true to use LuaJIT from external-deps/luajit instead of Lua 5.2.
+ifeq ($(USE_LUAJIT),true)
+LUA_DIR := luajit
+else
+LUA_DIR := lua
+endif
+
 # external-deps
 PNG_PATH := $(call my-dir)/../../../../external-deps/png/lib/android/arm
 ZLIB_PATH := $(call my-dir)/../../../../external-deps/zlib/lib/android/arm
-LUA_PATH := $(call my-dir)/../../../../external-deps/lua/lib/android/arm
+LUA_PATH := $(call my-dir)/../../../../external-deps/$(LUA_DIR)/lib/android/arm
 BULLET_PATH := $(call my-dir)/../../../../external-deps/bullet/lib/android/arm
 VORBIS_PATH := $(call my-dir)/../../../../external-deps/oggvorbis/lib/android/arm
 OPENAL_PATH := $(call my-dir)/../../../../external-deps/openal/lib/android/arm
@@ -33,7 +40,7 @@ include $(PREBUILT_STATIC_LIBRARY)
 LOCAL_PATH := $(LUA_PATH)
 include $(CLEAR_VARS)
 LOCAL_MODULE    := liblua
-LOCAL_SRC_FILES := liblua.a
+LOCAL_SRC_FILES := lib$(LUA_DIR).a
 include $(PREBUILT_STATIC_LIBRARY)
 
 # libbullet
@@ -68,9 +75,11 @@ LOCAL_SRC_FILES := ../../../gameplay/src/gameplay-main-android.cpp \
     Sample.cpp \
     SamplesGame.cpp \
     Audio3DSample.cpp \
+    AIMessageBenchmarkSample.cpp \
     BillboardSample.cpp \
     CreateSceneSample.cpp \
     FormsSample.cpp \
+    FormsBenchmarkSample.cpp \
     GestureSample.cpp \
     GamepadSample.cpp \
     InputSample.cpp \
@@ -79,15 +88,18 @@ LOCAL_SRC_FILES := ../../../gameplay/src/gameplay-main-android.cpp \
 	MeshBatchSample.cpp \
     MeshPrimitiveSample.cpp \
 	PhysicsCollisionObjectSample.cpp \
+    PhysicsBenchmarkSample.cpp \
     PostProcessSample.cpp \
+    ScriptBenchmarkSample.cpp \
 	SpriteBatchSample.cpp \
+    SpriteBenchmarkSample.cpp \
 	TerrainSample.cpp \
     TextSample.cpp \
     TextureSample.cpp \
 	TriangleSample.cpp
 
 LOCAL_LDLIBS    := -llog -landroid -lEGL -lGLESv2 -lOpenSLES
-LOCAL_CFLAGS    := -D__ANDROID__ -Wno-psabi -I"../../../external-deps/lua/include" -I"../../../external-deps/bullet/include" -I"../../../external-deps/png/include" -I"../../../external-deps/oggvorbis/include" -I"../../../external-deps/openal/include" -I"../../../gameplay/src"
+LOCAL_CFLAGS    := -D__ANDROID__ -Wno-psabi -I"../../../external-deps/$(LUA_DIR)/include" -I"../../../external-deps/bullet/include" -I"../../../external-deps/png/include" -I"../../../external-deps/oggvorbis/include" -I"../../../external-deps/openal/include" -I"../../../gameplay/src"
 LOCAL_STATIC_LIBRARIES := android_native_app_glue libgameplay libpng libzlib liblua libbullet libvorbis libOpenAL
 
 include $(BUILD_SHARED_LIBRARY)
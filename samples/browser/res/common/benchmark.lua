@@ -0,0 +1,23 @@
+
+-- Functions called by the script benchmark sample to measure the cost of calling Lua from C++.
+
+benchmark = { }
+callCount = 0
+
+function benchmarkCallback(value)
+    callCount = callCount + value
+end
+
+function benchmark.callback(value)
+    callCount = callCount + value
+end
+
+-- Calls Node:getTranslationWorld(), which returns a Vector3 by value, to measure the allocations made by the bindings.
+benchmarkNode = Node.create("benchmark")
+
+function benchmarkTranslationWorld(count)
+    local v
+    for i = 1, count do
+        v = benchmarkNode:getTranslationWorld()
+    end
+end
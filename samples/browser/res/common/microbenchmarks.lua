@@ -0,0 +1,131 @@
+
+-- Micro-benchmarks of common script operations.
+--
+-- The script benchmark sample runs these inside the engine. They can also be run headless by a
+-- stand-alone interpreter, to compare Lua 5.2 with LuaJIT, from this directory:
+--     lua microbenchmarks.lua
+--     luajit microbenchmarks.lua
+-- Benchmarks that call into the gameplay bindings are skipped when run stand-alone.
+
+local benchmarks = { }
+
+local function addBenchmark(name, iterations, usesBindings, run)
+    benchmarks[#benchmarks + 1] = { name = name, iterations = iterations, usesBindings = usesBindings, run = run }
+end
+
+addBenchmark("table array append", 1000000, false, function(n)
+    local t = { }
+    for i = 1, n do
+        t[#t + 1] = i
+    end
+end)
+
+addBenchmark("table hash set and get", 1000000, false, function(n)
+    local t = { }
+    local sum = 0
+    for i = 1, n do
+        local key = i % 1000
+        t[key] = i
+        sum = sum + t[key]
+    end
+    return sum
+end)
+
+addBenchmark("string format", 200000, false, function(n)
+    local s
+    for i = 1, n do
+        s = string.format("%d:%f", i, i * 0.5)
+    end
+    return s
+end)
+
+addBenchmark("string concat", 200000, false, function(n)
+    local parts = { }
+    for i = 1, n do
+        parts[#parts + 1] = tostring(i)
+    end
+    return table.concat(parts, ",")
+end)
+
+addBenchmark("closure creation", 1000000, false, function(n)
+    local f
+    for i = 1, n do
+        f = function() return i end
+    end
+    return f
+end)
+
+local Point = { }
+Point.__index = Point
+
+function Point.new(x, y)
+    return setmetatable({ x = x, y = y }, Point)
+end
+
+function Point:length()
+    return math.sqrt(self.x * self.x + self.y * self.y)
+end
+
+addBenchmark("method call", 1000000, false, function(n)
+    local p = Point.new(3, 4)
+    local sum = 0
+    for i = 1, n do
+        sum = sum + p:length()
+    end
+    return sum
+end)
+
+addBenchmark("small table allocation", 1000000, false, function(n)
+    local p
+    for i = 1, n do
+        p = Point.new(i, i)
+    end
+    return p
+end)
+
+addBenchmark("math", 1000000, false, function(n)
+    local sum = 0
+    for i = 1, n do
+        sum = sum + math.sin(i) * math.floor(i * 0.5)
+    end
+    return sum
+end)
+
+addBenchmark("Vector3 add", 200000, true, function(n)
+    local v = Vector3.new(0, 0, 0)
+    local step = Vector3.new(1, 2, 3)
+    for i = 1, n do
+        v:add(step)
+    end
+    return v
+end)
+
+addBenchmark("Node:getTranslationWorld", 200000, true, function(n)
+    local node = Node.create("benchmark")
+    local v
+    for i = 1, n do
+        v = node:getTranslationWorld()
+    end
+    return v
+end)
+
+-- Runs every benchmark that can run in this interpreter and returns the interpreter version
+-- followed by one line of results for each benchmark.
+function runMicroBenchmarks()
+    local lines = { _VERSION .. (jit and (" (" .. jit.version .. ")") or "") }
+    for _, benchmark in ipairs(benchmarks) do
+        if not benchmark.usesBindings or Node ~= nil then
+            collectgarbage("collect")
+            local start = os.clock()
+            benchmark.run(benchmark.iterations)
+            local elapsed = os.clock() - start
+            lines[#lines + 1] = string.format("%s: %.2f ms, %.1f ns per iteration", benchmark.name, elapsed * 1000, elapsed * 1e9 / benchmark.iterations)
+        end
+    end
+    return table.concat(lines, "\n")
+end
+
+-- Run the benchmarks straight away when loaded by a stand-alone interpreter.
+if ScriptController == nil then
+    print(runMicroBenchmarks())
+end
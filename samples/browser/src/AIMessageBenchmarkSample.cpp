@@ -0,0 +1,154 @@
+#include "AIMessageBenchmarkSample.h"
+#include "SamplesGame.h"
+
+#if defined(ADD_SAMPLE)
+    ADD_SAMPLE("AI", "Message Benchmark", AIMessageBenchmarkSample, 1);
+#endif
+
+#define AGENT_COUNT 100
+#define MESSAGE_COUNT 100000
+#define MAX_DELAY 1000.0f
+
+enum MessageId
+{
+    UNICAST_MESSAGE,
+    BROADCAST_MESSAGE,
+    DELAYED_MESSAGE
+};
+
+AIMessageBenchmarkSample::AIMessageBenchmarkSample()
+    : _font(NULL), _unicastTime(0), _broadcastTime(0), _queueTime(0), _delayedStartTime(0), _delayedEndTime(0),
+      _unicastReceived(0), _broadcastReceived(0), _delayedReceived(0), _delayedEarly(0)
+{
+}
+
+void AIMessageBenchmarkSample::initialize()
+{
+    // Create the font for drawing the results.
+    _font = Font::create("res/ui/arial.gpb");
+
+    // Agents are registered with the AIController by the ID of their node.
+    char id[32];
+    for (unsigned int i = 0; i < AGENT_COUNT; ++i)
+    {
+        sprintf(id, "agent%u", i);
+        _agentIds.push_back(id);
+
+        AIAgent* agent = AIAgent::create();
+        agent->setListener(this);
+        Node* node = Node::create(id);
+        node->setAgent(agent);
+        SAFE_RELEASE(agent);
+        _nodes.push_back(node);
+    }
+
+    runBenchmark();
+}
+
+void AIMessageBenchmarkSample::finalize()
+{
+    for (size_t i = 0, count = _nodes.size(); i < count; ++i)
+    {
+        _nodes[i]->setAgent(NULL);
+        SAFE_RELEASE(_nodes[i]);
+    }
+    _nodes.clear();
+    SAFE_RELEASE(_font);
+}
+
+void AIMessageBenchmarkSample::runBenchmark()
+{
+    AIController* controller = Game::getInstance()->getAIController();
+    _unicastReceived = 0;
+    _broadcastReceived = 0;
+    _delayedReceived = 0;
+    _delayedEarly = 0;
+
+    // Messages to single agents, found by ID.
+    double start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < MESSAGE_COUNT; ++i)
+    {
+        AIMessage* message = AIMessage::create(UNICAST_MESSAGE, NULL, _agentIds[i % AGENT_COUNT].c_str(), 1);
+        message->setInt(0, i);
+        controller->sendMessage(message);
+    }
+    _unicastTime = Game::getAbsoluteTime() - start;
+
+    // Messages to every agent, each of which lets the message continue to the next agent.
+    start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < MESSAGE_COUNT; ++i)
+    {
+        AIMessage* message = AIMessage::create(BROADCAST_MESSAGE, NULL, NULL, 1);
+        message->setInt(0, i);
+        controller->sendMessage(message);
+    }
+    _broadcastTime = Game::getAbsoluteTime() - start;
+
+    // Delayed messages, delivered by the controller over the next second as they fall due.
+    srand(1);
+    start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < MESSAGE_COUNT; ++i)
+    {
+        // Each message carries the time it is due, to check that none is delivered early.
+        float delay = MATH_RANDOM_0_1() * MAX_DELAY;
+        AIMessage* message = AIMessage::create(DELAYED_MESSAGE, NULL, _agentIds[i % AGENT_COUNT].c_str(), 1);
+        message->setDouble(0, Game::getGameTime() + delay);
+        controller->sendMessage(message, delay);
+    }
+    _queueTime = Game::getAbsoluteTime() - start;
+    _delayedStartTime = Game::getGameTime();
+    _delayedEndTime = 0;
+}
+
+bool AIMessageBenchmarkSample::messageReceived(AIMessage* message)
+{
+    switch (message->getId())
+    {
+    case UNICAST_MESSAGE:
+        ++_unicastReceived;
+        break;
+    case BROADCAST_MESSAGE:
+        ++_broadcastReceived;
+        break;
+    case DELAYED_MESSAGE:
+        if (message->getDouble(0) > Game::getGameTime())
+            ++_delayedEarly;
+        if (++_delayedReceived == MESSAGE_COUNT)
+            _delayedEndTime = Game::getGameTime();
+        break;
+    }
+    return false;
+}
+
+void AIMessageBenchmarkSample::update(float elapsedTime)
+{
+}
+
+void AIMessageBenchmarkSample::render(float elapsedTime)
+{
+    // Clear the color and depth buffers
+    clear(CLEAR_COLOR_DEPTH, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0);
+
+    char buffer[128];
+    _font->start();
+    sprintf(buffer, "%u unicast messages: %.2f ms (%.0f messages/s), %u received", MESSAGE_COUNT, _unicastTime, MESSAGE_COUNT * 1000.0 / _unicastTime, _unicastReceived);
+    _font->drawText(buffer, 5, 30, Vector4::one(), _font->getSize());
+    sprintf(buffer, "%u broadcast messages to %u agents: %.2f ms (%.0f messages/s), %u received", MESSAGE_COUNT, AGENT_COUNT, _broadcastTime, MESSAGE_COUNT * 1000.0 / _broadcastTime, _broadcastReceived);
+    _font->drawText(buffer, 5, 50, Vector4::one(), _font->getSize());
+    sprintf(buffer, "%u delayed messages: %.2f ms to queue, %u received, %u early", MESSAGE_COUNT, _queueTime, _delayedReceived, _delayedEarly);
+    _font->drawText(buffer, 5, 70, Vector4::one(), _font->getSize());
+    if (_delayedEndTime > 0)
+    {
+        sprintf(buffer, "Last delayed message delivered after %.0f ms", _delayedEndTime - _delayedStartTime);
+        _font->drawText(buffer, 5, 90, Vector4::one(), _font->getSize());
+    }
+    _font->finish();
+
+    drawFrameRate(_font, Vector4(0, 0.5f, 1, 1), 5, 1, getFrameRate());
+}
+
+void AIMessageBenchmarkSample::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
+{
+    if (evt == Touch::TOUCH_PRESS)
+        runBenchmark();
+}
@@ -0,0 +1,54 @@
+#ifndef AIMESSAGEBENCHMARKSAMPLE_H_
+#define AIMESSAGEBENCHMARKSAMPLE_H_
+
+#include "gameplay.h"
+#include "Sample.h"
+
+using namespace gameplay;
+
+/**
+ * Sample measuring the rate at which the AIController routes messages between agents.
+ *
+ * A hundred thousand messages are sent to single agents by ID, then a hundred thousand are
+ * broadcast to every agent, then a hundred thousand are queued with random delays of up to
+ * a second and delivered by the controller as they fall due. Touch to run again.
+ */
+class AIMessageBenchmarkSample : public Sample, public AIAgent::Listener
+{
+public:
+
+    AIMessageBenchmarkSample();
+
+    void touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex);
+
+    bool messageReceived(AIMessage* message);
+
+protected:
+
+    void initialize();
+
+    void finalize();
+
+    void update(float elapsedTime);
+
+    void render(float elapsedTime);
+
+private:
+
+    void runBenchmark();
+
+    Font* _font;
+    std::vector<Node*> _nodes;
+    std::vector<std::string> _agentIds;
+    double _unicastTime;
+    double _broadcastTime;
+    double _queueTime;
+    double _delayedStartTime;
+    double _delayedEndTime;
+    unsigned int _unicastReceived;
+    unsigned int _broadcastReceived;
+    unsigned int _delayedReceived;
+    unsigned int _delayedEarly;
+};
+
+#endif
@@ -0,0 +1,363 @@
+#include "FormsBenchmarkSample.h"
+#include "SamplesGame.h"
+
+#if defined(ADD_SAMPLE)
+    ADD_SAMPLE("Graphics", "Forms Benchmark", FormsBenchmarkSample, 14);
+#endif
+
+#define LIST_ITEM_COUNT 5000
+#define APPEND_BLOCK_COUNT 100
+#define IDLE_UPDATE_COUNT 100
+#define SCROLL_UPDATE_COUNT 1000
+#define HIT_CONTAINER_COLUMNS 5
+#define HIT_CONTAINER_ROWS 4
+#define HIT_BUTTONS_PER_SIDE 10
+#define TOUCH_MOVE_COUNT 100000
+#define HUD_LABEL_COLUMNS 20
+#define HUD_LABEL_ROWS 30
+#define HUD_FRAME_COUNT 100
+
+// Row counts of the virtual list benchmark.
+static const unsigned int VIRTUAL_ROW_COUNTS[] = { 1000, 100000, 1000000 };
+
+FormsBenchmarkSample::FormsBenchmarkSample()
+    : _font(NULL), _form(NULL), _list(NULL), _appendTime(0), _firstAppendTime(0), _lastAppendTime(0), _idleUpdateTime(0),
+      _virtualList(NULL), _virtualRowCount(0), _gridHitTime(0), _searchHitTime(0), _hitCount(0), _hitMismatches(0),
+      _cachedLabelTime(0), _drawTextLabelTime(0)
+{
+    memset(_virtualUpdateTimes, 0, sizeof(_virtualUpdateTimes));
+    memset(_virtualControlCounts, 0, sizeof(_virtualControlCounts));
+}
+
+void FormsBenchmarkSample::initialize()
+{
+    // Create the font for drawing the results.
+    _font = Font::create("res/ui/arial.gpb");
+
+    runAppend();
+    runVirtualList();
+    runHitTest();
+    runLabels();
+}
+
+void FormsBenchmarkSample::finalize()
+{
+    SAFE_RELEASE(_form);
+    SAFE_RELEASE(_font);
+}
+
+void FormsBenchmarkSample::runAppend()
+{
+    // Start each run from an empty list.
+    SAFE_RELEASE(_form);
+    _form = Form::create("formsBenchmark", NULL);
+    _form->setSize(getWidth(), getHeight());
+
+    _list = Container::create("list", NULL, Layout::LAYOUT_VERTICAL);
+    _list->setPosition(5, 215);
+    _list->setSize(300, getHeight() - 220);
+    _list->setScroll(Container::SCROLL_VERTICAL);
+    _form->addControl(_list);
+    _list->release();
+    _form->update(0);
+
+    char text[32];
+    double start = Game::getAbsoluteTime();
+    double blockStart = start;
+    for (unsigned int i = 0; i < LIST_ITEM_COUNT; ++i)
+    {
+        sprintf(text, "item%u", i);
+        Label* label = Label::create(text);
+        sprintf(text, "Item %u", i);
+        label->setText(text);
+        _list->addControl(label);
+        label->release();
+
+        // Lay the form out as the next frame would.
+        _form->update(0);
+
+        if (i + 1 == APPEND_BLOCK_COUNT)
+        {
+            _firstAppendTime = Game::getAbsoluteTime() - start;
+        }
+        else if (i + APPEND_BLOCK_COUNT == LIST_ITEM_COUNT)
+        {
+            blockStart = Game::getAbsoluteTime();
+        }
+    }
+    double end = Game::getAbsoluteTime();
+    _appendTime = end - start;
+    _lastAppendTime = end - blockStart;
+
+    // Updating the full list when nothing has changed should not visit the items.
+    start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < IDLE_UPDATE_COUNT; ++i)
+    {
+        _form->update(0);
+    }
+    _idleUpdateTime = Game::getAbsoluteTime() - start;
+}
+
+void FormsBenchmarkSample::runVirtualList()
+{
+    _virtualList = VirtualList::create("virtualList");
+    _virtualList->setPosition(315, 215);
+    _virtualList->setSize(300, getHeight() - 220);
+    _virtualList->setRowHeight(20);
+    _virtualList->setDataSource(this);
+    _form->addControl(_virtualList);
+    _virtualList->release();
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        _virtualRowCount = VIRTUAL_ROW_COUNTS[i];
+        _virtualList->reloadData();
+        _virtualList->scrollToRow(0);
+        _form->update(0);
+
+        // Jump to a different part of the list on every update, so that every row is rebound.
+        double start = Game::getAbsoluteTime();
+        for (unsigned int j = 0; j < SCROLL_UPDATE_COUNT; ++j)
+        {
+            _virtualList->scrollToRow((j * 7919) % _virtualRowCount);
+            _form->update(0);
+        }
+        _virtualUpdateTimes[i] = Game::getAbsoluteTime() - start;
+        _virtualControlCounts[i] = _virtualList->getControlCount();
+    }
+}
+
+/**
+ * Finds the control that receives input at a point by searching the whole control tree,
+ * the way forms did before they kept a hit-test grid. Later controls are drawn on top, so
+ * the last match wins.
+ */
+static Control* findControlAt(Control* control, int x, int y)
+{
+    if (!control->isVisible() || !control->isEnabled())
+        return NULL;
+
+    // The benchmark's controls lie within their containers, so their bounds are not clipped.
+    Control* result = NULL;
+    if (control->getConsumeInputEvents() && control->getAbsoluteBounds().contains(x, y))
+        result = control;
+
+    if (control->isContainer())
+    {
+        Container* container = static_cast<Container*>(control);
+        for (unsigned int i = 0, count = container->getControlCount(); i < count; ++i)
+        {
+            Control* child = findControlAt(container->getControl(i), x, y);
+            if (child)
+                result = child;
+        }
+    }
+
+    return result;
+}
+
+void FormsBenchmarkSample::runHitTest()
+{
+    // The form only exists for the duration of the benchmark. It does not consume input
+    // itself, so touches outside its buttons still reach the sample.
+    Form* form = Form::create("hitTestBenchmark", NULL);
+    form->setSize(getWidth(), getHeight());
+    form->setConsumeInputEvents(false);
+
+    // Neighbouring buttons overlap, so the order of the controls decides which one is hit.
+    // Some are disabled or hidden, and must be skipped.
+    const float cellWidth = (float)getWidth() / HIT_CONTAINER_COLUMNS;
+    const float cellHeight = (float)getHeight() / HIT_CONTAINER_ROWS;
+    const float spacingX = (cellWidth - 60) / (HIT_BUTTONS_PER_SIDE + 1);
+    const float spacingY = (cellHeight - 60) / (HIT_BUTTONS_PER_SIDE + 1);
+    char id[32];
+    unsigned int buttonIndex = 0;
+    for (unsigned int row = 0; row < HIT_CONTAINER_ROWS; ++row)
+    {
+        for (unsigned int column = 0; column < HIT_CONTAINER_COLUMNS; ++column)
+        {
+            sprintf(id, "container%u", row * HIT_CONTAINER_COLUMNS + column);
+            Container* container = Container::create(id);
+            container->setPosition(column * cellWidth, row * cellHeight);
+            container->setSize(cellWidth, cellHeight);
+            form->addControl(container);
+            container->release();
+
+            for (unsigned int i = 0; i < HIT_BUTTONS_PER_SIDE * HIT_BUTTONS_PER_SIDE; ++i, ++buttonIndex)
+            {
+                sprintf(id, "button%u", buttonIndex);
+                Button* button = Button::create(id);
+                button->setPosition(10 + (i % HIT_BUTTONS_PER_SIDE) * spacingX, 10 + (i / HIT_BUTTONS_PER_SIDE) * spacingY);
+                button->setSize(spacingX * 1.5f, spacingY * 1.5f);
+                if (buttonIndex % 7 == 0)
+                    button->setEnabled(false);
+                if (buttonIndex % 11 == 0)
+                    button->setVisible(false);
+                container->addControl(button);
+                button->release();
+            }
+        }
+    }
+    form->update(0);
+
+    // A stream of touch moves sweeping back and forth across the form.
+    std::vector<Vector2> points(TOUCH_MOVE_COUNT);
+    for (unsigned int i = 0; i < TOUCH_MOVE_COUNT; ++i)
+    {
+        float t = (float)i / TOUCH_MOVE_COUNT;
+        points[i].set((0.5f + 0.5f * sinf(t * 37.0f)) * (getWidth() - 1), (0.5f + 0.5f * sinf(t * 23.0f + 1.0f)) * (getHeight() - 1));
+    }
+
+    std::vector<Control*> gridHits(TOUCH_MOVE_COUNT);
+    double start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < TOUCH_MOVE_COUNT; ++i)
+    {
+        gridHits[i] = form->getControlAt((int)points[i].x, (int)points[i].y);
+    }
+    _gridHitTime = Game::getAbsoluteTime() - start;
+
+    std::vector<Control*> searchHits(TOUCH_MOVE_COUNT);
+    start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < TOUCH_MOVE_COUNT; ++i)
+    {
+        searchHits[i] = findControlAt(form, (int)points[i].x, (int)points[i].y);
+    }
+    _searchHitTime = Game::getAbsoluteTime() - start;
+
+    _hitCount = 0;
+    _hitMismatches = 0;
+    for (unsigned int i = 0; i < TOUCH_MOVE_COUNT; ++i)
+    {
+        if (gridHits[i])
+            ++_hitCount;
+        if (gridHits[i] != searchHits[i])
+            ++_hitMismatches;
+    }
+    if (_hitMismatches > 0)
+        GP_WARN("The hit-test grid and the recursive search disagree for %u of %u points.", _hitMismatches, TOUCH_MOVE_COUNT);
+
+    SAFE_RELEASE(form);
+}
+
+void FormsBenchmarkSample::runLabels()
+{
+    // Lay the labels out in a grid covering the screen, each with a short changing value.
+    const unsigned int labelCount = HUD_LABEL_COLUMNS * HUD_LABEL_ROWS;
+    const float cellWidth = (float)getWidth() / HUD_LABEL_COLUMNS;
+    const float cellHeight = (float)getHeight() / HUD_LABEL_ROWS;
+    const unsigned int fontSize = _font->getSize();
+    std::vector<std::string> strings(labelCount);
+    std::vector<Rectangle> areas(labelCount);
+    char text[32];
+    for (unsigned int i = 0; i < labelCount; ++i)
+    {
+        sprintf(text, "Label %u: %u", i, (i * 7919) % 1000);
+        strings[i] = text;
+        areas[i].set((i % HUD_LABEL_COLUMNS) * cellWidth, (i / HUD_LABEL_COLUMNS) * cellHeight, cellWidth, cellHeight);
+    }
+
+    // Labels lay their text out once and draw the stored vertices on later frames.
+    std::vector<Font::Text*> texts(labelCount);
+    for (unsigned int i = 0; i < labelCount; ++i)
+    {
+        texts[i] = _font->createText(strings[i].c_str(), areas[i], Vector4::one(), fontSize, Font::ALIGN_TOP_LEFT, true, false, &areas[i]);
+    }
+    double start = Game::getAbsoluteTime();
+    for (unsigned int frame = 0; frame < HUD_FRAME_COUNT; ++frame)
+    {
+        _font->start();
+        for (unsigned int i = 0; i < labelCount; ++i)
+        {
+            _font->drawText(texts[i]);
+        }
+        _font->finish();
+    }
+    _cachedLabelTime = Game::getAbsoluteTime() - start;
+    for (unsigned int i = 0; i < labelCount; ++i)
+    {
+        SAFE_DELETE(texts[i]);
+    }
+
+    // Font::drawText measures, wraps and aligns the text and builds its glyphs again every frame.
+    start = Game::getAbsoluteTime();
+    for (unsigned int frame = 0; frame < HUD_FRAME_COUNT; ++frame)
+    {
+        _font->start();
+        for (unsigned int i = 0; i < labelCount; ++i)
+        {
+            _font->drawText(strings[i].c_str(), areas[i], Vector4::one(), fontSize, Font::ALIGN_TOP_LEFT, true, false, &areas[i]);
+        }
+        _font->finish();
+    }
+    _drawTextLabelTime = Game::getAbsoluteTime() - start;
+}
+
+unsigned int FormsBenchmarkSample::getRowCount(VirtualList* list)
+{
+    return _virtualRowCount;
+}
+
+Control* FormsBenchmarkSample::createRowControl(VirtualList* list)
+{
+    return Label::create("row");
+}
+
+void FormsBenchmarkSample::bindRowControl(VirtualList* list, Control* control, unsigned int row)
+{
+    char text[32];
+    sprintf(text, "Row %u", row);
+    static_cast<Label*>(control)->setText(text);
+}
+
+void FormsBenchmarkSample::update(float elapsedTime)
+{
+}
+
+void FormsBenchmarkSample::render(float elapsedTime)
+{
+    // Clear the color and depth buffers
+    clear(CLEAR_COLOR_DEPTH, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0);
+
+    _form->draw();
+
+    char buffer[128];
+    _font->start();
+    sprintf(buffer, "%u items appended: %.2f ms (%.3f ms per append)", LIST_ITEM_COUNT, _appendTime, _appendTime / LIST_ITEM_COUNT);
+    _font->drawText(buffer, 5, 30, Vector4::one(), _font->getSize());
+    sprintf(buffer, "First %u appends: %.3f ms per append, last %u appends: %.3f ms per append", APPEND_BLOCK_COUNT,
+        _firstAppendTime / APPEND_BLOCK_COUNT, APPEND_BLOCK_COUNT, _lastAppendTime / APPEND_BLOCK_COUNT);
+    _font->drawText(buffer, 5, 50, Vector4::one(), _font->getSize());
+    sprintf(buffer, "Update of %u items with nothing changed: %.3f ms", LIST_ITEM_COUNT, _idleUpdateTime / IDLE_UPDATE_COUNT);
+    _font->drawText(buffer, 5, 70, Vector4::one(), _font->getSize());
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        sprintf(buffer, "Virtual list of %u rows: %.3f ms per scrolled update, %u row controls", VIRTUAL_ROW_COUNTS[i],
+            _virtualUpdateTimes[i] / SCROLL_UPDATE_COUNT, _virtualControlCounts[i]);
+        _font->drawText(buffer, 5, 90 + i * 20, Vector4::one(), _font->getSize());
+    }
+    sprintf(buffer, "%u touch moves over %u buttons: %.2f ms with the hit-test grid, %.2f ms with a recursive search, %u hits",
+        TOUCH_MOVE_COUNT, HIT_CONTAINER_COLUMNS * HIT_CONTAINER_ROWS * HIT_BUTTONS_PER_SIDE * HIT_BUTTONS_PER_SIDE, _gridHitTime, _searchHitTime, _hitCount);
+    _font->drawText(buffer, 5, 150, Vector4::one(), _font->getSize());
+    sprintf(buffer, "%u labels: %.3f ms per frame from laid out text, %.3f ms per frame with Font::drawText", HUD_LABEL_COLUMNS * HUD_LABEL_ROWS,
+        _cachedLabelTime / HUD_FRAME_COUNT, _drawTextLabelTime / HUD_FRAME_COUNT);
+    _font->drawText(buffer, 5, 170, Vector4::one(), _font->getSize());
+    if (_hitMismatches > 0)
+    {
+        sprintf(buffer, "%u hit-test results differ from the recursive search", _hitMismatches);
+        _font->drawText(buffer, 5, 190, Vector4(1, 0, 0, 1), _font->getSize());
+    }
+    _font->finish();
+
+    drawFrameRate(_font, Vector4(0, 0.5f, 1, 1), 5, 1, getFrameRate());
+}
+
+void FormsBenchmarkSample::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
+{
+    if (evt == Touch::TOUCH_PRESS)
+    {
+        runAppend();
+        runVirtualList();
+        runHitTest();
+        runLabels();
+    }
+}
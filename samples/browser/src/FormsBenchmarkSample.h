@@ -0,0 +1,83 @@
+#ifndef FORMSBENCHMARKSAMPLE_H_
+#define FORMSBENCHMARKSAMPLE_H_
+
+#include "gameplay.h"
+#include "Sample.h"
+
+using namespace gameplay;
+
+/**
+ * Sample measuring the cost of laying out forms with many controls.
+ *
+ * Five thousand labels are appended one at a time to a scrolling list with a vertical
+ * layout, and the form is laid out after each one, as it would be if one item were added
+ * per frame. The time taken by the first and last hundred appends shows whether the cost
+ * of an append grows with the length of the list. The time to update the full list when
+ * nothing has changed is measured as well.
+ *
+ * A VirtualList is then scrolled to a different row on every update, with a thousand, a
+ * hundred thousand and a million rows. The time per update and the number of row controls
+ * should not depend on the number of rows.
+ *
+ * Finally, a form with two thousand buttons in twenty containers is hit tested along a
+ * stream of touch moves, both through the form's hit-test grid and with a recursive search
+ * of the control tree. The results of the two are compared.
+ *
+ * The text of a HUD with six hundred labels is also drawn for a number of frames, once
+ * from the laid out text that labels keep between frames and once with Font::drawText, as
+ * labels drew it before. Touch outside the lists to run again.
+ */
+class FormsBenchmarkSample : public Sample, public VirtualList::DataSource
+{
+public:
+
+    FormsBenchmarkSample();
+
+    void touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex);
+
+    unsigned int getRowCount(VirtualList* list);
+
+    Control* createRowControl(VirtualList* list);
+
+    void bindRowControl(VirtualList* list, Control* control, unsigned int row);
+
+protected:
+
+    void initialize();
+
+    void finalize();
+
+    void update(float elapsedTime);
+
+    void render(float elapsedTime);
+
+private:
+
+    void runAppend();
+
+    void runVirtualList();
+
+    void runHitTest();
+
+    void runLabels();
+
+    Font* _font;
+    Form* _form;
+    Container* _list;
+    double _appendTime;
+    double _firstAppendTime;
+    double _lastAppendTime;
+    double _idleUpdateTime;
+    VirtualList* _virtualList;
+    unsigned int _virtualRowCount;
+    double _virtualUpdateTimes[3];
+    unsigned int _virtualControlCounts[3];
+    double _gridHitTime;
+    double _searchHitTime;
+    unsigned int _hitCount;
+    unsigned int _hitMismatches;
+    double _cachedLabelTime;
+    double _drawTextLabelTime;
+};
+
+#endif
@@ -0,0 +1,324 @@
+#include "PhysicsBenchmarkSample.h"
+#include "SamplesGame.h"
+
+#if defined(ADD_SAMPLE)
+    ADD_SAMPLE("Physics", "Query Benchmark", PhysicsBenchmarkSample, 2);
+#endif
+
+#define BODY_ROWS 10
+#define BODY_COUNT (BODY_ROWS * BODY_ROWS * BODY_ROWS)
+#define RAY_COUNT 10000
+#define WORLD_EXTENT 30.0f
+#define ROLLBACK_STEPS 8
+#define ROLLBACK_REPEATS 10
+#define LISTENER_STEPS 60
+#define LEVEL_MESH_COUNT 8
+
+static bool hitsMesh(const PhysicsController::HitResult& result)
+{
+    return result.object && result.object->getCollisionShape()->getType() == PhysicsCollisionShape::SHAPE_MESH;
+}
+
+static bool hitResultsEqual(const PhysicsController::HitResult& a, const PhysicsController::HitResult& b)
+{
+    if (a.object != b.object)
+        return false;
+    return a.object == NULL || (a.point == b.point && a.normal == b.normal && a.fraction == b.fraction);
+}
+
+PhysicsBenchmarkSample::PhysicsBenchmarkSample()
+    : _font(NULL), _scene(NULL), _ground(NULL), _previousTimeStep(0), _singleRayTime(0), _batchRayTime(0), _singleSweepTime(0), _batchSweepTime(0),
+      _rayHits(0), _rayMeshHits(0), _rayMismatches(0), _sweepHits(0), _sweepMeshHits(0), _sweepMismatches(0), _saveTime(0), _rollbackTime(0), _rollbackMismatches(0),
+      _manifoldTime(0), _pairTestTime(0), _manifoldEvents(0), _manifoldContacts(0), _pairTestContacts(0)
+{
+}
+
+void PhysicsBenchmarkSample::initialize()
+{
+    // Create the font for drawing the results.
+    _font = Font::create("res/ui/arial.gpb");
+
+    createWorld();
+
+    // Cast the rays down into the world from random points above it.
+    srand(1);
+    _rays.resize(RAY_COUNT);
+    _distances.resize(RAY_COUNT);
+    for (unsigned int i = 0; i < RAY_COUNT; ++i)
+    {
+        Vector3 origin(MATH_RANDOM_MINUS1_1() * WORLD_EXTENT, 40.0f, MATH_RANDOM_MINUS1_1() * WORLD_EXTENT);
+        Vector3 direction(MATH_RANDOM_MINUS1_1() * 0.5f, -1.0f, MATH_RANDOM_MINUS1_1() * 0.5f);
+        _rays[i].set(origin, direction);
+        _distances[i] = 100.0f;
+    }
+
+    runQueries();
+
+    // Rollback needs a fixed time step. Let the bodies fall and pile up first, so the steps have contacts to solve.
+    _previousTimeStep = getPhysicsController()->getFixedTimeStep();
+    getPhysicsController()->setFixedTimeStep(1.0f / 60.0f);
+    getPhysicsController()->step(120);
+
+    runRollback();
+    runListeners();
+}
+
+void PhysicsBenchmarkSample::finalize()
+{
+    getPhysicsController()->setFixedTimeStep(_previousTimeStep);
+    SAFE_RELEASE(_font);
+    SAFE_RELEASE(_scene);
+    _ground = NULL;
+    _bodies.clear();
+}
+
+void PhysicsBenchmarkSample::createWorld()
+{
+    _scene = Scene::create();
+
+    Camera* camera = Camera::createPerspective(45.0f, getAspectRatio(), 1.0f, 500.0f);
+    Node* cameraNode = _scene->addNode("camera");
+    cameraNode->setCamera(camera);
+    cameraNode->setTranslation(0.0f, 45.0f, 90.0f);
+    cameraNode->rotateX(MATH_DEG_TO_RAD(-25.0f));
+    _scene->setActiveCamera(camera);
+    SAFE_RELEASE(camera);
+
+    Node* ground = _scene->addNode("ground");
+    ground->setTranslation(0.0f, -0.5f, 0.0f);
+    PhysicsRigidBody::Parameters groundParameters(0.0f);
+    _ground = ground->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::box(Vector3(WORLD_EXTENT * 2.0f, 1.0f, WORLD_EXTENT * 2.0f)), &groundParameters);
+
+    // Ring the stacks with a static level of triangle meshes, which the queries test as a bounding volume hierarchy.
+    Bundle* bundle = Bundle::create("res/common/duck.gpb");
+    Node* duck = bundle->loadNode("duck");
+    for (unsigned int i = 0; i < LEVEL_MESH_COUNT; ++i)
+    {
+        float angle = i * MATH_PIX2 / LEVEL_MESH_COUNT;
+        Node* node = _scene->addNode();
+        node->setScale(3.0f);
+        node->rotateY(angle);
+        node->setTranslation(sin(angle) * 22.0f, 0.0f, cos(angle) * 22.0f);
+        node->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::mesh(duck->getModel()->getMesh()), &groundParameters);
+    }
+    SAFE_RELEASE(duck);
+    SAFE_RELEASE(bundle);
+
+    // Stack a grid of boxes and spheres above the ground.
+    PhysicsRigidBody::Parameters parameters(1.0f);
+    for (unsigned int i = 0; i < BODY_COUNT; ++i)
+    {
+        Node* node = _scene->addNode();
+        node->setTranslation((i % BODY_ROWS) * 4.0f - BODY_ROWS * 2.0f, 2.0f + (i / (BODY_ROWS * BODY_ROWS)) * 3.0f, ((i / BODY_ROWS) % BODY_ROWS) * 4.0f - BODY_ROWS * 2.0f);
+        if (i % 2)
+            _bodies.push_back(node->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::box(Vector3::one()), &parameters));
+        else
+            _bodies.push_back(node->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::sphere(0.5f), &parameters));
+    }
+}
+
+void PhysicsBenchmarkSample::runQueries()
+{
+    PhysicsController* controller = getPhysicsController();
+
+    // Rays, one at a time and then as a batch.
+    _singleResults.resize(RAY_COUNT);
+    _batchResults.resize(RAY_COUNT);
+    double start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < RAY_COUNT; ++i)
+    {
+        if (!controller->rayTest(_rays[i], _distances[i], &_singleResults[i]))
+            _singleResults[i].object = NULL;
+    }
+    _singleRayTime = Game::getAbsoluteTime() - start;
+
+    start = Game::getAbsoluteTime();
+    _rayHits = controller->rayTest(&_rays[0], &_distances[0], RAY_COUNT, &_batchResults[0]);
+    _batchRayTime = Game::getAbsoluteTime() - start;
+
+    _rayMismatches = 0;
+    _rayMeshHits = 0;
+    for (unsigned int i = 0; i < RAY_COUNT; ++i)
+    {
+        if (!hitResultsEqual(_singleResults[i], _batchResults[i]))
+            ++_rayMismatches;
+        if (hitsMesh(_batchResults[i]))
+            ++_rayMeshHits;
+    }
+
+    // Sweep every body sideways through its neighbors.
+    _endPositions.resize(BODY_COUNT);
+    for (unsigned int i = 0; i < BODY_COUNT; ++i)
+    {
+        _endPositions[i] = _bodies[i]->getNode()->getTranslationWorld() + Vector3(6.0f, -1.0f, 2.0f);
+    }
+
+    start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < BODY_COUNT; ++i)
+    {
+        if (!controller->sweepTest(_bodies[i], _endPositions[i], &_singleResults[i]))
+            _singleResults[i].object = NULL;
+    }
+    _singleSweepTime = Game::getAbsoluteTime() - start;
+
+    start = Game::getAbsoluteTime();
+    _sweepHits = controller->sweepTest(&_bodies[0], &_endPositions[0], BODY_COUNT, &_batchResults[0]);
+    _batchSweepTime = Game::getAbsoluteTime() - start;
+
+    _sweepMismatches = 0;
+    _sweepMeshHits = 0;
+    for (unsigned int i = 0; i < BODY_COUNT; ++i)
+    {
+        if (!hitResultsEqual(_singleResults[i], _batchResults[i]))
+            ++_sweepMismatches;
+        if (hitsMesh(_batchResults[i]))
+            ++_sweepMeshHits;
+    }
+
+    if (_rayMismatches || _sweepMismatches)
+        GP_WARN("Batched physics queries differ from single queries (%u rays, %u sweeps).", _rayMismatches, _sweepMismatches);
+}
+
+void PhysicsBenchmarkSample::runRollback()
+{
+    PhysicsController* controller = getPhysicsController();
+
+    // Simulate the steps once and record where they leave the bodies.
+    double start = Game::getAbsoluteTime();
+    controller->saveSnapshot(&_snapshot);
+    _saveTime = Game::getAbsoluteTime() - start;
+
+    controller->step(ROLLBACK_STEPS);
+
+    // Restoring discards the cached contacts, so re-simulated steps are compared with the first re-simulation.
+    controller->restoreSnapshot(&_snapshot[0], (unsigned int)_snapshot.size());
+    controller->step(ROLLBACK_STEPS);
+    _transforms.resize(BODY_COUNT);
+    for (unsigned int i = 0; i < BODY_COUNT; ++i)
+    {
+        _transforms[i] = _bodies[i]->getNode()->getWorldMatrix();
+    }
+
+    // Roll back and re-simulate the same steps several more times.
+    _rollbackMismatches = 0;
+    start = Game::getAbsoluteTime();
+    for (unsigned int repeat = 0; repeat < ROLLBACK_REPEATS; ++repeat)
+    {
+        controller->restoreSnapshot(&_snapshot[0], (unsigned int)_snapshot.size());
+        controller->step(ROLLBACK_STEPS);
+
+        for (unsigned int i = 0; i < BODY_COUNT; ++i)
+        {
+            if (memcmp(_transforms[i].m, _bodies[i]->getNode()->getWorldMatrix().m, sizeof(_transforms[i].m)) != 0)
+                ++_rollbackMismatches;
+        }
+    }
+    _rollbackTime = (Game::getAbsoluteTime() - start) / ROLLBACK_REPEATS;
+
+    if (_rollbackMismatches)
+        GP_WARN("Re-simulating %u physics steps after a rollback gave %u different body transforms.", ROLLBACK_STEPS, _rollbackMismatches);
+}
+
+void PhysicsBenchmarkSample::runListeners()
+{
+    PhysicsController* controller = getPhysicsController();
+
+    // Wake the pile, so the steps have contacts to update.
+    for (unsigned int i = 0; i < BODY_COUNT; ++i)
+    {
+        static_cast<PhysicsRigidBody*>(_bodies[i])->applyImpulse(Vector3(0.0f, 2.0f, 0.0f));
+    }
+
+    // Both ways of finding the contacts are timed over the same steps.
+    std::vector<unsigned char> snapshot;
+    controller->saveSnapshot(&snapshot);
+
+    // Events derived from the contact manifolds of each step.
+    for (unsigned int i = 0; i < BODY_COUNT; ++i)
+    {
+        _bodies[i]->addCollisionListener(this, _ground);
+    }
+    _manifoldEvents = 0;
+    _manifoldContacts = 0;
+    double start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < LISTENER_STEPS; ++i)
+    {
+        controller->step();
+    }
+    _manifoldTime = (Game::getAbsoluteTime() - start) / LISTENER_STEPS;
+
+    // Removed listeners are notified that their pairs stopped colliding, which is not counted.
+    unsigned int events = _manifoldEvents;
+    unsigned int contacts = _manifoldContacts;
+    for (unsigned int i = 0; i < BODY_COUNT; ++i)
+    {
+        _bodies[i]->removeCollisionListener(this, _ground);
+    }
+    controller->step(0);
+    _manifoldEvents = events;
+    _manifoldContacts = contacts;
+    controller->restoreSnapshot(&snapshot[0], (unsigned int)snapshot.size());
+
+    // Listened pairs tested with contactPairTest after each step, as collision listeners used to.
+    start = Game::getAbsoluteTime();
+    for (unsigned int i = 0; i < LISTENER_STEPS; ++i)
+    {
+        controller->step();
+        _pairTestContacts = 0;
+        for (unsigned int j = 0; j < BODY_COUNT; ++j)
+        {
+            if (_bodies[j]->collidesWith(_ground))
+                ++_pairTestContacts;
+        }
+    }
+    _pairTestTime = (Game::getAbsoluteTime() - start) / LISTENER_STEPS;
+}
+
+void PhysicsBenchmarkSample::collisionEvent(PhysicsCollisionObject::CollisionListener::EventType type,
+                                            const PhysicsCollisionObject::CollisionPair& collisionPair,
+                                            const Vector3& contactPointA, const Vector3& contactPointB)
+{
+    ++_manifoldEvents;
+    if (type == PhysicsCollisionObject::CollisionListener::COLLIDING)
+        ++_manifoldContacts;
+    else if (_manifoldContacts > 0)
+        --_manifoldContacts;
+}
+
+void PhysicsBenchmarkSample::update(float elapsedTime)
+{
+}
+
+void PhysicsBenchmarkSample::render(float elapsedTime)
+{
+    // Clear the color and depth buffers
+    clear(CLEAR_COLOR_DEPTH, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0);
+
+    getPhysicsController()->drawDebug(_scene->getActiveCamera()->getViewProjectionMatrix());
+
+    char buffer[128];
+    _font->start();
+    sprintf(buffer, "%u rays: %.2f ms single, %.2f ms batch, %u hits (%u on meshes), %u mismatches", RAY_COUNT, _singleRayTime, _batchRayTime, _rayHits, _rayMeshHits, _rayMismatches);
+    _font->drawText(buffer, 5, 30, Vector4::one(), _font->getSize());
+    sprintf(buffer, "%u sweeps: %.2f ms single, %.2f ms batch, %u hits (%u on meshes), %u mismatches", BODY_COUNT, _singleSweepTime, _batchSweepTime, _sweepHits, _sweepMeshHits, _sweepMismatches);
+    _font->drawText(buffer, 5, 50, Vector4::one(), _font->getSize());
+    sprintf(buffer, "Rollback of %u steps: %.2f ms save, %.2f ms restore and re-simulate, %u mismatches", ROLLBACK_STEPS, _saveTime, _rollbackTime, _rollbackMismatches);
+    _font->drawText(buffer, 5, 70, Vector4::one(), _font->getSize());
+    sprintf(buffer, "%u listened bodies: %.2f ms per step with manifold events (%u events), %.2f ms with contactPairTest", BODY_COUNT, _manifoldTime, _manifoldEvents, _pairTestTime);
+    _font->drawText(buffer, 5, 90, Vector4::one(), _font->getSize());
+    sprintf(buffer, "Bodies touching the ground: %u from events, %u from contactPairTest", _manifoldContacts, _pairTestContacts);
+    _font->drawText(buffer, 5, 110, Vector4::one(), _font->getSize());
+    _font->finish();
+
+    drawFrameRate(_font, Vector4(0, 0.5f, 1, 1), 5, 1, getFrameRate());
+}
+
+void PhysicsBenchmarkSample::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
+{
+    if (evt == Touch::TOUCH_PRESS)
+    {
+        runQueries();
+        runRollback();
+        runListeners();
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef PHYSICSBENCHMARKSAMPLE_H_
+#define PHYSICSBENCHMARKSAMPLE_H_
+
+#include "gameplay.h"
+#include "Sample.h"
+
+using namespace gameplay;
+
+/**
+ * Sample measuring batched physics queries and snapshot rollback against a world of a
+ * thousand rigid bodies, ringed by a static level of triangle meshes.
+ *
+ * Ten thousand rays and a thousand sweeps are tested one at a time and as a batch, and the
+ * batch results, including the hits on the meshes, are checked against the single queries.
+ * Batches run on several threads when the physics section of game.config sets more than one
+ * thread.
+ *
+ * The simulation is then rolled back eight steps, as a networked game does when a late
+ * input arrives, and re-simulated several times. The transforms after each re-simulation are
+ * checked to be bitwise equal.
+ *
+ * Finally every body listens for collisions with the ground, and the simulation steps with
+ * events derived from the contact manifolds are timed against steps that test each listened
+ * pair with contactPairTest, as collision listeners used to. Touch to run again.
+ */
+class PhysicsBenchmarkSample : public Sample, public PhysicsCollisionObject::CollisionListener
+{
+public:
+
+    PhysicsBenchmarkSample();
+
+    void touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex);
+
+    void collisionEvent(PhysicsCollisionObject::CollisionListener::EventType type,
+                        const PhysicsCollisionObject::CollisionPair& collisionPair,
+                        const Vector3& contactPointA = Vector3::zero(),
+                        const Vector3& contactPointB = Vector3::zero());
+
+protected:
+
+    void initialize();
+
+    void finalize();
+
+    void update(float elapsedTime);
+
+    void render(float elapsedTime);
+
+private:
+
+    void createWorld();
+
+    void runQueries();
+
+    void runRollback();
+
+    void runListeners();
+
+    Font* _font;
+    Scene* _scene;
+    PhysicsCollisionObject* _ground;
+    float _previousTimeStep;
+    std::vector<PhysicsCollisionObject*> _bodies;
+    std::vector<Ray> _rays;
+    std::vector<float> _distances;
+    std::vector<Vector3> _endPositions;
+    std::vector<PhysicsController::HitResult> _singleResults;
+    std::vector<PhysicsController::HitResult> _batchResults;
+    double _singleRayTime;
+    double _batchRayTime;
+    double _singleSweepTime;
+    double _batchSweepTime;
+    unsigned int _rayHits;
+    unsigned int _rayMeshHits;
+    unsigned int _rayMismatches;
+    unsigned int _sweepHits;
+    unsigned int _sweepMeshHits;
+    unsigned int _sweepMismatches;
+    std::vector<unsigned char> _snapshot;
+    std::vector<Matrix> _transforms;
+    double _saveTime;
+    double _rollbackTime;
+    unsigned int _rollbackMismatches;
+    double _manifoldTime;
+    double _pairTestTime;
+    unsigned int _manifoldEvents;
+    unsigned int _manifoldContacts;
+    unsigned int _pairTestContacts;
+};
+
+#endif
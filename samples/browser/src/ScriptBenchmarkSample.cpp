@@ -0,0 +1,160 @@
+#include "ScriptBenchmarkSample.h"
+#include "SamplesGame.h"
+
+#if defined(ADD_SAMPLE)
+    ADD_SAMPLE("Script", "Script Benchmark", ScriptBenchmarkSample, 1);
+#endif
+
+#define CALL_COUNT 100000
+#define ALLOCATION_CALL_COUNT 10000
+#define GC_BUDGET 1.0f
+
+ScriptBenchmarkSample::ScriptBenchmarkSample()
+    : _font(NULL), _nameTime(0), _handleTime(0), _nestedNameTime(0), _nestedHandleTime(0), _callsReceived(false),
+      _allocationCount(0), _allocationBytes(0), _previousGcBudget(0)
+{
+}
+
+void ScriptBenchmarkSample::initialize()
+{
+    // Create the font for drawing the results.
+    _font = Font::create("res/ui/arial.gpb");
+
+    // Collect garbage within a budget at the end of each frame while the sample runs.
+    _previousGcBudget = getScriptController()->getGarbageCollectionBudget();
+    getScriptController()->setGarbageCollectionBudget(GC_BUDGET);
+
+    getScriptController()->loadScript("res/common/benchmark.lua");
+    getScriptController()->loadScript("res/common/microbenchmarks.lua");
+
+    runCallbacks();
+    runAllocations();
+    runMicroBenchmarks();
+}
+
+void ScriptBenchmarkSample::finalize()
+{
+    getScriptController()->setGarbageCollectionBudget(_previousGcBudget);
+    SAFE_RELEASE(_font);
+}
+
+void ScriptBenchmarkSample::runCallbacks()
+{
+    ScriptController* sc = getScriptController();
+    sc->setInt("callCount", 0);
+
+    // Calls by name look up the function and parse the argument signature every time.
+    double start = Game::getAbsoluteTime();
+    for (int i = 0; i < CALL_COUNT; ++i)
+    {
+        sc->executeFunction<void>("benchmarkCallback", "i", 1);
+    }
+    _nameTime = Game::getAbsoluteTime() - start;
+
+    start = Game::getAbsoluteTime();
+    for (int i = 0; i < CALL_COUNT; ++i)
+    {
+        sc->executeFunction<void>("benchmark.callback", "i", 1);
+    }
+    _nestedNameTime = Game::getAbsoluteTime() - start;
+
+    // Calls through a handle resolve the function and its signature once.
+    ScriptFunction callback("benchmarkCallback", "i");
+    start = Game::getAbsoluteTime();
+    for (int i = 0; i < CALL_COUNT; ++i)
+    {
+        sc->executeFunction<void>(&callback, 1);
+    }
+    _handleTime = Game::getAbsoluteTime() - start;
+
+    ScriptFunction nestedCallback("benchmark.callback", "i");
+    start = Game::getAbsoluteTime();
+    for (int i = 0; i < CALL_COUNT; ++i)
+    {
+        sc->executeFunction<void>(&nestedCallback, 1);
+    }
+    _nestedHandleTime = Game::getAbsoluteTime() - start;
+
+    _callsReceived = sc->getInt("callCount") == CALL_COUNT * 4;
+    if (!_callsReceived)
+        GP_WARN("Script benchmark callbacks were called %d times instead of %d.", sc->getInt("callCount"), CALL_COUNT * 4);
+}
+
+void ScriptBenchmarkSample::runAllocations()
+{
+    // The garbage collection budget keeps the collector from running during the calls, so the
+    // growth in memory use is the memory allocated by them.
+    ScriptController* sc = getScriptController();
+    ScriptController::GarbageCollectionStats before;
+    sc->getGarbageCollectionStats(&before);
+    sc->executeFunction<void>("benchmarkTranslationWorld", "i", ALLOCATION_CALL_COUNT);
+    ScriptController::GarbageCollectionStats after;
+    sc->getGarbageCollectionStats(&after);
+
+    _allocationCount = after.allocationCount - before.allocationCount;
+    _allocationBytes = after.memoryUsage > before.memoryUsage ? after.memoryUsage - before.memoryUsage : 0;
+}
+
+void ScriptBenchmarkSample::runMicroBenchmarks()
+{
+    // The results come back as one line per benchmark.
+    std::string results = getScriptController()->executeFunction<std::string>("runMicroBenchmarks");
+    _microBenchmarks.clear();
+    size_t start = 0;
+    while (start < results.size())
+    {
+        size_t end = results.find('\n', start);
+        if (end == std::string::npos)
+            end = results.size();
+        _microBenchmarks.push_back(results.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+void ScriptBenchmarkSample::update(float elapsedTime)
+{
+}
+
+void ScriptBenchmarkSample::render(float elapsedTime)
+{
+    // Clear the color and depth buffers
+    clear(CLEAR_COLOR_DEPTH, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0);
+
+    char buffer[128];
+    _font->start();
+    sprintf(buffer, "%u calls to benchmarkCallback: %.2f ms by name, %.2f ms by handle", CALL_COUNT, _nameTime, _handleTime);
+    _font->drawText(buffer, 5, 30, Vector4::one(), _font->getSize());
+    sprintf(buffer, "%u calls to benchmark.callback: %.2f ms by name, %.2f ms by handle", CALL_COUNT, _nestedNameTime, _nestedHandleTime);
+    _font->drawText(buffer, 5, 50, Vector4::one(), _font->getSize());
+    if (!_callsReceived)
+        _font->drawText("Not every call reached the script", 5, 70, Vector4(1, 0, 0, 1), _font->getSize());
+
+    sprintf(buffer, "%u calls to Node:getTranslationWorld: %u Lua allocations, %.1f bytes per call", ALLOCATION_CALL_COUNT,
+        _allocationCount, (float)_allocationBytes / ALLOCATION_CALL_COUNT);
+    _font->drawText(buffer, 5, 90, Vector4::one(), _font->getSize());
+
+    int y = 120;
+    for (size_t i = 0, count = _microBenchmarks.size(); i < count; ++i, y += 20)
+    {
+        _font->drawText(_microBenchmarks[i].c_str(), 5, y, Vector4::one(), _font->getSize());
+    }
+
+    ScriptController::GarbageCollectionStats stats;
+    getScriptController()->getGarbageCollectionStats(&stats);
+    sprintf(buffer, "Lua memory: %u KB, GC cycles: %u, GC this frame: %u steps, %.2f ms (max %.2f ms)",
+        (unsigned int)(stats.memoryUsage / 1024), stats.cycleCount, stats.frameStepCount, stats.frameTime, stats.maxFrameTime);
+    _font->drawText(buffer, 5, y + 10, Vector4::one(), _font->getSize());
+    _font->finish();
+
+    drawFrameRate(_font, Vector4(0, 0.5f, 1, 1), 5, 1, getFrameRate());
+}
+
+void ScriptBenchmarkSample::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
+{
+    if (evt == Touch::TOUCH_PRESS)
+    {
+        runCallbacks();
+        runAllocations();
+        runMicroBenchmarks();
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef SCRIPTBENCHMARKSAMPLE_H_
+#define SCRIPTBENCHMARKSAMPLE_H_
+
+#include "gameplay.h"
+#include "Sample.h"
+
+using namespace gameplay;
+
+/**
+ * Sample measuring the cost of calling Lua functions from C++ and of common script operations.
+ *
+ * A hundred thousand calls are made to a global function and to a function in a table,
+ * first by name, which looks the function up and parses its argument signature on every
+ * call, and then through a ScriptFunction handle, which resolves both once.
+ *
+ * The Lua allocations and memory made by ten thousand calls to Node:getTranslationWorld(),
+ * which returns a Vector3 by value, are counted to check the cost of the binding layer.
+ *
+ * The micro-benchmarks in res/common/microbenchmarks.lua are then run, and shown along with
+ * the statistics of the garbage collector, which the sample gives a budget of one millisecond
+ * per frame. The same script can be run headless by a stand-alone Lua or LuaJIT interpreter.
+ * Touch to run again.
+ */
+class ScriptBenchmarkSample : public Sample
+{
+public:
+
+    ScriptBenchmarkSample();
+
+    void touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex);
+
+protected:
+
+    void initialize();
+
+    void finalize();
+
+    void update(float elapsedTime);
+
+    void render(float elapsedTime);
+
+private:
+
+    void runCallbacks();
+
+    void runAllocations();
+
+    void runMicroBenchmarks();
+
+    Font* _font;
+    double _nameTime;
+    double _handleTime;
+    double _nestedNameTime;
+    double _nestedHandleTime;
+    bool _callsReceived;
+    unsigned int _allocationCount;
+    size_t _allocationBytes;
+    float _previousGcBudget;
+    std::vector<std::string> _microBenchmarks;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "SpriteBenchmarkSample.h"
+#include "SamplesGame.h"
+
+#if defined(ADD_SAMPLE)
+    ADD_SAMPLE("Graphics", "Sprite Benchmark", SpriteBenchmarkSample, 15);
+#endif
+
+#define SPRITE_COUNT 200000
+#define SPRITE_SIZE 8.0f
+#define ANGULAR_SPEED 0.002f
+#define AVERAGE_FRAMES 60
+
+SpriteBenchmarkSample::SpriteBenchmarkSample()
+    : _font(NULL), _spriteBatch(NULL), _bulkDraw(true), _drawTime(0), _drawFrames(0), _averageDrawTime(0)
+{
+}
+
+void SpriteBenchmarkSample::initialize()
+{
+    // Create the font for drawing the results.
+    _font = Font::create("res/ui/arial.gpb");
+
+    _spriteBatch = SpriteBatch::create("res/png/logo.png", NULL, SPRITE_COUNT);
+
+    // Scatter the sprites over the screen with random velocities, rotations and tints.
+    _sprites.resize(SPRITE_COUNT);
+    _velocities.resize(SPRITE_COUNT);
+    _angles.resize(SPRITE_COUNT);
+    for (unsigned int i = 0; i < SPRITE_COUNT; ++i)
+    {
+        SpriteBatch::SpriteInstance& s = _sprites[i];
+        s.x = MATH_RANDOM_0_1() * getWidth();
+        s.y = MATH_RANDOM_0_1() * getHeight();
+        s.z = 0;
+        s.width = SPRITE_SIZE;
+        s.height = SPRITE_SIZE;
+        s.originX = 0.5f;
+        s.originY = 0.5f;
+        s.u1 = 0;
+        s.v1 = 1;
+        s.u2 = 1;
+        s.v2 = 0;
+        s.r = 0.5f + 0.5f * MATH_RANDOM_0_1();
+        s.g = 0.5f + 0.5f * MATH_RANDOM_0_1();
+        s.b = 0.5f + 0.5f * MATH_RANDOM_0_1();
+        s.a = 1;
+        _velocities[i].set(MATH_RANDOM_MINUS1_1() * 0.1f, MATH_RANDOM_MINUS1_1() * 0.1f);
+        _angles[i] = MATH_RANDOM_0_1() * MATH_PIX2;
+    }
+}
+
+void SpriteBenchmarkSample::finalize()
+{
+    SAFE_DELETE(_spriteBatch);
+    SAFE_RELEASE(_font);
+}
+
+void SpriteBenchmarkSample::update(float elapsedTime)
+{
+    // Move and rotate every sprite, wrapping around the edges of the screen.
+    const float width = (float)getWidth();
+    const float height = (float)getHeight();
+    const float rotation = ANGULAR_SPEED * elapsedTime;
+    for (unsigned int i = 0; i < SPRITE_COUNT; ++i)
+    {
+        SpriteBatch::SpriteInstance& s = _sprites[i];
+        s.x += _velocities[i].x * elapsedTime;
+        s.y += _velocities[i].y * elapsedTime;
+        if (s.x < 0)
+            s.x += width;
+        else if (s.x > width)
+            s.x -= width;
+        if (s.y < 0)
+            s.y += height;
+        else if (s.y > height)
+            s.y -= height;
+
+        _angles[i] += rotation;
+        s.rotationCos = cos(_angles[i]);
+        s.rotationSin = sin(_angles[i]);
+    }
+}
+
+void SpriteBenchmarkSample::render(float elapsedTime)
+{
+    // Clear the color and depth buffers
+    clear(CLEAR_COLOR_DEPTH, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0);
+
+    double start = Game::getAbsoluteTime();
+    _spriteBatch->start();
+    if (_bulkDraw)
+    {
+        _spriteBatch->draw(&_sprites[0], SPRITE_COUNT);
+    }
+    else
+    {
+        const Vector2 center(0.5f, 0.5f);
+        for (unsigned int i = 0; i < SPRITE_COUNT; ++i)
+        {
+            const SpriteBatch::SpriteInstance& s = _sprites[i];
+            _spriteBatch->draw(s.x, s.y, s.z, s.width, s.height, s.u1, s.v1, s.u2, s.v2, Vector4(s.r, s.g, s.b, s.a), center, _angles[i]);
+        }
+    }
+    _spriteBatch->finish();
+
+    // Average the time over a number of frames so that it can be read.
+    _drawTime += Game::getAbsoluteTime() - start;
+    if (++_drawFrames == AVERAGE_FRAMES)
+    {
+        _averageDrawTime = _drawTime / AVERAGE_FRAMES;
+        _drawTime = 0;
+        _drawFrames = 0;
+    }
+
+    char buffer[128];
+    _font->start();
+    sprintf(buffer, "%u sprites drawn %s: %.2f ms per frame", SPRITE_COUNT, _bulkDraw ? "in bulk" : "one at a time", _averageDrawTime);
+    _font->drawText(buffer, 5, 30, Vector4::one(), _font->getSize());
+    _font->finish();
+
+    drawFrameRate(_font, Vector4(0, 0.5f, 1, 1), 5, 1, getFrameRate());
+}
+
+void SpriteBenchmarkSample::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
+{
+    if (evt == Touch::TOUCH_PRESS)
+    {
+        _bulkDraw = !_bulkDraw;
+        _drawTime = 0;
+        _drawFrames = 0;
+        _averageDrawTime = 0;
+    }
+}
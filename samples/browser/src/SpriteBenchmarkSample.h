@@ -0,0 +1,48 @@
+#ifndef SPRITEBENCHMARKSAMPLE_H_
+#define SPRITEBENCHMARKSAMPLE_H_
+
+#include "gameplay.h"
+#include "Sample.h"
+
+using namespace gameplay;
+
+/**
+ * Sample measuring the cost of drawing a large number of moving, rotating sprites.
+ *
+ * Two hundred thousand sprites are drawn every frame, either with one call to the bulk
+ * SpriteBatch::draw method or with one call per sprite to the rotated draw method. The
+ * average CPU time spent submitting the sprites and finishing the batch is shown for the
+ * current method. Touch to switch between the two methods.
+ */
+class SpriteBenchmarkSample : public Sample
+{
+public:
+
+    SpriteBenchmarkSample();
+
+    void touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex);
+
+protected:
+
+    void initialize();
+
+    void finalize();
+
+    void update(float elapsedTime);
+
+    void render(float elapsedTime);
+
+private:
+
+    Font* _font;
+    SpriteBatch* _spriteBatch;
+    std::vector<SpriteBatch::SpriteInstance> _sprites;
+    std::vector<Vector2> _velocities;
+    std::vector<float> _angles;
+    bool _bulkDraw;
+    double _drawTime;
+    unsigned int _drawFrames;
+    double _averageDrawTime;
+};
+
+#endif
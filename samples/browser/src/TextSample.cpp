@@ -27,7 +27,7 @@ std::string _fontFiles[] =
 
 TextSample::TextSample()
     : _form(NULL), _stateBlock(NULL), _size(18), _wrap(true), _ignoreClip(false), _useViewport(true), _rightToLeft(false), _simple(false), _alignment(Font::ALIGN_LEFT),
-      _fontsCount(FONT_COUNT), _fontIndex(0), _font(NULL), _viewport(250, 100, 512, 200)
+      _fontsCount(FONT_COUNT), _fontIndex(0), _font(NULL), _viewport(250, 100, 512, 200), _glyphRunHits(0)
 {
 }
 
@@ -104,6 +104,15 @@ void TextSample::render(float elapsedTime)
     _fonts[0]->start();
 
     _fonts[0]->drawText(fps, 245, 5, Vector4(0, 0.5f, 1, 1), _size);
+
+    // Draw how often measurements are answered from the font's glyph run cache, and how many
+    // measurements of the previous frame did not have to look up glyphs.
+    unsigned int hits, misses;
+    _font->getGlyphRunCacheStats(&hits, &misses);
+    char cacheStats[64];
+    sprintf(cacheStats, "Glyph run cache: %u%% hits, %u saved per frame", (hits * 100) / std::max(hits + misses, 1u), hits - _glyphRunHits);
+    _glyphRunHits = hits;
+    _fonts[0]->drawText(cacheStats, 300, 5, Vector4(0, 0.5f, 1, 1), _size);
     
     if (_font != _fonts[0])
         _font->start();
@@ -165,6 +174,8 @@ void TextSample::controlEvent(Control* control, EventType evt)
             _fontIndex = 0;
         }
         _font = _fonts[_fontIndex];
+        unsigned int misses;
+        _font->getGlyphRunCacheStats(&_glyphRunHits, &misses);
         std::string s = "Font (" + _fontNames[_fontIndex] + ")";
         static_cast<Button*>(control)->setText(s.c_str());
     }
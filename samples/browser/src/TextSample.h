@@ -42,6 +42,7 @@ private:
     Font* _font;
     Rectangle _viewport;
     std::string _sampleString;
+    unsigned int _glyphRunHits;
 
 };
 
@@ -0,0 +1,193 @@
+#include "TestUtil.h"
+#include "GlyphAtlas.h"
+
+using namespace gameplay;
+
+static const unsigned int ATLAS_SIZE = 64;
+static const unsigned int GLYPH_SIZE = 15; // 16 pixels with the default padding
+static const unsigned int SMALL_GLYPH_SIZE = 7; // 8 pixels with the default padding
+
+/**
+ * Determines if two regions overlap, including the padding to their right and below them.
+ */
+static bool overlaps(const GlyphAtlas::Region& a, const GlyphAtlas::Region& b)
+{
+    return a.x < b.x + b.width + 1 && b.x < a.x + a.width + 1 &&
+           a.y < b.y + b.height + 1 && b.y < a.y + a.height + 1;
+}
+
+/**
+ * Fills an atlas with a grid of same sized glyphs, using codes starting at zero.
+ */
+static void fill(GlyphAtlas* atlas)
+{
+    const unsigned int count = (ATLAS_SIZE / (GLYPH_SIZE + 1)) * (ATLAS_SIZE / (GLYPH_SIZE + 1));
+    for (unsigned int code = 0; code < count; ++code)
+    {
+        TEST_CHECK(atlas->insert(code, GLYPH_SIZE, GLYPH_SIZE) >= 0);
+    }
+}
+
+/**
+ * Glyphs are packed left to right into shelves, and go into the shortest shelf they fit in.
+ */
+static void testShelfPacking()
+{
+    GlyphAtlas atlas(ATLAS_SIZE, ATLAS_SIZE);
+
+    // The first four glyphs fill the first shelf.
+    std::vector<GlyphAtlas::Region> regions;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        int index = atlas.insert('a' + i, GLYPH_SIZE, GLYPH_SIZE);
+        TEST_CHECK(index >= 0);
+        const GlyphAtlas::Region& region = atlas.getRegion(index);
+        TEST_CHECK(region.x == i * (GLYPH_SIZE + 1));
+        TEST_CHECK(region.y == 0);
+        TEST_CHECK(region.width == GLYPH_SIZE);
+        TEST_CHECK(region.height == GLYPH_SIZE);
+        regions.push_back(region);
+    }
+
+    // A small glyph starts a second, shorter shelf below the full one.
+    int small1 = atlas.insert('e', SMALL_GLYPH_SIZE, SMALL_GLYPH_SIZE);
+    TEST_CHECK(small1 >= 0);
+    TEST_CHECK(atlas.getRegion(small1).x == 0);
+    TEST_CHECK(atlas.getRegion(small1).y == GLYPH_SIZE + 1);
+    regions.push_back(atlas.getRegion(small1));
+
+    // A large glyph does not fit the short shelf, so it starts a third one.
+    int large = atlas.insert('f', GLYPH_SIZE, GLYPH_SIZE);
+    TEST_CHECK(large >= 0);
+    TEST_CHECK(atlas.getRegion(large).x == 0);
+    TEST_CHECK(atlas.getRegion(large).y == GLYPH_SIZE + 1 + SMALL_GLYPH_SIZE + 1);
+    regions.push_back(atlas.getRegion(large));
+
+    // Another small glyph prefers the short shelf over the tall one that has room.
+    int small2 = atlas.insert('g', SMALL_GLYPH_SIZE, SMALL_GLYPH_SIZE);
+    TEST_CHECK(small2 >= 0);
+    TEST_CHECK(atlas.getRegion(small2).x == SMALL_GLYPH_SIZE + 1);
+    TEST_CHECK(atlas.getRegion(small2).y == GLYPH_SIZE + 1);
+    regions.push_back(atlas.getRegion(small2));
+
+    TEST_CHECK(atlas.getGlyphCount() == 7);
+    TEST_CHECK(atlas.getEvictionCount() == 0);
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        TEST_CHECK(regions[i].x + regions[i].width <= ATLAS_SIZE);
+        TEST_CHECK(regions[i].y + regions[i].height <= ATLAS_SIZE);
+        for (size_t j = i + 1; j < regions.size(); ++j)
+        {
+            TEST_CHECK(!overlaps(regions[i], regions[j]));
+        }
+    }
+
+    // Glyphs that can never fit are rejected without evicting anything.
+    TEST_CHECK(atlas.insert('h', ATLAS_SIZE, 1) == -1);
+    TEST_CHECK(atlas.insert('h', 1, ATLAS_SIZE) == -1);
+    TEST_CHECK(atlas.getGlyphCount() == 7);
+    TEST_CHECK(atlas.getEvictionCount() == 0);
+}
+
+/**
+ * When the atlas is full, the least recently used glyph is evicted and its region reused.
+ */
+static void testEviction()
+{
+    GlyphAtlas atlas(ATLAS_SIZE, ATLAS_SIZE);
+    fill(&atlas);
+    const unsigned int count = atlas.getGlyphCount();
+    TEST_CHECK(count == 16);
+
+    // Using the oldest glyph makes the second oldest the least recently used.
+    TEST_CHECK(atlas.find(0) >= 0);
+    const GlyphAtlas::Region evictedRegion = atlas.getRegion(atlas.find(1));
+    atlas.find(0);
+    for (unsigned int code = 2; code < count; ++code)
+    {
+        atlas.find(code);
+    }
+
+    int index = atlas.insert(100, GLYPH_SIZE, GLYPH_SIZE);
+    TEST_CHECK(index >= 0);
+    TEST_CHECK(atlas.getEvictionCount() == 1);
+    TEST_CHECK(atlas.getGlyphCount() == count);
+    TEST_CHECK(atlas.find(1) == -1);
+    TEST_CHECK(atlas.find(0) >= 0);
+    TEST_CHECK(atlas.getRegion(index).x == evictedRegion.x);
+    TEST_CHECK(atlas.getRegion(index).y == evictedRegion.y);
+
+    // A glyph twice as wide needs two neighbouring regions, so glyphs are evicted until a
+    // whole shelf is free.
+    TEST_CHECK(atlas.insert(101, GLYPH_SIZE * 2 + 1, GLYPH_SIZE) >= 0);
+    TEST_CHECK(atlas.getGlyphCount() < count);
+    TEST_CHECK(atlas.find(101) >= 0);
+
+    atlas.clear();
+    TEST_CHECK(atlas.getGlyphCount() == 0);
+    TEST_CHECK(atlas.find(0) == -1);
+    fill(&atlas);
+    TEST_CHECK(atlas.getGlyphCount() == count);
+}
+
+/**
+ * Glyphs that remain in the atlas after others are evicted keep their codes and regions.
+ */
+static void testLookupAfterEviction()
+{
+    GlyphAtlas atlas(ATLAS_SIZE, ATLAS_SIZE);
+    fill(&atlas);
+    const unsigned int count = atlas.getGlyphCount();
+
+    std::vector<GlyphAtlas::Region> regions(count);
+    for (unsigned int code = 0; code < count; ++code)
+    {
+        regions[code] = atlas.getRegion(atlas.find(code));
+    }
+
+    // Touching the glyphs in order leaves the first four as the least recently used.
+    const unsigned int evicted = 4;
+    for (unsigned int i = 0; i < evicted; ++i)
+    {
+        TEST_CHECK(atlas.insert(1000 + i, GLYPH_SIZE, GLYPH_SIZE) >= 0);
+    }
+    TEST_CHECK(atlas.getEvictionCount() == evicted);
+
+    for (unsigned int code = 0; code < count; ++code)
+    {
+        int index = atlas.find(code);
+        if (code < evicted)
+        {
+            TEST_CHECK(index == -1);
+            continue;
+        }
+
+        TEST_CHECK(index >= 0);
+        if (index >= 0)
+        {
+            TEST_CHECK(atlas.getCode(index) == code);
+            TEST_CHECK(atlas.getRegion(index).x == regions[code].x);
+            TEST_CHECK(atlas.getRegion(index).y == regions[code].y);
+        }
+    }
+
+    // The new glyphs reuse the regions of the evicted ones.
+    for (unsigned int i = 0; i < evicted; ++i)
+    {
+        int index = atlas.find(1000 + i);
+        TEST_CHECK(index >= 0);
+        if (index >= 0)
+        {
+            TEST_CHECK(atlas.getCode(index) == 1000 + i);
+            TEST_CHECK(atlas.getRegion(index).y == regions[i].y);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testShelfPacking();
+    testEviction();
+    testLookupAfterEviction();
+    return TEST_RESULT();
+}
@@ -0,0 +1,79 @@
+#ifndef HEADLESSGAME_H_
+#define HEADLESSGAME_H_
+
+#include "Game.h"
+#include "PhysicsController.h"
+
+namespace gameplay
+{
+
+/**
+ * A game without a window, graphics or audio, used by the headless tests of engine systems.
+ *
+ * Only one game can exist at a time, so tests that need different settings restart the
+ * systems they use instead of creating another game.
+ */
+class HeadlessGame : public Game
+{
+public:
+
+    HeadlessGame()
+    {
+    }
+
+    ~HeadlessGame()
+    {
+        stopPhysics();
+        SAFE_DELETE(_properties);
+    }
+
+    /**
+     * Creates the physics controller, replacing any existing one.
+     *
+     * @param configPath The path of a game config to read the physics settings from, or NULL to use the defaults.
+     */
+    void startPhysics(const char* configPath = NULL)
+    {
+        stopPhysics();
+        SAFE_DELETE(_properties);
+        if (configPath)
+            _properties = Properties::create(configPath);
+
+        _physicsController = new PhysicsController();
+        _physicsController->initialize();
+    }
+
+    /**
+     * Destroys the physics controller. All collision objects must have been released.
+     */
+    void stopPhysics()
+    {
+        if (_physicsController)
+        {
+            _physicsController->finalize();
+            SAFE_DELETE(_physicsController);
+        }
+    }
+
+protected:
+
+    void initialize()
+    {
+    }
+
+    void finalize()
+    {
+    }
+
+    void update(float elapsedTime)
+    {
+    }
+
+    void render(float elapsedTime)
+    {
+    }
+};
+
+}
+
+#endif
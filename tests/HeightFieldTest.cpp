@@ -0,0 +1,149 @@
+#include "TestUtil.h"
+#include "HeightField.h"
+
+using namespace gameplay;
+
+static const unsigned int SIZE = 257;
+
+/**
+ * Writes a RAW heightmap with the given number of bits per sample.
+ */
+static bool writeRaw(const char* path, const unsigned short* values, unsigned int count, unsigned int bits)
+{
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL)
+        return false;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (bits == 16)
+        {
+            fputc(values[i] & 0xff, fp);
+            fputc(values[i] >> 8, fp);
+        }
+        else
+        {
+            fputc(values[i] & 0xff, fp);
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+/**
+ * Quantizing keeps every height within half a step of its original value, and halves the memory used.
+ */
+static void testQuantizeErrorBound()
+{
+    HeightField* heightfield = HeightField::create(SIZE, SIZE);
+    float* heights = heightfield->getArray();
+    std::vector<float> original(SIZE * SIZE);
+    srand(1);
+    for (unsigned int i = 0; i < SIZE * SIZE; ++i)
+    {
+        heights[i] = original[i] = -50.0f + 250.0f * (rand() / (float)RAND_MAX);
+    }
+    const float minHeight = *std::min_element(original.begin(), original.end());
+    const float maxHeight = *std::max_element(original.begin(), original.end());
+
+    const size_t floatSize = heightfield->getMemoryUsage();
+    TEST_CHECK(floatSize == SIZE * SIZE * sizeof(float));
+
+    heightfield->quantize();
+    TEST_CHECK(heightfield->isQuantized());
+    TEST_CHECK(heightfield->getArray() == NULL);
+    TEST_CHECK(heightfield->getQuantizedArray() != NULL);
+    TEST_CHECK(heightfield->getMemoryUsage() * 2 == floatSize);
+    TEST_CHECK(heightfield->getQuantizedMin() == minHeight);
+
+    const float step = heightfield->getQuantizedStep();
+    TEST_CHECK(fabs(step - (maxHeight - minHeight) / 65535.0f) <= 1e-6f);
+
+    // Allow for the float rounding of the dequantized value on top of the quantization error.
+    const float bound = step * 0.5f + (maxHeight - minHeight) * 1e-6f;
+    float maxError = 0.0f;
+    for (unsigned int z = 0; z < SIZE; ++z)
+    {
+        for (unsigned int x = 0; x < SIZE; ++x)
+        {
+            float error = fabs(heightfield->getHeight((float)x, (float)z) - original[x + z * SIZE]);
+            maxError = std::max(maxError, error);
+        }
+    }
+    TEST_CHECK(maxError <= bound);
+    printf("Quantized %ux%u heights: %u -> %u bytes, max error %g (bound %g)\n",
+        SIZE, SIZE, (unsigned int)floatSize, (unsigned int)heightfield->getMemoryUsage(), maxError, step * 0.5f);
+
+    // Batched queries interpolate quantized values the same way as single queries.
+    Vector2 points[5] = { Vector2(0.5f, 0.5f), Vector2(10.25f, 3.75f), Vector2(-4.0f, 7.0f), Vector2(255.9f, 255.9f), Vector2(128.0f, 64.5f) };
+    float batch[5];
+    heightfield->getHeights(points, batch, 5);
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        TEST_CHECK(fabs(batch[i] - heightfield->getHeight(points[i].x, points[i].y)) <= bound);
+    }
+
+    SAFE_RELEASE(heightfield);
+}
+
+/**
+ * RAW8 and RAW16 heights are stored quantized without any loss.
+ */
+static void testRawIsLossless()
+{
+    std::vector<unsigned short> values(SIZE * SIZE);
+    srand(2);
+    for (unsigned int i = 0; i < SIZE * SIZE; ++i)
+    {
+        values[i] = (unsigned short)(rand() & 0xffff);
+    }
+
+    const unsigned int bits[2] = { 16, 8 };
+    const char* paths[2] = { "heightfieldtest16.r16", "heightfieldtest8.raw" };
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        const unsigned int maxValue = bits[i] == 16 ? 65535 : 255;
+        TEST_CHECK(writeRaw(paths[i], &values[0], SIZE * SIZE, bits[i]));
+
+        HeightField* heightfield = HeightField::createFromRAW(paths[i], SIZE, SIZE, 10.0f, 20.0f, true);
+        TEST_CHECK(heightfield != NULL);
+        if (heightfield)
+        {
+            TEST_CHECK(heightfield->isQuantized());
+            TEST_CHECK(heightfield->getMemoryUsage() == SIZE * SIZE * sizeof(unsigned short));
+
+            const unsigned short* quantized = heightfield->getQuantizedArray();
+            const unsigned int scale = 65535 / maxValue;
+            unsigned int mismatches = 0;
+            for (unsigned int j = 0; j < SIZE * SIZE; ++j)
+            {
+                if (quantized[j] != (values[j] & maxValue) * scale)
+                    ++mismatches;
+            }
+            TEST_CHECK(mismatches == 0);
+            SAFE_RELEASE(heightfield);
+        }
+
+        // Tiled heightfields keep the quantized storage for the tiles they load.
+        HeightField* tiled = HeightField::createTiled(paths[i], SIZE, SIZE, 32, 10.0f, 20.0f, true);
+        TEST_CHECK(tiled != NULL);
+        if (tiled)
+        {
+            TEST_CHECK(tiled->isTiled());
+            TEST_CHECK(tiled->isQuantized());
+            TEST_CHECK(tiled->getQuantizedArray() == NULL);
+            TEST_CHECK(tiled->getQuantizedStep() == 10.0f / 65535);
+            TEST_CHECK(tiled->getMemoryUsage() == 0);
+            SAFE_RELEASE(tiled);
+        }
+
+        remove(paths[i]);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testQuantizeErrorBound();
+    testRawIsLossless();
+    return TEST_RESULT();
+}
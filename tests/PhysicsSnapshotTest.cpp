@@ -0,0 +1,103 @@
+#include "TestUtil.h"
+#include "HeadlessGame.h"
+#include "Scene.h"
+#include "PhysicsRigidBody.h"
+
+using namespace gameplay;
+
+static const unsigned int STACK_ROWS = 4;
+static const unsigned int STACK_HEIGHT = 4;
+static const unsigned int STEPS = 8;
+
+/**
+ * Creates leaning stacks of boxes on a static ground box, and returns the nodes of the boxes.
+ */
+static Scene* createScene(std::vector<Node*>* boxes)
+{
+    Scene* scene = Scene::create();
+
+    Node* ground = scene->addNode("ground");
+    ground->setTranslation(0.0f, -0.5f, 0.0f);
+    PhysicsRigidBody::Parameters groundParameters(0.0f);
+    ground->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::box(Vector3(40.0f, 1.0f, 40.0f)), &groundParameters);
+
+    // Each box is offset from the one below it, so the stacks topple into each other.
+    PhysicsRigidBody::Parameters parameters(1.0f);
+    for (unsigned int i = 0; i < STACK_ROWS * STACK_ROWS * STACK_HEIGHT; ++i)
+    {
+        unsigned int level = i / (STACK_ROWS * STACK_ROWS);
+        Node* node = scene->addNode();
+        node->setTranslation((i % STACK_ROWS) * 1.5f + level * 0.3f, 0.5f + level * 1.05f, ((i / STACK_ROWS) % STACK_ROWS) * 1.5f + level * 0.2f);
+        node->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::box(Vector3::one()), &parameters);
+        boxes->push_back(node);
+    }
+
+    return scene;
+}
+
+/**
+ * Checks that the transforms of the boxes are bitwise equal to the given transforms.
+ */
+static void checkTransforms(const std::vector<Node*>& boxes, const std::vector<Matrix>& transforms)
+{
+    unsigned int mismatches = 0;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        if (memcmp(boxes[i]->getWorldMatrix().m, transforms[i].m, sizeof(transforms[i].m)) != 0)
+            ++mismatches;
+    }
+    TEST_CHECK(mismatches == 0);
+}
+
+/**
+ * Stepping from a restored snapshot gives bitwise identical transforms every time, and saving
+ * snapshots between the steps does not change them.
+ */
+static void testSnapshotDeterminism()
+{
+    PhysicsController* controller = Game::getInstance()->getPhysicsController();
+    controller->setFixedTimeStep(1.0f / 60.0f);
+
+    std::vector<Node*> boxes;
+    Scene* scene = createScene(&boxes);
+
+    // Let the stacks settle onto the ground and start toppling, so the steps have contacts to solve.
+    controller->step(30);
+
+    std::vector<unsigned char> snapshot;
+    controller->saveSnapshot(&snapshot);
+    TEST_CHECK(snapshot.size() > 0);
+
+    TEST_CHECK(controller->restoreSnapshot(&snapshot[0], (unsigned int)snapshot.size()));
+    controller->step(STEPS);
+    std::vector<Matrix> transforms(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        transforms[i] = boxes[i]->getWorldMatrix();
+    }
+
+    // Re-simulate the same steps.
+    TEST_CHECK(controller->restoreSnapshot(&snapshot[0], (unsigned int)snapshot.size()));
+    controller->step(STEPS);
+    checkTransforms(boxes, transforms);
+
+    // Re-simulate them again, saving a snapshot before every step.
+    TEST_CHECK(controller->restoreSnapshot(&snapshot[0], (unsigned int)snapshot.size()));
+    std::vector<unsigned char> other;
+    for (unsigned int i = 0; i < STEPS; ++i)
+    {
+        controller->saveSnapshot(&other);
+        controller->step();
+    }
+    checkTransforms(boxes, transforms);
+
+    SAFE_RELEASE(scene);
+}
+
+int main(int argc, char** argv)
+{
+    HeadlessGame game;
+    game.startPhysics();
+    testSnapshotDeterminism();
+    return TEST_RESULT();
+}
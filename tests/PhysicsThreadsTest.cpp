@@ -0,0 +1,121 @@
+#include "TestUtil.h"
+#include "HeadlessGame.h"
+#include "Scene.h"
+#include "PhysicsRigidBody.h"
+#include "Thread.h"
+
+using namespace gameplay;
+
+static const unsigned int STACK_ROWS = 10;
+static const unsigned int STACK_HEIGHT = 10;
+static const unsigned int STEPS = 100;
+static const char* CONFIG_PATH = "PhysicsThreadsTest.config";
+
+/**
+ * Creates a grid of box stacks on a static ground box, and returns the nodes of the boxes.
+ */
+static Scene* createScene(std::vector<Node*>* boxes)
+{
+    Scene* scene = Scene::create();
+
+    Node* ground = scene->addNode("ground");
+    ground->setTranslation(0.0f, -0.5f, 0.0f);
+    PhysicsRigidBody::Parameters groundParameters(0.0f);
+    ground->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::box(Vector3(100.0f, 1.0f, 100.0f)), &groundParameters);
+
+    // Alternate boxes are offset a little, so the stacks keep moving and contacts change every step.
+    PhysicsRigidBody::Parameters parameters(1.0f);
+    for (unsigned int i = 0; i < STACK_ROWS * STACK_ROWS * STACK_HEIGHT; ++i)
+    {
+        unsigned int level = i / (STACK_ROWS * STACK_ROWS);
+        float offset = (level % 2) * 0.2f;
+        Node* node = scene->addNode();
+        node->setTranslation((i % STACK_ROWS) * 1.2f + offset, 0.5f + level * 1.01f, ((i / STACK_ROWS) % STACK_ROWS) * 1.2f + offset);
+        node->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::box(Vector3::one()), &parameters);
+        boxes->push_back(node);
+    }
+
+    return scene;
+}
+
+/**
+ * Steps the stacked boxes with contacts computed on the given number of threads.
+ *
+ * Returns the time per step, in milliseconds, and the final box transforms.
+ */
+static double simulate(HeadlessGame* game, unsigned int threadCount, std::vector<Matrix>* transforms)
+{
+    FILE* fp = fopen(CONFIG_PATH, "w");
+    TEST_CHECK(fp != NULL);
+    if (fp == NULL)
+        return 0;
+    fprintf(fp, "physics\n{\n    threads = %u\n}\n", threadCount);
+    fclose(fp);
+    game->startPhysics(CONFIG_PATH);
+    remove(CONFIG_PATH);
+
+    PhysicsController* controller = game->getPhysicsController();
+    controller->setFixedTimeStep(1.0f / 60.0f);
+
+    std::vector<Node*> boxes;
+    Scene* scene = createScene(&boxes);
+
+    double start = Game::getAbsoluteTime();
+    controller->step(STEPS);
+    double time = (Game::getAbsoluteTime() - start) / STEPS;
+
+    // The stacks may topple, but no box may fall through the ground or another box.
+    transforms->resize(boxes.size());
+    unsigned int sunk = 0;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        (*transforms)[i] = boxes[i]->getWorldMatrix();
+        if (boxes[i]->getTranslationWorld().y < 0.4f)
+            ++sunk;
+    }
+    TEST_CHECK(sunk == 0);
+
+    SAFE_RELEASE(scene);
+    game->stopPhysics();
+    return time;
+}
+
+/**
+ * Times the steps of a stacked boxes scene with contacts computed on 1, 2, 4 and all hardware
+ * threads, and checks that the results for each thread count are reproducible.
+ */
+static void testThreadCounts(HeadlessGame* game)
+{
+    std::vector<unsigned int> threadCounts;
+    threadCounts.push_back(1);
+    threadCounts.push_back(2);
+    threadCounts.push_back(4);
+    unsigned int hardwareThreads = Thread::getHardwareConcurrency();
+    if (hardwareThreads > 4 || hardwareThreads == 3)
+        threadCounts.push_back(hardwareThreads);
+
+    for (size_t i = 0; i < threadCounts.size(); ++i)
+    {
+        std::vector<Matrix> first, second;
+        double time = simulate(game, threadCounts[i], &first);
+        simulate(game, threadCounts[i], &second);
+
+        unsigned int mismatches = 0;
+        for (size_t j = 0; j < first.size(); ++j)
+        {
+            if (memcmp(first[j].m, second[j].m, sizeof(first[j].m)) != 0)
+                ++mismatches;
+        }
+        TEST_CHECK(mismatches == 0);
+
+        printf("%u boxes, %u threads: %.3f ms per step, %u different transforms when repeated\n",
+            (unsigned int)first.size(), threadCounts[i], time, mismatches);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    HeadlessGame game;
+    testThreadCounts(&game);
+    return TEST_RESULT();
+}
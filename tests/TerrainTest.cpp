@@ -0,0 +1,82 @@
+#include "TestUtil.h"
+#include "Terrain.h"
+#include "Node.h"
+
+using namespace gameplay;
+
+static const unsigned int COLUMNS = 65;
+static const float SCALE_X = 2.0f;
+
+/**
+ * Creates a terrain whose heights rise along the X axis.
+ *
+ * The heightfield has a single row, so the terrain has no patches and no geometry needs to be
+ * built (which would need a graphics context). Heights vary only along X, and Z is clamped.
+ */
+static Terrain* createTerrain()
+{
+    HeightField* heightfield = HeightField::create(COLUMNS, 1);
+    float* heights = heightfield->getArray();
+    for (unsigned int x = 0; x < COLUMNS; ++x)
+    {
+        heights[x] = x * 0.5f + (x % 3) * 0.25f;
+    }
+    return Terrain::create(heightfield, Vector3(SCALE_X, 1.0f, 1.0f));
+}
+
+/**
+ * Returns the expected height at world position x of a terrain translated by tx along X.
+ */
+static float expectedHeight(float x, float tx)
+{
+    float column = (x - tx) / SCALE_X + (COLUMNS - 1) * 0.5f;
+    column = std::max(0.0f, std::min(column, (float)(COLUMNS - 1)));
+    unsigned int x1 = std::min((unsigned int)column, COLUMNS - 2);
+    float h1 = x1 * 0.5f + (x1 % 3) * 0.25f;
+    float h2 = (x1 + 1) * 0.5f + ((x1 + 1) % 3) * 0.25f;
+    return h1 + (h2 - h1) * (column - x1);
+}
+
+/**
+ * Single and batched height queries agree, and both follow the terrain node's translation.
+ */
+static void testTranslatedHeights()
+{
+    Terrain* terrain = createTerrain();
+    Node* node = Node::create("terrain");
+    node->setTerrain(terrain);
+
+    const float translations[2] = { 0.0f, 37.5f };
+    for (unsigned int t = 0; t < 2; ++t)
+    {
+        const float tx = translations[t];
+        node->setTranslation(tx, 12.0f, -20.0f);
+
+        const unsigned int count = 7;
+        Vector2 xz[count];
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            xz[i].set(tx - 60.0f + i * 19.3f, -20.0f + i * 3.0f);
+        }
+        float heights[count];
+        Vector3 normals[count];
+        terrain->getHeights(xz, heights, normals, count);
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            const float expected = expectedHeight(xz[i].x, tx);
+            TEST_CHECK(fabs(terrain->getHeight(xz[i].x, xz[i].y) - expected) <= 1e-4f);
+            TEST_CHECK(fabs(heights[i] - expected) <= 1e-4f);
+            TEST_CHECK(fabs(normals[i].length() - 1.0f) <= 1e-4f);
+        }
+    }
+
+    SAFE_RELEASE(terrain);
+    SAFE_RELEASE(node);
+}
+
+int main(int argc, char** argv)
+{
+    testTranslatedHeights();
+    return TEST_RESULT();
+}
@@ -0,0 +1,25 @@
+#ifndef TESTUTIL_H_
+#define TESTUTIL_H_
+
+#include "Base.h"
+
+/**
+ * Checks used by the headless tests.
+ *
+ * Failed checks are reported to stderr and counted, so that a test reports every
+ * failure in a single run. A test returns TEST_RESULT() from main.
+ */
+static int __testFailures = 0;
+
+#define TEST_CHECK(expression) do \
+    { \
+        if (!(expression)) \
+        { \
+            fprintf(stderr, "%s(%d): Check failed: %s\n", __FILE__, __LINE__, #expression); \
+            ++__testFailures; \
+        } \
+    } while (0)
+
+#define TEST_RESULT() (__testFailures == 0 ? 0 : 1)
+
+#endif
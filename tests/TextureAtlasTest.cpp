@@ -0,0 +1,139 @@
+#include "TestUtil.h"
+#include "TextureAtlas.h"
+
+using namespace gameplay;
+
+static const unsigned int PAGE_SIZE = 64;
+
+/**
+ * Adds an image of the given size to the atlas and returns its region.
+ */
+static const TextureAtlas::Region* add(TextureAtlas* atlas, const char* id, unsigned int width, unsigned int height)
+{
+    Image* image = Image::create(width, height, Image::RGBA, NULL);
+    const TextureAtlas::Region* region = atlas->add(id, image);
+    SAFE_RELEASE(image);
+    return region;
+}
+
+/**
+ * Checks that an image was placed at the given position.
+ */
+static void checkRegion(const TextureAtlas::Region* region, unsigned int page, unsigned int x, unsigned int y)
+{
+    TEST_CHECK(region != NULL);
+    if (region)
+    {
+        TEST_CHECK(region->page == page);
+        TEST_CHECK(region->x == x);
+        TEST_CHECK(region->y == y);
+    }
+}
+
+/**
+ * Images go onto the shortest shelf with room for them, and start a new shelf when none has room.
+ */
+static void testShelfChoice()
+{
+    TextureAtlas* atlas = TextureAtlas::create(PAGE_SIZE, PAGE_SIZE);
+
+    // Sizes are one less than the space taken, because of the padding.
+    checkRegion(add(atlas, "a", 47, 15), 0, 0, 0);
+
+    // Too wide for the rest of the first shelf, so a shorter shelf is started below it.
+    checkRegion(add(atlas, "b", 23, 7), 0, 0, 16);
+
+    // Both shelves have room, and the shorter one is chosen.
+    checkRegion(add(atlas, "c", 7, 7), 0, 24, 16);
+
+    // Too tall for the short shelf, so it goes onto the first one.
+    checkRegion(add(atlas, "d", 15, 15), 0, 48, 0);
+
+    // Neither shelf has room, so a third one is started.
+    checkRegion(add(atlas, "e", 15, 15), 0, 0, 24);
+
+    TEST_CHECK(atlas->getPageCount() == 1);
+    const TextureAtlas::Region* region = atlas->find("b");
+    TEST_CHECK(region != NULL && region->width == 23 && region->height == 7);
+
+    SAFE_RELEASE(atlas);
+}
+
+/**
+ * A new page is started when an image does not fit on any of the existing pages.
+ */
+static void testPageOverflow()
+{
+    TextureAtlas* atlas = TextureAtlas::create(PAGE_SIZE, PAGE_SIZE);
+
+    checkRegion(add(atlas, "a", 31, 31), 0, 0, 0);
+    checkRegion(add(atlas, "b", 31, 31), 0, 32, 0);
+    checkRegion(add(atlas, "c", 31, 31), 0, 0, 32);
+    checkRegion(add(atlas, "d", 31, 31), 0, 32, 32);
+    TEST_CHECK(atlas->getPageCount() == 1);
+
+    checkRegion(add(atlas, "e", 31, 31), 1, 0, 0);
+    TEST_CHECK(atlas->getPageCount() == 2);
+
+    // An image that fits the page exactly, including its padding, needs a page of its own.
+    checkRegion(add(atlas, "f", PAGE_SIZE - 1, PAGE_SIZE - 1), 2, 0, 0);
+    TEST_CHECK(atlas->getPageCount() == 3);
+
+    // Later images still use the first page with room.
+    checkRegion(add(atlas, "g", 15, 15), 1, 32, 0);
+    TEST_CHECK(atlas->getPageCount() == 3);
+
+    SAFE_RELEASE(atlas);
+}
+
+/**
+ * Images larger than a page are rejected without starting a page.
+ */
+static void testOversize()
+{
+    TextureAtlas* atlas = TextureAtlas::create(PAGE_SIZE, PAGE_SIZE);
+
+    TEST_CHECK(add(atlas, "wide", PAGE_SIZE, 1) == NULL);
+    TEST_CHECK(add(atlas, "tall", 1, PAGE_SIZE) == NULL);
+    TEST_CHECK(add(atlas, "large", PAGE_SIZE * 2, PAGE_SIZE * 2) == NULL);
+    TEST_CHECK(atlas->getPageCount() == 0);
+    TEST_CHECK(atlas->find("wide") == NULL);
+
+    SAFE_RELEASE(atlas);
+}
+
+/**
+ * Adding an image with an ID that was already added returns the existing region.
+ */
+static void testDuplicateIds()
+{
+    TextureAtlas* atlas = TextureAtlas::create(PAGE_SIZE, PAGE_SIZE);
+
+    const TextureAtlas::Region* first = add(atlas, "image", 15, 15);
+    TEST_CHECK(first != NULL);
+
+    // The duplicate is ignored, so the atlas does not keep a reference to it.
+    Image* image = Image::create(31, 31, Image::RGBA, NULL);
+    const TextureAtlas::Region* second = atlas->add("image", image);
+    TEST_CHECK(second == first);
+    TEST_CHECK(image->getRefCount() == 1);
+    SAFE_RELEASE(image);
+
+    TEST_CHECK(second->width == 15 && second->height == 15);
+    TEST_CHECK(atlas->find("image") == first);
+    TEST_CHECK(atlas->find("missing") == NULL);
+
+    // The space of the duplicate was not allocated.
+    checkRegion(add(atlas, "next", 15, 15), 0, 16, 0);
+
+    SAFE_RELEASE(atlas);
+}
+
+int main(int argc, char** argv)
+{
+    testShelfChoice();
+    testPageOverflow();
+    testOversize();
+    testDuplicateIds();
+    return TEST_RESULT();
+}
@@ -24,7 +24,7 @@ EncoderArguments::EncoderArguments(size_t argc, const char** argv) :
     _normalMap(false),
     _parseError(false),
     _fontPreview(false),
-    _fontFormat(Font::BITMAP),
+    _fontFormat(Font::DISTANCE_FIELD),
     _textOutput(false),
     _optimizeAnimations(false),
     _animationGrouping(ANIMATIONGROUP_PROMPT),
@@ -267,7 +267,9 @@ void EncoderArguments::printUsage() const
         "\t\t<size> is two comma-separated numbers in the format \"X,Y\", \n" \
         "\t\tindicating the dimensions of the produced heightmap image.\n" \
         "\t\t<node ids> should be in quotes with a space between each id.\n" \
-        "\t\tFilename is the name of the image (PNG) to be saved.\n" \
+        "\t\tFilename is the name of the image (PNG) to be saved. If the\n" \
+        "\t\tfilename has a .raw or .r16 extension, quantized 16-bit RAW\n" \
+        "\t\theights are saved instead.\n" \
         "\t\tMultiple -h arguments can be supplied to generate more than one \n" \
         "\t\theightmap. For 24-bit packed height data use -hp instead of -h.\n" \
     "\n" \
@@ -288,8 +290,10 @@ void EncoderArguments::printUsage() const
     "\n" \
     "TTF file options:\n" \
     "  -s <sizes>\tComma-separated list of font sizes (in pixels).\n" \
+    "  \t\tDistance field fonts only use the largest size, which they scale to\n" \
+    "  \t\tevery other size.\n" \
     "  -p\t\tOutput font preview.\n" \
-    "  -f\t\tFormat of font. -f:b (BITMAP), -f:d (DISTANCE_FIELD).\n" \
+    "  -f\t\tFormat of font. -f:b (BITMAP), -f:d (DISTANCE_FIELD, the default).\n" \
     "\n");
     exit(8);
 }
@@ -490,11 +494,14 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
                         return;
                     }
                     
-                    // Ensure the output filename has a .png extention
+                    // Ensure the output filename has a .png extention (or .raw/.r16 for RAW16 output)
                     if (heightmap.filename.length() > 5)
                     {
                         const char* ext = heightmap.filename.c_str() + (heightmap.filename.length() - 4);
-                        if (ext[0] != '.' || tolower(ext[1]) != 'p' || tolower(ext[2]) != 'n' || tolower(ext[3]) != 'g')
+                        bool isPng = ext[0] == '.' && tolower(ext[1]) == 'p' && tolower(ext[2]) == 'n' && tolower(ext[3]) == 'g';
+                        bool isRaw = ext[0] == '.' && tolower(ext[1]) == 'r' &&
+                            ((tolower(ext[2]) == 'a' && tolower(ext[3]) == 'w') || (ext[2] == '1' && ext[3] == '6'));
+                        if (!isPng && !isRaw)
                             heightmap.filename += ".png";
                     }
                     else
@@ -40,6 +40,9 @@ int generateHeightmapChunk(void* threadData);
 bool intersect(const Vector3& rayOrigin, const Vector3& rayDirection, const Vector3& boxMin, const Vector3& boxMax, float* distance = NULL);
 int intersect_triangle(const float orig[3], const float dir[3], const float vert0[3], const float vert1[3], const float vert2[3], float *t, float *u, float *v);
 bool intersect(const Vector3& rayOrigin, const Vector3& rayDirection, const std::vector<Vertex>& vertices, const std::vector<MeshPart*>& parts, Vector3* point);
+bool isRawFilename(const char* filename);
+bool writeRaw16(const char* filename, const float* heights, int size, float minHeight, float maxHeight);
+bool writeTerrain(const char* filename, int width, int height, float minHeight, float maxHeight, float sizeX, float sizeZ);
 
 void Heightmap::generate(const std::vector<std::string>& nodeIds, int width, int height, const char* filename, bool highP)
 {
@@ -174,14 +177,29 @@ void Heightmap::generate(const std::vector<std::string>& nodeIds, int width, int
         }
     }
     
-    // Normalize the max height value
-    maxHeight = maxHeight - minHeight;
-
     png_structp png_ptr = NULL;
     png_infop info_ptr = NULL;
     png_bytep row = NULL;
+    FILE* fp = NULL;
 
-    FILE* fp = fopen(filename, "wb");
+    if (isRawFilename(filename))
+    {
+        // Quantized 16-bit output
+        if (writeRaw16(filename, heights, size, minHeight, maxHeight))
+        {
+            LOG(1, "Saved heightmap: %s\n", filename);
+            LOG(1, "\tHeight range: %f to %f (max quantization error: %f)\n", minHeight, maxHeight, (maxHeight - minHeight) / 131070.0f);
+
+            // The height range is needed to map the quantized values back to heights
+            writeTerrain(filename, width, height, minHeight, maxHeight, maxX - minX, maxZ - minZ);
+        }
+        goto error;
+    }
+
+    // Normalize the max height value
+    maxHeight = maxHeight - minHeight;
+
+    fp = fopen(filename, "wb");
     if (fp == NULL)
     {
         LOG(1, "Error: Failed to open file for writing: %s\n", filename);
@@ -260,6 +278,75 @@ error:
         png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
 }
 
+bool isRawFilename(const char* filename)
+{
+    size_t len = strlen(filename);
+    if (len < 4)
+        return false;
+
+    const char* ext = filename + (len - 4);
+    return ext[0] == '.' &&
+        ((tolower(ext[1]) == 'r' && tolower(ext[2]) == 'a' && tolower(ext[3]) == 'w') ||
+         (tolower(ext[1]) == 'r' && ext[2] == '1' && ext[3] == '6'));
+}
+
+bool writeRaw16(const char* filename, const float* heights, int size, float minHeight, float maxHeight)
+{
+    FILE* fp = fopen(filename, "wb");
+    if (fp == NULL)
+    {
+        LOG(1, "Error: Failed to open file for writing: %s\n", filename);
+        return false;
+    }
+
+    // Round each height to the nearest of 65536 steps between min and max height
+    float scale = maxHeight > minHeight ? 65535.0f / (maxHeight - minHeight) : 0.0f;
+    unsigned char* bytes = new unsigned char[size * 2];
+    for (int i = 0; i < size; ++i)
+    {
+        unsigned int q = (unsigned int)((heights[i] - minHeight) * scale + 0.5f);
+        bytes[i * 2] = (unsigned char)(q & 0xff);
+        bytes[i * 2 + 1] = (unsigned char)((q >> 8) & 0xff);
+    }
+
+    bool result = fwrite(bytes, 1, size * 2, fp) == (size_t)(size * 2);
+    if (!result)
+        LOG(1, "Error: Failed to write heightmap data: %s\n", filename);
+
+    delete[] bytes;
+    fclose(fp);
+    return result;
+}
+
+bool writeTerrain(const char* filename, int width, int height, float minHeight, float maxHeight, float sizeX, float sizeZ)
+{
+    // Write a terrain file with the same name as the heightmap, which references it by file name
+    std::string heightmapPath(filename);
+    std::string terrainPath = heightmapPath.substr(0, heightmapPath.length() - 4) + ".terrain";
+    std::string heightmapName = getBaseName(heightmapPath) + heightmapPath.substr(heightmapPath.length() - 4);
+
+    FILE* fp = fopen(terrainPath.c_str(), "w");
+    if (fp == NULL)
+    {
+        LOG(1, "Error: Failed to open file for writing: %s\n", terrainPath.c_str());
+        return false;
+    }
+
+    fprintf(fp, "terrain\n{\n");
+    fprintf(fp, "    heightmap\n    {\n");
+    fprintf(fp, "        path = %s\n", heightmapName.c_str());
+    fprintf(fp, "        size = %d, %d\n", width, height);
+    fprintf(fp, "        heightRange = %f, %f\n", minHeight, maxHeight);
+    fprintf(fp, "        quantized = true\n");
+    fprintf(fp, "    }\n\n");
+    fprintf(fp, "    size = %f, 1, %f\n", sizeX, sizeZ);
+    fprintf(fp, "}\n");
+    fclose(fp);
+
+    LOG(1, "Saved terrain: %s\n", terrainPath.c_str());
+    return true;
+}
+
 int generateHeightmapChunk(void* threadData)
 {
     HeightmapThreadData* data = (HeightmapThreadData*)threadData;
@@ -11,13 +11,19 @@ class Heightmap
 public:
 
     /**
-     * Generates heightmap data and saves the result to the specified filename (PNG file).
+     * Generates heightmap data and saves the result to the specified filename (PNG or RAW file).
+     *
+     * If the filename has a .raw or .r16 extension, heights are written as quantized 16-bit
+     * little endian values (RAW16), which can be loaded directly into a quantized HeightField.
+     * The height range that the quantized values map to is logged, along with the maximum
+     * quantization error. It is also written to a terrain file with the same name as the
+     * heightmap (and a .terrain extension), from which the heights can be loaded directly.
      *
      * @param nodeIds List of node ids to include in the heightmap generation.
      * @param width Width of the produced heightmap image.
      * @param height Height of the produced  heightmap image.
-     * @param filename Output PNG file to write the heightmap image to.
-     * @param highP Use packed 24-bit (RGB) instead of standard 8-bit grayscale.
+     * @param filename Output PNG or RAW file to write the heightmap image to.
+     * @param highP Use packed 24-bit (RGB) instead of standard 8-bit grayscale (PNG only).
      */
     static void generate(const std::vector<std::string>& nodeIds, int width, int height, const char* filename, bool highP = false);
 
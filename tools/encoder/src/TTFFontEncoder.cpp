@@ -2,10 +2,14 @@
 #include "TTFFontEncoder.h"
 #include "GPBFile.h"
 #include "StringUtil.h"
+#include "Thread.h"
 
 namespace gameplay
 {
 
+// Number of threads to spawn for distance field generation
+#define THREAD_COUNT 8
+
 static void drawBitmap(unsigned char* dstBitmap, int x, int y, int dstWidth, unsigned char* srcBitmap, int srcWidth, int srcHeight)
 {
     // offset dst bitmap by x,y.
@@ -57,6 +61,18 @@ unsigned char* createDistanceFields(unsigned char* img, unsigned int width, unsi
         if (v < imgMin) 
             imgMin = v;
     }
+    // An empty image is far from any outline everywhere
+    if (imgMax <= 0)
+    {
+        free(xDistance);
+        free(yDistance);
+        free(gx);
+        free(gy);
+        free(data);
+        free(outside);
+        free(inside);
+        return (unsigned char*)calloc(width * height, sizeof(unsigned char));
+    }
     // Rescale image levels between 0 and 1
     for (i = 0; i < width * height; ++i)
     {
@@ -124,7 +140,11 @@ struct FontData
     unsigned int imageWidth;
     unsigned int imageHeight;
 
-    FontData() : fontSize(0), glyphSize(0), imageBuffer(NULL), imageWidth(0), imageHeight(0)
+    // Height of a row of glyphs in the texture, including padding, and the number of rows
+    unsigned int rowHeight;
+    unsigned int rowCount;
+
+    FontData() : fontSize(0), glyphSize(0), imageBuffer(NULL), imageWidth(0), imageHeight(0), rowHeight(0), rowCount(0)
     {
     }
 
@@ -134,6 +154,73 @@ struct FontData
             free(imageBuffer);
     }
 };
+
+// Thread data structure
+struct DistanceFieldThreadData
+{
+    unsigned char* image;       // [in][out]
+    unsigned int width;         // [in]
+    unsigned int rowHeight;     // [in]
+    unsigned int firstRow;      // [in]
+    unsigned int rowCount;      // [in]
+};
+
+static int generateDistanceFieldRows(void* threadData)
+{
+    DistanceFieldThreadData* data = (DistanceFieldThreadData*)threadData;
+    const unsigned int rowSize = data->rowHeight * data->width;
+    for (unsigned int row = data->firstRow, end = data->firstRow + data->rowCount; row < end; ++row)
+    {
+        unsigned char* rowImage = data->image + row * rowSize;
+
+        // Flip height and width since the distance field map generator is column-wise.
+        unsigned char* distanceField = createDistanceFields(rowImage, data->rowHeight, data->width);
+        memcpy(rowImage, distanceField, rowSize);
+        free(distanceField);
+    }
+    return 0;
+}
+
+// Replaces the glyphs in the texture of a font by their distance fields. Each row of glyphs
+// is transformed separately, which keeps the fields of neighbouring rows from running into
+// each other and lets the rows be split between threads.
+static void generateDistanceFields(FontData* font)
+{
+    unsigned int threadCount = std::min((unsigned int)THREAD_COUNT, font->rowCount);
+    if (threadCount == 0)
+        return;
+
+    DistanceFieldThreadData* threadData = new DistanceFieldThreadData[threadCount];
+    THREAD_HANDLE* threads = new THREAD_HANDLE[threadCount];
+    unsigned int startedCount = 0;
+    unsigned int firstRow = 0;
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        DistanceFieldThreadData& data = threadData[i];
+        data.image = font->imageBuffer;
+        data.width = font->imageWidth;
+        data.rowHeight = font->rowHeight;
+        data.firstRow = firstRow;
+        data.rowCount = (font->rowCount - firstRow) / (threadCount - i);
+        firstRow += data.rowCount;
+
+        // Start the processing thread, or process the rows here if that fails
+        if (createThread(&threads[startedCount], &generateDistanceFieldRows, &data))
+            ++startedCount;
+        else
+            generateDistanceFieldRows(&data);
+    }
+
+    // Wait for all threads to terminate
+    waitForThreads(startedCount, threads);
+
+    // Close all thread handles and free memory allocations.
+    for (unsigned int i = 0; i < startedCount; ++i)
+        closeThread(threads[i]);
+
+    delete[] threads;
+    delete[] threadData;
+}
  
 int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsigned int>& fontSizes, const char* id, bool fontpreview = false, Font::FontFormat fontFormat = Font::BITMAP)
 {
@@ -377,7 +464,14 @@ int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsig
         font->imageBuffer = imageBuffer;
         font->imageWidth = imageWidth;
         font->imageHeight = imageHeight;
+        font->rowHeight = rowSize;
+        font->rowCount = row + 1;
         fonts.push_back(font);
+
+        if (fontFormat == Font::DISTANCE_FIELD)
+        {
+            generateDistanceFields(font);
+        }
     }
 
     // File header and version.
@@ -435,36 +529,13 @@ int writeFont(const char* inFilePath, const char* outFilePath, std::vector<unsig
             fprintf(previewFp, "P5 %u %u 255\n", font->imageWidth, font->imageHeight);
         }
 
-        if (fontFormat == Font::DISTANCE_FIELD)
-        {
-            // Flip height and width since the distance field map generator is column-wise.
-            unsigned char* distanceFieldBuffer = createDistanceFields(font->imageBuffer, font->imageHeight, font->imageWidth);
-
-            fwrite(distanceFieldBuffer, sizeof(unsigned char), imageSize, gpbFp);
-            writeUint(gpbFp, Font::DISTANCE_FIELD);
-
-            if (previewFp)
-            {
-                fwrite((const char*)distanceFieldBuffer, sizeof(unsigned char), imageSize, previewFp);
-                fclose(previewFp);
-            }
-
-            free(distanceFieldBuffer);
-        }
-        else
-        {
-            fwrite(font->imageBuffer, sizeof(unsigned char), imageSize, gpbFp);
-            writeUint(gpbFp, Font::BITMAP);
-
-            if (previewFp)
-            {
-                fwrite((const char*)font->imageBuffer, sizeof(unsigned char), font->imageWidth * font->imageHeight, previewFp);
-                fclose(previewFp);
-            }
-        }
+        // The image holds distance fields already for distance field fonts.
+        fwrite(font->imageBuffer, sizeof(unsigned char), imageSize, gpbFp);
+        writeUint(gpbFp, fontFormat);
 
         if (previewFp)
         {
+            fwrite((const char*)font->imageBuffer, sizeof(unsigned char), imageSize, previewFp);
             fclose(previewFp);
             LOG(1, "%s.pgm preview image created successfully. \n", getBaseName(pgmFilePath).c_str());
         }
@@ -125,11 +125,17 @@ int main(int argc, const char** argv)
             }
             else
             {
-                // Distance fields use size
+                // A distance field scales to every size, so only the largest size is encoded.
                 if (fontSizes.size() == 0)
                 {
                     fontSizes.push_back(FONT_SIZE_DISTANCEFIELD);
                 }
+                else if (fontSizes.size() > 1)
+                {
+                    unsigned int fontSize = *std::max_element(fontSizes.begin(), fontSizes.end());
+                    LOG(1, "Distance field fonts scale to every size; encoding size %u only.\n", fontSize);
+                    fontSizes.assign(1, fontSize);
+                }
             }
             std::string id = getBaseName(arguments.getFilePath());
             writeFont(arguments.getFilePath().c_str(), arguments.getOutputFilePath().c_str(), fontSizes, id.c_str(), arguments.fontPreviewEnabled(), fontFormat);
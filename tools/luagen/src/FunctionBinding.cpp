@@ -12,6 +12,15 @@ static inline void outputGetParam(ostream& o, const FunctionBinding::Param& p, i
 static inline void outputMatchedBinding(ostream& o, const FunctionBinding& b, unsigned int paramCount, unsigned int indentLevel, int numBindings);
 static inline void outputReturnValue(ostream& o, const FunctionBinding& b, int indentLevel);
 static inline std::string getTypeName(const FunctionBinding::Param& param);
+static inline bool isInlineValue(const FunctionBinding::Param& param);
+
+// Value types that are returned to Lua stored inline in their userdata (instead of
+// in a separate heap allocation). These must all have trivial destructors, since the
+// Lua garbage collector frees the userdata without calling them.
+static const char* INLINE_VALUE_TYPES[] =
+{
+    "BoundingBox", "BoundingSphere", "Matrix", "Plane", "Quaternion", "Ray", "Rectangle", "Vector2", "Vector3", "Vector4", NULL
+};
 
 FunctionBinding::Param::Param(FunctionBinding::Param::Type type, Kind kind, const string& info) : 
     type(type), kind(kind), info(info), hasDefaultValue(false), levelsOfIndirection(0)
@@ -133,7 +142,10 @@ void FunctionBinding::write(ostream& o, const vector<FunctionBinding>& bindings)
                 o << "        void* returnPtr = (void*)instance->" << bindings[0].name << ";\n";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "        void* returnPtr = (void*)new " << bindings[0].returnParam << "(instance->" << bindings[0].name << ");\n";
+                if (isInlineValue(bindings[0].returnParam))
+                    o << "        " << bindings[0].returnParam << " result(instance->" << bindings[0].name << ");\n";
+                else
+                    o << "        void* returnPtr = (void*)new " << bindings[0].returnParam << "(instance->" << bindings[0].name << ");\n";
                 break;
             case FunctionBinding::Param::KIND_REFERENCE:
                 o << "        void* returnPtr = (void*)&(instance->" << bindings[0].name << ");\n";
@@ -208,7 +220,10 @@ void FunctionBinding::write(ostream& o, const vector<FunctionBinding>& bindings)
                 o << bindings[0].name << ";\n";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "        void* returnPtr = (void*)new " << bindings[0].returnParam << "(";
+                if (isInlineValue(bindings[0].returnParam))
+                    o << "        " << bindings[0].returnParam << " result(";
+                else
+                    o << "        void* returnPtr = (void*)new " << bindings[0].returnParam << "(";
                 if (bindings[0].classname.size() > 0)
                     o << bindings[0].classname << "::";
                 o << bindings[0].name << ");\n";
@@ -255,7 +270,10 @@ void FunctionBinding::write(ostream& o, const vector<FunctionBinding>& bindings)
                 o << "    void* returnPtr = (void*)instance->" << bindings[0].name << ";\n";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "    void* returnPtr = (void*)new " << bindings[0].returnParam << "(instance->" << bindings[0].name << ");\n";
+                if (isInlineValue(bindings[0].returnParam))
+                    o << "    " << bindings[0].returnParam << " result(instance->" << bindings[0].name << ");\n";
+                else
+                    o << "    void* returnPtr = (void*)new " << bindings[0].returnParam << "(instance->" << bindings[0].name << ");\n";
                 break;
             case FunctionBinding::Param::KIND_REFERENCE:
                 o << "    void* returnPtr = (void*)&(instance->" << bindings[0].name << ");\n";
@@ -296,7 +314,10 @@ void FunctionBinding::write(ostream& o, const vector<FunctionBinding>& bindings)
                 o << bindings[0].name << ";\n";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "    void* returnPtr = (void*)new " << bindings[0].returnParam << "(";
+                if (isInlineValue(bindings[0].returnParam))
+                    o << "    " << bindings[0].returnParam << " result(";
+                else
+                    o << "    void* returnPtr = (void*)new " << bindings[0].returnParam << "(";
                 if (bindings[0].classname.size() > 0)
                     o << bindings[0].classname << "::";
                 o << bindings[0].name << ");\n";
@@ -507,6 +528,24 @@ ostream& operator<<(ostream& o, const FunctionBinding::Param& param)
 // ---------------------------------------------
 // Helper functions
 
+static inline bool isInlineValue(const FunctionBinding::Param& param)
+{
+    // Constructors of the value types are treated the same as functions returning them by value.
+    if (param.type != FunctionBinding::Param::TYPE_CONSTRUCTOR &&
+        (param.type != FunctionBinding::Param::TYPE_OBJECT || param.kind != FunctionBinding::Param::KIND_VALUE))
+    {
+        return false;
+    }
+
+    string name = Generator::getInstance()->getUniqueNameFromRef(param.info);
+    for (int i = 0; INLINE_VALUE_TYPES[i] != NULL; i++)
+    {
+        if (name == INLINE_VALUE_TYPES[i])
+            return true;
+    }
+    return false;
+}
+
 static inline void outputLuaTypeCheckInstance(ostream& o)
 {
     o << "(lua_type(state, 1) == LUA_TUSERDATA)";
@@ -637,10 +676,16 @@ static inline void outputBindingInvocation(ostream& o, const FunctionBinding& b,
             switch (b.returnParam.kind)
             {
             case FunctionBinding::Param::KIND_POINTER:
-                o << "void* returnPtr = (void*)";
+                if (isInlineValue(b.returnParam))
+                    o << b.returnParam << " result = ";
+                else
+                    o << "void* returnPtr = (void*)";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "void* returnPtr = (void*)new " << b.returnParam << "(";
+                if (isInlineValue(b.returnParam))
+                    o << b.returnParam << " result(";
+                else
+                    o << "void* returnPtr = (void*)new " << b.returnParam << "(";
                 break;
             case FunctionBinding::Param::KIND_REFERENCE:
                 o << "void* returnPtr = (void*)&(";
@@ -667,7 +712,9 @@ static inline void outputBindingInvocation(ostream& o, const FunctionBinding& b,
         {
             if (b.returnParam.type == FunctionBinding::Param::TYPE_CONSTRUCTOR)
             {
-                o << "new " << Generator::getInstance()->getIdentifier(b.returnParam.info) << "(";
+                if (!isInlineValue(b.returnParam))
+                    o << "new ";
+                o << Generator::getInstance()->getIdentifier(b.returnParam.info) << "(";
             }
             else
             {
@@ -988,6 +1035,11 @@ static inline void outputReturnValue(ostream& o, const FunctionBinding& b, int i
         break;
     case FunctionBinding::Param::TYPE_OBJECT:
     case FunctionBinding::Param::TYPE_CONSTRUCTOR:
+        if (isInlineValue(b.returnParam))
+        {
+            o << "gameplay::ScriptUtil::pushValue(state, result, \"" << Generator::getInstance()->getUniqueNameFromRef(b.returnParam.info) << "\");\n";
+            break;
+        }
         o << "if (returnPtr)\n";
         indent(o, indentLevel);
         o << "{\n";